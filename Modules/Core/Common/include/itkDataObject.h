@@ -440,6 +440,14 @@ public:
   virtual bool RequestedRegionIsOutsideOfTheBufferedRegion()
   { return false; }
 
+  /** Size, in bytes, of the bulk data that holds the RequestedRegion.
+   * ProcessObject::EstimateRequestedRegionMemory() sums it over the
+   * outputs of a process object to estimate the memory it allocates.  The
+   * default implementation returns 0, for DataObject's whose size is not
+   * known from their requested region. */
+  virtual SizeValueType GetRequestedRegionMemorySize() const
+  { return 0; }
+
   /** Verify that the RequestedRegion is within the LargestPossibleRegion.
    *
    * If the RequestedRegion is not within the LargestPossibleRegion,
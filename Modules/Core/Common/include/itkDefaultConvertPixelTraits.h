@@ -191,7 +191,7 @@ public:
   {
     return 0;
   }
-  static unsigned int GetNumberOfComponents( const TargetType pixel )
+  static unsigned int GetNumberOfComponents( const TargetType & pixel )
   {
     return pixel.Size();
   }
@@ -224,7 +224,7 @@ public:
   {
     return 0;
   }
-  static unsigned int GetNumberOfComponents( const TargetType pixel )
+  static unsigned int GetNumberOfComponents( const TargetType & pixel )
   {
     return pixel.Cols() * pixel.Rows();
   }
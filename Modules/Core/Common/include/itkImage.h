@@ -287,6 +287,12 @@ public:
 
   unsigned int GetNumberOfComponentsPerPixel() const override;
 
+  /** Size, in bytes, of the pixels of the RequestedRegion. */
+  SizeValueType GetRequestedRegionMemorySize() const override
+  {
+    return this->GetRequestedRegion().GetNumberOfPixels() * sizeof( PixelType );
+  }
+
 protected:
   Image();
   void PrintSelf(std::ostream & os, Indent indent) const override;
@@ -123,6 +123,28 @@ struct ImageAlgorithm
                        const OutputImageType* outputImage,
                        const TransformType* transform);
 
+  /**
+   * \brief Calls a function for each run of pixels of a region that is
+   * contiguous in the buffers of all the given images.
+   *
+   * The runs are as long as possible: a run is a line of the region, or
+   * several lines when the region spans whole lines, or planes, of all the
+   * buffers.  The function is called as
+   * \code
+   * function( offsets, length );
+   * \endcode
+   * where offsets[i] is the offset, in pixels, of the first pixel of the
+   * run in the buffer of the i-th image, and length is the number of
+   * pixels of the run.  The region must be buffered by all the images.
+   *
+   * Pixel-wise operations on the buffers of Image's are then plain loops
+   * over arrays, which the compiler can vectorize.
+   */
+  template<unsigned int VImageDimension, typename TFunction, typename... TImages>
+  static void ForEachContiguousRun( const ImageRegion<VImageDimension> & region,
+                                    const TFunction & function,
+                                    const TImages * ... images );
+
 private:
 
   /** This is an optimized method which requires the input and
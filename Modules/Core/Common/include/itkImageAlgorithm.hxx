@@ -168,6 +168,67 @@ void ImageAlgorithm::DispatchedCopy( const InputImageType *inImage,
 }
 
 
+template<unsigned int VImageDimension, typename TFunction, typename... TImages>
+void ImageAlgorithm::ForEachContiguousRun( const ImageRegion<VImageDimension> & region,
+                                           const TFunction & function,
+                                           const TImages * ... images )
+{
+  constexpr unsigned int NumberOfImages = sizeof...( TImages );
+  const ImageBase<VImageDimension> * const bases[NumberOfImages] = { images... };
+
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  // The lines are merged as long as the region spans the lower
+  // dimensions of all the buffers.
+  SizeValueType length = region.GetSize(0);
+  unsigned int movingDirection = 1;
+  while ( movingDirection < VImageDimension )
+    {
+    bool spansBuffers = true;
+    for ( unsigned int i = 0; i < NumberOfImages; ++i )
+      {
+      spansBuffers = spansBuffers
+        && region.GetSize(movingDirection - 1) == bases[i]->GetBufferedRegion().GetSize(movingDirection - 1);
+      }
+    if ( !spansBuffers )
+      {
+      break;
+      }
+    length *= region.GetSize(movingDirection);
+    ++movingDirection;
+    }
+
+  OffsetValueType offsets[NumberOfImages];
+  typename ImageRegion<VImageDimension>::IndexType index = region.GetIndex();
+  while ( true )
+    {
+    for ( unsigned int i = 0; i < NumberOfImages; ++i )
+      {
+      offsets[i] = bases[i]->ComputeOffset(index);
+      }
+    function(offsets, length);
+
+    // Move to the next run, carrying to the higher dimensions
+    unsigned int dim = movingDirection;
+    for ( ; dim < VImageDimension; ++dim )
+      {
+      if ( ++index[dim] < region.GetIndex(dim) + static_cast<IndexValueType>( region.GetSize(dim) ) )
+        {
+        break;
+        }
+      index[dim] = region.GetIndex(dim);
+      }
+    if ( dim == VImageDimension )
+      {
+      return;
+      }
+    }
+}
+
+
 template<typename InputImageType, typename OutputImageType>
 typename OutputImageType::RegionType
 ImageAlgorithm::EnlargeRegionOverBox(const typename InputImageType::RegionType & inputRegion,
@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h" // for ITKCommon_EXPORT
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+/** \class ImageBufferPool
+ *  \brief Process-wide pool of recycled pixel buffers.
+ *
+ * When the pool is enabled, ImportImageContainer draws the buffers of
+ * images and vector images from it, and returns them to it instead of
+ * freeing them.  A pipeline that is updated over and over, or that
+ * releases its intermediate data with ReleaseDataFlag, then reuses the
+ * same pages instead of allocating and faulting in new ones.
+ *
+ * Buffers are grouped in size classes, four per power of two, so that a
+ * buffer serves any request of its class.  Buffers smaller than
+ * MinimumBufferSize are not pooled, and the pool frees the buffers that
+ * are returned while it already caches MaximumCachedSize bytes.  On Linux,
+ * the pool can ask for transparent huge pages for its buffers.
+ *
+ * The pool is disabled by default.  It is enabled with SetEnabled(), or
+ * with the ITK_USE_IMAGE_BUFFER_POOL environment variable, so that
+ * existing filters benefit from it without code changes.  Only the
+ * buffers of pixel types without destructor are pooled.
+ *
+ * \ingroup ITKCommon
+ */
+
+struct ImageBufferPoolGlobals;
+
+class ITKCommon_EXPORT ImageBufferPool
+{
+public:
+  /** Enable or disable the pool for the buffers allocated from now on.
+   * Disabling the pool frees the cached buffers.  The buffers that are in
+   * use are returned to the pool, and freed, when they are released. */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+
+  /** Buffers smaller than this size, in bytes, are not pooled.  The default
+   * is 64 KiB. */
+  static void SetMinimumBufferSize(SizeValueType size);
+  static SizeValueType GetMinimumBufferSize();
+
+  /** The largest number of bytes held by unused buffers.  The default is
+   * 1 GiB. */
+  static void SetMaximumCachedSize(SizeValueType size);
+  static SizeValueType GetMaximumCachedSize();
+
+  /** Advise the kernel to back the buffers allocated from now on with huge
+   * pages.  Only has an effect on Linux. */
+  static void SetUseHugePages(bool useHugePages);
+  static bool GetUseHugePages();
+
+  /** Returns a buffer of at least the given size, in bytes, or nullptr if
+   * the pool is disabled, the size is below MinimumBufferSize, or the
+   * allocation fails.  The content of the buffer is undefined.  The buffer
+   * is raw memory from operator new[]: it is given back with Release(), or
+   * freed with ::operator delete[] once the pool is destroyed, never with a
+   * typed delete[]. */
+  static void * Allocate(SizeValueType size);
+
+  /** Returns a buffer to the pool.  Returns false, and does nothing, if the
+   * buffer was not allocated by the pool or the pool is destroyed. */
+  static bool Release(void * buffer);
+
+  /** Whether the buffer was allocated by the pool and is not released. */
+  static bool IsInUse(const void * buffer);
+
+  /** Frees all the cached buffers. */
+  static void ReleaseCachedBuffers();
+
+  /** The number of allocations served by a cached buffer. */
+  static SizeValueType GetNumberOfHits();
+
+  /** The number of allocations that needed a new buffer. */
+  static SizeValueType GetNumberOfMisses();
+
+  /** The number of bytes of the buffers in use. */
+  static SizeValueType GetSizeInUse();
+
+  /** The number of bytes of the cached buffers. */
+  static SizeValueType GetCachedSize();
+
+  /** The largest number of bytes held by the pool at once, in use or
+   * cached. */
+  static SizeValueType GetHighWaterMark();
+
+  /** Resets the hits, misses and high water mark. */
+  static void ResetStatistics();
+
+private:
+  ImageBufferPool() = default;
+  ImageBufferPool(const ImageBufferPool &) = delete;
+  void operator=(const ImageBufferPool &) = delete;
+
+  itkGetGlobalDeclarationMacro(ImageBufferPoolGlobals, PimplGlobals);
+  static ImageBufferPoolGlobals * m_PimplGlobals;
+};
+}
+
+#endif
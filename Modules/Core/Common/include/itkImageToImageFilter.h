@@ -207,6 +207,15 @@ public:
   using ImageToImageFilterCommon::SetGlobalDefaultCoordinateTolerance;
   using ImageToImageFilterCommon::GetGlobalDefaultCoordinateTolerance;
 
+  /** get/set the global automatic in-place execution
+   *
+   * When on, the InPlaceImageFilter subclasses overwrite their first input
+   * if it is released after their execution anyway, whether their InPlace
+   * flag is set or not.
+   */
+  using ImageToImageFilterCommon::SetGlobalAutomaticInPlace;
+  using ImageToImageFilterCommon::GetGlobalAutomaticInPlace;
+
 
 protected:
   ImageToImageFilter();
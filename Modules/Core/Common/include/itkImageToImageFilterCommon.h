@@ -42,6 +42,12 @@ public:
   static double GetGlobalDefaultCoordinateTolerance();
   static void SetGlobalDefaultDirectionTolerance(double);
   static double GetGlobalDefaultDirectionTolerance();
+
+  /** When on, an InPlaceImageFilter also runs in place while its InPlace
+   * flag is off, if its first input is released after the execution anyway
+   * (see InPlaceImageFilter::ShouldRunInPlace()).  Off by default. */
+  static void SetGlobalAutomaticInPlace(bool);
+  static bool GetGlobalAutomaticInPlace();
 };
 
 } // end namespace itk
@@ -36,6 +36,9 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * When the ImageBufferPool is enabled, the memory managed by the container
+ * is drawn from the pool and returned to it.
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -182,6 +185,7 @@ private:
   TElementIdentifier m_Size;
   TElementIdentifier m_Capacity;
   bool               m_ContainerManageMemory;
+  bool               m_ImportPointerFromPool;
 };
 } // end namespace itk
 
@@ -29,7 +29,12 @@
 #define itkImportImageContainer_hxx
 
 #include "itkImportImageContainer.h"
+#include "itkImageBufferPool.h"
+#include "itkMultiThreaderBase.h"
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <new>
+#include <type_traits>
 
 namespace itk
 {
@@ -39,6 +44,7 @@ ImportImageContainer< TElementIdentifier, TElement >
 {
   m_ImportPointer = nullptr;
   m_ContainerManageMemory = true;
+  m_ImportPointerFromPool = false;
   m_Capacity = 0;
   m_Size = 0;
 }
@@ -66,13 +72,15 @@ ImportImageContainer< TElementIdentifier, TElement >
     {
     if ( size > m_Capacity )
       {
-      TElement *temp = this->AllocateElements(size, UseDefaultConstructor);
+      TElement * temp = this->AllocateElements(size, UseDefaultConstructor);
+      const bool tempFromPool = ImageBufferPool::IsInUse(temp);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerFromPool = tempFromPool;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -87,6 +95,7 @@ ImportImageContainer< TElementIdentifier, TElement >
   else
     {
     m_ImportPointer = this->AllocateElements(size, UseDefaultConstructor);
+    m_ImportPointerFromPool = ImageBufferPool::IsInUse(m_ImportPointer);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -109,11 +118,13 @@ ImportImageContainer< TElementIdentifier, TElement >
       {
       const TElementIdentifier size = m_Size;
       TElement *               temp = this->AllocateElements(size, false);
+      const bool               tempFromPool = ImageBufferPool::IsInUse(temp);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerFromPool = tempFromPool;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -158,6 +169,7 @@ ImportImageContainer< TElementIdentifier, TElement >
 {
   DeallocateManagedMemory();
   m_ImportPointer = ptr;
+  m_ImportPointerFromPool = ImageBufferPool::IsInUse(ptr);
   m_ContainerManageMemory = LetContainerManageMemory;
   m_Capacity = num;
   m_Size = num;
@@ -172,11 +184,47 @@ TElement *ImportImageContainer< TElementIdentifier, TElement >
   // Encapsulate all image memory allocation here to throw an
   // exception when memory allocation fails even when the compiler
   // does not do this by default.
-  TElement *data;
+  TElement *data = nullptr;
 
+  // Draw from the buffer pool when it is enabled.  Its buffers are not
+  // destroyed element by element, so only types without destructor qualify.
+  if ( std::is_trivially_destructible< TElement >::value
+       && size <= std::numeric_limits< SizeValueType >::max() / sizeof( TElement ) )
+    {
+    data = static_cast< TElement * >( ImageBufferPool::Allocate( static_cast< SizeValueType >( size )
+                                                                 * sizeof( TElement ) ) );
+    if ( data )
+      {
+      if ( UseDefaultConstructor )
+        {
+        for ( ElementIdentifier i = 0; i < size; ++i )
+          {
+          new ( data + i ) TElement();
+          }
+        }
+      else if ( !std::is_trivial< TElement >::value )
+        {
+        for ( ElementIdentifier i = 0; i < size; ++i )
+          {
+          new ( data + i ) TElement;
+          }
+        }
+      return data;
+      }
+    }
+
+  // The pages of the buffer are placed on the NUMA nodes of the threads
+  // that first write them, which can be the work units rather than the
+  // calling thread.
+  const bool touchInParallel = std::is_trivial< TElement >::value
+                               && MultiThreaderBase::GetGlobalDefaultParallelFirstTouch();
   try
     {
-    if ( UseDefaultConstructor )
+    if ( touchInParallel )
+      {
+      data = new TElement[size];
+      }
+    else if ( UseDefaultConstructor )
       {
       data = new TElement[size](); //POD types initialized to 0, others use default constructor.
       }
@@ -197,6 +245,11 @@ TElement *ImportImageContainer< TElementIdentifier, TElement >
                                 "Failed to allocate memory for image.",
                                 ITK_LOCATION);
     }
+  if ( touchInParallel )
+    {
+    MultiThreaderBase::TouchInParallel( data, static_cast< SizeValueType >( size ) * sizeof( TElement ),
+                                        UseDefaultConstructor );
+    }
   return data;
 }
 
@@ -204,12 +257,22 @@ template< typename TElementIdentifier, typename TElement >
 void ImportImageContainer< TElementIdentifier, TElement >
 ::DeallocateManagedMemory()
 {
-  // Encapsulate all image memory deallocation here
-  if ( m_ContainerManageMemory )
+  // Encapsulate all image memory deallocation here.  The buffers of the pool
+  // are raw memory: they go back to the pool, or are freed with the matching
+  // operator once the pool is destroyed.
+  if ( m_ContainerManageMemory && !ImageBufferPool::Release(m_ImportPointer) )
     {
-    delete[] m_ImportPointer;
+    if ( m_ImportPointerFromPool )
+      {
+      ::operator delete[]( m_ImportPointer );
+      }
+    else
+      {
+      delete[] m_ImportPointer;
+      }
     }
   m_ImportPointer = nullptr;
+  m_ImportPointerFromPool = false;
   m_Capacity = 0;
   m_Size = 0;
 }
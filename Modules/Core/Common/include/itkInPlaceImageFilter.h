@@ -61,6 +61,15 @@ namespace itk
  * operation can also be controlled (when the input and output image
  * type match) via the methods InPlaceOn() and InPlaceOff().
  *
+ * When the GlobalAutomaticInPlace flag of ImageToImageFilter is on, the
+ * filter also runs in place while InPlace is off if its first input
+ * is released after the execution anyway, i.e. if the input is produced by
+ * another filter and its ReleaseDataFlag (or the GlobalReleaseDataFlag) is
+ * set.  Overwriting such an input has no effect on the other consumers,
+ * which have to re-execute the upstream pipeline in both cases, and halves
+ * the memory of chains of pixel-wise filters.  GetRanInPlace() reports
+ * whether the last execution reused the buffer of the input.
+ *
  * Subclasses of InPlaceImageFilter must take extra care in how they
  * manage memory using (and perhaps overriding) the implementations of
  * ReleaseInputs() and AllocateOutputs() provided here.
@@ -124,6 +133,14 @@ public:
    * subclasses to fine tune its behavior. */
   virtual bool CanRunInPlace() const;
 
+  /** The output of a filter that runs in place takes no memory beyond the
+   * buffer of its first input. */
+  SizeValueType EstimateRequestedRegionMemory() const override;
+
+  /** Whether the last execution reused the buffer of the first input for
+   * the output. */
+  itkGetConstMacro(RanInPlace, bool);
+
 protected:
   InPlaceImageFilter() = default;
   ~InPlaceImageFilter() override = default;
@@ -158,17 +175,28 @@ protected:
    * \sa ProcessObject::ReleaseInputs() */
   void ReleaseInputs() override;
 
+  /** The ReleaseDataFlag of the inputs is turned off while the filter
+   * executes, so the flag of the first input is recorded beforehand to
+   * decide whether the filter may run in place automatically. */
+  void CacheInputReleaseDataFlags() override;
+
   /** This methods should only be called during the GenerateData phase
    *  of the pipeline. This method return true if the input image's
    *  bulk data is the same as the output image's data.
    */
   itkGetConstMacro(RunningInPlace,bool);
 
+  /** Whether the first input may be overwritten: either InPlace is on, or
+   * automatic in-place execution is on and the first input is released
+   * after the execution anyway.  CanRunInPlace() must hold as well. */
+  bool ShouldRunInPlace() const;
+
 private:
   // the type are different we can't run in place
   void InternalAllocateOutputs( const FalseType& )
   {
     this->m_RunningInPlace = false;
+    this->m_RanInPlace = false;
     this->Superclass::AllocateOutputs();
   }
 
@@ -176,6 +204,8 @@ private:
 
   bool m_InPlace{true}; // enable the possibility of in-place
   bool m_RunningInPlace{false};
+  bool m_RanInPlace{false};
+  bool m_ReleasePrimaryInput{false};
 
 };
 } // end namespace itk
@@ -40,6 +40,7 @@ InPlaceImageFilter< TInputImage, TOutputImage >
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "InPlace: " << ( m_InPlace ? "On" : "Off" ) << std::endl;
+  os << indent << "RanInPlace: " << ( m_RanInPlace ? "On" : "Off" ) << std::endl;
   if ( this->CanRunInPlace() )
     {
     os << indent << "The input and output to this filter are the same type. The filter can be run in place."
@@ -52,6 +53,22 @@ InPlaceImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+InPlaceImageFilter< TInputImage, TOutputImage >
+::EstimateRequestedRegionMemory() const
+{
+  SizeValueType memory = Superclass::EstimateRequestedRegionMemory();
+  const DataObject * input = this->ProcessObject::GetInput(0);
+  const DataObject * output = this->ProcessObject::GetOutput(0);
+  if ( input && output && this->ShouldRunInPlace() && this->CanRunInPlace()
+       && input->GetRequestedRegionMemorySize() == output->GetRequestedRegionMemorySize() )
+    {
+    memory -= output->GetRequestedRegionMemorySize();
+    }
+  return memory;
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 InPlaceImageFilter< TInputImage, TOutputImage >
@@ -87,10 +104,12 @@ InPlaceImageFilter< TInputImage, TOutputImage >
     rMatch = false;
     }
   if ( inputPtr != nullptr &&
-       this->GetInPlace() &&
+       this->ShouldRunInPlace() &&
        this->CanRunInPlace() &&
        rMatch )
     {
+    itkDebugMacro(<< "Running in place, the output reuses the buffer of the first input");
+
     // Graft this first input to the output.  Later, we'll need to
     // remove the input's hold on the bulk data.
     //
@@ -103,6 +122,7 @@ InPlaceImageFilter< TInputImage, TOutputImage >
 
     this->GraftOutput(inputAsOutput);
     this->m_RunningInPlace = true;
+    this->m_RanInPlace = true;
 
     using ImageBaseType = ImageBase< OutputImageDimension >;
 
@@ -129,10 +149,42 @@ InPlaceImageFilter< TInputImage, TOutputImage >
   else
     {
     this->m_RunningInPlace = false;
+    this->m_RanInPlace = false;
     Superclass::AllocateOutputs();
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+bool
+InPlaceImageFilter< TInputImage, TOutputImage >
+::ShouldRunInPlace() const
+{
+  if ( this->GetInPlace() )
+    {
+    return true;
+    }
+  if ( !Superclass::GetGlobalAutomaticInPlace() )
+    {
+    return false;
+    }
+
+  // An input that is released after this execution is not used by anyone
+  // else afterwards, so its buffer may as well become the output.  Images
+  // without a source belong to the application and are never overwritten.
+  const DataObject *input = this->ProcessObject::GetInput(0);
+  return input != nullptr && input->GetSource() != nullptr && m_ReleasePrimaryInput;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+InPlaceImageFilter< TInputImage, TOutputImage >
+::CacheInputReleaseDataFlags()
+{
+  const DataObject *input = this->ProcessObject::GetInput(0);
+  m_ReleasePrimaryInput = input != nullptr && input->ShouldIReleaseData();
+  Superclass::CacheInputReleaseDataFlags();
+}
+
 template< typename TInputImage, typename TOutputImage >
 bool
 InPlaceImageFilter< TInputImage, TOutputImage >
@@ -152,6 +152,41 @@ public:
   static void SetGlobalDefaultNumberOfThreads(ThreadIdType val);
   static ThreadIdType GetGlobalDefaultNumberOfThreads();
 
+  /** Set/Get whether the work units are pinned to the processors of a NUMA
+   * node.  When enabled, work unit i of n runs on the processors of node
+   * i * m / n, where m is the number of NUMA nodes, whichever thread
+   * executes it.  The work units that process the same part of an image
+   * then run on the same node from filter to filter, so that the pages of
+   * the image stay local to the threads that use them.  It is disabled by
+   * default, unless the ITK_GLOBAL_DEFAULT_THREAD_AFFINITY environment
+   * variable is set to ON.  The Platform and Pool threaders support it; it
+   * only has an effect on Linux systems whose NUMA nodes are known. */
+  static void SetGlobalDefaultThreadAffinity(bool threadAffinity);
+  static bool GetGlobalDefaultThreadAffinity();
+
+  /** Set/Get whether new image buffers are first touched in parallel.  The
+   * kernel places a page on the NUMA node of the thread that first writes
+   * it, so a buffer allocated and zeroed by the main thread lives on a
+   * single node.  When enabled, ImportImageContainer has the pages of its
+   * buffers of trivial pixels touched by TouchInParallel() instead.  It is
+   * disabled by default, unless the ITK_GLOBAL_DEFAULT_PARALLEL_FIRST_TOUCH
+   * environment variable is set to ON. */
+  static void SetGlobalDefaultParallelFirstTouch(bool parallelFirstTouch);
+  static bool GetGlobalDefaultParallelFirstTouch();
+
+  /** Touches, or zeroes, the pages of a buffer of size bytes with the work
+   * units of a default multi-threader: work unit i of n touches the i-th of
+   * n equal parts of the buffer, as it processes the i-th slab of an image
+   * split along its slowest dimension.  With GlobalDefaultThreadAffinity,
+   * each part is placed on the NUMA node that processes it.  Small buffers,
+   * and the buffers allocated within a work unit, are touched by the
+   * calling thread. */
+  static void TouchInParallel(void *buffer, SizeValueType size, bool zero);
+
+  /** The number of NUMA nodes the work units are distributed over: 1 when
+   * the system has a single node or its topology is not known. */
+  static unsigned int GetNumberOfNumaNodes();
+
 #if !defined( ITK_LEGACY_REMOVE )
   /** Get/Set the number of threads to use.
    * DEPRECATED! Use WorkUnits and MaximumNumberOfThreads instead. */
@@ -375,6 +410,39 @@ protected:
 
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION ParallelizeImageRegionHelper(void *arg);
 
+  /** Marks the calling thread as running a work unit while in scope.  When
+   * GlobalDefaultThreadAffinity is enabled, the thread is pinned to the
+   * processors of the NUMA node of the work unit, and gets its own affinity
+   * back afterwards. */
+  class WorkUnitAffinityScope
+  {
+  public:
+    WorkUnitAffinityScope(ThreadIdType workUnit, ThreadIdType numberOfWorkUnits):
+      m_Pinned( MultiThreaderBase::EnterWorkUnit(workUnit, numberOfWorkUnits) )
+    {}
+    ~WorkUnitAffinityScope()
+    {
+      MultiThreaderBase::LeaveWorkUnit(m_Pinned);
+    }
+    WorkUnitAffinityScope(const WorkUnitAffinityScope &) = delete;
+    void operator=(const WorkUnitAffinityScope &) = delete;
+
+  private:
+    const bool m_Pinned;
+  };
+
+  /** Enters a work unit, and pins the calling thread to the node of the
+   * work unit.  Returns whether the thread was pinned. */
+  static bool EnterWorkUnit(ThreadIdType workUnit, ThreadIdType numberOfWorkUnits);
+
+  /** Leaves a work unit, and restores the affinity the calling thread had
+   * before it, if it was pinned. */
+  static void LeaveWorkUnit(bool pinned);
+
+  /** Whether the calling thread is running a work unit of the Platform or
+   * Pool threaders. */
+  static bool IsInWorkUnit();
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits;
 
@@ -19,6 +19,7 @@
 #define itkNeighborhoodAlgorithm_h
 
 #include <list>
+#include <vector>
 #include "itkImage.h"
 #include "itkNeighborhoodOperator.h"
 #include "itkNeighborhoodIterator.h"
@@ -71,6 +72,149 @@ struct ImageBoundaryFacesCalculator {
   FaceListType operator()(const TImage *, RegionType, RadiusType);
 };
 
+/** \class InteriorNeighborhood
+ *  \brief Neighborhood of a pixel whose neighbors are all in the buffer.
+ *
+ * The neighbors are read at fixed offsets from the center pixel, without
+ * boundary condition.  The neighbors are numbered as in a Neighborhood, and
+ * GetPixel(i) returns the same value as ConstNeighborhoodIterator::GetPixel(i).
+ * InteriorNeighborhood's are provided by
+ * ImageNeighborhoodPartition::ForEachInteriorNeighborhood().
+ *
+ * \ingroup ITKCommon
+ */
+template< typename TImage >
+class InteriorNeighborhood
+{
+public:
+  using PixelType = typename TImage::PixelType;
+  using InternalPixelType = typename TImage::InternalPixelType;
+  using NeighborhoodAccessorFunctorType = typename TImage::NeighborhoodAccessorFunctorType;
+  using NeighborIndexType = typename Neighborhood< PixelType, TImage::ImageDimension >::NeighborIndexType;
+
+  InteriorNeighborhood(const NeighborhoodAccessorFunctorType & accessor,
+                       const OffsetValueType *offsets, NeighborIndexType size):
+    m_NeighborhoodAccessor(accessor),
+    m_Offsets(offsets),
+    m_Size(size)
+  {}
+
+  /** Value of the i-th pixel of the neighborhood. */
+  PixelType GetPixel(NeighborIndexType i) const
+  {
+    return m_NeighborhoodAccessor.Get(m_Center + m_Offsets[i]);
+  }
+
+  /** Value of the center pixel. */
+  PixelType GetCenterPixel() const
+  {
+    return m_NeighborhoodAccessor.Get(m_Center);
+  }
+
+  /** Number of pixels of the neighborhood. */
+  NeighborIndexType Size() const
+  {
+    return m_Size;
+  }
+
+  /** Set the pixel the neighborhood is centered on. */
+  void SetCenterPointer(const InternalPixelType *center)
+  {
+    m_Center = center;
+  }
+
+  const InternalPixelType * GetCenterPointer() const
+  {
+    return m_Center;
+  }
+
+private:
+  const NeighborhoodAccessorFunctorType & m_NeighborhoodAccessor;
+  const OffsetValueType *                 m_Offsets;
+  NeighborIndexType                       m_Size;
+  const InternalPixelType *               m_Center{ nullptr };
+};
+
+/** \class ImageNeighborhoodPartition
+ *  \brief Splits a region into an interior region, processed without
+ *  boundary condition through flat buffer offsets, and boundary faces.
+ *
+ * ConstNeighborhoodIterator updates a pointer per neighbor at each step and
+ * checks the boundary on each access.  In the interior region computed by
+ * ImageBoundaryFacesCalculator, none of this is needed: the neighbors of a
+ * pixel are at the same offsets from it in the buffer.  This class computes
+ * these offsets once, and visits the interior neighborhoods with plain
+ * pointer arithmetic:
+ *
+   \code
+   NeighborhoodAlgorithm::ImageNeighborhoodPartition< ImageType > partition( input, region, radius );
+   ImageRegionIterator< OutputImageType > it( output, partition.GetInteriorRegion() );
+   partition.ForEachInteriorNeighborhood(
+     [&it]( const NeighborhoodAlgorithm::InteriorNeighborhood< ImageType > & neighborhood )
+     {
+     it.Set( ... neighborhood.GetPixel( i ) ... );
+     ++it;
+     } );
+   for ( const auto & face : partition.GetBoundaryFaces() )
+     {
+     // Process the face with a ConstNeighborhoodIterator and a boundary condition
+     }
+   \endcode
+ *
+ * The interior neighborhoods are visited in the order of
+ * ImageRegionIterator.  The interior region may be empty, and the boundary
+ * faces do not overlap it.
+ *
+ * \ingroup ITKCommon
+ */
+template< typename TImage >
+class ImageNeighborhoodPartition
+{
+public:
+  using ImageType = TImage;
+  using RegionType = typename TImage::RegionType;
+  using RadiusType = typename NeighborhoodIterator< TImage >::RadiusType;
+  using FaceListType = typename ImageBoundaryFacesCalculator< TImage >::FaceListType;
+  using InteriorNeighborhoodType = InteriorNeighborhood< TImage >;
+  using NeighborIndexType = typename InteriorNeighborhoodType::NeighborIndexType;
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Partitions the region of the image in which neighborhoods of the given
+   * radius are centered. */
+  ImageNeighborhoodPartition(const TImage *image, const RegionType & region, const RadiusType & radius);
+
+  /** The region whose neighborhoods are entirely in the buffer. */
+  const RegionType & GetInteriorRegion() const
+  {
+    return m_InteriorRegion;
+  }
+
+  /** The rest of the region, whose neighborhoods need a boundary
+   * condition. */
+  const FaceListType & GetBoundaryFaces() const
+  {
+    return m_BoundaryFaces;
+  }
+
+  /** The offsets in the buffer, in pixels, of the neighbors from the center
+   * pixel, in the order of the pixels of a Neighborhood. */
+  const std::vector< OffsetValueType > & GetInteriorBufferOffsets() const
+  {
+    return m_InteriorBufferOffsets;
+  }
+
+  /** Calls function( neighborhood ) for each pixel of the interior region,
+   * with an InteriorNeighborhood centered on it. */
+  template< typename TFunction >
+  void ForEachInteriorNeighborhood(TFunction && function) const;
+
+private:
+  const TImage *                 m_Image;
+  RegionType                     m_InteriorRegion;
+  FaceListType                   m_BoundaryFaces;
+  std::vector< OffsetValueType > m_InteriorBufferOffsets;
+};
+
 /** \class CalculateOutputWrapOffsetModifiers
  *  \brief Sets up itkNeighborhoodIterator output buffers.
  *
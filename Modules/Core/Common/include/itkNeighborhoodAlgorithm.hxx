@@ -18,6 +18,7 @@
 #ifndef itkNeighborhoodAlgorithm_hxx
 #define itkNeighborhoodAlgorithm_hxx
 #include "itkNeighborhoodAlgorithm.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegion.h"
 #include "itkConstSliceIterator.h"
@@ -166,6 +167,80 @@ ImageBoundaryFacesCalculator< TImage >
   return faceList;
 }
 
+template< typename TImage >
+ImageNeighborhoodPartition< TImage >
+::ImageNeighborhoodPartition(const TImage *image, const RegionType & region, const RadiusType & radius):
+  m_Image(image)
+{
+  ImageBoundaryFacesCalculator< TImage > faceCalculator;
+  m_BoundaryFaces = faceCalculator(image, region, radius);
+
+  // The first region of the face list is the non-boundary one.  It is kept
+  // as a boundary face, processed with the boundary condition, in the
+  // corner case of a buffer too small for its neighborhoods.
+  if ( !m_BoundaryFaces.empty() )
+    {
+    RegionType paddedRegion = m_BoundaryFaces.front();
+    paddedRegion.PadByRadius(radius);
+    if ( m_BoundaryFaces.front().GetNumberOfPixels() == 0 )
+      {
+      m_BoundaryFaces.pop_front();
+      }
+    else if ( image->GetBufferedRegion().IsInside(paddedRegion) )
+      {
+      m_InteriorRegion = m_BoundaryFaces.front();
+      m_BoundaryFaces.pop_front();
+      }
+    }
+
+  Neighborhood< char, ImageDimension > neighborhood;
+  neighborhood.SetRadius(radius);
+  const OffsetValueType *offsetTable = image->GetOffsetTable();
+  m_InteriorBufferOffsets.resize( neighborhood.Size() );
+  for ( NeighborIndexType i = 0; i < neighborhood.Size(); ++i )
+    {
+    const typename Neighborhood< char, ImageDimension >::OffsetType offset = neighborhood.GetOffset(i);
+    OffsetValueType bufferOffset = offset[0];
+    for ( unsigned int d = 1; d < ImageDimension; ++d )
+      {
+      bufferOffset += offset[d] * offsetTable[d];
+      }
+    m_InteriorBufferOffsets[i] = bufferOffset;
+    }
+}
+
+template< typename TImage >
+template< typename TFunction >
+void
+ImageNeighborhoodPartition< TImage >
+::ForEachInteriorNeighborhood(TFunction && function) const
+{
+  if ( m_InteriorRegion.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  using InternalPixelType = typename TImage::InternalPixelType;
+  const InternalPixelType *buffer = m_Image->GetBufferPointer();
+
+  typename TImage::NeighborhoodAccessorFunctorType accessor = m_Image->GetNeighborhoodAccessor();
+  accessor.SetBegin(buffer);
+  InteriorNeighborhoodType neighborhood( accessor, m_InteriorBufferOffsets.data(),
+                                         static_cast< NeighborIndexType >( m_InteriorBufferOffsets.size() ) );
+
+  ImageAlgorithm::ForEachContiguousRun( m_InteriorRegion,
+    [buffer, &neighborhood, &function](const OffsetValueType * offsets, SizeValueType length)
+    {
+    const InternalPixelType *center = buffer + offsets[0];
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      neighborhood.SetCenterPointer(center + i);
+      function( static_cast< const InteriorNeighborhoodType & >( neighborhood ) );
+      }
+    },
+    m_Image );
+}
+
 template< typename TImage >
 typename CalculateOutputWrapOffsetModifiers< TImage >::OffsetType
 CalculateOutputWrapOffsetModifiers< TImage >
@@ -19,6 +19,7 @@
 #define itkNeighborhoodInnerProduct_h
 
 #include "itkNeighborhoodIterator.h"
+#include "itkNeighborhoodAlgorithm.h"
 #include "itkConstSliceIterator.h"
 #include "itkImageBoundaryCondition.h"
 
@@ -66,6 +67,8 @@ public:
   using NeighborhoodType = Neighborhood< ImagePixelType,
                         Self::ImageDimension >;
 
+  using InteriorNeighborhoodType = NeighborhoodAlgorithm::InteriorNeighborhood< TImage >;
+
   static OutputPixelType Compute(
     const ConstNeighborhoodIterator< TImage > & it,
     const OperatorType & op,
@@ -78,6 +81,12 @@ public:
     const unsigned start = 0,
     const unsigned stride = 1);
 
+  static OutputPixelType Compute(
+    const InteriorNeighborhoodType & N,
+    const OperatorType & op,
+    const unsigned start = 0,
+    const unsigned stride = 1);
+
   /** Reference oeprator. */
   OutputPixelType operator()(const std::slice & s,
                              const ConstNeighborhoodIterator< TImage > & it,
@@ -104,6 +113,19 @@ public:
   {
     return Self::Compute(N, op);
   }
+
+  OutputPixelType operator()(const std::slice & s,
+                             const InteriorNeighborhoodType & N,
+                             const OperatorType & op) const
+  {
+    return Self::Compute(N, op, s.start(), s.stride());
+  }
+
+  OutputPixelType operator()(const InteriorNeighborhoodType & N,
+                             const OperatorType & op) const
+  {
+    return Self::Compute(N, op);
+  }
 };
 } // end namespace itk
 
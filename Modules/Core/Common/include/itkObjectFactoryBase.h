@@ -85,6 +85,14 @@ public:
   static std::list< LightObject::Pointer >
   CreateAllInstance(const char *itkclassname);
 
+  /** Create and return an instance of the named itk object, from its
+   * override named overrideWithName, as listed by
+   * GetClassOverrideWithNames().  The loaded factories are asked in the
+   * same order as in CreateInstance().  This lets the caller create only the
+   * overrides it needs, instead of all of them with CreateAllInstance(). */
+  static LightObject::Pointer
+  CreateInstance(const char *itkclassname, const char *overrideWithName);
+
   /** Re-check the ITK_AUTOLOAD_PATH for new factory libraries.
    * This calls UnRegisterAll before re-loading. */
   static void ReHash();
@@ -387,6 +387,23 @@ public:
     */
   virtual void EnlargeOutputRequestedRegion( DataObject *itkNotUsed(output) ){}
 
+  /** Estimate, in bytes, of the memory this process object allocates to
+   * generate the requested regions of its outputs.  It is meant to be
+   * called once the requested regions have been propagated, so that the
+   * regions the filters downstream request from this one, padded for
+   * instance by neighborhood filters, are accounted for.  The default
+   * implementation sums DataObject::GetRequestedRegionMemorySize() over the
+   * outputs.  Filters that allocate large temporary buffers may add them.
+   *
+   * \sa EstimatePipelineMemory(), StreamingImageFilter::SetMemoryBudget() */
+  virtual SizeValueType EstimateRequestedRegionMemory() const;
+
+  /** Sum of EstimateRequestedRegionMemory() over this process object and
+   * all the process objects upstream of it, each counted once.  This is an
+   * upper bound of the memory used to update the pipeline, as the outputs
+   * of the upstream filters may be released before the update ends. */
+  SizeValueType EstimatePipelineMemory() const;
+
   /** \brief Reset the pipeline.
    *
    * If an exception is thrown during an Update(),
@@ -20,6 +20,7 @@
 
 #include "itkObjectFactory.h"
 #include "itkObject.h"
+#include <algorithm>
 #include <vector>
 
 namespace itk
@@ -256,6 +257,61 @@ public:
       the itkSparseFieldLayer */
   RegionListType SplitRegions(int num) const;
 
+  /** Relinks the nodes of the list so that they are ordered according to
+   *  the strict weak ordering \a comp on node pointers.  No nodes are
+   *  allocated or freed, but a temporary array of node pointers is used, so
+   *  this method should not be called concurrently with other list
+   *  operations.  Sorting the nodes of a sparse field layer by their
+   *  position in the image buffer makes subsequent traversals of the layer
+   *  access the image memory in order.
+   *
+   *  Nodes are linked at the front of the list, and unlinking a node keeps
+   *  the others in order, so the nodes left since the previous sort form an
+   *  ordered run at the back of the list.  Only the nodes in front of that
+   *  run are sorted, then merged into it: sorting a list that did not change
+   *  is a single pass over its nodes. */
+  template< typename TCompare >
+  void Sort(TCompare comp)
+  {
+    NodeType *ordered = m_HeadNode->Previous;
+    if ( ordered == m_HeadNode )
+      {
+      return;
+      }
+    while ( ordered->Previous != m_HeadNode && !comp(ordered, ordered->Previous) )
+      {
+      ordered = ordered->Previous;
+      }
+    if ( ordered->Previous == m_HeadNode )
+      {
+      return;
+      }
+
+    std::vector< NodeType * > nodes;
+    for ( NodeType *n = m_HeadNode->Next; n != ordered; n = n->Next )
+      {
+      nodes.push_back(n);
+      }
+    std::sort(nodes.begin(), nodes.end(), comp);
+
+    NodeType *previous = m_HeadNode;
+    for ( auto n : nodes )
+      {
+      while ( ordered != m_HeadNode && !comp(n, ordered) )
+        {
+        previous->Next = ordered;
+        ordered->Previous = previous;
+        previous = ordered;
+        ordered = ordered->Next;
+        }
+      previous->Next = n;
+      n->Previous = previous;
+      previous = n;
+      }
+    previous->Next = ordered;
+    ordered->Previous = previous;
+  }
+
 protected:
   SparseFieldLayer();
   ~SparseFieldLayer() override;
@@ -36,6 +36,20 @@ namespace itk
  * This filter will produce the entire output as one image, but the upstream
  * filters will do their processing in pieces.
  *
+ * Instead of a number of pieces, a memory budget may be set with
+ * SetMemoryBudget().  The number of pieces is then the smallest one for
+ * which the upstream pipeline is estimated to need no more than the budget
+ * to generate a piece, as estimated by
+ * ProcessObject::EstimatePipelineMemory() once the region of the piece has
+ * been propagated.  The same pipeline then streams in few pieces on a large
+ * machine and in many on a small one.
+ *
+ * With SetNumberOfPiecesInFlight() above one, each piece is copied into the
+ * output in the ThreadPool while the upstream pipeline generates the next
+ * pieces, instead of between two pipeline updates.  The buffer of a piece
+ * is then handed over to the copy, and the input no longer holds the last
+ * piece once the filter has run.
+ *
  * \ingroup ITKSystemObjects
  * \ingroup DataProcessing
  * \ingroup ITKCommon
@@ -86,6 +100,21 @@ public:
    * will be executed this many times. */
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum memory, in bytes, the upstream pipeline should
+   * need to generate a piece.  When it is not zero, the number of pieces
+   * is computed from it, and NumberOfStreamDivisions is ignored.  The
+   * output of this filter, which is allocated whole, is not included.
+   * The default, zero, disables the memory budget. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Set/Get the maximum number of pieces held at once: the one the
+   * upstream pipeline generates, and the ones waiting to be copied into
+   * the output.  The default, one, copies each piece before the next one
+   * is generated. \sa StreamingPieceQueue */
+  itkSetClampMacro(NumberOfPiecesInFlight, unsigned int, 1, NumericTraits< unsigned int >::max());
+  itkGetConstMacro(NumberOfPiecesInFlight, unsigned int);
+
   /** Get/Set the helper class for dividing the input into chunks. */
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
@@ -117,8 +146,18 @@ protected:
   ~StreamingImageFilter() override = default;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The smallest number of pieces for which the estimated memory to
+   * generate a piece of the region is within the memory budget, or the
+   * largest number of pieces of the splitter. */
+  virtual unsigned int ComputeNumberOfStreamDivisionsFromMemoryBudget(const OutputImageRegionType & region);
+
 private:
+  /** Estimated memory to generate a piece of the input. */
+  SizeValueType EstimatePieceMemory(const InputImageRegionType & piece);
+
   unsigned int          m_NumberOfStreamDivisions;
+  SizeValueType         m_MemoryBudget{ 0 };
+  unsigned int          m_NumberOfPiecesInFlight{ 1 };
   RegionSplitterPointer m_RegionSplitter;
 };
 } // end namespace itk
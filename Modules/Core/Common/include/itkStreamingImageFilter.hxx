@@ -21,6 +21,9 @@
 #include "itkCommand.h"
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include "itkStreamingPieceQueue.h"
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -50,6 +53,8 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions
      << std::endl;
+  os << indent << "Memory budget: " << m_MemoryBudget << std::endl;
+  os << indent << "Number of pieces in flight: " << m_NumberOfPiecesInFlight << std::endl;
 
   itkPrintSelfObjectMacro( RegionSplitter );
 }
@@ -95,6 +100,77 @@ StreamingImageFilter< TInputImage, TOutputImage >
   // because the pipeline managed later
 }
 
+/**
+ *
+ */
+template< typename TInputImage, typename TOutputImage >
+unsigned int
+StreamingImageFilter< TInputImage, TOutputImage >
+::ComputeNumberOfStreamDivisionsFromMemoryBudget(const OutputImageRegionType & region)
+{
+  unsigned int  numberOfDivisions = 1;
+  unsigned int  previousNumberOfSplits = 0;
+  SizeValueType previousMemory = 0;
+  while ( true )
+    {
+    const unsigned int numberOfSplits = m_RegionSplitter->GetNumberOfSplits(region, numberOfDivisions);
+
+    // The first piece is the largest one with the splitters of ITK, and a
+    // piece in the middle has its padding not cropped by the boundary
+    InputImageRegionType firstPiece = region;
+    m_RegionSplitter->GetSplit(0, numberOfSplits, firstPiece);
+    InputImageRegionType middlePiece = region;
+    m_RegionSplitter->GetSplit(numberOfSplits / 2, numberOfSplits, middlePiece);
+    const SizeValueType memory = std::max( this->EstimatePieceMemory(firstPiece),
+                                           this->EstimatePieceMemory(middlePiece) );
+    itkDebugMacro(<< numberOfSplits << " pieces need an estimated " << memory << " bytes");
+    if ( memory <= m_MemoryBudget )
+      {
+      return numberOfSplits;
+      }
+    // The splitter cannot make smaller pieces
+    if ( numberOfSplits <= previousNumberOfSplits || numberOfDivisions == NumericTraits< unsigned int >::max() )
+      {
+      itkWarningMacro(<< "The pieces of the smallest size need an estimated " << memory
+                      << " bytes, more than the memory budget of " << m_MemoryBudget << " bytes");
+      return numberOfSplits;
+      }
+    // Smaller pieces need as much memory, for instance when a filter of the
+    // pipeline requests its whole input: more pieces would only cost time
+    if ( previousNumberOfSplits > 0 && memory >= previousMemory )
+      {
+      itkWarningMacro(<< "The pieces need an estimated " << previousMemory
+                      << " bytes whatever their size, more than the memory budget of " << m_MemoryBudget << " bytes");
+      return previousNumberOfSplits;
+      }
+    previousNumberOfSplits = numberOfSplits;
+    previousMemory = memory;
+
+    // The memory grows about linearly with the size of the pieces, and a
+    // little faster with the padding of the pieces
+    const double proportionalNumberOfDivisions =
+      std::ceil( numberOfDivisions * static_cast< double >( memory ) / static_cast< double >( m_MemoryBudget ) );
+    numberOfDivisions = static_cast< unsigned int >( std::min( proportionalNumberOfDivisions,
+      static_cast< double >( NumericTraits< unsigned int >::max() ) ) );
+    }
+}
+
+/**
+ *
+ */
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+StreamingImageFilter< TInputImage, TOutputImage >
+::EstimatePieceMemory(const InputImageRegionType & piece)
+{
+  auto * inputPtr = const_cast< InputImageType * >( this->GetInput(0) );
+  inputPtr->SetRequestedRegion(piece);
+  inputPtr->PropagateRequestedRegion();
+
+  const ProcessObject::Pointer source = inputPtr->GetSource();
+  return source.IsNotNull() ? source->EstimatePipelineMemory() : 0;
+}
+
 /**
  *
  */
@@ -162,9 +238,13 @@ StreamingImageFilter< TInputImage, TOutputImage >
   unsigned int numDivisions, numDivisionsFromSplitter;
 
   numDivisions = m_NumberOfStreamDivisions;
+  if ( m_MemoryBudget > 0 )
+    {
+    numDivisions = this->ComputeNumberOfStreamDivisionsFromMemoryBudget(outputRegion);
+    }
   numDivisionsFromSplitter =
     m_RegionSplitter
-    ->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+    ->GetNumberOfSplits(outputRegion, numDivisions);
   if ( numDivisionsFromSplitter < numDivisions )
     {
     numDivisions = numDivisionsFromSplitter;
@@ -174,6 +254,7 @@ StreamingImageFilter< TInputImage, TOutputImage >
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
    */
+  StreamingPieceQueue queue( m_NumberOfPiecesInFlight, false );
   unsigned int         piece=0;
   for (;
        piece < numDivisions && !this->GetAbortGenerateData();
@@ -190,11 +271,30 @@ StreamingImageFilter< TInputImage, TOutputImage >
     // requested region determined by the RegionSplitter (as opposed
     // to what the pipeline might have enlarged it to) is used to
     // copy the regions from the input to output
-    ImageAlgorithm::Copy( inputPtr, outputPtr, streamRegion, streamRegion );
+    if ( queue.IsPipelined() && inputPtr->GetSource() && inputPtr->GetBufferedRegion() == streamRegion )
+      {
+      // The piece keeps the buffer, and the pipeline generates the next
+      // piece in a new one while this one is copied. The pieces do not
+      // overlap in the output.  A buffer larger than the piece, as the
+      // whole image of a filter that does not stream, is kept by the input
+      // for the next pieces.
+      InputImagePointer pieceImage = InputImageType::New();
+      pieceImage->Graft( inputPtr );
+      inputPtr->ReleaseData();
+      queue.Push( [pieceImage, outputPtr, streamRegion]()
+        {
+        ImageAlgorithm::Copy( pieceImage.GetPointer(), outputPtr, streamRegion, streamRegion );
+        } );
+      }
+    else
+      {
+      ImageAlgorithm::Copy( inputPtr, outputPtr, streamRegion, streamRegion );
+      }
 
 
     this->UpdateProgress( static_cast<float>(piece) / static_cast<float>(numDivisions) );
     }
+  queue.WaitForAll();
 
   /**
    * If we ended due to aborting, push the progress up to 1.0 (since
@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingPieceQueue_h
+#define itkStreamingPieceQueue_h
+
+#include "itkMacro.h" // for ITKCommon_EXPORT
+
+#include <deque>
+#include <functional>
+#include <future>
+
+namespace itk
+{
+/** \class StreamingPieceQueue
+ *  \brief Consumes the pieces of a streamed pipeline in the ThreadPool
+ *  while the next pieces are generated.
+ *
+ * StreamingImageFilter and ImageFileWriter update their input one piece at
+ * a time, then copy or write the piece.  With a StreamingPieceQueue, the
+ * copy or the writing of a piece runs in the ThreadPool, and the pipeline
+ * generates the next piece meanwhile.  The caller hands over a piece whose
+ * buffer is no longer used by the pipeline, typically by grafting the
+ * input to a new image, then releasing the data of the input:
+ *
+   \code
+   StreamingPieceQueue queue( numberOfPiecesInFlight, false );
+   for ( each piece )
+     {
+     input->SetRequestedRegion( pieceRegion );
+     input->PropagateRequestedRegion();
+     input->UpdateOutputData();
+     ImageType::Pointer piece = ImageType::New();
+     piece->Graft( input );
+     input->ReleaseData();
+     queue.Push( [piece, pieceRegion]() { ... } );
+     }
+   queue.WaitForAll();
+   \endcode
+ *
+ * At most NumberOfPiecesInFlight pieces are held at once: the one being
+ * generated, and the ones waiting to be consumed.  The number of pieces
+ * consumed in the background is also less than the number of threads of
+ * the ThreadPool, so that they do not take all the threads the filters
+ * need.  With one piece in flight, or a ThreadPool of a single thread,
+ * Push() consumes the piece right away in the calling thread.
+ *
+ * With ordered consumption, the pieces are consumed one at a time, in the
+ * order they were pushed, as required by an ImageIO.  Otherwise they may be
+ * consumed concurrently.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT StreamingPieceQueue
+{
+public:
+  StreamingPieceQueue(unsigned int numberOfPiecesInFlight, bool ordered);
+
+  /** Waits for the pieces that are still consumed. */
+  ~StreamingPieceQueue();
+
+  StreamingPieceQueue(const StreamingPieceQueue &) = delete;
+  void operator=(const StreamingPieceQueue &) = delete;
+
+  /** Whether the pieces are consumed in the background. */
+  bool IsPipelined() const
+  {
+    return m_MaximumNumberOfPendingPieces > 0;
+  }
+
+  /** Consumes a piece, then waits until there is room for the next one.
+   * Rethrows the exception thrown while consuming a piece, once all the
+   * pending pieces have been consumed. */
+  void Push(const std::function< void() > & consume);
+
+  /** Waits until all the pieces have been consumed.  Rethrows the first
+   * exception thrown while consuming them. */
+  void WaitForAll();
+
+private:
+  /** Waits until at most numberOfPendingPieces pieces are pending. */
+  void WaitUntil(std::size_t numberOfPendingPieces);
+
+  std::deque< std::shared_future< void > > m_PendingPieces;
+  unsigned int                             m_MaximumNumberOfPendingPieces;
+  bool                                     m_Ordered;
+};
+} // end namespace itk
+
+#endif
@@ -21,6 +21,8 @@
 #include "itkMacro.h"
 #include "itk_eigen.h"
 #include ITK_EIGEN(Eigenvalues)
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <vector>
 // For GetPointerToMatrixData
@@ -109,6 +111,328 @@ namespace detail
       // Apply it
       eigenVectors = eigenVectors * perm;
     }
+
+  /** Closed-form eigen analysis of a real symmetric 2x2 matrix, given by
+   * its upper triangle {a00, a01, a11}. The eigen values are returned in
+   * ascending order and, if eigenVectors is not null, the corresponding
+   * unit eigen vectors in its rows. */
+  inline void
+  ComputeSymmetricEigenSystem2x2(const double a[3], double eigenValues[2], double eigenVectors[2][2])
+    {
+    const double mean = 0.5 * ( a[0] + a[2] );
+    const double halfDifference = 0.5 * ( a[0] - a[2] );
+    const double radius = std::hypot( halfDifference, a[1] );
+    eigenValues[0] = mean - radius;
+    eigenValues[1] = mean + radius;
+    if ( eigenVectors )
+      {
+      // rotation angle of the eigen vector of the largest eigen value
+      const double angle = 0.5 * std::atan2( a[1], halfDifference );
+      const double c = std::cos( angle );
+      const double s = std::sin( angle );
+      eigenVectors[0][0] = -s;
+      eigenVectors[0][1] = c;
+      eigenVectors[1][0] = c;
+      eigenVectors[1][1] = s;
+      }
+    }
+
+  /** Unit eigen vector of a real symmetric 3x3 matrix for an eigen value of
+   * multiplicity one: the largest cross product of two rows of A - lambda I. */
+  inline void
+  ComputeSymmetricEigenVector3x3(const double a[6], double eigenValue, double eigenVector[3])
+    {
+    const double row0[3] = { a[0] - eigenValue, a[1], a[2] };
+    const double row1[3] = { a[1], a[3] - eigenValue, a[4] };
+    const double row2[3] = { a[2], a[4], a[5] - eigenValue };
+    const double r0xr1[3] = { row0[1] * row1[2] - row0[2] * row1[1],
+                              row0[2] * row1[0] - row0[0] * row1[2],
+                              row0[0] * row1[1] - row0[1] * row1[0] };
+    const double r0xr2[3] = { row0[1] * row2[2] - row0[2] * row2[1],
+                              row0[2] * row2[0] - row0[0] * row2[2],
+                              row0[0] * row2[1] - row0[1] * row2[0] };
+    const double r1xr2[3] = { row1[1] * row2[2] - row1[2] * row2[1],
+                              row1[2] * row2[0] - row1[0] * row2[2],
+                              row1[0] * row2[1] - row1[1] * row2[0] };
+    const double d0 = r0xr1[0] * r0xr1[0] + r0xr1[1] * r0xr1[1] + r0xr1[2] * r0xr1[2];
+    const double d1 = r0xr2[0] * r0xr2[0] + r0xr2[1] * r0xr2[1] + r0xr2[2] * r0xr2[2];
+    const double d2 = r1xr2[0] * r1xr2[0] + r1xr2[1] * r1xr2[1] + r1xr2[2] * r1xr2[2];
+    const double * largest = r0xr1;
+    double          squaredNorm = d0;
+    if ( d1 > squaredNorm )
+      {
+      largest = r0xr2;
+      squaredNorm = d1;
+      }
+    if ( d2 > squaredNorm )
+      {
+      largest = r1xr2;
+      squaredNorm = d2;
+      }
+    if ( squaredNorm == 0.0 )
+      {
+      // A - lambda I is zero: any vector is an eigen vector
+      eigenVector[0] = 1.0;
+      eigenVector[1] = 0.0;
+      eigenVector[2] = 0.0;
+      return;
+      }
+    const double inverseNorm = 1.0 / std::sqrt( squaredNorm );
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      eigenVector[i] = largest[i] * inverseNorm;
+      }
+    }
+
+  /** Closed-form eigen analysis of a real symmetric 3x3 matrix, given by
+   * its upper triangle {a00, a01, a02, a11, a12, a22}. The eigen value
+   * farthest from the two others is a root of the characteristic
+   * polynomial, computed with the trigonometric formula on the scaled and
+   * shifted matrix. The two others are the eigen values of the 2x2 problem
+   * in the plane orthogonal to its eigen vector, which keeps them accurate
+   * when they are close. The eigen values are returned in ascending order
+   * and, if eigenVectors is not null, the corresponding unit eigen vectors
+   * in its rows.
+   *
+   * Reference: D. Eberly, A Robust Eigensolver for 3x3 Symmetric Matrices,
+   * Geometric Tools, 2014. */
+  inline void
+  ComputeSymmetricEigenSystem3x3(const double matrix[6], double eigenValues[3], double eigenVectors[3][3])
+    {
+    // scale the matrix to avoid overflow and underflow
+    double maximumAbsoluteValue = 0.0;
+    for ( unsigned int i = 0; i < 6; ++i )
+      {
+      maximumAbsoluteValue = std::max( maximumAbsoluteValue, std::abs( matrix[i] ) );
+      }
+    if ( maximumAbsoluteValue == 0.0 )
+      {
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        eigenValues[i] = 0.0;
+        if ( eigenVectors )
+          {
+          for ( unsigned int j = 0; j < 3; ++j )
+            {
+            eigenVectors[i][j] = ( i == j ) ? 1.0 : 0.0;
+            }
+          }
+        }
+      return;
+      }
+    double a[6];
+    for ( unsigned int i = 0; i < 6; ++i )
+      {
+      a[i] = matrix[i] / maximumAbsoluteValue;
+      }
+
+    const double offDiagonal = a[1] * a[1] + a[2] * a[2] + a[4] * a[4];
+    if ( offDiagonal == 0.0 )
+      {
+      // diagonal matrix: sort the diagonal
+      unsigned int order[3] = { 0, 1, 2 };
+      const double diagonal[3] = { a[0], a[3], a[5] };
+      for ( unsigned int i = 1; i < 3; ++i )
+        {
+        for ( unsigned int j = i; j > 0 && diagonal[order[j]] < diagonal[order[j - 1]]; --j )
+          {
+          std::swap( order[j], order[j - 1] );
+          }
+        }
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        eigenValues[i] = diagonal[order[i]] * maximumAbsoluteValue;
+        if ( eigenVectors )
+          {
+          for ( unsigned int j = 0; j < 3; ++j )
+            {
+            eigenVectors[i][j] = ( order[i] == j ) ? 1.0 : 0.0;
+            }
+          }
+        }
+      return;
+      }
+
+    // B = (A - q I) / p has the eigen values 2 cos(angle + 2 k pi / 3). Only
+    // the eigen value farthest from the two others is accurate when two
+    // eigen values are close: the two others are computed from the 2x2
+    // problem in the plane orthogonal to its eigen vector.
+    const double q = ( a[0] + a[3] + a[5] ) / 3.0;
+    const double b00 = a[0] - q;
+    const double b11 = a[3] - q;
+    const double b22 = a[5] - q;
+    const double p = std::sqrt( ( b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * offDiagonal ) / 6.0 );
+    const double c00 = b11 * b22 - a[4] * a[4];
+    const double c01 = a[1] * b22 - a[4] * a[2];
+    const double c02 = a[1] * a[4] - b11 * a[2];
+    const double determinant = ( b00 * c00 - a[1] * c01 + a[2] * c02 ) / ( p * p * p );
+    const double halfDeterminant = std::min( std::max( 0.5 * determinant, -1.0 ), 1.0 );
+    const double angle = std::acos( halfDeterminant ) / 3.0;
+    constexpr double twoThirdsPi = 2.09439510239319549;
+    const bool largestIsFarthest = halfDeterminant >= 0.0;
+    const double farthestEigenValue = largestIsFarthest ? q + 2.0 * p * std::cos( angle )
+                                                        : q + 2.0 * p * std::cos( angle + twoThirdsPi );
+    double farthestEigenVector[3];
+    ComputeSymmetricEigenVector3x3( a, farthestEigenValue, farthestEigenVector );
+
+    // orthonormal basis {u, v} of the plane orthogonal to the eigen vector
+    const double * w = farthestEigenVector;
+    double u[3];
+    if ( std::abs( w[0] ) > std::abs( w[1] ) )
+      {
+      const double inverseLength = 1.0 / std::sqrt( w[0] * w[0] + w[2] * w[2] );
+      u[0] = -w[2] * inverseLength;
+      u[1] = 0.0;
+      u[2] = w[0] * inverseLength;
+      }
+    else
+      {
+      const double inverseLength = 1.0 / std::sqrt( w[1] * w[1] + w[2] * w[2] );
+      u[0] = 0.0;
+      u[1] = w[2] * inverseLength;
+      u[2] = -w[1] * inverseLength;
+      }
+    const double v[3] = { w[1] * u[2] - w[2] * u[1],
+                          w[2] * u[0] - w[0] * u[2],
+                          w[0] * u[1] - w[1] * u[0] };
+    const double au[3] = { a[0] * u[0] + a[1] * u[1] + a[2] * u[2],
+                           a[1] * u[0] + a[3] * u[1] + a[4] * u[2],
+                           a[2] * u[0] + a[4] * u[1] + a[5] * u[2] };
+    const double av[3] = { a[0] * v[0] + a[1] * v[1] + a[2] * v[2],
+                           a[1] * v[0] + a[3] * v[1] + a[4] * v[2],
+                           a[2] * v[0] + a[4] * v[1] + a[5] * v[2] };
+    const double projected[3] = { u[0] * au[0] + u[1] * au[1] + u[2] * au[2],
+                                  u[0] * av[0] + u[1] * av[1] + u[2] * av[2],
+                                  v[0] * av[0] + v[1] * av[1] + v[2] * av[2] };
+    double projectedEigenValues[2];
+    double projectedEigenVectors[2][2];
+    ComputeSymmetricEigenSystem2x2( projected, projectedEigenValues, eigenVectors ? projectedEigenVectors : nullptr );
+
+    // ascending order, the farthest eigen value being the first or the last
+    const unsigned int farthest = largestIsFarthest ? 2 : 0;
+    const unsigned int first = largestIsFarthest ? 0 : 1;
+    eigenValues[farthest] = farthestEigenValue * maximumAbsoluteValue;
+    for ( unsigned int k = 0; k < 2; ++k )
+      {
+      eigenValues[first + k] = projectedEigenValues[k] * maximumAbsoluteValue;
+      }
+    if ( eigenVectors )
+      {
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        eigenVectors[farthest][i] = w[i];
+        for ( unsigned int k = 0; k < 2; ++k )
+          {
+          eigenVectors[first + k][i] = projectedEigenVectors[k][0] * u[i] + projectedEigenVectors[k][1] * v[i];
+          }
+        }
+      }
+    }
+
+  /** Closed-form eigen analysis of a 2x2 or 3x3 symmetric matrix, given by
+   * its upper triangle. The eigen values are returned in ascending order, or
+   * in ascending order of magnitude if orderByMagnitude is true, and the
+   * eigen vectors, if eigenVectors is not null, in the same order. */
+  inline void
+  ComputeSymmetricEigenSystemClosedForm(const double upperTriangle[6], unsigned int dimension,
+                                        bool orderByMagnitude, double eigenValues[3], double eigenVectors[3][3])
+    {
+    double values[3];
+    double vectors[3][3];
+    if ( dimension == 2 )
+      {
+      double vectors2[2][2];
+      ComputeSymmetricEigenSystem2x2( upperTriangle, values, eigenVectors ? vectors2 : nullptr );
+      for ( unsigned int i = 0; eigenVectors && i < 2; ++i )
+        {
+        vectors[i][0] = vectors2[i][0];
+        vectors[i][1] = vectors2[i][1];
+        }
+      }
+    else
+      {
+      ComputeSymmetricEigenSystem3x3( upperTriangle, values, eigenVectors ? vectors : nullptr );
+      }
+
+    // the eigen values are ascending up to the rounding errors
+    unsigned int order[3] = { 0, 1, 2 };
+    for ( unsigned int i = 1; i < dimension; ++i )
+      {
+      for ( unsigned int j = i; j > 0; --j )
+        {
+        const double current = values[order[j]];
+        const double previous = values[order[j - 1]];
+        if ( orderByMagnitude ? std::abs( current ) >= std::abs( previous ) : current >= previous )
+          {
+          break;
+          }
+        std::swap( order[j], order[j - 1] );
+        }
+      }
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      eigenValues[i] = values[order[i]];
+      for ( unsigned int j = 0; eigenVectors && j < dimension; ++j )
+        {
+        eigenVectors[i][j] = vectors[order[i]][j];
+        }
+      }
+    }
+
+  /** Read the upper triangle of a 2x2 or 3x3 matrix, which provides the
+   * A(row, col) operator, as expected by
+   * ComputeSymmetricEigenSystemClosedForm. */
+  template< typename TMatrix >
+  void
+  GetUpperTriangle(const TMatrix & A, unsigned int dimension, double upperTriangle[6])
+    {
+    unsigned int k = 0;
+    for ( unsigned int row = 0; row < dimension; ++row )
+      {
+      for ( unsigned int col = row; col < dimension; ++col )
+        {
+        upperTriangle[k++] = static_cast< double >( A(row, col) );
+        }
+      }
+    }
+
+  /** Closed-form eigen values of a 2x2 or 3x3 symmetric matrix A. */
+  template< typename TMatrix, typename TVector >
+  void
+  ComputeSymmetricEigenValuesClosedForm(const TMatrix & A, unsigned int dimension, bool orderByMagnitude,
+                                        TVector & EigenValues)
+    {
+    double upperTriangle[6];
+    double eigenValues[3];
+    GetUpperTriangle( A, dimension, upperTriangle );
+    ComputeSymmetricEigenSystemClosedForm( upperTriangle, dimension, orderByMagnitude, eigenValues, nullptr );
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      EigenValues[i] = eigenValues[i];
+      }
+    }
+
+  /** Closed-form eigen values and eigen vectors, in the rows of
+   * EigenVectors, of a 2x2 or 3x3 symmetric matrix A. */
+  template< typename TMatrix, typename TVector, typename TEigenMatrix >
+  void
+  ComputeSymmetricEigenValuesAndVectorsClosedForm(const TMatrix & A, unsigned int dimension, bool orderByMagnitude,
+                                                  TVector & EigenValues, TEigenMatrix & EigenVectors)
+    {
+    double upperTriangle[6];
+    double eigenValues[3];
+    double eigenVectors[3][3];
+    GetUpperTriangle( A, dimension, upperTriangle );
+    ComputeSymmetricEigenSystemClosedForm( upperTriangle, dimension, orderByMagnitude, eigenValues, eigenVectors );
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      EigenValues[i] = eigenValues[i];
+      for ( unsigned int j = 0; j < dimension; ++j )
+        {
+        EigenVectors[i][j] = eigenVectors[i][j];
+        }
+      }
+    }
 } // end namespace detail
 
 /** \class SymmetricEigenAnalysis
@@ -278,8 +602,29 @@ public:
     m_UseEigenLibrary = false;
   }
   bool GetUseEigenLibrary() const { return m_UseEigenLibrary; }
+
+  /** Set/Get to use the closed-form solver for 2x2 and 3x3 matrices: the
+   * eigen values are computed without iterations nor allocations, from the
+   * roots of the characteristic polynomial. It is faster than the iterative
+   * solvers, and as accurate relative to the largest matrix element.
+   * It has no effect on the matrices of other dimensions. With DoNotOrder,
+   * the eigen values are returned in ascending order. */
+  void SetUseClosedFormSolver(const bool input)
+  {
+    m_UseClosedFormSolver = input;
+  }
+  void SetUseClosedFormSolverOn()
+  {
+    m_UseClosedFormSolver = true;
+  }
+  void SetUseClosedFormSolverOff()
+  {
+    m_UseClosedFormSolver = false;
+  }
+  bool GetUseClosedFormSolver() const { return m_UseClosedFormSolver; }
 private:
   bool                m_UseEigenLibrary{false};
+  bool                m_UseClosedFormSolver{false};
   unsigned int        m_Dimension{0};
   unsigned int        m_Order{0};
   EigenValueOrderType m_OrderEigenValues;
@@ -676,6 +1021,7 @@ std::ostream & operator<<(std::ostream & os,
   os << "  OrderEigenValues: " << s.GetOrderEigenValues() << std::endl;
   os << "  OrderEigenMagnitudes: " << s.GetOrderEigenMagnitudes() << std::endl;
   os << "  UseEigenLibrary: " << s.GetUseEigenLibrary() << std::endl;
+  os << "  UseClosedFormSolver: " << s.GetUseClosedFormSolver() << std::endl;
   return os;
 }
 
@@ -715,6 +1061,12 @@ public:
     const TMatrix  & A,
     TVector        & EigenValues) const
   {
+    if ( ( VDimension == 2 || VDimension == 3 ) && m_UseClosedFormSolver )
+      {
+      detail::ComputeSymmetricEigenValuesClosedForm( A, VDimension, m_OrderEigenValues == OrderByMagnitude,
+                                                     EigenValues );
+      return 0;
+      }
     return ComputeEigenValuesWithEigenLibraryImpl(
       A, EigenValues, true);
   }
@@ -744,6 +1096,12 @@ public:
     TVector        & EigenValues,
     TEigenMatrix   & EigenVectors) const
   {
+    if ( ( VDimension == 2 || VDimension == 3 ) && m_UseClosedFormSolver )
+      {
+      detail::ComputeSymmetricEigenValuesAndVectorsClosedForm( A, VDimension, m_OrderEigenValues == OrderByMagnitude,
+                                                               EigenValues, EigenVectors );
+      return 0;
+      }
     return ComputeEigenValuesAndVectorsWithEigenLibraryImpl(
       A, EigenValues, EigenVectors, true);
   }
@@ -764,8 +1122,25 @@ public:
   constexpr unsigned int GetDimension() const { return VDimension; }
   constexpr bool GetUseEigenLibrary() const { return true; }
 
+  /** Set/Get to use the closed-form solver instead of the Eigen library.
+   * \sa SymmetricEigenAnalysis::SetUseClosedFormSolver */
+  void SetUseClosedFormSolver(const bool input)
+  {
+    m_UseClosedFormSolver = input;
+  }
+  void SetUseClosedFormSolverOn()
+  {
+    m_UseClosedFormSolver = true;
+  }
+  void SetUseClosedFormSolverOff()
+  {
+    m_UseClosedFormSolver = false;
+  }
+  bool GetUseClosedFormSolver() const { return m_UseClosedFormSolver; }
+
 private:
   EigenValueOrderType m_OrderEigenValues;
+  bool                m_UseClosedFormSolver{false};
 
   /* Helper to get the matrix value type for EigenLibMatrix typename.
    *
@@ -1001,6 +1376,7 @@ std::ostream & operator<<(std::ostream & os,
   os << "  OrderEigenValues: " << s.GetOrderEigenValues() << std::endl;
   os << "  OrderEigenMagnitudes: " << s.GetOrderEigenMagnitudes() << std::endl;
   os << "  UseEigenLibrary: " << s.GetUseEigenLibrary() << std::endl;
+  os << "  UseClosedFormSolver: " << s.GetUseClosedFormSolver() << std::endl;
   return os;
 }
 } // end namespace itk
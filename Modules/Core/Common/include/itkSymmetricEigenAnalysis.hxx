@@ -28,6 +28,11 @@ unsigned int
 SymmetricEigenAnalysis< TMatrix, TVector, TEigenMatrix >::ComputeEigenValues(const TMatrix  & A,
                                                                              TVector  & D) const
 {
+  if( m_UseClosedFormSolver && m_Order == m_Dimension && ( m_Dimension == 2 || m_Dimension == 3 ) )
+    {
+    detail::ComputeSymmetricEigenValuesClosedForm( A, m_Dimension, m_OrderEigenValues == OrderByMagnitude, D );
+    return 0;
+    }
   if(m_UseEigenLibrary && m_OrderEigenValues != DoNotOrder)
     {
     return ComputeEigenValuesWithEigenLibrary(A, D);
@@ -45,6 +50,12 @@ SymmetricEigenAnalysis< TMatrix, TVector, TEigenMatrix >::ComputeEigenValuesAndV
   TVector        & EigenValues,
   TEigenMatrix   & EigenVectors) const
 {
+  if( m_UseClosedFormSolver && m_Order == m_Dimension && ( m_Dimension == 2 || m_Dimension == 3 ) )
+    {
+    detail::ComputeSymmetricEigenValuesAndVectorsClosedForm( A, m_Dimension, m_OrderEigenValues == OrderByMagnitude,
+                                                             EigenValues, EigenVectors );
+    return 0;
+    }
   if(m_UseEigenLibrary)
     {
     return ComputeEigenValuesAndVectorsWithEigenLibrary(A, EigenValues, EigenVectors);
@@ -126,6 +126,22 @@ protected:
   void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
+  /** Applies the functor over the runs of pixels that are contiguous in the
+   * buffers, with plain loops that the compiler can vectorize.  Only
+   * Image's, whose pixels are stored as they are, take this path, when the
+   * input and output regions match; false is returned otherwise. */
+  template< typename TInput, typename TOutput, typename TInputRegion, typename TOutputRegion >
+  bool GenerateDataOverContiguousRuns(const TInput *, TOutput *, const TInputRegion &, const TOutputRegion &)
+  {
+    return false;
+  }
+
+  template< typename TInputPixel, typename TOutputPixel, unsigned int VImageDimension >
+  bool GenerateDataOverContiguousRuns(const Image< TInputPixel, VImageDimension > * inputPtr,
+                                      Image< TOutputPixel, VImageDimension > * outputPtr,
+                                      const ImageRegion< VImageDimension > & inputRegionForThread,
+                                      const ImageRegion< VImageDimension > & outputRegionForThread);
+
   FunctorType m_Functor;
 };
 } // end namespace itk
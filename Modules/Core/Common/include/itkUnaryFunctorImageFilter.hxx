@@ -19,6 +19,7 @@
 #define itkUnaryFunctorImageFilter_hxx
 
 #include "itkUnaryFunctorImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
@@ -94,6 +95,11 @@ UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
 
   this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
 
+  if ( this->GenerateDataOverContiguousRuns(inputPtr, outputPtr, inputRegionForThread, outputRegionForThread) )
+    {
+    return;
+    }
+
   ImageScanlineConstIterator< TInputImage > inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator< TOutputImage > outputIt(outputPtr, outputRegionForThread);
 
@@ -111,6 +117,38 @@ UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
     outputIt.NextLine();
     }
 }
+
+
+template< typename TInputImage, typename TOutputImage, typename TFunction  >
+template< typename TInputPixel, typename TOutputPixel, unsigned int VImageDimension >
+bool
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GenerateDataOverContiguousRuns(const Image< TInputPixel, VImageDimension > * inputPtr,
+                                 Image< TOutputPixel, VImageDimension > * outputPtr,
+                                 const ImageRegion< VImageDimension > & inputRegionForThread,
+                                 const ImageRegion< VImageDimension > & outputRegionForThread)
+{
+  if ( inputRegionForThread != outputRegionForThread )
+    {
+    return false;
+    }
+
+  const TInputPixel *inputBuffer = inputPtr->GetBufferPointer();
+  TOutputPixel *     outputBuffer = outputPtr->GetBufferPointer();
+  FunctorType &      functor = m_Functor;
+  ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+    [inputBuffer, outputBuffer, &functor](const OffsetValueType * offsets, SizeValueType length)
+    {
+    const TInputPixel *input = inputBuffer + offsets[0];
+    TOutputPixel *     output = outputBuffer + offsets[1];
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(input[i]);
+      }
+    },
+    inputPtr, outputPtr );
+  return true;
+}
 } // end namespace itk
 
 #endif
@@ -337,6 +337,12 @@ public:
 
   void SetNumberOfComponentsPerPixel(unsigned int n) override;
 
+  /** Size, in bytes, of the pixels of the RequestedRegion. */
+  SizeValueType GetRequestedRegionMemorySize() const override
+  {
+    return this->GetRequestedRegion().GetNumberOfPixels() * m_VectorLength * sizeof( InternalPixelType );
+  }
+
 protected:
   VectorImage();
   void PrintSelf(std::ostream & os, Indent indent) const override;
@@ -0,0 +1,377 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined( __linux__ )
+#include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+struct ImageBufferPoolGlobals
+{
+  ImageBufferPoolGlobals()
+  {
+    std::string envVar;
+    if ( itksys::SystemTools::GetEnv("ITK_USE_IMAGE_BUFFER_POOL", envVar) )
+      {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      m_Enabled = ( envVar != "NO" && envVar != "OFF" && envVar != "FALSE" && envVar != "0" );
+      }
+  }
+
+  ~ImageBufferPoolGlobals()
+  {
+    // The buffers in use belong to their containers, which free them with
+    // ::operator delete[] once the pool is gone.
+    this->ReleaseCachedBuffers(0);
+  }
+
+  void ReleaseCachedBuffers(SizeValueType maximumCachedSize)
+  {
+    for ( auto it = m_CachedBuffers.begin(); it != m_CachedBuffers.end() && m_CachedSize > maximumCachedSize; )
+      {
+      while ( !it->second.empty() && m_CachedSize > maximumCachedSize )
+        {
+        ::operator delete[]( it->second.back() );
+        it->second.pop_back();
+        m_CachedSize -= it->first;
+        }
+      it = it->second.empty() ? m_CachedBuffers.erase(it) : std::next(it);
+      }
+  }
+
+  std::mutex m_Mutex;
+
+  std::atomic< bool >          m_Enabled{ false };
+  std::atomic< SizeValueType > m_NumberOfBuffersInUse{ 0 };
+  SizeValueType                m_MinimumBufferSize{ 64 * 1024 };
+  SizeValueType                m_MaximumCachedSize{ SizeValueType( 1 ) << 30 };
+  bool                         m_UseHugePages{ false };
+
+  /** The unused buffers of each size class */
+  std::map< SizeValueType, std::vector< void * > > m_CachedBuffers;
+
+  /** The size class of each buffer in use */
+  std::unordered_map< void *, SizeValueType > m_BuffersInUse;
+
+  SizeValueType m_NumberOfHits{ 0 };
+  SizeValueType m_NumberOfMisses{ 0 };
+  SizeValueType m_SizeInUse{ 0 };
+  SizeValueType m_CachedSize{ 0 };
+  SizeValueType m_HighWaterMark{ 0 };
+};
+
+itkGetGlobalSimpleMacro(ImageBufferPool, ImageBufferPoolGlobals, PimplGlobals);
+
+ImageBufferPoolGlobals * ImageBufferPool::m_PimplGlobals;
+
+namespace
+{
+// Four size classes per power of two waste at most a fifth of a buffer.
+SizeValueType
+SizeClass(SizeValueType size)
+{
+  SizeValueType power = 1;
+  while ( power <= size / 2 )
+    {
+    power <<= 1;
+    }
+  const SizeValueType step = std::max< SizeValueType >( power / 4, 1 );
+  return ( ( size + step - 1 ) / step ) * step;
+}
+
+void
+AdviseHugePages(void *buffer, SizeValueType size)
+{
+#if defined( __linux__ ) && defined( MADV_HUGEPAGE )
+  // Only the whole huge pages inside the buffer can be advised.
+  constexpr std::uintptr_t hugePageSize = 2 * 1024 * 1024;
+  const auto begin = ( reinterpret_cast< std::uintptr_t >( buffer ) + hugePageSize - 1 ) & ~( hugePageSize - 1 );
+  const auto end = ( reinterpret_cast< std::uintptr_t >( buffer ) + size ) & ~( hugePageSize - 1 );
+  if ( end > begin )
+    {
+    madvise( reinterpret_cast< void * >( begin ), end - begin, MADV_HUGEPAGE );
+    }
+#else
+  (void)buffer;
+  (void)size;
+#endif
+}
+} // end anonymous namespace
+
+void
+ImageBufferPool
+::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Enabled = enabled;
+  if ( !enabled )
+    {
+    m_PimplGlobals->ReleaseCachedBuffers(0);
+    }
+}
+
+bool
+ImageBufferPool
+::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+void
+ImageBufferPool
+::SetMinimumBufferSize(SizeValueType size)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MinimumBufferSize = size;
+}
+
+SizeValueType
+ImageBufferPool
+::GetMinimumBufferSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MinimumBufferSize;
+}
+
+void
+ImageBufferPool
+::SetMaximumCachedSize(SizeValueType size)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumCachedSize = size;
+  m_PimplGlobals->ReleaseCachedBuffers(size);
+}
+
+SizeValueType
+ImageBufferPool
+::GetMaximumCachedSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumCachedSize;
+}
+
+void
+ImageBufferPool
+::SetUseHugePages(bool useHugePages)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_UseHugePages = useHugePages;
+}
+
+bool
+ImageBufferPool
+::GetUseHugePages()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_UseHugePages;
+}
+
+void *
+ImageBufferPool
+::Allocate(SizeValueType size)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if ( !m_PimplGlobals->m_Enabled )
+    {
+    return nullptr;
+    }
+
+  std::unique_lock< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  if ( size < m_PimplGlobals->m_MinimumBufferSize )
+    {
+    return nullptr;
+    }
+
+  const SizeValueType sizeClass = SizeClass(size);
+  void *buffer = nullptr;
+  auto cached = m_PimplGlobals->m_CachedBuffers.find(sizeClass);
+  if ( cached != m_PimplGlobals->m_CachedBuffers.end() )
+    {
+    buffer = cached->second.back();
+    cached->second.pop_back();
+    if ( cached->second.empty() )
+      {
+      m_PimplGlobals->m_CachedBuffers.erase(cached);
+      }
+    m_PimplGlobals->m_CachedSize -= sizeClass;
+    ++m_PimplGlobals->m_NumberOfHits;
+    }
+  else
+    {
+    // The buffer is freed with ::operator delete[] by its container if the
+    // pool is destroyed first.
+    const bool useHugePages = m_PimplGlobals->m_UseHugePages;
+    lock.unlock();
+    buffer = ::operator new[]( sizeClass, std::nothrow );
+    if ( buffer == nullptr )
+      {
+      return nullptr;
+      }
+    if ( useHugePages )
+      {
+      AdviseHugePages(buffer, sizeClass);
+      }
+    lock.lock();
+    ++m_PimplGlobals->m_NumberOfMisses;
+    }
+
+  m_PimplGlobals->m_BuffersInUse[buffer] = sizeClass;
+  ++m_PimplGlobals->m_NumberOfBuffersInUse;
+  m_PimplGlobals->m_SizeInUse += sizeClass;
+  m_PimplGlobals->m_HighWaterMark =
+    std::max( m_PimplGlobals->m_HighWaterMark, m_PimplGlobals->m_SizeInUse + m_PimplGlobals->m_CachedSize );
+  return buffer;
+}
+
+bool
+ImageBufferPool
+::Release(void *buffer)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if ( m_PimplGlobals == nullptr || m_PimplGlobals->m_NumberOfBuffersInUse == 0 )
+    {
+    return false;
+    }
+
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  auto inUse = m_PimplGlobals->m_BuffersInUse.find(buffer);
+  if ( inUse == m_PimplGlobals->m_BuffersInUse.end() )
+    {
+    return false;
+    }
+  const SizeValueType sizeClass = inUse->second;
+  m_PimplGlobals->m_BuffersInUse.erase(inUse);
+  --m_PimplGlobals->m_NumberOfBuffersInUse;
+  m_PimplGlobals->m_SizeInUse -= sizeClass;
+
+  if ( m_PimplGlobals->m_Enabled
+       && m_PimplGlobals->m_CachedSize + sizeClass <= m_PimplGlobals->m_MaximumCachedSize )
+    {
+    m_PimplGlobals->m_CachedBuffers[sizeClass].push_back(buffer);
+    m_PimplGlobals->m_CachedSize += sizeClass;
+    }
+  else
+    {
+    ::operator delete[]( buffer );
+    }
+  return true;
+}
+
+bool
+ImageBufferPool
+::IsInUse(const void *buffer)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  if ( m_PimplGlobals == nullptr || m_PimplGlobals->m_NumberOfBuffersInUse == 0 )
+    {
+    return false;
+    }
+
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_BuffersInUse.count(const_cast< void * >( buffer )) != 0;
+}
+
+void
+ImageBufferPool
+::ReleaseCachedBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->ReleaseCachedBuffers(0);
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfHits()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfHits;
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfMisses()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfMisses;
+}
+
+SizeValueType
+ImageBufferPool
+::GetSizeInUse()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_SizeInUse;
+}
+
+SizeValueType
+ImageBufferPool
+::GetCachedSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_CachedSize;
+}
+
+SizeValueType
+ImageBufferPool
+::GetHighWaterMark()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_HighWaterMark;
+}
+
+void
+ImageBufferPool
+::ResetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::lock_guard< std::mutex > lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_NumberOfHits = 0;
+  m_PimplGlobals->m_NumberOfMisses = 0;
+  m_PimplGlobals->m_HighWaterMark = m_PimplGlobals->m_SizeInUse + m_PimplGlobals->m_CachedSize;
+}
+
+} // end namespace itk
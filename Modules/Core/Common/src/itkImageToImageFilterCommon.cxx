@@ -25,6 +25,7 @@ namespace
 {
 double globalDefaultCoordinateTolerance = 1.0e-6;
 double globalDefaultDirectionTolerance = 1.0e-6;
+bool globalAutomaticInPlace = false;
 }
 
 void
@@ -55,4 +56,18 @@ ImageToImageFilterCommon
   return globalDefaultDirectionTolerance;
 }
 
+void
+ImageToImageFilterCommon
+::SetGlobalAutomaticInPlace( bool automaticInPlace )
+{
+  globalAutomaticInPlace = automaticInPlace;
+}
+
+bool
+ImageToImageFilterCommon
+::GetGlobalAutomaticInPlace( )
+{
+  return globalAutomaticInPlace;
+}
+
 }
@@ -43,6 +43,16 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #if defined(ITK_USE_TBB)
 #include "itkTBBMultiThreader.h"
@@ -69,7 +79,22 @@ struct MultiThreaderBaseGlobals
   m_GlobalMaximumNumberOfThreads(ITK_MAX_THREADS),
   // Global default number of threads : 0 => Not initialized.
   m_GlobalDefaultNumberOfThreads(0)
-  {};
+  {
+    m_GlobalDefaultThreadAffinity = IsEnvironmentVariableOn("ITK_GLOBAL_DEFAULT_THREAD_AFFINITY");
+    m_GlobalDefaultParallelFirstTouch = IsEnvironmentVariableOn("ITK_GLOBAL_DEFAULT_PARALLEL_FIRST_TOUCH");
+  };
+
+  static bool IsEnvironmentVariableOn(const char * name)
+  {
+    std::string envVar;
+    if ( itksys::SystemTools::GetEnv(name, envVar) )
+      {
+      envVar = itksys::SystemTools::UpperCase(envVar);
+      return envVar != "NO" && envVar != "OFF" && envVar != "FALSE" && envVar != "0";
+      }
+    return false;
+  }
+
   // GlobalDefaultThreaderTypeIsInitialized is used only in this
   // file to ensure that the ITK_GLOBAL_DEFAULT_THREADER or
   // ITK_USE_THREADPOOL environmenal variables are
@@ -96,8 +121,122 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads;
+
+  // Whether the work units are pinned to the processors of a NUMA node.
+  std::atomic< bool > m_GlobalDefaultThreadAffinity;
+
+  // Whether new image buffers are first touched in parallel.
+  std::atomic< bool > m_GlobalDefaultParallelFirstTouch;
 };
 
+namespace
+{
+/** The processors of the NUMA nodes, read once from sysfs, among the
+ * processors the process may run on.  A single node is kept, so that the
+ * work units are pinned, to the processors of the process, as on several
+ * nodes. */
+class NumaTopology
+{
+public:
+  static const NumaTopology & GetInstance()
+  {
+    static const NumaTopology topology;
+    return topology;
+  }
+
+  unsigned int GetNumberOfNodes() const
+  {
+#if defined( __linux__ )
+    return std::max< unsigned int >( 1, static_cast< unsigned int >( m_NodeProcessors.size() ) );
+#else
+    return 1;
+#endif
+  }
+
+#if defined( __linux__ )
+  /** Whether the nodes could be read */
+  bool IsKnown() const
+  {
+    return !m_NodeProcessors.empty();
+  }
+
+  const cpu_set_t & GetNodeProcessors(unsigned int node) const
+  {
+    return m_NodeProcessors[node];
+  }
+#endif
+
+private:
+  NumaTopology()
+  {
+#if defined( __linux__ )
+    cpu_set_t processProcessors;
+    CPU_ZERO( &processProcessors );
+    if ( sched_getaffinity( 0, sizeof( cpu_set_t ), &processProcessors ) != 0 )
+      {
+      return;
+      }
+    cpu_set_t nodes;
+    if ( !ReadList( "/sys/devices/system/node/online", nodes ) )
+      {
+      return;
+      }
+    for ( int node = 0; node < CPU_SETSIZE; ++node )
+      {
+      cpu_set_t processors;
+      if ( CPU_ISSET( node, &nodes )
+           && ReadList( "/sys/devices/system/node/node" + std::to_string( node ) + "/cpulist", processors ) )
+        {
+        CPU_AND( &processors, &processors, &processProcessors );
+        if ( CPU_COUNT( &processors ) > 0 )
+          {
+          m_NodeProcessors.push_back( processors );
+          }
+        }
+      }
+#endif
+  }
+
+#if defined( __linux__ )
+  // Reads a list such as "0-31,64-95" into a set
+  static bool ReadList(const std::string & fileName, cpu_set_t & set)
+  {
+    CPU_ZERO( &set );
+    std::ifstream file( fileName.c_str() );
+    std::string list;
+    if ( !std::getline( file, list ) )
+      {
+      return false;
+      }
+    std::stringstream stream( list );
+    std::string item;
+    while ( std::getline( stream, item, ',' ) )
+      {
+      const std::string::size_type dash = item.find( '-' );
+      const int first = std::atoi( item.c_str() );
+      const int last = dash == std::string::npos ? first : std::atoi( item.c_str() + dash + 1 );
+      for ( int i = std::max( first, 0 ); i <= last && i < CPU_SETSIZE; ++i )
+        {
+        CPU_SET( i, &set );
+        }
+      }
+    return true;
+  }
+
+  std::vector< cpu_set_t > m_NodeProcessors;
+#endif
+};
+// The number of work units the calling thread is executing, nested ones
+// included
+thread_local unsigned int WorkUnitDepth = 0;
+
+#if defined( __linux__ )
+// The affinities of the calling thread before its pinned work units, the
+// innermost one last
+thread_local std::vector< cpu_set_t > SavedAffinities;
+#endif
+} // end anonymous namespace
+
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
 
 
@@ -249,6 +388,143 @@ void MultiThreaderBase::SetGlobalDefaultNumberOfThreads(ThreadIdType val)
 
 }
 
+void MultiThreaderBase::SetGlobalDefaultThreadAffinity(bool threadAffinity)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalDefaultThreadAffinity = threadAffinity;
+}
+
+bool MultiThreaderBase::GetGlobalDefaultThreadAffinity()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalDefaultThreadAffinity;
+}
+
+void MultiThreaderBase::SetGlobalDefaultParallelFirstTouch(bool parallelFirstTouch)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalDefaultParallelFirstTouch = parallelFirstTouch;
+}
+
+bool MultiThreaderBase::GetGlobalDefaultParallelFirstTouch()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalDefaultParallelFirstTouch;
+}
+
+unsigned int MultiThreaderBase::GetNumberOfNumaNodes()
+{
+  return NumaTopology::GetInstance().GetNumberOfNodes();
+}
+
+bool MultiThreaderBase::EnterWorkUnit(ThreadIdType workUnit, ThreadIdType numberOfWorkUnits)
+{
+  ++WorkUnitDepth;
+  if ( !MultiThreaderBase::GetGlobalDefaultThreadAffinity() || numberOfWorkUnits == 0 )
+    {
+    return false;
+    }
+#if defined( __linux__ )
+  const NumaTopology & topology = NumaTopology::GetInstance();
+  if ( !topology.IsKnown() )
+    {
+    return false;
+    }
+
+  // The thread may have an affinity of its own, which is restored when the
+  // work unit ends
+  cpu_set_t affinity;
+  if ( pthread_getaffinity_np( pthread_self(), sizeof( cpu_set_t ), &affinity ) != 0 )
+    {
+    return false;
+    }
+  const unsigned int numberOfNodes = topology.GetNumberOfNodes();
+  const auto node = static_cast< unsigned int >( static_cast< SizeValueType >( workUnit ) * numberOfNodes
+                                                 / numberOfWorkUnits );
+  if ( pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ),
+                               &topology.GetNodeProcessors( std::min( node, numberOfNodes - 1 ) ) ) != 0 )
+    {
+    return false;
+    }
+  SavedAffinities.push_back( affinity );
+  return true;
+#else
+  (void)workUnit;
+  return false;
+#endif
+}
+
+void MultiThreaderBase::LeaveWorkUnit(bool pinned)
+{
+#if defined( __linux__ )
+  if ( pinned )
+    {
+    pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &SavedAffinities.back() );
+    SavedAffinities.pop_back();
+    }
+#else
+  (void)pinned;
+#endif
+  --WorkUnitDepth;
+}
+
+bool MultiThreaderBase::IsInWorkUnit()
+{
+  return WorkUnitDepth > 0;
+}
+
+void MultiThreaderBase::TouchInParallel(void *buffer, SizeValueType size, bool zero)
+{
+  // Below this size, the threads cost more than they save
+  constexpr SizeValueType minimumSize = 1 << 20;
+  constexpr SizeValueType pageSize = 4096;
+
+  auto * bytes = static_cast< char * >( buffer );
+  auto touchSerially = [bytes, size, zero]()
+    {
+    if ( zero )
+      {
+      std::memset( bytes, 0, size );
+      }
+    };
+
+  // Within a work unit, the other threads may be busy with the same
+  // parallel section: the buffer is touched by the calling thread
+  if ( size < minimumSize || MultiThreaderBase::IsInWorkUnit() )
+    {
+    touchSerially();
+    return;
+    }
+
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const SizeValueType numberOfParts = threader->GetNumberOfWorkUnits();
+  if ( numberOfParts < 2 )
+    {
+    touchSerially();
+    return;
+    }
+
+  // One part per work unit, so that work unit i touches part i
+  threader->ParallelizeArray( 0, numberOfParts,
+    [bytes, size, numberOfParts, zero](SizeValueType part)
+    {
+    const SizeValueType begin = size / numberOfParts * part + std::min( part, size % numberOfParts );
+    const SizeValueType end = begin + size / numberOfParts + ( part < size % numberOfParts ? 1 : 0 );
+    if ( zero )
+      {
+      std::memset( bytes + begin, 0, end - begin );
+      }
+    else
+      {
+      for ( SizeValueType i = begin; i < end; i += pageSize )
+        {
+        bytes[i] = 0;
+        }
+      }
+    },
+    nullptr );
+}
+
 void MultiThreaderBase::SetMaximumNumberOfThreads( ThreadIdType numberOfThreads )
 {
   if( m_MaximumNumberOfThreads == numberOfThreads &&
@@ -449,6 +725,7 @@ MultiThreaderBase
   // execute the user specified threader callback, catching any exceptions
   try
     {
+    const WorkUnitAffinityScope affinity( threadInfoStruct->WorkUnitID, threadInfoStruct->NumberOfWorkUnits );
     ( *threadInfoStruct->ThreadFunction )(arg);
     threadInfoStruct->ThreadExitCode = WorkUnitInfo::SUCCESS;
     }
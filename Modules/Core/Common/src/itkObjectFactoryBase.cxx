@@ -229,6 +229,27 @@ ObjectFactoryBase
   return created;
 }
 
+LightObject::Pointer
+ObjectFactoryBase
+::CreateInstance(const char *itkclassname, const char *overrideWithName)
+{
+  ObjectFactoryBase::Initialize();
+
+  for (auto & registeredFactory : *m_PimplGlobals->m_RegisteredFactories)
+    {
+    auto start = registeredFactory->m_OverrideMap->lower_bound(itkclassname);
+    auto end = registeredFactory->m_OverrideMap->upper_bound(itkclassname);
+    for ( auto i = start; i != end; ++i )
+      {
+      if ( ( *i ).second.m_EnabledFlag && ( *i ).second.m_OverrideWithName == overrideWithName )
+        {
+        return ( *i ).second.m_CreateObject->CreateObject();
+        }
+      }
+    }
+  return nullptr;
+}
+
 /**
  * A one time initialization method.
  */
@@ -89,11 +89,18 @@ void PoolMultiThreader::SingleMethodExecute()
 
   bool exceptionOccurred = false;
   std::string exceptionDetails;
+  const ThreadFunctionType singleMethod = m_SingleMethod;
   for ( threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop )
     {
     m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
     m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
-    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork( m_SingleMethod, &m_ThreadInfoArray[threadLoop] );
+    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork(
+      [singleMethod]( WorkUnitInfo * info )
+      {
+        const WorkUnitAffinityScope affinity( info->WorkUnitID, info->NumberOfWorkUnits );
+        return singleMethod( info );
+      },
+      &m_ThreadInfoArray[threadLoop] );
     }
 
   try
@@ -101,7 +108,10 @@ void PoolMultiThreader::SingleMethodExecute()
     // Now, the parent thread calls this->SingleMethod() itself
     m_ThreadInfoArray[0].UserData = m_SingleData;
     m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
+    {
+    const WorkUnitAffinityScope affinity( 0, m_NumberOfWorkUnits );
     m_SingleMethod( (void *)( &m_ThreadInfoArray[0] ) );
+    }
 
     // The parent thread has finished SingleMethod()
     // so now it waits for each of the other work units to finish
@@ -177,12 +187,14 @@ PoolMultiThreader
       chunkSize++; // we want slightly bigger chunks to be processed first
       }
 
+    const ThreadIdType numberOfWorkUnits = m_NumberOfWorkUnits;
     SizeValueType workUnit = 1;
     for ( SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize )
       {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(
-        [aFunc]( SizeValueType start, SizeValueType end)
+      m_ThreadInfoArray[workUnit].Future = m_ThreadPool->AddWork(
+        [aFunc, workUnit, numberOfWorkUnits]( SizeValueType start, SizeValueType end)
         {
+          const WorkUnitAffinityScope affinity( static_cast< ThreadIdType >( workUnit ), numberOfWorkUnits );
           for ( SizeValueType ii = start; ii < end; ii++ )
           {
             aFunc( ii );
@@ -192,14 +204,18 @@ PoolMultiThreader
         },
         i,
         std::min( i + chunkSize, lastIndexPlus1 ) );
+      ++workUnit;
       }
     itkAssertOrThrowMacro( workUnit <= m_NumberOfWorkUnits,
       "Number of work units was somehow miscounted!" );
     // execute this thread's share
+    {
+    const WorkUnitAffinityScope affinity( 0, numberOfWorkUnits );
     for ( SizeValueType ii = firstIndex; ii < firstIndex + chunkSize; ii++ )
       {
       aFunc( ii );
       }
+    }
     // now wait for the other computations to finish
     for (SizeValueType i = 1; i < workUnit; i++)
       {
@@ -261,8 +277,9 @@ PoolMultiThreader
         if (i < total)
           {
           m_ThreadInfoArray[i].Future = m_ThreadPool->AddWork(
-            [funcP, iRegion]()
+            [funcP, iRegion, i, splitCount]()
             {
+              const WorkUnitAffinityScope affinity( i, splitCount );
               funcP( &iRegion.GetIndex()[0], &iRegion.GetSize()[0] );
               // make this lambda have the same signature as m_SingleMethod
               return ITK_THREAD_RETURN_DEFAULT_VALUE;
@@ -278,7 +295,10 @@ PoolMultiThreader
       iRegion = region;
       total = splitter->GetSplit( 0, splitCount, iRegion );
       // execute this thread's share
+      {
+      const WorkUnitAffinityScope affinity( 0, splitCount );
       funcP( &iRegion.GetIndex()[0], &iRegion.GetSize()[0] );
+      }
 
       // now wait for the other computations to finish
       for ( ThreadIdType i = 1; i < splitCount; i++ )
@@ -1611,6 +1611,52 @@ ProcessObject
 }
 
 
+SizeValueType
+ProcessObject
+::EstimateRequestedRegionMemory() const
+{
+  SizeValueType memory = 0;
+  for ( auto & output : m_Outputs )
+    {
+    if ( output.second )
+      {
+      memory += output.second->GetRequestedRegionMemorySize();
+      }
+    }
+  return memory;
+}
+
+
+SizeValueType
+ProcessObject
+::EstimatePipelineMemory() const
+{
+  // Walk the pipeline upstream, visiting each process object once even
+  // when several filters share an input
+  std::set< const ProcessObject * > visited;
+  std::vector< const ProcessObject * > toVisit( 1, this );
+  SizeValueType memory = 0;
+  while ( !toVisit.empty() )
+    {
+    const ProcessObject * processObject = toVisit.back();
+    toVisit.pop_back();
+    if ( !visited.insert( processObject ).second )
+      {
+      continue;
+      }
+    memory += processObject->EstimateRequestedRegionMemory();
+    for ( auto & input : processObject->m_Inputs )
+      {
+      if ( input.second && input.second->GetSource() )
+        {
+        toVisit.push_back( input.second->GetSource().GetPointer() );
+        }
+      }
+    }
+  return memory;
+}
+
+
 void
 ProcessObject
 ::GenerateInputRequestedRegion()
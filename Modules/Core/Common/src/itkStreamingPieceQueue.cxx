@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkStreamingPieceQueue.h"
+#if defined( ITK_USE_PTHREADS ) || defined( ITK_USE_WIN32_THREADS )
+#define THREAD_POOL_AVAILABLE 1
+#include "itkThreadPool.h"
+#endif
+
+#include <algorithm>
+
+namespace itk
+{
+StreamingPieceQueue
+::StreamingPieceQueue(unsigned int numberOfPiecesInFlight, bool ordered):
+  m_MaximumNumberOfPendingPieces(0),
+  m_Ordered(ordered)
+{
+#if defined( THREAD_POOL_AVAILABLE )
+  // At least one thread of the pool is left to the filters of the pipeline
+  const auto numberOfThreads = static_cast< unsigned int >( ThreadPool::GetInstance()->GetMaximumNumberOfThreads() );
+  if ( numberOfPiecesInFlight > 1 && numberOfThreads > 1 )
+    {
+    m_MaximumNumberOfPendingPieces = std::min( numberOfPiecesInFlight - 1, numberOfThreads - 1 );
+    }
+#else
+  (void)numberOfPiecesInFlight;
+#endif
+}
+
+StreamingPieceQueue
+::~StreamingPieceQueue()
+{
+  // The pieces refer to objects of the caller, which may be destroyed once
+  // the queue is
+  for ( auto & piece : m_PendingPieces )
+    {
+    piece.wait();
+    }
+}
+
+void
+StreamingPieceQueue
+::Push(const std::function< void() > & consume)
+{
+  if ( !this->IsPipelined() )
+    {
+    consume();
+    return;
+    }
+
+#if defined( THREAD_POOL_AVAILABLE )
+  std::shared_future< void > piece;
+  if ( m_Ordered && !m_PendingPieces.empty() )
+    {
+    // The previous piece is consumed first, and its exception, if any, is
+    // passed on to the next ones
+    std::shared_future< void > previousPiece = m_PendingPieces.back();
+    piece = ThreadPool::GetInstance()->AddWork( [previousPiece, consume]()
+      {
+      previousPiece.get();
+      consume();
+      } ).share();
+    }
+  else
+    {
+    piece = ThreadPool::GetInstance()->AddWork( consume ).share();
+    }
+  m_PendingPieces.push_back( piece );
+#endif
+
+  this->WaitUntil( m_MaximumNumberOfPendingPieces );
+}
+
+void
+StreamingPieceQueue
+::WaitForAll()
+{
+  this->WaitUntil( 0 );
+}
+
+void
+StreamingPieceQueue
+::WaitUntil(std::size_t numberOfPendingPieces)
+{
+  while ( m_PendingPieces.size() > numberOfPendingPieces )
+    {
+    std::shared_future< void > piece = m_PendingPieces.front();
+    m_PendingPieces.pop_front();
+    try
+      {
+      piece.get();
+      }
+    catch ( ... )
+      {
+      // Nothing must refer to the pieces once the exception is handled
+      for ( auto & pendingPiece : m_PendingPieces )
+        {
+        pendingPiece.wait();
+        }
+      m_PendingPieces.clear();
+      throw;
+      }
+    }
+}
+} // end namespace itk
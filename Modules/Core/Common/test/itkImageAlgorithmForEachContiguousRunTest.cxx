@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+namespace
+{
+
+using ImageType = itk::Image< short, 3 >;
+using RegionType = ImageType::RegionType;
+
+RegionType
+MakeRegion( itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z,
+            itk::SizeValueType sx, itk::SizeValueType sy, itk::SizeValueType sz )
+{
+  RegionType::IndexType index;
+  index[0] = x;
+  index[1] = y;
+  index[2] = z;
+  RegionType::SizeType size;
+  size[0] = sx;
+  size[1] = sy;
+  size[2] = sz;
+  return RegionType( index, size );
+}
+
+ImageType::Pointer
+MakeImage( const RegionType & bufferedRegion )
+{
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( bufferedRegion );
+  image->Allocate( true );
+  return image;
+}
+
+// Checks that the runs visit each pixel of the region once, in both images,
+// and that the runs have the expected length.
+bool
+CheckRuns( const RegionType & region, const ImageType * image1, const ImageType * image2,
+           itk::SizeValueType expectedLength )
+{
+  std::vector< unsigned int > visits1( image1->GetBufferedRegion().GetNumberOfPixels(), 0 );
+  std::vector< unsigned int > visits2( image2->GetBufferedRegion().GetNumberOfPixels(), 0 );
+  bool result = true;
+  itk::ImageAlgorithm::ForEachContiguousRun( region,
+    [&]( const itk::OffsetValueType * offsets, itk::SizeValueType length )
+    {
+    if ( length != expectedLength )
+      {
+      std::cerr << "Run of " << length << " pixels instead of " << expectedLength << std::endl;
+      result = false;
+      }
+    for ( itk::SizeValueType i = 0; i < length; ++i )
+      {
+      ++visits1[offsets[0] + i];
+      ++visits2[offsets[1] + i];
+      }
+    // The runs start at the same index in both images
+    if ( image1->ComputeIndex( offsets[0] ) != image2->ComputeIndex( offsets[1] ) )
+      {
+      std::cerr << "The runs start at different indices" << std::endl;
+      result = false;
+      }
+    },
+    image1, image2 );
+
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it( image1, image1->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const unsigned int expected = region.IsInside( it.GetIndex() ) ? 1 : 0;
+    if ( visits1[image1->ComputeOffset( it.GetIndex() )] != expected )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " of the first image visited "
+                << visits1[image1->ComputeOffset( it.GetIndex() )] << " times" << std::endl;
+      return false;
+      }
+    }
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it( image2, image2->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const unsigned int expected = region.IsInside( it.GetIndex() ) ? 1 : 0;
+    if ( visits2[image2->ComputeOffset( it.GetIndex() )] != expected )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " of the second image visited "
+                << visits2[image2->ComputeOffset( it.GetIndex() )] << " times" << std::endl;
+      return false;
+      }
+    }
+  return result;
+}
+
+class Twice
+{
+public:
+  bool operator!=( const Twice & ) const { return false; }
+  short operator()( short value ) const { return static_cast< short >( 2 * value ); }
+};
+
+} // end namespace
+
+int itkImageAlgorithmForEachContiguousRunTest( int, char *[] )
+{
+  const RegionType bufferedRegion = MakeRegion( 0, 0, 0, 10, 8, 6 );
+  ImageType::Pointer image = MakeImage( bufferedRegion );
+  ImageType::Pointer sameImage = MakeImage( bufferedRegion );
+  ImageType::Pointer largerImage = MakeImage( MakeRegion( -2, 0, 0, 14, 8, 6 ) );
+  ImageType::Pointer shiftedImage = MakeImage( MakeRegion( 0, -1, 0, 10, 9, 6 ) );
+
+  // The whole buffer is a single run
+  ITK_TEST_EXPECT_TRUE( CheckRuns( bufferedRegion, image, sameImage, 480 ) );
+
+  // Lines are merged as long as the region spans the lower dimensions of
+  // all the buffers
+  ITK_TEST_EXPECT_TRUE( CheckRuns( bufferedRegion, image, largerImage, 10 ) );
+  ITK_TEST_EXPECT_TRUE( CheckRuns( bufferedRegion, image, shiftedImage, 80 ) );
+  ITK_TEST_EXPECT_TRUE( CheckRuns( MakeRegion( 0, 2, 1, 10, 4, 3 ), image, sameImage, 40 ) );
+  ITK_TEST_EXPECT_TRUE( CheckRuns( MakeRegion( 0, 0, 2, 10, 8, 3 ), image, sameImage, 240 ) );
+  ITK_TEST_EXPECT_TRUE( CheckRuns( MakeRegion( 1, 2, 1, 7, 4, 3 ), image, sameImage, 7 ) );
+
+  // An empty region has no run
+  unsigned int numberOfRuns = 0;
+  itk::ImageAlgorithm::ForEachContiguousRun( MakeRegion( 0, 0, 0, 10, 0, 6 ),
+    [&numberOfRuns]( const itk::OffsetValueType *, itk::SizeValueType ) { ++numberOfRuns; }, image.GetPointer() );
+  ITK_TEST_EXPECT_EQUAL( numberOfRuns, 0u );
+
+  // The pixel-wise filters, which use the runs, process only the requested
+  // region of their output
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( image, bufferedRegion ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< short >( it.GetIndex()[0] + 10 * it.GetIndex()[1] + 100 * it.GetIndex()[2] ) );
+    }
+  using FilterType = itk::UnaryFunctorImageFilter< ImageType, ImageType, Twice >;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  const RegionType requestedRegion = MakeRegion( 1, 2, 1, 7, 4, 3 );
+  filter->GetOutput()->SetRequestedRegion( requestedRegion );
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it( filter->GetOutput(), requestedRegion ); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != 2 * image->GetPixel( it.GetIndex() ) )
+      {
+      std::cerr << "Wrong value " << it.Get() << " at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
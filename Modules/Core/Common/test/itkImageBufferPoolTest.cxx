@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferPool.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+using ImageType = itk::Image< float, 3 >;
+
+ImageType::Pointer
+MakeImage( unsigned int length, bool initialize )
+{
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill( length );
+  image->SetRegions( size );
+  image->Allocate( initialize );
+  return image;
+}
+
+} // end namespace
+
+int itkImageBufferPoolTest( int, char* [] )
+{
+  itk::ImageBufferPool::SetEnabled( false );
+  ITK_TEST_EXPECT_TRUE( !itk::ImageBufferPool::GetEnabled() );
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::Allocate( 1 << 20 ) == nullptr );
+
+  // Without the pool, nothing is recorded
+  itk::ImageBufferPool::ResetStatistics();
+  MakeImage( 64, false );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits() + itk::ImageBufferPool::GetNumberOfMisses(), 0u );
+
+  itk::ImageBufferPool::SetEnabled( true );
+  itk::ImageBufferPool::SetUseHugePages( true );
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::GetUseHugePages() );
+  itk::ImageBufferPool::SetMinimumBufferSize( 4096 );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetMinimumBufferSize(), 4096u );
+
+  // The first buffer is new, the second one is recycled
+  const itk::SizeValueType bufferSize = 64 * 64 * 64 * sizeof( float );
+  {
+  ImageType::Pointer image = MakeImage( 64, false );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfMisses(), 1u );
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::GetSizeInUse() >= bufferSize );
+  image->FillBuffer( 7.0f );
+  }
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetSizeInUse(), 0u );
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::GetCachedSize() >= bufferSize );
+
+  // A recycled buffer is still initialized on request
+  {
+  ImageType::Pointer image = MakeImage( 64, true );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits(), 1u );
+  for ( itk::ImageRegionConstIterator< ImageType > it( image, image->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != 0.0f )
+      {
+      std::cerr << "The recycled buffer was not initialized." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A slightly smaller buffer of the same size class is recycled as well
+  image = nullptr;
+  image = MakeImage( 63, false );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits(), 2u );
+  }
+
+  // Small buffers are not pooled
+  MakeImage( 4, false );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits() + itk::ImageBufferPool::GetNumberOfMisses(), 3u );
+
+  // Vector images draw from the pool as well
+  using VectorImageType = itk::VectorImage< float, 3 >;
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  VectorImageType::SizeType size;
+  size.Fill( 32 );
+  vectorImage->SetRegions( size );
+  vectorImage->SetNumberOfComponentsPerPixel( 8 );
+  vectorImage->Allocate();
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits(), 3u );
+
+  // Buffers that are not allocated by the pool are not taken
+  float external[16];
+  ITK_TEST_EXPECT_TRUE( !itk::ImageBufferPool::IsInUse( external ) );
+  ITK_TEST_EXPECT_TRUE( !itk::ImageBufferPool::Release( external ) );
+
+  // A buffer handed over to another container goes back to the pool
+  const itk::SizeValueType sizeInUse = itk::ImageBufferPool::GetSizeInUse();
+  {
+  ImageType::Pointer image = MakeImage( 64, false );
+  ImageType::PixelContainer * container = image->GetPixelContainer();
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::IsInUse( container->GetBufferPointer() ) );
+  container->ContainerManageMemoryOff();
+  ImageType::PixelContainerPointer newContainer = ImageType::PixelContainer::New();
+  newContainer->SetImportPointer( container->GetBufferPointer(), container->Size(), true );
+  image = nullptr;
+  ITK_TEST_EXPECT_TRUE( itk::ImageBufferPool::GetSizeInUse() >= sizeInUse + bufferSize );
+  }
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetSizeInUse(), sizeInUse );
+
+  // The cached size is bounded
+  const itk::SizeValueType highWaterMark = itk::ImageBufferPool::GetHighWaterMark();
+  ITK_TEST_EXPECT_TRUE( highWaterMark >= bufferSize );
+  vectorImage = nullptr;
+  itk::ImageBufferPool::SetMaximumCachedSize( 0 );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetCachedSize(), 0u );
+  MakeImage( 64, false );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetCachedSize(), 0u );
+  itk::ImageBufferPool::SetMaximumCachedSize( itk::SizeValueType( 1 ) << 30 );
+
+  // A buffer that is in use when the pool is disabled is still released
+  {
+  ImageType::Pointer image = MakeImage( 64, false );
+  itk::ImageBufferPool::SetEnabled( false );
+  }
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetSizeInUse(), 0u );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetCachedSize(), 0u );
+
+  itk::ImageBufferPool::ResetStatistics();
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetNumberOfHits(), 0u );
+  ITK_TEST_EXPECT_EQUAL( itk::ImageBufferPool::GetHighWaterMark(), 0u );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
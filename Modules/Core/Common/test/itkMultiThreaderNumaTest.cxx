@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAbsImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Checks that the work units still compute the same results when they are
+// pinned to NUMA nodes and the image buffers are first touched in parallel,
+// and that a thread gets its own affinity back after a work unit.
+int itkMultiThreaderNumaTest( int argc, char *argv[] )
+{
+  // The environment variables enable both
+  if ( argc > 1 && std::strcmp( argv[1], "environment" ) == 0 )
+    {
+    ITK_TEST_EXPECT_TRUE( itk::MultiThreaderBase::GetGlobalDefaultThreadAffinity() );
+    ITK_TEST_EXPECT_TRUE( itk::MultiThreaderBase::GetGlobalDefaultParallelFirstTouch() );
+    }
+  itk::MultiThreaderBase::SetGlobalDefaultThreadAffinity( true );
+  itk::MultiThreaderBase::SetGlobalDefaultParallelFirstTouch( true );
+  ITK_TEST_EXPECT_TRUE( itk::MultiThreaderBase::GetGlobalDefaultThreadAffinity() );
+  ITK_TEST_EXPECT_TRUE( itk::MultiThreaderBase::GetGlobalDefaultParallelFirstTouch() );
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( 4 );
+
+  std::cout << "Number of NUMA nodes: " << itk::MultiThreaderBase::GetNumberOfNumaNodes() << std::endl;
+  ITK_TEST_EXPECT_TRUE( itk::MultiThreaderBase::GetNumberOfNumaNodes() >= 1 );
+
+  // A buffer large enough to be touched by several work units
+  using ImageType = itk::Image< int, 3 >;
+  ImageType::SizeType size;
+  size[0] = 128;
+  size[1] = 64;
+  size[2] = 67;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate( true );
+  for ( itk::ImageRegionConstIterator< ImageType > it( image, image->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != 0 )
+      {
+      std::cerr << "The buffer is not initialized to zero" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A filter whose output buffer is touched in parallel
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< int >( it.GetIndex()[0] - 3 * it.GetIndex()[1] + 7 * it.GetIndex()[2] ) );
+    }
+  using FilterType = itk::AbsImageFilter< ImageType, ImageType >;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  itk::ImageRegionConstIterator< ImageType > out( filter->GetOutput(), image->GetBufferedRegion() );
+  for ( itk::ImageRegionConstIterator< ImageType > it( image, image->GetBufferedRegion() ); !it.IsAtEnd(); ++it, ++out )
+    {
+    if ( out.Get() != std::abs( it.Get() ) )
+      {
+      std::cerr << "Wrong value " << out.Get() << " instead of " << std::abs( it.Get() ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The work units of ParallelizeArray
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  std::vector< unsigned int > visits( 1000, 0 );
+  threader->ParallelizeArray( 0, visits.size(), [&visits]( itk::SizeValueType i ) { ++visits[i]; }, nullptr );
+  for ( auto visit : visits )
+    {
+    ITK_TEST_EXPECT_EQUAL( visit, 1u );
+    }
+
+  // Buffers touched in parallel, zeroed or not
+  std::vector< char > buffer( 5 << 20, 1 );
+  itk::MultiThreaderBase::TouchInParallel( buffer.data(), buffer.size(), true );
+  ITK_TEST_EXPECT_TRUE( std::count( buffer.begin(), buffer.end(), 0 ) == static_cast< std::ptrdiff_t >( buffer.size() ) );
+  itk::MultiThreaderBase::TouchInParallel( buffer.data() + 1, 100, true );
+  itk::MultiThreaderBase::TouchInParallel( buffer.data(), 0, false );
+
+  // Buffers touched within work units, as the buffers of images allocated
+  // by a work unit, are touched by the thread of the work unit
+  std::vector< std::vector< char > > buffers( 8, std::vector< char >( 2 << 20, 1 ) );
+  threader->ParallelizeArray( 0, buffers.size(), [&buffers]( itk::SizeValueType i )
+    {
+    itk::MultiThreaderBase::TouchInParallel( buffers[i].data(), buffers[i].size(), true );
+    }, nullptr );
+  for ( const auto & touched : buffers )
+    {
+    ITK_TEST_EXPECT_TRUE( std::count( touched.begin(), touched.end(), 0 ) == static_cast< std::ptrdiff_t >( touched.size() ) );
+    }
+
+#if defined( __linux__ )
+  // The calling thread runs work units: it is pinned to the processors of a
+  // node while it runs them, and then gets its own affinity back rather than
+  // the one of the process
+  cpu_set_t processAffinity;
+  ITK_TEST_EXPECT_EQUAL( pthread_getaffinity_np( pthread_self(), sizeof( cpu_set_t ), &processAffinity ), 0 );
+  cpu_set_t ownAffinity;
+  CPU_ZERO( &ownAffinity );
+  for ( int processor = 0; processor < CPU_SETSIZE; ++processor )
+    {
+    if ( CPU_ISSET( processor, &processAffinity ) )
+      {
+      CPU_SET( processor, &ownAffinity );
+      break;
+      }
+    }
+  ITK_TEST_EXPECT_EQUAL( pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &ownAffinity ), 0 );
+
+  const pthread_t callingThread = pthread_self();
+  std::vector< int > callingThreadProcessors;
+  threader->ParallelizeArray( 0, 64, [&]( itk::SizeValueType )
+    {
+    cpu_set_t affinity;
+    pthread_getaffinity_np( pthread_self(), sizeof( cpu_set_t ), &affinity );
+    CPU_AND( &affinity, &affinity, &processAffinity );
+    if ( pthread_equal( pthread_self(), callingThread ) )
+      {
+      callingThreadProcessors.push_back( CPU_COUNT( &affinity ) );
+      }
+    }, nullptr );
+
+  cpu_set_t affinity;
+  ITK_TEST_EXPECT_EQUAL( pthread_getaffinity_np( pthread_self(), sizeof( cpu_set_t ), &affinity ), 0 );
+  ITK_TEST_EXPECT_TRUE( CPU_EQUAL( &affinity, &ownAffinity ) );
+  // The node of a work unit has at least one processor of the process
+  ITK_TEST_EXPECT_TRUE( !callingThreadProcessors.empty() );
+  for ( int numberOfProcessors : callingThreadProcessors )
+    {
+    ITK_TEST_EXPECT_TRUE( numberOfProcessors >= 1 );
+    }
+  ITK_TEST_EXPECT_EQUAL( pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &processAffinity ), 0 );
+#endif
+
+  itk::MultiThreaderBase::SetGlobalDefaultThreadAffinity( false );
+  itk::MultiThreaderBase::SetGlobalDefaultParallelFirstTouch( false );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 template<typename TImage>
 bool ImageBoundaryFaceCalculatorTest(TImage * image, typename TImage::RegionType & region, const typename TImage::SizeType & radius)
@@ -82,6 +83,86 @@ bool ImageBoundaryFaceCalculatorTest(TImage * image, typename TImage::RegionType
     return true;
 }
 
+template<typename TImage>
+bool ImageNeighborhoodPartitionTest(TImage * image, const typename TImage::RegionType & region, const typename TImage::SizeType & radius)
+{
+  using PartitionType = itk::NeighborhoodAlgorithm::ImageNeighborhoodPartition<TImage>;
+  using InteriorNeighborhoodType = typename PartitionType::InteriorNeighborhoodType;
+
+  itk::ImageRegionIteratorWithIndex<TImage> fillIt(image, image->GetBufferedRegion());
+  for(; !fillIt.IsAtEnd(); ++fillIt)
+    {
+    fillIt.Set( static_cast<typename TImage::PixelType>( image->ComputeOffset( fillIt.GetIndex() ) ) );
+    }
+
+  const PartitionType partition(image, region, radius);
+
+  // The interior neighborhoods are in the buffer, and have the values read
+  // by a neighborhood iterator
+  typename TImage::RegionType paddedInterior = partition.GetInteriorRegion();
+  paddedInterior.PadByRadius(radius);
+  if( partition.GetInteriorRegion().GetNumberOfPixels() > 0 && !image->GetBufferedRegion().IsInside(paddedInterior) )
+    {
+    std::cerr << "The interior region " << partition.GetInteriorRegion() << " is too close to the boundary" << std::endl;
+    return false;
+    }
+
+  using NeighborhoodIteratorType = itk::ConstNeighborhoodIterator<TImage>;
+  NeighborhoodIteratorType nIt(radius, image, partition.GetInteriorRegion());
+  nIt.GoToBegin();
+  itk::SizeValueType numberOfInteriorNeighborhoods = 0;
+  bool sameValues = true;
+  partition.ForEachInteriorNeighborhood( [&](const InteriorNeighborhoodType & neighborhood)
+    {
+    ++numberOfInteriorNeighborhoods;
+    if( neighborhood.Size() != nIt.Size() || neighborhood.GetCenterPixel() != nIt.GetCenterPixel() )
+      {
+      sameValues = false;
+      }
+    for(unsigned int i = 0; i < nIt.Size(); ++i)
+      {
+      sameValues = sameValues && neighborhood.GetPixel(i) == nIt.GetPixel(i);
+      }
+    ++nIt;
+    } );
+  if( !sameValues || numberOfInteriorNeighborhoods != partition.GetInteriorRegion().GetNumberOfPixels() )
+    {
+    std::cerr << "The interior neighborhoods differ from the ones of the neighborhood iterator" << std::endl;
+    return false;
+    }
+
+  // The interior region and the boundary faces cover the region once
+  image->FillBuffer(0);
+  itk::ImageRegionIterator<TImage> interiorIt(image, partition.GetInteriorRegion());
+  for(; !interiorIt.IsAtEnd(); ++interiorIt)
+    {
+    interiorIt.Value()++;
+    }
+  for(const auto & face : partition.GetBoundaryFaces())
+    {
+    itk::ImageRegionIterator<TImage> faceIt(image, face);
+    for(; !faceIt.IsAtEnd(); ++faceIt)
+      {
+      faceIt.Value()++;
+      }
+    }
+  typename TImage::RegionType croppedRegion = region;
+  if( !croppedRegion.Crop(image->GetBufferedRegion()) )
+    {
+    return partition.GetInteriorRegion().GetNumberOfPixels() == 0;
+    }
+  itk::ImageRegionIteratorWithIndex<TImage> checkIt(image, image->GetBufferedRegion());
+  for(; !checkIt.IsAtEnd(); ++checkIt)
+    {
+    if( checkIt.Get() != ( croppedRegion.IsInside( checkIt.GetIndex() ) ? 1 : 0 ) )
+      {
+      std::cerr << "Pixel " << checkIt.GetIndex() << " covered " << checkIt.Get() << " times by the partition" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
 template<typename TPixel, unsigned int VDimension>
 bool NeighborhoodAlgorithmTest()
 {
@@ -106,7 +187,8 @@ bool NeighborhoodAlgorithmTest()
   image->Allocate();
 
   //test 1: requestToProcessRegion match the bufferedRegion
-  if ( !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
+  if ( !ImageNeighborhoodPartitionTest( image.GetPointer(), region, radius ) ||
+       !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
     return false;
 
   ind.Fill(1);
@@ -115,7 +197,8 @@ bool NeighborhoodAlgorithmTest()
   region.SetSize(size);
 
   //test 2: requestToProcessRegion is part of bufferedRegion
-  if ( !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
+  if ( !ImageNeighborhoodPartitionTest( image.GetPointer(), region, radius ) ||
+       !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
     return false;
 
   ind.Fill(0);
@@ -132,7 +215,8 @@ bool NeighborhoodAlgorithmTest()
   image->Allocate();
 
   //test 3: requestToProcessRegion match the bufferedRegion, but all the bufferedRegion is inside the boundary
-  if ( !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
+  if ( !ImageNeighborhoodPartitionTest( image.GetPointer(), region, radius ) ||
+       !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
     return false;
 
   size.Fill(5);
@@ -147,7 +231,8 @@ bool NeighborhoodAlgorithmTest()
   region.SetSize(size);
 
   //test 4: bufferedRegion is part of the requestToProcessRegion
-  if ( !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
+  if ( !ImageNeighborhoodPartitionTest( image.GetPointer(), region, radius ) ||
+       !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
     return false;
 
   ind.Fill(0);
@@ -164,7 +249,8 @@ bool NeighborhoodAlgorithmTest()
   region.SetIndex(ind);
   region.SetSize(size);
   //test 5: requestToProcessRegion is part of boundary of bufferedRegion
-  if ( !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
+  if ( !ImageNeighborhoodPartitionTest( image.GetPointer(), region, radius ) ||
+       !ImageBoundaryFaceCalculatorTest( image.GetPointer(), region, radius ))
     return false;
 
   if (VDimension == 2)
@@ -185,7 +271,8 @@ bool NeighborhoodAlgorithmTest()
     region.SetSize(size);
     radius.Fill(4);
     // test 6: test condition encountered by BoxMeanImageFilterTest with 24 threads
-    if (!ImageBoundaryFaceCalculatorTest(image.GetPointer(), region, radius))
+    if (!ImageNeighborhoodPartitionTest(image.GetPointer(), region, radius) ||
+        !ImageBoundaryFaceCalculatorTest(image.GetPointer(), region, radius))
       return false;
   }
 
@@ -85,6 +85,47 @@ int itkSparseFieldLayerTest(int , char *[] )
           --i;
         }
 
+      layer->Sort( [](const node_type *a, const node_type *b)
+                   { return a->value < b->value; } );
+      for (i = 0; i < 4000; i++)
+        {
+          (store+i)->value = i;
+        }
+      layer->Sort( [](const node_type *a, const node_type *b)
+                   { return a->value < b->value; } );
+      cit = layer->Begin();
+      i = 0;
+      while (cit != layer->End() )
+        {
+          if ( cit->value != i ) return EXIT_FAILURE;
+          ++cit;
+          ++i;
+        }
+      if ( i != 4000 ) return EXIT_FAILURE;
+      --cit;
+      if ( cit->value != 3999 ) return EXIT_FAILURE;
+
+      // Nodes moved to the front are merged back into the ordered ones
+      for (i = 0; i < 4000; i += 3)
+        {
+          layer->Unlink(store+i);
+        }
+      for (i = 0; i < 4000; i += 3)
+        {
+          layer->PushFront(store+i);
+        }
+      layer->Sort( [](const node_type *a, const node_type *b)
+                   { return a->value < b->value; } );
+      cit = layer->End();
+      i = 4000;
+      while ( i > 0 )
+        {
+          --cit;
+          --i;
+          if ( cit->value != i ) return EXIT_FAILURE;
+        }
+      if ( cit != layer->Begin() ) return EXIT_FAILURE;
+
       for (i = 0; i < 5000; i++)
         {
           layer->PopFront();
@@ -0,0 +1,239 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAbsImageFilter.h"
+#include "itkCommand.h"
+#include "itkDerivativeOperator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVectorImage.h"
+
+#include <algorithm>
+
+// Streams a pipeline of two neighborhood filters, whose requested regions
+// are padded, under a memory budget, and checks that each piece stays
+// within the budget, and that a pipeline that does not stream is not
+// divided for nothing.
+namespace
+{
+
+using ImageType = itk::Image< float, 3 >;
+using OutputImageType = itk::Image< double, 3 >;
+using NeighborhoodFilterType = itk::NeighborhoodOperatorImageFilter< ImageType, ImageType >;
+using ShiftScaleType = itk::ShiftScaleImageFilter< ImageType, OutputImageType >;
+using StreamerType = itk::StreamingImageFilter< OutputImageType, OutputImageType >;
+
+// The memory of the outputs of the pipeline, when a piece starts
+class PieceMemory
+{
+public:
+  void operator()()
+  {
+    const itk::SizeValueType memory =
+      m_Filter1->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * sizeof( float )
+      + m_Filter2->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * sizeof( float )
+      + m_ShiftScale->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * sizeof( double );
+    m_MaximumMemory = std::max( m_MaximumMemory, memory );
+    ++m_NumberOfPieces;
+  }
+
+  const NeighborhoodFilterType * m_Filter1;
+  const NeighborhoodFilterType * m_Filter2;
+  const ShiftScaleType *         m_ShiftScale;
+  itk::SizeValueType             m_MaximumMemory{ 0 };
+  unsigned int                   m_NumberOfPieces{ 0 };
+};
+
+// A filter that generates its whole output whatever the piece requested
+class WholeImageShiftScale:
+  public ShiftScaleType
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WholeImageShiftScale);
+
+  using Self = WholeImageShiftScale;
+  using Superclass = ShiftScaleType;
+  using Pointer = itk::SmartPointer< Self >;
+
+  itkNewMacro(Self);
+
+protected:
+  WholeImageShiftScale() = default;
+
+  void EnlargeOutputRequestedRegion( itk::DataObject * output ) override
+  {
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+};
+
+// Gives access to the number of pieces for the memory budget
+class BudgetStreamer:
+  public StreamerType
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BudgetStreamer);
+
+  using Self = BudgetStreamer;
+  using Superclass = StreamerType;
+  using Pointer = itk::SmartPointer< Self >;
+
+  itkNewMacro(Self);
+
+  using Superclass::ComputeNumberOfStreamDivisionsFromMemoryBudget;
+
+protected:
+  BudgetStreamer() = default;
+};
+
+} // end namespace
+
+int itkStreamingImageFilterMemoryBudgetTest( int, char *[] )
+{
+  ImageType::SizeType size;
+  size[0] = 32;
+  size[1] = 32;
+  size[2] = 40;
+  ImageType::Pointer input = ImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( input, input->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< float >( ( index[0] * 7 + index[1] * 3 + index[2] * index[2] ) % 31 ) );
+    }
+  const itk::SizeValueType sliceSize = size[0] * size[1];
+
+  // The size of the requested region
+  ITK_TEST_EXPECT_EQUAL( input->GetRequestedRegionMemorySize(), 40 * sliceSize * sizeof( float ) );
+  using VectorImageType = itk::VectorImage< float, 2 >;
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  VectorImageType::SizeType vectorSize;
+  vectorSize[0] = 2;
+  vectorSize[1] = 3;
+  vectorImage->SetRegions( vectorSize );
+  vectorImage->SetNumberOfComponentsPerPixel( 4 );
+  ITK_TEST_EXPECT_EQUAL( vectorImage->GetRequestedRegionMemorySize(), 6 * 4 * sizeof( float ) );
+
+  // Derivatives along the slowest dimension, which pad the pieces of the
+  // streaming by a slice on each side
+  itk::DerivativeOperator< float, 3 > derivative;
+  derivative.SetDirection( 2 );
+  derivative.SetOrder( 1 );
+  derivative.CreateDirectional();
+
+  auto filter1 = NeighborhoodFilterType::New();
+  filter1->SetInput( input );
+  filter1->SetOperator( derivative );
+  auto filter2 = NeighborhoodFilterType::New();
+  filter2->SetInput( filter1->GetOutput() );
+  filter2->SetOperator( derivative );
+  auto shiftScale = ShiftScaleType::New();
+  shiftScale->SetInput( filter2->GetOutput() );
+  shiftScale->SetScale( 2.0 );
+
+  PieceMemory pieceMemory;
+  pieceMemory.m_Filter1 = filter1;
+  pieceMemory.m_Filter2 = filter2;
+  pieceMemory.m_ShiftScale = shiftScale;
+  auto command = itk::SimpleMemberCommand< PieceMemory >::New();
+  command->SetCallbackFunction( &pieceMemory, &PieceMemory::operator() );
+  shiftScale->AddObserver( itk::StartEvent(), command );
+
+  // A piece of k slices in the middle needs k slices of double and float,
+  // and k + 2 slices of float for the padded output of the first filter
+  const itk::SizeValueType budget = ( 5 * ( sizeof( double ) + sizeof( float ) ) + 7 * sizeof( float ) ) * sliceSize;
+  auto streamer = StreamerType::New();
+  streamer->SetInput( shiftScale->GetOutput() );
+  streamer->SetMemoryBudget( budget );
+  ITK_TEST_SET_GET_VALUE( budget, streamer->GetMemoryBudget() );
+  ITK_TRY_EXPECT_NO_EXCEPTION( streamer->Update() );
+  std::cout << pieceMemory.m_NumberOfPieces << " pieces of at most " << pieceMemory.m_MaximumMemory << " bytes"
+            << std::endl;
+  ITK_TEST_EXPECT_EQUAL( pieceMemory.m_NumberOfPieces, 8u );
+  ITK_TEST_EXPECT_TRUE( pieceMemory.m_MaximumMemory <= budget );
+
+  // The same result as without streaming
+  OutputImageType::Pointer streamed = streamer->GetOutput();
+  streamed->DisconnectPipeline();
+  ITK_TRY_EXPECT_NO_EXCEPTION( shiftScale->UpdateLargestPossibleRegion() );
+  for ( itk::ImageRegionConstIteratorWithIndex< OutputImageType > it( shiftScale->GetOutput(),
+        shiftScale->GetOutput()->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != streamed->GetPixel( it.GetIndex() ) )
+      {
+      std::cerr << "Wrong value " << streamed->GetPixel( it.GetIndex() ) << " instead of " << it.Get()
+                << " at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A budget too small for a slice streams slice by slice
+  pieceMemory.m_NumberOfPieces = 0;
+  shiftScale->Modified();
+  streamer->SetMemoryBudget( 1 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( streamer->Update() );
+  ITK_TEST_EXPECT_EQUAL( pieceMemory.m_NumberOfPieces, 40u );
+
+  // Without budget, the number of stream divisions is used
+  pieceMemory.m_NumberOfPieces = 0;
+  shiftScale->Modified();
+  streamer->SetMemoryBudget( 0 );
+  streamer->SetNumberOfStreamDivisions( 4 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( streamer->Update() );
+  ITK_TEST_EXPECT_EQUAL( pieceMemory.m_NumberOfPieces, 4u );
+
+  // The output of a filter that runs in place takes no memory
+  using AbsType = itk::AbsImageFilter< ImageType, ImageType >;
+  auto abs = AbsType::New();
+  abs->SetInput( filter2->GetOutput() );
+  abs->InPlaceOn();
+  abs->UpdateOutputInformation();
+  abs->GetOutput()->SetRequestedRegionToLargestPossibleRegion();
+  abs->GetOutput()->PropagateRequestedRegion();
+  ITK_TEST_EXPECT_EQUAL( abs->EstimateRequestedRegionMemory(), 0u );
+  ITK_TEST_EXPECT_EQUAL( abs->EstimatePipelineMemory(), 2 * 40 * sliceSize * sizeof( float ) );
+  abs->InPlaceOff();
+  ITK_TEST_EXPECT_EQUAL( abs->EstimateRequestedRegionMemory(), 40 * sliceSize * sizeof( float ) );
+
+  // and neither does the output of a filter that runs in place because its
+  // input is released after its execution
+  AbsType::SetGlobalAutomaticInPlace( true );
+  filter2->ReleaseDataFlagOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION( abs->UpdateLargestPossibleRegion() );
+  ITK_TEST_EXPECT_TRUE( abs->GetRanInPlace() );
+  ITK_TEST_EXPECT_EQUAL( abs->EstimateRequestedRegionMemory(), 0u );
+  filter2->ReleaseDataFlagOff();
+  AbsType::SetGlobalAutomaticInPlace( false );
+
+  // The pieces of a filter that generates its whole output need as much
+  // memory whatever their size: the output is not divided
+  auto wholeShiftScale = WholeImageShiftScale::New();
+  wholeShiftScale->SetInput( filter2->GetOutput() );
+  auto budgetStreamer = BudgetStreamer::New();
+  budgetStreamer->SetInput( wholeShiftScale->GetOutput() );
+  budgetStreamer->SetMemoryBudget( 1 );
+  budgetStreamer->UpdateOutputInformation();
+  ITK_TEST_EXPECT_EQUAL( budgetStreamer->ComputeNumberOfStreamDivisionsFromMemoryBudget(
+    budgetStreamer->GetOutput()->GetLargestPossibleRegion() ), 1u );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
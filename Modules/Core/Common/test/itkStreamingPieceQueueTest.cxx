@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCommand.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkStreamingPieceQueue.h"
+#include "itkTestingMacros.h"
+#include "itkThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Consumes pieces with a StreamingPieceQueue, and streams a pipeline with
+// several pieces in flight, whose upstream filter streams or not.
+namespace
+{
+
+using ImageType = itk::Image< float, 3 >;
+using OutputImageType = itk::Image< double, 3 >;
+using ShiftScaleType = itk::ShiftScaleImageFilter< ImageType, OutputImageType >;
+using StreamerType = itk::StreamingImageFilter< OutputImageType, OutputImageType >;
+
+// A filter that generates its whole output whatever the piece requested
+class WholeImageShiftScale:
+  public ShiftScaleType
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WholeImageShiftScale);
+
+  using Self = WholeImageShiftScale;
+  using Superclass = ShiftScaleType;
+  using Pointer = itk::SmartPointer< Self >;
+
+  itkNewMacro(Self);
+
+protected:
+  WholeImageShiftScale() = default;
+
+  void EnlargeOutputRequestedRegion( itk::DataObject * output ) override
+  {
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+};
+
+class PieceCounter
+{
+public:
+  void Count()
+  {
+    ++m_NumberOfPieces;
+  }
+
+  unsigned int m_NumberOfPieces{ 0 };
+};
+
+OutputImageType::Pointer
+Stream( ImageType * image, unsigned int numberOfPiecesInFlight, bool wholeImage, unsigned int & numberOfPieces )
+{
+  ShiftScaleType::Pointer shiftScale;
+  if ( wholeImage )
+    {
+    shiftScale = WholeImageShiftScale::New();
+    }
+  else
+    {
+    shiftScale = ShiftScaleType::New();
+    }
+  shiftScale->SetInput( image );
+  shiftScale->SetShift( 1.0 );
+  shiftScale->SetScale( 2.0 );
+
+  PieceCounter counter;
+  using CommandType = itk::SimpleMemberCommand< PieceCounter >;
+  CommandType::Pointer command = CommandType::New();
+  command->SetCallbackFunction( &counter, &PieceCounter::Count );
+  shiftScale->AddObserver( itk::StartEvent(), command );
+
+  StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput( shiftScale->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( 10 );
+  streamer->SetNumberOfPiecesInFlight( numberOfPiecesInFlight );
+  streamer->Update();
+  numberOfPieces = counter.m_NumberOfPieces;
+
+  OutputImageType::Pointer output = streamer->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+} // end namespace
+
+int itkStreamingPieceQueueTest( int, char *[] )
+{
+  // One piece in flight: consumed right away
+  {
+  itk::StreamingPieceQueue queue( 1, true );
+  ITK_TEST_EXPECT_TRUE( !queue.IsPipelined() );
+  int consumed = 0;
+  queue.Push( [&consumed]() { ++consumed; } );
+  ITK_TEST_EXPECT_EQUAL( consumed, 1 );
+  }
+
+  // The pieces are consumed in the background only when the ThreadPool has
+  // threads left for the filters
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+  if ( pool->GetMaximumNumberOfThreads() == 1 )
+    {
+    itk::StreamingPieceQueue queue( 4, true );
+    ITK_TEST_EXPECT_TRUE( !queue.IsPipelined() );
+    }
+  if ( pool->GetMaximumNumberOfThreads() < 4 )
+    {
+    pool->AddThreads( 4 - pool->GetMaximumNumberOfThreads() );
+    }
+
+  // Ordered pieces are consumed in the order they were pushed, even when
+  // the first ones take longer
+  {
+  itk::StreamingPieceQueue queue( 4, true );
+  ITK_TEST_EXPECT_TRUE( queue.IsPipelined() );
+  std::vector< int >       order;
+  for ( int i = 0; i < 8; ++i )
+    {
+    queue.Push( [&order, i]()
+      {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 8 - i ) );
+      order.push_back( i );
+      } );
+    }
+  queue.WaitForAll();
+  ITK_TEST_EXPECT_EQUAL( order.size(), 8u );
+  for ( int i = 0; i < static_cast< int >( order.size() ); ++i )
+    {
+    ITK_TEST_EXPECT_EQUAL( order[i], i );
+    }
+  }
+
+  // Unordered pieces are all consumed
+  {
+  itk::StreamingPieceQueue queue( 3, false );
+  std::atomic< int >       consumed( 0 );
+  for ( int i = 0; i < 20; ++i )
+    {
+    queue.Push( [&consumed]() { ++consumed; } );
+    }
+  queue.WaitForAll();
+  ITK_TEST_EXPECT_EQUAL( consumed.load(), 20 );
+  }
+
+  // The exception of a piece is rethrown once the others are consumed
+  {
+  itk::StreamingPieceQueue queue( 2, true );
+  bool                     thrown = false;
+  try
+    {
+    queue.Push( []() { itkGenericExceptionMacro( "Piece failed" ); } );
+    queue.Push( []() {} );
+    queue.WaitForAll();
+    }
+  catch ( itk::ExceptionObject & e )
+    {
+    std::cout << "Expected exception: " << e.GetDescription() << std::endl;
+    thrown = true;
+    }
+  ITK_TEST_EXPECT_TRUE( thrown );
+  }
+
+  // Streaming with several pieces in flight gives the same output
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 16;
+  size[1] = 16;
+  size[2] = 30;
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< float >( index[0] + 16 * index[1] + 256 * index[2] ) );
+    }
+
+  unsigned int numberOfPieces = 0;
+  OutputImageType::Pointer sequential = Stream( image, 1, false, numberOfPieces );
+  ITK_TEST_EXPECT_EQUAL( numberOfPieces, 10u );
+  for ( unsigned int numberOfPiecesInFlight : { 2u, 3u, 16u } )
+    {
+    OutputImageType::Pointer pipelined = Stream( image, numberOfPiecesInFlight, false, numberOfPieces );
+    ITK_TEST_EXPECT_EQUAL( numberOfPieces, 10u );
+    itk::ImageRegionConstIterator< OutputImageType > expected( sequential, sequential->GetLargestPossibleRegion() );
+    itk::ImageRegionConstIterator< OutputImageType > actual( pipelined, sequential->GetLargestPossibleRegion() );
+    ITK_TEST_EXPECT_EQUAL( pipelined->GetBufferedRegion(), sequential->GetLargestPossibleRegion() );
+    for ( ; !expected.IsAtEnd(); ++expected, ++actual )
+      {
+      if ( expected.Get() != actual.Get() )
+        {
+        std::cerr << "Pixel " << expected.GetIndex() << " is " << actual.Get()
+                  << " with " << numberOfPiecesInFlight << " pieces in flight instead of "
+                  << expected.Get() << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // A filter that does not stream generates the whole image once, which is
+  // kept for all the pieces
+  for ( unsigned int numberOfPiecesInFlight : { 1u, 3u } )
+    {
+    unsigned int numberOfExecutions = 0;
+    OutputImageType::Pointer whole = Stream( image, numberOfPiecesInFlight, true, numberOfExecutions );
+    ITK_TEST_EXPECT_EQUAL( numberOfExecutions, 1u );
+    itk::ImageRegionConstIterator< OutputImageType > expected( sequential, sequential->GetLargestPossibleRegion() );
+    itk::ImageRegionConstIterator< OutputImageType > actual( whole, sequential->GetLargestPossibleRegion() );
+    for ( ; !expected.IsAtEnd(); ++expected, ++actual )
+      {
+      ITK_TEST_EXPECT_EQUAL( actual.Get(), expected.Get() );
+      }
+    }
+
+  StreamerType::Pointer streamer = StreamerType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( streamer, StreamingImageFilter, ImageToImageFilter );
+  ITK_TEST_EXPECT_EQUAL( streamer->GetNumberOfPiecesInFlight(), 1u );
+  streamer->SetNumberOfPiecesInFlight( 0 );
+  ITK_TEST_EXPECT_EQUAL( streamer->GetNumberOfPiecesInFlight(), 1u );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSymmetricEigenAnalysis.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include "vnl/algo/vnl_qr.h"
+#include <vector>
+
+namespace
+{
+
+using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+
+// Random symmetric matrices, including the difficult cases: diagonal and
+// zero matrices, repeated eigen values, nearly singular matrices and
+// matrices of very large or small scale.
+template< unsigned int VDimension >
+std::vector< itk::Matrix< double, VDimension, VDimension > >
+MakeMatrices()
+{
+  using MatrixType = itk::Matrix< double, VDimension, VDimension >;
+
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 20190523 );
+
+  std::vector< MatrixType > matrices;
+  for ( unsigned int n = 0; n < 2000; ++n )
+    {
+    // R diag(lambda) R^T with a random rotation R
+    vnl_matrix< double > random( VDimension, VDimension );
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      for ( unsigned int j = 0; j < VDimension; ++j )
+        {
+        random( i, j ) = generator->GetNormalVariate();
+        }
+      }
+    const vnl_matrix< double > q = vnl_qr< double >( random ).Q();
+
+    double lambda[VDimension];
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      lambda[i] = generator->GetUniformVariate( -10.0, 10.0 );
+      }
+    switch ( n % 5 )
+      {
+      case 1: // double eigen value
+        lambda[1] = lambda[0];
+        break;
+      case 2: // nearly double eigen value
+        lambda[1] = lambda[0] * ( 1.0 + 1e-9 );
+        break;
+      case 3: // singular
+        lambda[0] = 0.0;
+        break;
+      default:
+        break;
+      }
+    const double scale = ( n % 7 == 0 ) ? 1e-150 : ( ( n % 11 == 0 ) ? 1e150 : 1.0 );
+
+    MatrixType matrix;
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      for ( unsigned int j = 0; j < VDimension; ++j )
+        {
+        double value = 0.0;
+        for ( unsigned int k = 0; k < VDimension; ++k )
+          {
+          value += q( i, k ) * lambda[k] * q( j, k );
+          }
+        matrix[i][j] = value * scale;
+        }
+      }
+    // exactly symmetric
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      for ( unsigned int j = 0; j < i; ++j )
+        {
+        matrix[i][j] = matrix[j][i];
+        }
+      }
+    matrices.push_back( matrix );
+    }
+
+  MatrixType diagonal;
+  diagonal.Fill( 0.0 );
+  matrices.push_back( diagonal );
+  for ( unsigned int i = 0; i < VDimension; ++i )
+    {
+    diagonal[i][i] = 3.0 - i;
+    }
+  matrices.push_back( diagonal );
+  diagonal.SetIdentity();
+  matrices.push_back( diagonal );
+  return matrices;
+}
+
+// Compare the eigen values of the closed-form solver with the iterative one,
+// and check that its eigen vectors are orthonormal and satisfy A v = lambda v.
+template< typename TCalculator, unsigned int VDimension >
+int
+CompareWithIterativeSolver( TCalculator & calculator, bool orderByMagnitude )
+{
+  using MatrixType = itk::Matrix< double, VDimension, VDimension >;
+  using VectorType = itk::FixedArray< double, VDimension >;
+
+  constexpr double tolerance = 1e-10;
+  int result = EXIT_SUCCESS;
+  double maximumValueError = 0.0;
+  double maximumVectorError = 0.0;
+
+  for ( const MatrixType & matrix : MakeMatrices< VDimension >() )
+    {
+    double norm = 0.0;
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      for ( unsigned int j = 0; j < VDimension; ++j )
+        {
+        norm = std::max( norm, std::abs( matrix[i][j] ) );
+        }
+      }
+    norm = std::max( norm, std::numeric_limits< double >::min() );
+
+    VectorType expectedValues;
+    expectedValues.Fill( 0.0 );
+    calculator.SetUseClosedFormSolver( false );
+    calculator.ComputeEigenValues( matrix, expectedValues );
+
+    VectorType values;
+    values.Fill( 0.0 );
+    calculator.SetUseClosedFormSolver( true );
+    calculator.ComputeEigenValues( matrix, values );
+
+    VectorType valuesWithVectors;
+    valuesWithVectors.Fill( 0.0 );
+    MatrixType vectors;
+    calculator.ComputeEigenValuesAndVectors( matrix, valuesWithVectors, vectors );
+
+    for ( unsigned int i = 0; i < VDimension; ++i )
+      {
+      maximumValueError = std::max( maximumValueError, std::abs( values[i] - expectedValues[i] ) / norm );
+      maximumValueError = std::max( maximumValueError, std::abs( valuesWithVectors[i] - expectedValues[i] ) / norm );
+      if ( i > 0 )
+        {
+        const bool sorted = orderByMagnitude ? std::abs( values[i - 1] ) <= std::abs( values[i] )
+                                             : values[i - 1] <= values[i];
+        if ( !sorted )
+          {
+          std::cerr << "The eigen values " << values << " of " << matrix << " are not sorted." << std::endl;
+          result = EXIT_FAILURE;
+          }
+        }
+
+      for ( unsigned int j = 0; j < VDimension; ++j )
+        {
+        double residual = -valuesWithVectors[i] * vectors[i][j];
+        double dotProduct = 0.0;
+        for ( unsigned int k = 0; k < VDimension; ++k )
+          {
+          residual += matrix[j][k] * vectors[i][k];
+          dotProduct += vectors[i][k] * vectors[j][k];
+          }
+        maximumVectorError = std::max( maximumVectorError, std::abs( residual ) / norm );
+        maximumVectorError = std::max( maximumVectorError, std::abs( dotProduct - ( i == j ? 1.0 : 0.0 ) ) );
+        }
+      }
+    }
+
+  std::cout << "Dimension " << VDimension << ( orderByMagnitude ? ", ordered by magnitude" : "" )
+            << ": maximum relative error of the eigen values " << maximumValueError
+            << ", of the eigen vectors " << maximumVectorError << std::endl;
+  if ( maximumValueError > tolerance || maximumVectorError > tolerance )
+    {
+    std::cerr << "The closed-form solver is not accurate enough." << std::endl;
+    result = EXIT_FAILURE;
+    }
+  return result;
+}
+
+template< unsigned int VDimension >
+int
+TestDimension()
+{
+  using MatrixType = itk::Matrix< double, VDimension, VDimension >;
+  using VectorType = itk::FixedArray< double, VDimension >;
+
+  int result = EXIT_SUCCESS;
+  for ( bool orderByMagnitude : { false, true } )
+    {
+    itk::SymmetricEigenAnalysis< MatrixType, VectorType, MatrixType > calculator( VDimension );
+    if ( orderByMagnitude )
+      {
+      calculator.SetOrderEigenMagnitudes( true );
+      }
+    if ( CompareWithIterativeSolver< decltype( calculator ), VDimension >( calculator, orderByMagnitude )
+         == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+
+    itk::SymmetricEigenAnalysisFixedDimension< VDimension, MatrixType, VectorType, MatrixType > fixedCalculator;
+    if ( orderByMagnitude )
+      {
+      fixedCalculator.SetOrderEigenMagnitudes( true );
+      }
+    if ( CompareWithIterativeSolver< decltype( fixedCalculator ), VDimension >( fixedCalculator, orderByMagnitude )
+         == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    }
+  return result;
+}
+
+} // end namespace
+
+int itkSymmetricEigenAnalysisClosedFormTest( int, char *[] )
+{
+  using MatrixType = itk::Matrix< double, 3, 3 >;
+  using VectorType = itk::FixedArray< double, 3 >;
+  itk::SymmetricEigenAnalysis< MatrixType, VectorType > calculator( 3 );
+  ITK_TEST_EXPECT_TRUE( !calculator.GetUseClosedFormSolver() );
+  calculator.SetUseClosedFormSolverOn();
+  ITK_TEST_EXPECT_TRUE( calculator.GetUseClosedFormSolver() );
+  calculator.SetUseClosedFormSolverOff();
+  ITK_TEST_EXPECT_TRUE( !calculator.GetUseClosedFormSolver() );
+  std::cout << calculator;
+
+  int result = EXIT_SUCCESS;
+  if ( TestDimension< 2 >() == EXIT_FAILURE || TestDimension< 3 >() == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
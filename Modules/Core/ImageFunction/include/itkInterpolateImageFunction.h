@@ -114,6 +114,19 @@ public:
   OutputType EvaluateAtContinuousIndex(
     const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a continuous index position, into output.
+   *
+   * For images whose pixels are VariableLengthVector's, such as
+   * VectorImage, EvaluateAtContinuousIndex() returns a newly allocated
+   * value, while an output reused from call to call does not need to be
+   * reallocated.  The default implementation assigns the result of
+   * EvaluateAtContinuousIndex(); subclasses may override it to avoid the
+   * allocation. */
+  virtual void EvaluateAtContinuousIndexInto(const ContinuousIndexType & index, OutputType & output) const
+  {
+    output = this->EvaluateAtContinuousIndex(index);
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -104,6 +104,16 @@ public:
     return this->EvaluateOptimized(Dispatch< ImageDimension >(), index);
   }
 
+  /** Evaluate the function at a ContinuousIndex position, into output.
+   *
+   * For VariableLengthVector pixels, the neighbors are read in place in
+   * the buffer, and output is only reallocated when its length changes, so
+   * that no memory is allocated at each call. */
+  void EvaluateAtContinuousIndexInto(const ContinuousIndexType & index, OutputType & output) const override
+  {
+    this->EvaluateInto(index, output);
+  }
+
   SizeType GetRadius() const override
     {
     return SizeType::Filled(1);
@@ -504,6 +514,18 @@ private:
 
   /** \brief A method to generically set all components to zero
    */
+  /** Interpolates the components of VariableLengthVector pixels
+   * separately, along one dimension after the other, as
+   * EvaluateOptimized() does. */
+  template< typename TValue >
+  void EvaluateInto(const ContinuousIndexType & index, VariableLengthVector< TValue > & output) const;
+
+  template< typename TOutput >
+  void EvaluateInto(const ContinuousIndexType & index, TOutput & output) const
+  {
+    output = this->EvaluateAtContinuousIndex(index);
+  }
+
   template<typename RealTypeScalarRealType>
     void
     MakeZeroInitializer(const TInputImage * const inputImagePtr,
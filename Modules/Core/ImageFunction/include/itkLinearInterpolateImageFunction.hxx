@@ -111,6 +111,83 @@ LinearInterpolateImageFunction< TInputImage, TCoordRep >
 {
   this->Superclass::PrintSelf(os, indent);
 }
+template< typename TInputImage, typename TCoordRep >
+template< typename TValue >
+void
+LinearInterpolateImageFunction< TInputImage, TCoordRep >
+::EvaluateInto(const ContinuousIndexType & index, VariableLengthVector< TValue > & output) const
+{
+  const TInputImage * const inputImagePtr = this->GetInputImage();
+
+  // Compute base index = closest index below point, as EvaluateOptimized()
+  IndexType               baseIndex;
+  InternalComputationType distance[ImageDimension];
+  for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+    {
+    baseIndex[dim] = Math::Floor< IndexValueType >(index[dim]);
+    if ( baseIndex[dim] < this->m_StartIndex[dim] )
+      {
+      baseIndex[dim] = this->m_StartIndex[dim];
+      }
+    distance[dim] = index[dim] - static_cast< InternalComputationType >( baseIndex[dim] );
+    }
+
+  // The components of the neighbors are read in place: for VectorImage's,
+  // GetPixel() returns a proxy to the buffer.
+  using InputPixelValueType = typename InputPixelType::ValueType;
+  constexpr unsigned int      numberOfNeighbors = 1 << ImageDimension;
+  const InputPixelValueType * neighbors[numberOfNeighbors];
+  for ( unsigned int counter = 0; counter < numberOfNeighbors; ++counter )
+    {
+    IndexType neighIndex( baseIndex );
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      if ( ( counter >> dim ) & 1 && neighIndex[dim] < this->m_EndIndex[dim] )
+        {
+        ++neighIndex[dim];
+        }
+      }
+    neighbors[counter] = inputImagePtr->GetPixel(neighIndex).GetDataPointer();
+    }
+
+  const unsigned int numberOfComponents = inputImagePtr->GetPixel(baseIndex).GetSize();
+  output.SetSize( numberOfComponents,
+                  typename VariableLengthVector< TValue >::DontShrinkToFit(),
+                  typename VariableLengthVector< TValue >::DumpOldValues() );
+
+  // Each component is interpolated along one dimension after the other,
+  // from the pairs of neighbors that differ in this dimension.  A dimension
+  // without upper neighbor, or at a null distance, is not interpolated.
+  TValue values[numberOfNeighbors];
+  for ( unsigned int k = 0; k < numberOfComponents; ++k )
+    {
+    for ( unsigned int counter = 0; counter < numberOfNeighbors; ++counter )
+      {
+      values[counter] = static_cast< TValue >( neighbors[counter][k] );
+      }
+    unsigned int numberOfValues = numberOfNeighbors;
+    for ( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      numberOfValues /= 2;
+      if ( distance[dim] > 0. && baseIndex[dim] < this->m_EndIndex[dim] )
+        {
+        for ( unsigned int j = 0; j < numberOfValues; ++j )
+          {
+          values[j] = values[2 * j] + ( values[2 * j + 1] - values[2 * j] ) * distance[dim];
+          }
+        }
+      else
+        {
+        for ( unsigned int j = 0; j < numberOfValues; ++j )
+          {
+          values[j] = values[2 * j];
+          }
+        }
+      }
+    output[k] = values[0];
+    }
+}
+
 } // end namespace itk
 
 #endif
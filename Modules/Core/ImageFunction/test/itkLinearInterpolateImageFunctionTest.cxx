@@ -185,6 +185,7 @@ int RunLinearInterpolateTest()
  const AccumulatorType normTolerance = std::sqrt(4.0f*tolerance*tolerance);
 
  PointType point;
+ InterpolatedVariableVectorType reusedvariablevector;
  AccumulatorType testLengths[4] = {1,1,1,1};
  for( unsigned int ind = 0; ind < Dimensions; ind++ )
   {
@@ -286,6 +287,26 @@ int RunLinearInterpolateTest()
                        << std::endl;
                      return EXIT_FAILURE;
                      }
+
+                   // The same value, evaluated into a vector reused from point to point
+                   ContinuousIndexType continuousIndex;
+                   variablevectorimage->TransformPhysicalPointToContinuousIndex( point, continuousIndex );
+                   variablevectorinterpolator->EvaluateAtContinuousIndexInto( continuousIndex, reusedvariablevector );
+
+                   const AccumulatorType reusederrornorm =
+                    (variablevectorpixel - reusedvariablevector).GetNorm();
+
+                   if( reusederrornorm > normTolerance )
+                     {
+                     std::cerr << "Error found while computing variable "
+                               << " vector interpolation into a reused vector" << std::endl;
+                     std::cerr << "Point = " << point << std::endl;
+                     std::cerr << "Expected variablevector = "
+                      << variablevectorpixel << std::endl;
+                     std::cerr << "Computed variablevector = "
+                      << reusedvariablevector << std::endl;
+                     return EXIT_FAILURE;
+                     }
                    }
                  }
                }
@@ -27,6 +27,8 @@
 
 #include "vnl/vnl_vector.h"
 
+#include <vector>
+
 namespace itk {
 
 /**
@@ -380,21 +382,22 @@ private:
   /**
    * Sharpen the intensity histogram of the current estimate of the corrected
    * image and map those results to a new estimate of the unsmoothed corrected
-   * image.
+   * image.  Only the included pixels of the second image are written.
    */
-  RealImagePointer SharpenImage( const RealImageType * ) const;
+  void SharpenImage( const RealImageType *, RealImageType * ) const;
 
   /**
-   * Given the unsmoothed estimate of the bias field, this function smooths
-   * the estimate and adds the resulting control point values to the total
-   * bias field estimate.
+   * Given the current estimate of the corrected image and its sharpened
+   * version, this function smooths their difference, i.e. the residual bias
+   * field, adds the resulting control point values to the total bias field
+   * estimate and reconstructs this estimate in the last image.
    */
-  RealImagePointer UpdateBiasFieldEstimate( RealImageType *, std::size_t );
+  void UpdateBiasFieldEstimate( const RealImageType *, const RealImageType *, RealImageType * );
 
   /**
    * Reconstruct bias field given the control point lattice.
    */
-  RealImagePointer ReconstructBiasField( BiasFieldControlPointLatticeType * );
+  void ReconstructBiasField( BiasFieldControlPointLatticeType *, RealImageType * );
 
   /**
    * Convergence is determined by the coefficient of variation of the difference
@@ -402,6 +405,22 @@ private:
    */
   RealType CalculateConvergenceMeasurement( const RealImageType *, const RealImageType * ) const;
 
+  /**
+   * Set the positions and the weights of the points of the B-spline fit,
+   * which are the included pixels.
+   */
+  void InitializeFieldPoints( const RealImageType * );
+
+  /**
+   * Split [0, numberOfElements) in one chunk per work unit, and call
+   * chunkFunction( chunk, begin, end ) on the chunks in parallel.  Return the
+   * number of chunks, which only depends on numberOfElements and on the
+   * number of work units, so that the results computed per chunk are
+   * combined in the same order whatever the scheduling.
+   */
+  template< typename TChunkFunction >
+  SizeValueType ParallelizeChunks( SizeValueType numberOfElements, TChunkFunction chunkFunction ) const;
+
   MaskPixelType m_MaskLabel;
   bool          m_UseMaskLabel{ false };
 
@@ -428,6 +447,16 @@ private:
   ArrayType    m_NumberOfControlPoints;
   ArrayType    m_NumberOfFittingLevels;
 
+  // Data of the current execution: the buffer offsets of the pixels in the
+  // mask and with a positive confidence, and the points of the B-spline fit
+  // at these pixels.
+
+  std::vector< SizeValueType > m_IncludedPixels;
+  PointSetPointer              m_FieldPoints;
+
+  typename
+  BSplineFilterType::WeightsContainerType::Pointer m_FieldPointWeights;
+
 };
 
 } // end namespace itk
@@ -22,16 +22,10 @@
 
 #include "itkAddImageFilter.h"
 #include "itkBSplineControlPointImageFilter.h"
-#include "itkDivideImageFilter.h"
 #include "itkExpImageFilter.h"
 #include "itkImageBufferRange.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
-#include "itkSubtractImageFilter.h"
-#include "itkVectorIndexSelectionCastImageFilter.h"
 
 CLANG_PRAGMA_PUSH
 CLANG_SUPPRESS_Wfloat_equal
@@ -132,27 +126,44 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   const ImageBufferRange<RealImageType> logInputImageBufferRange{ *logInputImage };
   const std::size_t numberOfPixels = logInputImageBufferRange.size();
 
-  // Number of pixels of the input image that are included with the filter.
-  std::size_t numberOfIncludedPixels = 0;
-
-  for( std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue )
+  // Collect the pixels of the input image that are included with the
+  // filter, in buffer order.
+  std::vector< std::vector< SizeValueType > > includedPixelsPerChunk( this->GetNumberOfWorkUnits() );
+  const SizeValueType numberOfChunks = this->ParallelizeChunks( numberOfPixels,
+    [&]( SizeValueType chunk, SizeValueType begin, SizeValueType end )
     {
-    if( ( maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    std::vector< SizeValueType > & includedPixels = includedPixelsPerChunk[chunk];
+    for( SizeValueType indexValue = begin; indexValue < end; ++indexValue )
       {
-      ++numberOfIncludedPixels;
-      auto&& logInputPixel = logInputImageBufferRange[indexValue];
-
-      if(logInputPixel > NumericTraits<typename InputImageType::PixelType>::ZeroValue() )
+      if( ( maskImageBufferRange.empty()
+            || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
+            || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
+            )
+          && ( confidenceImageBufferRange.empty() ||
+               confidenceImageBufferRange[indexValue] > 0.0 ) )
         {
-        logInputPixel = std::log( static_cast< RealType >(logInputPixel) );
+        includedPixels.push_back( indexValue );
+        auto&& logInputPixel = logInputImageBufferRange[indexValue];
+
+        if(logInputPixel > NumericTraits<typename InputImageType::PixelType>::ZeroValue() )
+          {
+          logInputPixel = std::log( static_cast< RealType >(logInputPixel) );
+          }
         }
       }
+    } );
+
+  this->m_IncludedPixels.clear();
+  for( SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk )
+    {
+    this->m_IncludedPixels.insert( this->m_IncludedPixels.end(),
+      includedPixelsPerChunk[chunk].begin(), includedPixelsPerChunk[chunk].end() );
     }
+  includedPixelsPerChunk.clear();
+
+  // The points of the B-spline fit are the included pixels, whatever the
+  // iteration: only their values are updated by UpdateBiasFieldEstimate().
+  this->InitializeFieldPoints( logInputImage );
 
   // Duplicate logInputImage since we reuse the original at each iteration.
 
@@ -163,6 +174,13 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
 
   RealImagePointer logUncorrectedImage = duplicator->GetOutput();
 
+  // The images updated at each iteration are allocated once.
+
+  RealImagePointer logSharpenedImage = RealImageType::New();
+  logSharpenedImage->CopyInformation( inputImage );
+  logSharpenedImage->SetRegions( inputRegion );
+  logSharpenedImage->Allocate( true ); // initialize buffer to zero
+
   // Provide an initial log bias field of zeros
 
   RealImagePointer logBiasField = RealImageType::New();
@@ -170,6 +188,13 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   logBiasField->SetRegions( inputImage->GetLargestPossibleRegion() );
   logBiasField->Allocate( true ); // initialize buffer to zero
 
+  RealImagePointer newLogBiasField = RealImageType::New();
+  newLogBiasField->CopyInformation( inputImage );
+  newLogBiasField->SetRegions( inputImage->GetLargestPossibleRegion() );
+  newLogBiasField->Allocate( false );
+
+  const ImageBufferRange<RealImageType> logUncorrectedImageBufferRange{ *logUncorrectedImage };
+
   // Iterate until convergence or iterative exhaustion.
   unsigned int maximumNumberOfLevels = 1;
   for( unsigned int d = 0; d < this->m_NumberOfFittingLevels.Size(); d++ )
@@ -199,32 +224,27 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
 
       // Sharpen the current estimate of the uncorrected image.
 
-      RealImagePointer logSharpenedImage = this->SharpenImage( logUncorrectedImage );
-
-      using SubtracterType =
-          SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-      typename SubtracterType::Pointer subtracter1 = SubtracterType::New();
-      subtracter1->SetInput1( logUncorrectedImage );
-      subtracter1->SetInput2( logSharpenedImage );
-
-      RealImagePointer residualBiasField = subtracter1->GetOutput();
-      residualBiasField->Update();
+      this->SharpenImage( logUncorrectedImage, logSharpenedImage );
 
       // Smooth the residual bias field estimate and add the resulting
       // control point grid to get the new total bias field estimate.
 
-      RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate( residualBiasField, numberOfIncludedPixels );
+      this->UpdateBiasFieldEstimate( logUncorrectedImage, logSharpenedImage, newLogBiasField );
 
       this->m_CurrentConvergenceMeasurement =
         this->CalculateConvergenceMeasurement( logBiasField, newLogBiasField );
-      logBiasField = newLogBiasField;
+      std::swap( logBiasField, newLogBiasField );
 
-      typename SubtracterType::Pointer subtracter2 = SubtracterType::New();
-      subtracter2->SetInput1( logInputImage );
-      subtracter2->SetInput2( logBiasField );
-
-      logUncorrectedImage = subtracter2->GetOutput();
-      logUncorrectedImage->Update();
+      const ImageBufferRange<RealImageType> logBiasFieldBufferRange{ *logBiasField };
+      this->ParallelizeChunks( numberOfPixels,
+        [&]( SizeValueType, SizeValueType begin, SizeValueType end )
+        {
+        for( SizeValueType indexValue = begin; indexValue < end; ++indexValue )
+          {
+          logUncorrectedImageBufferRange[indexValue] =
+            logInputImageBufferRange[indexValue] - logBiasFieldBufferRange[indexValue];
+          }
+        } );
 
       reporter.CompletedStep();
       }
@@ -254,6 +274,12 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
       RefineControlPointLattice( numberOfLevels );
     }
 
+  // Release the per execution data.
+  this->m_IncludedPixels.clear();
+  this->m_IncludedPixels.shrink_to_fit();
+  this->m_FieldPoints = nullptr;
+  this->m_FieldPointWeights = nullptr;
+
   using CustomBinaryFilter = itk::BinaryGeneratorImageFilter<InputImageType, RealImageType, OutputImageType>;
   typename CustomBinaryFilter::Pointer expAndDivFilter = CustomBinaryFilter::New();
   auto expAndDivLambda = [](const typename InputImageType::PixelType &input,
@@ -265,74 +291,143 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   expAndDivFilter->SetFunctor( expAndDivLambda );
   expAndDivFilter->SetInput1( inputImage );
   expAndDivFilter->SetInput2( logBiasField );
+  expAndDivFilter->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
   expAndDivFilter->Update();
 
   this->GraftOutput( expAndDivFilter->GetOutput() );
 }
 
 template<typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
+template<typename TChunkFunction>
+SizeValueType
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
-::SharpenImage( const RealImageType *unsharpenedImage ) const
+::ParallelizeChunks( SizeValueType numberOfElements, TChunkFunction chunkFunction ) const
+{
+  const SizeValueType numberOfChunks = std::max< SizeValueType >( 1,
+    std::min< SizeValueType >( this->GetNumberOfWorkUnits(), numberOfElements ) );
+  this->GetMultiThreader()->ParallelizeArray( 0, numberOfChunks,
+    [&]( SizeValueType chunk )
+    {
+    chunkFunction( chunk, numberOfElements * chunk / numberOfChunks,
+                   numberOfElements * ( chunk + 1 ) / numberOfChunks );
+    }, nullptr );
+  return numberOfChunks;
+}
+
+template<typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
+::InitializeFieldPoints( const RealImageType * logInputImage )
 {
-  using itk::Experimental::ImageBufferRange;
   using itk::Experimental::MakeImageBufferRange;
 
-  const auto maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
+  const std::size_t numberOfIncludedPixels = this->m_IncludedPixels.size();
+
+  this->m_FieldPoints = PointSetType::New();
+  this->m_FieldPoints->Initialize();
+  auto& pointSTLContainer = this->m_FieldPoints->GetPoints()->CastToSTLContainer();
+  pointSTLContainer.resize( numberOfIncludedPixels );
+  auto& pointDataSTLContainer = this->m_FieldPoints->GetPointData()->CastToSTLContainer();
+  pointDataSTLContainer.resize( numberOfIncludedPixels );
+
+  this->m_FieldPointWeights = BSplineFilterType::WeightsContainerType::New();
+  this->m_FieldPointWeights->Initialize();
+  auto& weightSTLContainer = this->m_FieldPointWeights->CastToSTLContainer();
+  weightSTLContainer.resize( numberOfIncludedPixels );
+
+  // The B-spline approximation algorithm works in parametric space and not
+  // physical space, so the points are placed as if the direction cosine
+  // were the identity.
   const auto confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool useMaskLabel = this->GetUseMaskLabel();
+  const typename RealImageType::PointType & origin = logInputImage->GetOrigin();
+  const typename RealImageType::SpacingType & spacing = logInputImage->GetSpacing();
+
+  this->ParallelizeChunks( numberOfIncludedPixels,
+    [&]( SizeValueType, SizeValueType begin, SizeValueType end )
+    {
+    for( SizeValueType k = begin; k < end; ++k )
+      {
+      const SizeValueType indexValue = this->m_IncludedPixels[k];
+      const typename RealImageType::IndexType index = logInputImage->ComputeIndex( indexValue );
+
+      PointType point;
+      for( unsigned int d = 0; d < ImageDimension; d++ )
+        {
+        point[d] = origin[d];
+        point[d] += spacing[d] * index[d];
+        }
+      pointSTLContainer[k] = point;
+
+      RealType confidenceWeight = 1.0;
+      if( !confidenceImageBufferRange.empty())
+        {
+        confidenceWeight = confidenceImageBufferRange[indexValue];
+        }
+      weightSTLContainer[k] = confidenceWeight;
+      }
+    } );
+}
+
+template<typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
+::SharpenImage( const RealImageType *unsharpenedImage, RealImageType *sharpenedImage ) const
+{
+  using itk::Experimental::ImageBufferRange;
+  using itk::Experimental::MakeImageBufferRange;
 
   // Build the histogram for the uncorrected image.  Store copy
   // in a vnl_vector to utilize vnl FFT routines.  Note that variables
   // in real space are denoted by a single uppercase letter whereas their
   // frequency counterparts are indicated by a trailing lowercase 'f'.
 
-  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-  RealType binMinimum = NumericTraits<RealType>::max();
-
   const auto unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-  const std::size_t numberOfPixels = unsharpenedImageBufferRange.size();
+  const std::vector< SizeValueType > & includedPixels = this->m_IncludedPixels;
+  const SizeValueType numberOfIncludedPixels = includedPixels.size();
 
-  for( std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue )
+  std::vector< RealType > binMaximumPerChunk( this->GetNumberOfWorkUnits(), NumericTraits<RealType>::NonpositiveMin() );
+  std::vector< RealType > binMinimumPerChunk( this->GetNumberOfWorkUnits(), NumericTraits<RealType>::max() );
+
+  const SizeValueType numberOfChunks = this->ParallelizeChunks( numberOfIncludedPixels,
+    [&]( SizeValueType chunk, SizeValueType begin, SizeValueType end )
     {
-    if( ( maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
+    RealType binMinimum = NumericTraits<RealType>::max();
+    for( SizeValueType k = begin; k < end; ++k )
       {
-      RealType pixel = unsharpenedImageBufferRange[indexValue];
-      if( pixel > binMaximum )
-        {
-        binMaximum = pixel;
-        }
-      else if( pixel < binMinimum )
-        {
-        binMinimum = pixel;
-        }
+      const RealType pixel = unsharpenedImageBufferRange[includedPixels[k]];
+      binMaximum = std::max( binMaximum, pixel );
+      binMinimum = std::min( binMinimum, pixel );
       }
+    binMaximumPerChunk[chunk] = binMaximum;
+    binMinimumPerChunk[chunk] = binMinimum;
+    } );
+
+  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
+  RealType binMinimum = NumericTraits<RealType>::max();
+  for( SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk )
+    {
+    binMaximum = std::max( binMaximum, binMaximumPerChunk[chunk] );
+    binMinimum = std::min( binMinimum, binMinimumPerChunk[chunk] );
     }
+
   RealType histogramSlope = ( binMaximum - binMinimum ) /
     static_cast<RealType>( this->m_NumberOfHistogramBins - 1 );
 
   // Create the intensity profile (within the masked region, if applicable)
-  // using a triangular parzen windowing scheme.
+  // using a triangular parzen windowing scheme.  Each chunk of pixels
+  // fills its own histogram, and the histograms are summed afterwards.
 
-  vnl_vector<RealType> H( this->m_NumberOfHistogramBins, 0.0 );
+  std::vector< vnl_vector<RealType> > HPerChunk( numberOfChunks,
+    vnl_vector<RealType>( this->m_NumberOfHistogramBins, 0.0 ) );
 
-  for( std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue )
+  this->ParallelizeChunks( numberOfIncludedPixels,
+    [&]( SizeValueType chunk, SizeValueType begin, SizeValueType end )
     {
-    if( ( maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    vnl_vector<RealType> & H = HPerChunk[chunk];
+    for( SizeValueType k = begin; k < end; ++k )
       {
-      RealType pixel = unsharpenedImageBufferRange[indexValue];
+      RealType pixel = unsharpenedImageBufferRange[includedPixels[k]];
 
       RealType cidx = ( static_cast<RealType>( pixel ) - binMinimum ) /
         histogramSlope;
@@ -349,6 +444,12 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
         H[idx+1] += offset;
         }
       }
+    } );
+
+  vnl_vector<RealType> H( this->m_NumberOfHistogramBins, 0.0 );
+  for( const auto & chunkH : HPerChunk )
+    {
+    H += chunkH;
     }
 
   // Determine information about the intensity histogram and zero-pad
@@ -481,25 +582,17 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
 
   E = E.extract( this->m_NumberOfHistogramBins, histogramOffset );
 
-  const InputImageType * inputImage = this->GetInput();
-
-  // Sharpen the image with the new mapping, E(u|v)
-  RealImagePointer sharpenedImage = RealImageType::New();
-  sharpenedImage->CopyInformation( inputImage );
-  sharpenedImage->SetRegions( inputImage->GetLargestPossibleRegion() );
-  sharpenedImage->Allocate( true ); // initialize buffer to zero
+  // Sharpen the image with the new mapping, E(u|v).  Only the included
+  // pixels are written: the others are never used.
 
   const ImageBufferRange<RealImageType> sharpenedImageBufferRange{ *sharpenedImage };
 
-  for( std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue )
+  this->ParallelizeChunks( numberOfIncludedPixels,
+    [&]( SizeValueType, SizeValueType begin, SizeValueType end )
     {
-    if( ( maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    for( SizeValueType k = begin; k < end; ++k )
       {
+      const SizeValueType indexValue = includedPixels[k];
       RealType     cidx = ( unsharpenedImageBufferRange[indexValue] - binMinimum ) / histogramSlope;
       unsigned int idx = itk::Math::floor( cidx );
 
@@ -515,87 +608,37 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
         }
       sharpenedImageBufferRange[indexValue] = correctedPixel;
       }
-    }
-
-  return sharpenedImage;
+    } );
 }
 
 template<typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
+void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
-::UpdateBiasFieldEstimate( RealImageType* fieldEstimate, const std::size_t numberOfIncludedPixels )
+::UpdateBiasFieldEstimate( const RealImageType * uncorrectedImage,
+                           const RealImageType * sharpenedImage,
+                           RealImageType * fieldEstimate )
 {
   using itk::Experimental::MakeImageBufferRange;
 
-  // Temporarily set the direction cosine to identity since the B-spline
-  // approximation algorithm works in parametric space and not physical
-  // space.
-  typename ScalarImageType::DirectionType identity;
-  identity.SetIdentity();
-
-  const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-  const SizeValueType numberOfPixels = bufferedRegion.GetNumberOfPixels();
-  const bool filterHandlesMemory = false;
-
-  using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-  typename ImporterType::Pointer importer = ImporterType::New();
-  importer->SetImportPointer( fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory );
-  importer->SetRegion( fieldEstimate->GetBufferedRegion() );
-  importer->SetOrigin( fieldEstimate->GetOrigin() );
-  importer->SetSpacing( fieldEstimate->GetSpacing() );
-  importer->SetDirection( identity );
-  importer->Update();
-
-  const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-  PointSetPointer fieldPoints = PointSetType::New();
-  fieldPoints->Initialize();
-  auto& pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-  pointSTLContainer.reserve(numberOfIncludedPixels);
-  auto& pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-  pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-  typename BSplineFilterType::WeightsContainerType::Pointer weights =
-    BSplineFilterType::WeightsContainerType::New();
-  weights->Initialize();
-  auto& weightSTLContainer = weights->CastToSTLContainer();
-  weightSTLContainer.reserve(numberOfIncludedPixels);
-
-  const auto maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool useMaskLabel = this->GetUseMaskLabel();
-
-  ImageRegionConstIteratorWithIndex<RealImageType>
-    It( parametricFieldEstimate, parametricFieldEstimate->GetRequestedRegion() );
+  // The residual bias field is the difference between the uncorrected and
+  // the sharpened images.  It is only needed at the included pixels, which
+  // are the points of the fit.
+  const auto uncorrectedImageBufferRange = MakeImageBufferRange(uncorrectedImage);
+  const auto sharpenedImageBufferRange = MakeImageBufferRange(sharpenedImage);
+  auto& pointDataSTLContainer = this->m_FieldPoints->GetPointData()->CastToSTLContainer();
 
-  for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
+  this->ParallelizeChunks( this->m_IncludedPixels.size(),
+    [&]( SizeValueType, SizeValueType begin, SizeValueType end )
     {
-    if( (maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    for( SizeValueType k = begin; k < end; ++k )
       {
-      PointType point;
-      parametricFieldEstimate->TransformIndexToPhysicalPoint( It.GetIndex(), point );
-
+      const SizeValueType indexValue = this->m_IncludedPixels[k];
       ScalarType scalar;
-      scalar[0] = It.Get();
-
-      pointDataSTLContainer.push_back(scalar);
-      pointSTLContainer.push_back(point);
-
-      RealType confidenceWeight = 1.0;
-      if( !confidenceImageBufferRange.empty())
-        {
-        confidenceWeight = confidenceImageBufferRange[indexValue];
-        }
-      weightSTLContainer.push_back(confidenceWeight);
+      scalar[0] = uncorrectedImageBufferRange[indexValue] - sharpenedImageBufferRange[indexValue];
+      pointDataSTLContainer[k] = scalar;
       }
-    }
+    } );
+  this->m_FieldPoints->Modified();
 
   typename BSplineFilterType::Pointer bspliner = BSplineFilterType::New();
 
@@ -616,23 +659,24 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
     }
 
   typename ScalarImageType::PointType parametricOrigin =
-    fieldEstimate->GetOrigin();
+    uncorrectedImage->GetOrigin();
   for( unsigned int d = 0; d < ImageDimension; d++ )
     {
     parametricOrigin[d] += (
-        fieldEstimate->GetSpacing()[d] *
-        fieldEstimate->GetLargestPossibleRegion().GetIndex()[d] );
+        uncorrectedImage->GetSpacing()[d] *
+        uncorrectedImage->GetLargestPossibleRegion().GetIndex()[d] );
     }
   bspliner->SetOrigin( parametricOrigin );
-  bspliner->SetSpacing( fieldEstimate->GetSpacing() );
-  bspliner->SetSize( fieldEstimate->GetLargestPossibleRegion().GetSize() );
-  bspliner->SetDirection( fieldEstimate->GetDirection() );
+  bspliner->SetSpacing( uncorrectedImage->GetSpacing() );
+  bspliner->SetSize( uncorrectedImage->GetLargestPossibleRegion().GetSize() );
+  bspliner->SetDirection( uncorrectedImage->GetDirection() );
   bspliner->SetGenerateOutputImage( false );
   bspliner->SetNumberOfLevels( numberOfFittingLevels );
   bspliner->SetSplineOrder( this->m_SplineOrder );
   bspliner->SetNumberOfControlPoints( numberOfControlPoints );
-  bspliner->SetInput( fieldPoints );
-  bspliner->SetPointWeights( weights );
+  bspliner->SetInput( this->m_FieldPoints );
+  bspliner->SetPointWeights( this->m_FieldPointWeights );
+  bspliner->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
   bspliner->Update();
 
   typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
@@ -661,17 +705,16 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
     this->m_LogBiasFieldControlPointLattice = adder->GetOutput();
     }
 
-  RealImagePointer smoothField = this->ReconstructBiasField( this->m_LogBiasFieldControlPointLattice );
-
-  return smoothField;
+  this->ReconstructBiasField( this->m_LogBiasFieldControlPointLattice, fieldEstimate );
 }
 
 template<typename TInputImage, typename TMaskImage, typename TOutputImage>
-typename
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
+void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
-::ReconstructBiasField( BiasFieldControlPointLatticeType* controlPointLattice )
+::ReconstructBiasField( BiasFieldControlPointLatticeType* controlPointLattice, RealImageType * biasField )
 {
+  using itk::Experimental::MakeImageBufferRange;
+
   const InputImageType * inputImage = this->GetInput();
 
   using BSplineReconstructerType = BSplineControlPointImageFilter
@@ -684,23 +727,23 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
   reconstructer->SetDirection( inputImage->GetDirection() );
   reconstructer->SetSplineOrder( this->m_SplineOrder );
   reconstructer->SetSize( inputImage->GetLargestPossibleRegion().GetSize() );
+  reconstructer->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
 
   typename ScalarImageType::Pointer biasFieldBsplineImage = reconstructer->GetOutput();
   biasFieldBsplineImage->Update();
 
-  using SelectorType =
-      VectorIndexSelectionCastImageFilter<ScalarImageType, RealImageType>;
-  typename SelectorType::Pointer selector = SelectorType::New();
-  selector->SetInput( biasFieldBsplineImage );
-  selector->SetIndex( 0 );
+  // Copy the single component of the reconstructed field to the bias field.
+  const auto biasFieldBsplineImageBufferRange = MakeImageBufferRange(biasFieldBsplineImage.GetPointer());
+  const auto biasFieldBufferRange = MakeImageBufferRange(biasField);
 
-  RealImagePointer biasField = selector->GetOutput();
-  biasField->Update();
-
-  biasField->DisconnectPipeline();
-  biasField->SetRegions( inputImage->GetRequestedRegion() );
-
-  return biasField;
+  this->ParallelizeChunks( biasFieldBufferRange.size(),
+    [&]( SizeValueType, SizeValueType begin, SizeValueType end )
+    {
+    for( SizeValueType indexValue = begin; indexValue < end; ++indexValue )
+      {
+      biasFieldBufferRange[indexValue] = biasFieldBsplineImageBufferRange[indexValue][0];
+      }
+    } );
 }
 
 template<typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -711,37 +754,33 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
                                    const RealImageType *fieldEstimate2 ) const
 {
   using itk::Experimental::MakeImageBufferRange;
-  using SubtracterType =
-      SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-  typename SubtracterType::Pointer subtracter = SubtracterType::New();
-  subtracter->SetInput1( fieldEstimate1 );
-  subtracter->SetInput2( fieldEstimate2 );
-  subtracter->Update();
-
-  // Calculate statistics over the mask region
-
-  RealType mu = 0.0;
-  RealType sigma = 0.0;
-  RealType N = 0.0;
 
-  const auto maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool useMaskLabel = this->GetUseMaskLabel();
+  // Calculate statistics over the mask region.  Each chunk of pixels
+  // computes its own count, mean and sum of squared deviations, which are
+  // then merged.
 
-  const auto subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
-  const std::size_t numberOfPixels = subtracterImageBufferRange.size();
+  const auto fieldEstimate1BufferRange = MakeImageBufferRange(fieldEstimate1);
+  const auto fieldEstimate2BufferRange = MakeImageBufferRange(fieldEstimate2);
+  const std::vector< SizeValueType > & includedPixels = this->m_IncludedPixels;
 
-  for( std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue )
+  struct Statistics
+  {
+    RealType N{ 0.0 };
+    RealType mu{ 0.0 };
+    RealType sigma{ 0.0 };
+  };
+  std::vector< Statistics > statisticsPerChunk( this->GetNumberOfWorkUnits() );
+
+  const SizeValueType numberOfChunks = this->ParallelizeChunks( includedPixels.size(),
+    [&]( SizeValueType chunk, SizeValueType begin, SizeValueType end )
     {
-    if( ( maskImageBufferRange.empty()
-          || ( useMaskLabel && maskImageBufferRange[indexValue] == maskLabel )
-          || ( !useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits< MaskPixelType >::ZeroValue() )
-          )
-        && ( confidenceImageBufferRange.empty() ||
-             confidenceImageBufferRange[indexValue] > 0.0 ) )
+    RealType mu = 0.0;
+    RealType sigma = 0.0;
+    RealType N = 0.0;
+    for( SizeValueType k = begin; k < end; ++k )
       {
-      RealType pixel = std::exp( subtracterImageBufferRange[indexValue] );
+      const SizeValueType indexValue = includedPixels[k];
+      RealType pixel = std::exp( fieldEstimate1BufferRange[indexValue] - fieldEstimate2BufferRange[indexValue] );
       N += 1.0;
 
       if( N > 1.0 )
@@ -750,6 +789,25 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>
         }
       mu = mu * ( 1.0 - 1.0 / N ) + pixel / N;
       }
+    statisticsPerChunk[chunk].N = N;
+    statisticsPerChunk[chunk].mu = mu;
+    statisticsPerChunk[chunk].sigma = sigma;
+    } );
+
+  RealType mu = 0.0;
+  RealType sigma = 0.0;
+  RealType N = 0.0;
+  for( SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk )
+    {
+    const Statistics & statistics = statisticsPerChunk[chunk];
+    if( statistics.N > 0.0 )
+      {
+      const RealType mergedN = N + statistics.N;
+      const RealType delta = statistics.mu - mu;
+      sigma = sigma + statistics.sigma + itk::Math::sqr( delta ) * N * statistics.N / mergedN;
+      mu = mu + delta * statistics.N / mergedN;
+      N = mergedN;
+      }
     }
   sigma = std::sqrt( sigma / ( N - 1.0 ) );
 
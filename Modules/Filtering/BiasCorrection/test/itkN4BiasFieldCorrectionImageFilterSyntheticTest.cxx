@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+// Corrects synthetic images, and checks that
+// - an image increasing in buffer order, whose minimum is the first pixel,
+//   is corrected like the same image flipped, whose minimum is the last
+//   pixel;
+// - the output does not depend on the number of work units.
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image< float, Dimension >;
+using MaskImageType = itk::Image< unsigned char, Dimension >;
+using CorrecterType = itk::N4BiasFieldCorrectionImageFilter< ImageType, MaskImageType, ImageType >;
+
+ImageType::Pointer
+Correct( const ImageType * image, unsigned int numberOfWorkUnits )
+{
+  CorrecterType::Pointer correcter = CorrecterType::New();
+  correcter->SetInput( image );
+  correcter->SetNumberOfFittingLevels( 2 );
+  CorrecterType::VariableSizeArrayType maximumNumberOfIterations( 2 );
+  maximumNumberOfIterations.Fill( 10 );
+  correcter->SetMaximumNumberOfIterations( maximumNumberOfIterations );
+  correcter->SetNumberOfWorkUnits( numberOfWorkUnits );
+  correcter->Update();
+
+  ImageType::Pointer output = correcter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+// Largest difference between the two images, relative to the value of the
+// first one. The second image is read flipped along all axes if flipped is
+// true.
+double
+MaximumRelativeDifference( const ImageType * expected, const ImageType * actual, bool flipped )
+{
+  const ImageType::SizeType size = expected->GetLargestPossibleRegion().GetSize();
+  double                    maximumDifference = 0.0;
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it( expected, expected->GetLargestPossibleRegion() );
+        !it.IsAtEnd(); ++it )
+    {
+    ImageType::IndexType index = it.GetIndex();
+    if ( flipped )
+      {
+      for ( unsigned int d = 0; d < Dimension; ++d )
+        {
+        index[d] = static_cast< ImageType::IndexValueType >( size[d] ) - 1 - index[d];
+        }
+      }
+    const double value = actual->GetPixel( index );
+    if ( !std::isfinite( value ) )
+      {
+      return itk::NumericTraits< double >::max();
+      }
+    maximumDifference = std::max( maximumDifference, std::abs( value - it.Get() ) / std::abs( it.Get() ) );
+    }
+  return maximumDifference;
+}
+
+} // end namespace
+
+int itkN4BiasFieldCorrectionImageFilterSyntheticTest( int, char *[] )
+{
+  // The intensity grows with the buffer offset, and is multiplied by a
+  // smooth bias which also grows along y
+  ImageType::SizeType size;
+  size[0] = 48;
+  size[1] = 40;
+  ImageType::Pointer increasing = ImageType::New();
+  increasing->SetRegions( size );
+  increasing->Allocate();
+  ImageType::Pointer decreasing = ImageType::New();
+  decreasing->SetRegions( size );
+  decreasing->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( increasing, increasing->GetLargestPossibleRegion() );
+        !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    const double               offset = index[0] + static_cast< double >( size[0] ) * index[1];
+    const double               bias = 1.0 + 0.5 * index[1] / static_cast< double >( size[1] );
+    const auto                 value = static_cast< float >( ( 100.0 + 0.1 * offset ) * bias );
+    it.Set( value );
+
+    ImageType::IndexType flippedIndex;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      flippedIndex[d] = static_cast< ImageType::IndexValueType >( size[d] ) - 1 - index[d];
+      }
+    decreasing->SetPixel( flippedIndex, value );
+    }
+
+  ImageType::Pointer increasingCorrected = Correct( increasing, 1 );
+  ImageType::Pointer decreasingCorrected = Correct( decreasing, 1 );
+  const double flipDifference = MaximumRelativeDifference( increasingCorrected, decreasingCorrected, true );
+  std::cout << "Largest relative difference with the flipped image: " << flipDifference << std::endl;
+  ITK_TEST_EXPECT_TRUE( flipDifference < 1e-4 );
+
+  for ( unsigned int numberOfWorkUnits : { 2u, 3u, 8u } )
+    {
+    ImageType::Pointer corrected = Correct( increasing, numberOfWorkUnits );
+    const double workUnitsDifference = MaximumRelativeDifference( increasingCorrected, corrected, false );
+    std::cout << "Largest relative difference with " << numberOfWorkUnits << " work units: "
+              << workUnitsDifference << std::endl;
+    ITK_TEST_EXPECT_TRUE( workUnitsDifference < 1e-5 );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
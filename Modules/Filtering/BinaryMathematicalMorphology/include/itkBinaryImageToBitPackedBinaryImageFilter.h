@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryImageToBitPackedBinaryImageFilter_h
+#define itkBinaryImageToBitPackedBinaryImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkBitPackedBinaryImage.h"
+
+namespace itk
+{
+/** \class BinaryImageToBitPackedBinaryImageFilter
+ * \brief Convert a binary image to a BitPackedBinaryImage.
+ *
+ * The pixels equal to the foreground value are set in the output, all
+ * the others are background.
+ *
+ * The requested region is never split along the fastest moving axis, so
+ * that the work units write to different words.
+ *
+ * \sa BitPackedBinaryImageToBinaryImageFilter
+ * \ingroup MultiThreaded
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< typename TInputImage >
+class ITK_TEMPLATE_EXPORT BinaryImageToBitPackedBinaryImageFilter:
+  public ImageToImageFilter< TInputImage, BitPackedBinaryImage< TInputImage::ImageDimension > >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BinaryImageToBitPackedBinaryImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BinaryImageToBitPackedBinaryImageFilter;
+  using Superclass = ImageToImageFilter< TInputImage, BitPackedBinaryImage< TInputImage::ImageDimension > >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BinaryImageToBitPackedBinaryImageFilter, ImageToImageFilter);
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = BitPackedBinaryImage< ImageDimension >;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+
+  /** Set/Get the value of the foreground pixels in the input. Defaults to
+   * the maximum value of the pixel type. */
+  itkSetMacro(ForegroundValue, InputPixelType);
+  itkGetConstMacro(ForegroundValue, InputPixelType);
+
+protected:
+  BinaryImageToBitPackedBinaryImageFilter();
+  ~BinaryImageToBitPackedBinaryImageFilter() override = default;
+
+  void GenerateData() override;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  InputPixelType m_ForegroundValue;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBinaryImageToBitPackedBinaryImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryImageToBitPackedBinaryImageFilter_hxx
+#define itkBinaryImageToBitPackedBinaryImageFilter_hxx
+
+#include "itkBinaryImageToBitPackedBinaryImageFilter.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+template< typename TInputImage >
+BinaryImageToBitPackedBinaryImageFilter< TInputImage >
+::BinaryImageToBitPackedBinaryImageFilter():
+  m_ForegroundValue( NumericTraits< InputPixelType >::max() )
+{
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TInputImage >
+void
+BinaryImageToBitPackedBinaryImageFilter< TInputImage >
+::GenerateData()
+{
+  this->AllocateOutputs();
+
+  // the rows must not be shared between the work units
+  this->GetMultiThreader()->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection< ImageDimension >(
+    0,
+    this->GetOutput()->GetRequestedRegion(),
+    [this]( const OutputImageRegionType & region )
+    {
+      this->DynamicThreadedGenerateData( region );
+    },
+    this );
+}
+
+template< typename TInputImage >
+void
+BinaryImageToBitPackedBinaryImageFilter< TInputImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using WordType = typename OutputImageType::WordType;
+  constexpr unsigned int BitsPerWord = OutputImageType::BitsPerWord;
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const IndexValueType start = output->GetBufferedRegion().GetIndex(0);
+
+  ImageScanlineConstIterator< InputImageType > it(input, outputRegionForThread);
+  while ( !it.IsAtEnd() )
+    {
+    WordType *    words = output->GetRow( output->ComputeRow( it.GetIndex() ) );
+    SizeValueType x = it.GetIndex()[0] - start;
+    while ( !it.IsAtEndOfLine() )
+      {
+      if ( it.Get() == m_ForegroundValue )
+        {
+        words[x / BitsPerWord] |= WordType(1) << ( x % BitsPerWord );
+        }
+      ++x;
+      ++it;
+      }
+    it.NextLine();
+    }
+}
+
+template< typename TInputImage >
+void
+BinaryImageToBitPackedBinaryImageFilter< TInputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ForegroundValue: "
+     << static_cast< typename NumericTraits< InputPixelType >::PrintType >( m_ForegroundValue ) << std::endl;
+}
+} // end namespace itk
+
+#endif
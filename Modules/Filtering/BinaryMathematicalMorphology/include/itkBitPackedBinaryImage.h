@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryImage_h
+#define itkBitPackedBinaryImage_h
+
+#include "itkImageBase.h"
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+/** \class BitPackedBinaryImage
+ * \brief Binary image storing one bit per pixel.
+ *
+ * The pixels are packed 64 to a word along the fastest moving axis, and
+ * every row along that axis starts on a new word: a row of the buffered
+ * region is an array of GetWordsPerRow() words, in which the bit \c x % 64
+ * of the word \c x / 64 is the pixel \c x of the row. The unused bits at
+ * the end of the rows are always zero.
+ *
+ * Besides pixel access, the class provides logic and morphological
+ * operations working on whole words, so 64 pixels at a time:
+ * - And(), Or(), Xor() and Not() combine the image with another one
+ *   having the same buffered region;
+ * - CountForegroundPixels() counts the set bits;
+ * - Dilate() and Erode() use a box of the given radius, decomposed in
+ *   lines along the axes. Along the rows the lines are word shifts,
+ *   along the other axes they are word wise operations between rows;
+ * - Contour() keeps the foreground pixels with a background neighbor;
+ * - FillHoles() sets the background components which do not touch the
+ *   border of the buffered region.
+ *
+ * The pixels outside the buffered region are considered as background by
+ * Dilate(), and as foreground by Erode() and Contour(), like the default
+ * behavior of BinaryErodeImageFilter.
+ *
+ * BinaryImageToBitPackedBinaryImageFilter and
+ * BitPackedBinaryImageToBinaryImageFilter convert from and to images with
+ * a foreground value.
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< unsigned int VImageDimension >
+class ITK_TEMPLATE_EXPORT BitPackedBinaryImage:
+  public ImageBase< VImageDimension >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BitPackedBinaryImage);
+
+  /** Standard class type aliases */
+  using Self = BitPackedBinaryImage;
+  using Superclass = ImageBase< VImageDimension >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedBinaryImage, ImageBase);
+
+  /** Dimension of the image. */
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** A pixel is either foreground (true) or background (false). */
+  using PixelType = bool;
+
+  /** Type of the words holding the pixels. */
+  using WordType = std::uint64_t;
+  static constexpr unsigned int BitsPerWord = 64;
+  using BufferType = std::vector< WordType >;
+
+  using IndexType = typename Superclass::IndexType;
+  using SizeType = typename Superclass::SizeType;
+  using RegionType = typename Superclass::RegionType;
+
+  /** Allocate the words of the buffered region. All the pixels are set
+   * to background, whatever the value of initialize. */
+  void Allocate(bool initialize = false) override;
+
+  /** Restore the image to its initial state and release the buffer. */
+  void Initialize() override;
+
+  /** Set all the pixels of the buffered region. */
+  void FillBuffer(bool value);
+
+  /** Get/Set a pixel of the buffered region. */
+  bool GetPixel(const IndexType & index) const;
+  void SetPixel(const IndexType & index, bool value);
+
+  /** Number of words per row, and number of rows of the buffered
+   * region. */
+  SizeValueType GetWordsPerRow() const
+  {
+    return m_WordsPerRow;
+  }
+  SizeValueType GetNumberOfRows() const
+  {
+    return m_NumberOfRows;
+  }
+
+  /** Row holding the given index of the buffered region. */
+  SizeValueType ComputeRow(const IndexType & index) const;
+
+  /** Access to the words of a row. */
+  WordType * GetRow(SizeValueType row)
+  {
+    return m_Buffer.data() + row * m_WordsPerRow;
+  }
+  const WordType * GetRow(SizeValueType row) const
+  {
+    return m_Buffer.data() + row * m_WordsPerRow;
+  }
+
+  /** Pixel wise logic operations with an image of the same buffered
+   * region. */
+  void And(const Self * other);
+  void Or(const Self * other);
+  void Xor(const Self * other);
+  void Not();
+
+  /** Number of foreground pixels in the buffered region. */
+  SizeValueType CountForegroundPixels() const;
+
+  /** Dilate or erode the buffered region with a box of the given radius. */
+  void Dilate(const SizeType & radius);
+  void Erode(const SizeType & radius);
+
+  /** Keep only the foreground pixels with a background neighbor. The
+   * neighbors are the face connected ones, or all the pixels of the
+   * 3x3x... box if fullyConnected is true. */
+  void Contour(bool fullyConnected = false);
+
+  /** Set the background pixels which are not connected to the border of
+   * the buffered region. The connectivity of the background is the face
+   * connectivity, or the 3x3x... box if fullyConnected is true. */
+  void FillHoles(bool fullyConnected = false);
+
+protected:
+  BitPackedBinaryImage() = default;
+  ~BitPackedBinaryImage() override = default;
+
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  void CheckBufferedRegion(const Self * other) const;
+
+  /** Number of rows between two neighbors along an axis. Only valid for
+   * axis > 0. */
+  SizeValueType GetRowStride(unsigned int axis) const;
+
+  /** Set the unused bits at the end of the rows to zero. */
+  void ClearPaddingBits(BufferType & buffer) const;
+
+  /** Invert the pixels in buffer. */
+  void Invert(BufferType & buffer) const;
+
+  /** Dilate the pixels in buffer by a line of the given radius along an
+   * axis. */
+  void DilateAlongAxis(BufferType & buffer, unsigned int axis, SizeValueType radius) const;
+
+  /** Propagate seed inside mask along the whole length of the rows. */
+  void PropagateAlongRows(BufferType & seed, const BufferType & mask) const;
+
+  BufferType    m_Buffer;
+  SizeValueType m_WordsPerRow{ 0 };
+  SizeValueType m_NumberOfRows{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBitPackedBinaryImage.hxx"
+#endif
+
+#endif
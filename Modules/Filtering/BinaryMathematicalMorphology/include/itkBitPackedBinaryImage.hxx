@@ -0,0 +1,588 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryImage_hxx
+#define itkBitPackedBinaryImage_hxx
+
+#include "itkBitPackedBinaryImage.h"
+#include <algorithm>
+
+namespace itk
+{
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Allocate(bool)
+{
+  const SizeType & size = this->GetBufferedRegion().GetSize();
+
+  m_WordsPerRow = ( size[0] + BitsPerWord - 1 ) / BitsPerWord;
+  m_NumberOfRows = 1;
+  for ( unsigned int d = 1; d < ImageDimension; d++ )
+    {
+    m_NumberOfRows *= size[d];
+    }
+  m_Buffer.assign(m_WordsPerRow * m_NumberOfRows, 0);
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Initialize()
+{
+  Superclass::Initialize();
+
+  m_Buffer = BufferType();
+  m_WordsPerRow = 0;
+  m_NumberOfRows = 0;
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::FillBuffer(bool value)
+{
+  std::fill(m_Buffer.begin(), m_Buffer.end(), value ? ~WordType(0) : WordType(0));
+  this->ClearPaddingBits(m_Buffer);
+}
+
+template< unsigned int VImageDimension >
+SizeValueType
+BitPackedBinaryImage< VImageDimension >
+::ComputeRow(const IndexType & index) const
+{
+  const RegionType & region = this->GetBufferedRegion();
+
+  SizeValueType row = 0;
+  for ( unsigned int d = ImageDimension - 1; d > 0; d-- )
+    {
+    row = row * region.GetSize(d) + static_cast< SizeValueType >( index[d] - region.GetIndex(d) );
+    }
+  return row;
+}
+
+template< unsigned int VImageDimension >
+bool
+BitPackedBinaryImage< VImageDimension >
+::GetPixel(const IndexType & index) const
+{
+  const auto x = static_cast< SizeValueType >( index[0] - this->GetBufferedRegion().GetIndex(0) );
+
+  return ( ( this->GetRow( this->ComputeRow(index) )[x / BitsPerWord] >> ( x % BitsPerWord ) ) & 1 ) != 0;
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::SetPixel(const IndexType & index, bool value)
+{
+  const auto x = static_cast< SizeValueType >( index[0] - this->GetBufferedRegion().GetIndex(0) );
+  const WordType bit = WordType(1) << ( x % BitsPerWord );
+  WordType &     word = this->GetRow( this->ComputeRow(index) )[x / BitsPerWord];
+
+  if ( value )
+    {
+    word |= bit;
+    }
+  else
+    {
+    word &= ~bit;
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::CheckBufferedRegion(const Self * other) const
+{
+  if ( other == nullptr )
+    {
+    itkExceptionMacro(<< "Null image");
+    }
+  if ( other->GetBufferedRegion() != this->GetBufferedRegion() )
+    {
+    itkExceptionMacro(<< "Buffered regions differ: " << this->GetBufferedRegion()
+                      << " and " << other->GetBufferedRegion());
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::And(const Self * other)
+{
+  this->CheckBufferedRegion(other);
+  for ( SizeValueType i = 0; i < m_Buffer.size(); i++ )
+    {
+    m_Buffer[i] &= other->m_Buffer[i];
+    }
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Or(const Self * other)
+{
+  this->CheckBufferedRegion(other);
+  for ( SizeValueType i = 0; i < m_Buffer.size(); i++ )
+    {
+    m_Buffer[i] |= other->m_Buffer[i];
+    }
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Xor(const Self * other)
+{
+  this->CheckBufferedRegion(other);
+  for ( SizeValueType i = 0; i < m_Buffer.size(); i++ )
+    {
+    m_Buffer[i] ^= other->m_Buffer[i];
+    }
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Not()
+{
+  this->Invert(m_Buffer);
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+SizeValueType
+BitPackedBinaryImage< VImageDimension >
+::CountForegroundPixels() const
+{
+  SizeValueType count = 0;
+
+  for ( WordType word : m_Buffer )
+    {
+    // bit count by pairs, nibbles and then bytes
+    word = word - ( ( word >> 1 ) & 0x5555555555555555ULL );
+    word = ( word & 0x3333333333333333ULL ) + ( ( word >> 2 ) & 0x3333333333333333ULL );
+    word = ( word + ( word >> 4 ) ) & 0x0f0f0f0f0f0f0f0fULL;
+    count += static_cast< SizeValueType >( ( word * 0x0101010101010101ULL ) >> 56 );
+    }
+  return count;
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Dilate(const SizeType & radius)
+{
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    this->DilateAlongAxis(m_Buffer, d, radius[d]);
+    }
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Erode(const SizeType & radius)
+{
+  // the erosion is the dilation of the background. The pixels outside
+  // the buffered region are background for the dilation, so foreground
+  // for the erosion.
+  this->Invert(m_Buffer);
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    this->DilateAlongAxis(m_Buffer, d, radius[d]);
+    }
+  this->Invert(m_Buffer);
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Contour(bool fullyConnected)
+{
+  // the contour is the foreground pixels covered by the dilation of the
+  // background
+  BufferType background = m_Buffer;
+  this->Invert(background);
+
+  BufferType dilated = background;
+  if ( fullyConnected )
+    {
+    for ( unsigned int d = 0; d < ImageDimension; d++ )
+      {
+      this->DilateAlongAxis(dilated, d, 1);
+      }
+    }
+  else
+    {
+    for ( unsigned int d = 0; d < ImageDimension; d++ )
+      {
+      BufferType line = background;
+      this->DilateAlongAxis(line, d, 1);
+      for ( SizeValueType i = 0; i < dilated.size(); i++ )
+        {
+        dilated[i] |= line[i];
+        }
+      }
+    }
+
+  for ( SizeValueType i = 0; i < m_Buffer.size(); i++ )
+    {
+    m_Buffer[i] &= dilated[i];
+    }
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::FillHoles(bool fullyConnected)
+{
+  if ( m_Buffer.empty() )
+    {
+    return;
+    }
+
+  const SizeType & size = this->GetBufferedRegion().GetSize();
+
+  BufferType mask = m_Buffer;
+  this->Invert(mask);
+
+  // the background pixels on the border are the seeds of the propagation
+  BufferType    seed(m_Buffer.size(), 0);
+  IndexType     position;
+  position.Fill(0);
+  const SizeValueType lastWord = ( size[0] - 1 ) / BitsPerWord;
+  const WordType      lastBit = WordType(1) << ( ( size[0] - 1 ) % BitsPerWord );
+  for ( SizeValueType row = 0; row < m_NumberOfRows; row++ )
+    {
+    bool onBorder = false;
+    for ( unsigned int d = 1; d < ImageDimension; d++ )
+      {
+      onBorder |= position[d] == 0 || position[d] == static_cast< IndexValueType >( size[d] - 1 );
+      }
+
+    const SizeValueType first = row * m_WordsPerRow;
+    if ( onBorder )
+      {
+      std::copy(mask.begin() + first, mask.begin() + first + m_WordsPerRow, seed.begin() + first);
+      }
+    else
+      {
+      seed[first] |= mask[first] & 1;
+      seed[first + lastWord] |= mask[first + lastWord] & lastBit;
+      }
+
+    for ( unsigned int d = 1; d < ImageDimension; d++ )
+      {
+      if ( ++position[d] < static_cast< IndexValueType >( size[d] ) )
+        {
+        break;
+        }
+      position[d] = 0;
+      }
+    }
+
+  // Propagate the seeds in the background until nothing changes. The
+  // rows are filled on their whole length at each iteration, and the
+  // propagation between the rows sweeps the other axes in both
+  // directions, so few iterations are needed for usual shapes.
+  BufferType previous;
+  do
+    {
+    previous = seed;
+    this->PropagateAlongRows(seed, mask);
+    if ( fullyConnected )
+      {
+      for ( unsigned int d = 0; d < ImageDimension; d++ )
+        {
+        this->DilateAlongAxis(seed, d, 1);
+        }
+      for ( SizeValueType i = 0; i < seed.size(); i++ )
+        {
+        seed[i] &= mask[i];
+        }
+      }
+    else
+      {
+      for ( unsigned int d = 1; d < ImageDimension; d++ )
+        {
+        const SizeValueType stride = this->GetRowStride(d) * m_WordsPerRow;
+        const SizeValueType length = size[d];
+        const SizeValueType groupSize = stride * length;
+        for ( SizeValueType group = 0; group < seed.size(); group += groupSize )
+          {
+          for ( SizeValueType k = 1; k < length; k++ )
+            {
+            const SizeValueType dst = group + k * stride;
+            for ( SizeValueType i = 0; i < stride; i++ )
+              {
+              seed[dst + i] |= seed[dst - stride + i] & mask[dst + i];
+              }
+            }
+          for ( SizeValueType k = length - 1; k-- > 0; )
+            {
+            const SizeValueType dst = group + k * stride;
+            for ( SizeValueType i = 0; i < stride; i++ )
+              {
+              seed[dst + i] |= seed[dst + stride + i] & mask[dst + i];
+              }
+            }
+          }
+        }
+      }
+    }
+  while ( seed != previous );
+
+  // everything which is not reached by the border background is
+  // foreground
+  this->Invert(seed);
+  m_Buffer.swap(seed);
+  this->Modified();
+}
+
+template< unsigned int VImageDimension >
+SizeValueType
+BitPackedBinaryImage< VImageDimension >
+::GetRowStride(unsigned int axis) const
+{
+  const SizeType & size = this->GetBufferedRegion().GetSize();
+
+  SizeValueType stride = 1;
+  for ( unsigned int d = 1; d < axis; d++ )
+    {
+    stride *= size[d];
+    }
+  return stride;
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::ClearPaddingBits(BufferType & buffer) const
+{
+  const SizeValueType used = this->GetBufferedRegion().GetSize(0) % BitsPerWord;
+
+  if ( used == 0 )
+    {
+    return;
+    }
+  const WordType mask = ( WordType(1) << used ) - 1;
+  for ( SizeValueType row = 0; row < m_NumberOfRows; row++ )
+    {
+    buffer[( row + 1 ) * m_WordsPerRow - 1] &= mask;
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::Invert(BufferType & buffer) const
+{
+  for ( WordType & word : buffer )
+    {
+    word = ~word;
+    }
+  this->ClearPaddingBits(buffer);
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::DilateAlongAxis(BufferType & buffer, unsigned int axis, SizeValueType radius) const
+{
+  if ( radius == 0 || buffer.empty() )
+    {
+    return;
+    }
+
+  // The line [-radius, radius] is built by or-ing shifted copies of the
+  // pixels, first toward the higher indices and then toward the lower
+  // ones. Each shift doubles the length covered so far, so only
+  // log2(radius) shifts are needed in each direction.
+  if ( axis == 0 )
+    {
+    const SizeValueType n = m_WordsPerRow;
+    BufferType          shifted(n);
+    for ( SizeValueType row = 0; row < m_NumberOfRows; row++ )
+      {
+      WordType * words = buffer.data() + row * n;
+
+      for ( SizeValueType covered = 0; covered < radius; )
+        {
+        const SizeValueType step = std::min(covered + 1, radius - covered);
+        const SizeValueType q = step / BitsPerWord;
+        const unsigned int  b = step % BitsPerWord;
+        for ( SizeValueType i = 0; i < n; i++ )
+          {
+          WordType v = 0;
+          if ( i >= q )
+            {
+            v = words[i - q] << b;
+            if ( b != 0 && i > q )
+              {
+              v |= words[i - q - 1] >> ( BitsPerWord - b );
+              }
+            }
+          shifted[i] = v;
+          }
+        for ( SizeValueType i = 0; i < n; i++ )
+          {
+          words[i] |= shifted[i];
+          }
+        covered += step;
+        }
+      // the unused bits must be cleared before shifting the other way
+      if ( this->GetBufferedRegion().GetSize(0) % BitsPerWord != 0 )
+        {
+        words[n - 1] &= ( WordType(1) << ( this->GetBufferedRegion().GetSize(0) % BitsPerWord ) ) - 1;
+        }
+
+      for ( SizeValueType covered = 0; covered < radius; )
+        {
+        const SizeValueType step = std::min(covered + 1, radius - covered);
+        const SizeValueType q = step / BitsPerWord;
+        const unsigned int  b = step % BitsPerWord;
+        for ( SizeValueType i = 0; i < n; i++ )
+          {
+          WordType v = 0;
+          if ( i + q < n )
+            {
+            v = words[i + q] >> b;
+            if ( b != 0 && i + q + 1 < n )
+              {
+              v |= words[i + q + 1] << ( BitsPerWord - b );
+              }
+            }
+          shifted[i] = v;
+          }
+        for ( SizeValueType i = 0; i < n; i++ )
+          {
+          words[i] |= shifted[i];
+          }
+        covered += step;
+        }
+      }
+    return;
+    }
+
+  // Along the other axes, the neighbors of a row are whole rows, and all
+  // the rows with the same coordinate along the axis are contiguous.
+  const SizeValueType stride = this->GetRowStride(axis) * m_WordsPerRow;
+  const SizeValueType length = this->GetBufferedRegion().GetSize(axis);
+  const SizeValueType groupSize = stride * length;
+  for ( SizeValueType group = 0; group < buffer.size(); group += groupSize )
+    {
+    WordType * words = buffer.data() + group;
+
+    // the destination rows are visited so that their sources are not
+    // modified yet
+    for ( SizeValueType covered = 0; covered < radius; )
+      {
+      const SizeValueType step = std::min(covered + 1, radius - covered);
+      for ( SizeValueType k = length; k-- > step; )
+        {
+        WordType *       dst = words + k * stride;
+        const WordType * src = dst - step * stride;
+        for ( SizeValueType i = 0; i < stride; i++ )
+          {
+          dst[i] |= src[i];
+          }
+        }
+      covered += step;
+      }
+    for ( SizeValueType covered = 0; covered < radius; )
+      {
+      const SizeValueType step = std::min(covered + 1, radius - covered);
+      for ( SizeValueType k = 0; k + step < length; k++ )
+        {
+        WordType *       dst = words + k * stride;
+        const WordType * src = dst + step * stride;
+        for ( SizeValueType i = 0; i < stride; i++ )
+          {
+          dst[i] |= src[i];
+          }
+        }
+      covered += step;
+      }
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::PropagateAlongRows(BufferType & seed, const BufferType & mask) const
+{
+  const SizeValueType n = m_WordsPerRow;
+
+  for ( SizeValueType row = 0; row < m_NumberOfRows; row++ )
+    {
+    WordType *       s = seed.data() + row * n;
+    const WordType * m = mask.data() + row * n;
+
+    // Occluded fill toward the higher bits: the seeds are spread in the
+    // mask by 1, 2, 4... bits, only where the mask is set on the whole
+    // shifted distance. The last bit of a word seeds the next one.
+    WordType carry = 0;
+    for ( SizeValueType i = 0; i < n; i++ )
+      {
+      WordType propagate = m[i];
+      WordType generate = ( s[i] | carry ) & propagate;
+      for ( unsigned int shift = 1; shift < BitsPerWord; shift *= 2 )
+        {
+        generate |= propagate & ( generate << shift );
+        propagate &= propagate << shift;
+        }
+      s[i] = generate;
+      carry = generate >> ( BitsPerWord - 1 );
+      }
+
+    // and toward the lower bits
+    carry = 0;
+    for ( SizeValueType i = n; i-- > 0; )
+      {
+      WordType propagate = m[i];
+      WordType generate = ( s[i] | ( carry << ( BitsPerWord - 1 ) ) ) & propagate;
+      for ( unsigned int shift = 1; shift < BitsPerWord; shift *= 2 )
+        {
+        generate |= propagate & ( generate >> shift );
+        propagate &= propagate >> shift;
+        }
+      s[i] = generate;
+      carry = generate & 1;
+      }
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+BitPackedBinaryImage< VImageDimension >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "WordsPerRow: " << m_WordsPerRow << std::endl;
+  os << indent << "NumberOfRows: " << m_NumberOfRows << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,90 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryImageToBinaryImageFilter_h
+#define itkBitPackedBinaryImageToBinaryImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkBitPackedBinaryImage.h"
+
+namespace itk
+{
+/** \class BitPackedBinaryImageToBinaryImageFilter
+ * \brief Convert a BitPackedBinaryImage to a binary image.
+ *
+ * The foreground pixels of the input are set to the foreground value in
+ * the output, and the others to the background value.
+ *
+ * \sa BinaryImageToBitPackedBinaryImageFilter
+ * \ingroup MultiThreaded
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< typename TOutputImage >
+class ITK_TEMPLATE_EXPORT BitPackedBinaryImageToBinaryImageFilter:
+  public ImageToImageFilter< BitPackedBinaryImage< TOutputImage::ImageDimension >, TOutputImage >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BitPackedBinaryImageToBinaryImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BitPackedBinaryImageToBinaryImageFilter;
+  using Superclass = ImageToImageFilter< BitPackedBinaryImage< TOutputImage::ImageDimension >, TOutputImage >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedBinaryImageToBinaryImageFilter, ImageToImageFilter);
+
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = BitPackedBinaryImage< ImageDimension >;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+
+  /** Set/Get the value of the foreground pixels in the output. Defaults
+   * to the maximum value of the pixel type. */
+  itkSetMacro(ForegroundValue, OutputPixelType);
+  itkGetConstMacro(ForegroundValue, OutputPixelType);
+
+  /** Set/Get the value of the background pixels in the output. Defaults
+   * to zero. */
+  itkSetMacro(BackgroundValue, OutputPixelType);
+  itkGetConstMacro(BackgroundValue, OutputPixelType);
+
+protected:
+  BitPackedBinaryImageToBinaryImageFilter();
+  ~BitPackedBinaryImageToBinaryImageFilter() override = default;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  OutputPixelType m_ForegroundValue;
+  OutputPixelType m_BackgroundValue;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBitPackedBinaryImageToBinaryImageFilter.hxx"
+#endif
+
+#endif
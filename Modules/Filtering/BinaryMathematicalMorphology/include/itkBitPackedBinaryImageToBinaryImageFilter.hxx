@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryImageToBinaryImageFilter_hxx
+#define itkBitPackedBinaryImageToBinaryImageFilter_hxx
+
+#include "itkBitPackedBinaryImageToBinaryImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+template< typename TOutputImage >
+BitPackedBinaryImageToBinaryImageFilter< TOutputImage >
+::BitPackedBinaryImageToBinaryImageFilter():
+  m_ForegroundValue( NumericTraits< OutputPixelType >::max() ),
+  m_BackgroundValue( NumericTraits< OutputPixelType >::ZeroValue() )
+{
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TOutputImage >
+void
+BitPackedBinaryImageToBinaryImageFilter< TOutputImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using WordType = typename InputImageType::WordType;
+  constexpr unsigned int BitsPerWord = InputImageType::BitsPerWord;
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const IndexValueType start = input->GetBufferedRegion().GetIndex(0);
+
+  ImageScanlineIterator< OutputImageType > it(output, outputRegionForThread);
+  while ( !it.IsAtEnd() )
+    {
+    const WordType * words = input->GetRow( input->ComputeRow( it.GetIndex() ) );
+    SizeValueType    x = it.GetIndex()[0] - start;
+    while ( !it.IsAtEndOfLine() )
+      {
+      const bool foreground = ( ( words[x / BitsPerWord] >> ( x % BitsPerWord ) ) & 1 ) != 0;
+      it.Set( foreground ? m_ForegroundValue : m_BackgroundValue );
+      ++x;
+      ++it;
+      }
+    it.NextLine();
+    }
+}
+
+template< typename TOutputImage >
+void
+BitPackedBinaryImageToBinaryImageFilter< TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ForegroundValue: "
+     << static_cast< typename NumericTraits< OutputPixelType >::PrintType >( m_ForegroundValue ) << std::endl;
+  os << indent << "BackgroundValue: "
+     << static_cast< typename NumericTraits< OutputPixelType >::PrintType >( m_BackgroundValue ) << std::endl;
+}
+} // end namespace itk
+
+#endif
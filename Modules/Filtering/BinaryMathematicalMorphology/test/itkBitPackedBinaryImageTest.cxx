@@ -0,0 +1,272 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkBinaryFillholeImageFilter.h"
+#include "itkBinaryImageToBitPackedBinaryImageFilter.h"
+#include "itkBitPackedBinaryImageToBinaryImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using PixelType = unsigned char;
+using ImageType = itk::Image< PixelType, Dimension >;
+using PackedImageType = itk::BitPackedBinaryImage< Dimension >;
+using PackType = itk::BinaryImageToBitPackedBinaryImageFilter< ImageType >;
+using UnpackType = itk::BitPackedBinaryImageToBinaryImageFilter< ImageType >;
+
+constexpr PixelType Foreground = 255;
+
+// random blobs, so that the morphological operations have some
+// structure to work on
+ImageType::Pointer
+MakeMask( unsigned int seed, double threshold )
+{
+  ImageType::SizeType size = {{ 131, 17, 11 }};
+  ImageType::IndexType start = {{ -5, 3, 2 }};
+  ImageType::RegionType region( start, size );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( seed );
+
+  itk::ImageRegionIterator< ImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( generator->GetVariate() < threshold ? Foreground : 0 );
+    }
+  return image;
+}
+
+PackedImageType::Pointer
+Pack( const ImageType * image )
+{
+  PackType::Pointer pack = PackType::New();
+  pack->SetInput( image );
+  pack->SetForegroundValue( Foreground );
+  pack->SetNumberOfWorkUnits( 3 );
+  pack->Update();
+  PackedImageType::Pointer packed = pack->GetOutput();
+  packed->DisconnectPipeline();
+  return packed;
+}
+
+ImageType::Pointer
+Unpack( const PackedImageType * packed )
+{
+  UnpackType::Pointer unpack = UnpackType::New();
+  unpack->SetInput( packed );
+  unpack->SetForegroundValue( Foreground );
+  unpack->Update();
+  ImageType::Pointer image = unpack->GetOutput();
+  image->DisconnectPipeline();
+  return image;
+}
+
+bool
+Same( const ImageType * expected, const PackedImageType * packed, const char * operation )
+{
+  ImageType::Pointer actual = Unpack( packed );
+  itk::ImageRegionConstIterator< ImageType > eit( expected, expected->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< ImageType > ait( actual, actual->GetBufferedRegion() );
+  for ( ; !eit.IsAtEnd(); ++eit, ++ait )
+    {
+    if ( eit.Get() != ait.Get() )
+      {
+      std::cerr << operation << " differs at " << eit.GetIndex() << ": expected "
+                << static_cast< int >( eit.Get() ) << ", got " << static_cast< int >( ait.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// foreground pixels with a background neighbor, the outside of the image
+// being foreground
+ImageType::Pointer
+ContourReference( const ImageType * image, bool fullyConnected )
+{
+  ImageType::Pointer output = ImageType::New();
+  output->SetRegions( image->GetBufferedRegion() );
+  output->Allocate();
+
+  itk::ConstantBoundaryCondition< ImageType > boundary;
+  boundary.SetConstant( Foreground );
+  ImageType::SizeType radius;
+  radius.Fill( 1 );
+  itk::ConstNeighborhoodIterator< ImageType > nit( radius, image, image->GetBufferedRegion() );
+  nit.OverrideBoundaryCondition( &boundary );
+  itk::ImageRegionIterator< ImageType > oit( output, output->GetBufferedRegion() );
+  for ( ; !nit.IsAtEnd(); ++nit, ++oit )
+    {
+    bool contour = false;
+    if ( nit.GetCenterPixel() == Foreground )
+      {
+      for ( unsigned int i = 0; i < nit.Size(); i++ )
+        {
+        unsigned int distance = 0;
+        for ( unsigned int d = 0; d < Dimension; d++ )
+          {
+          distance += std::abs( nit.GetOffset( i )[d] );
+          }
+        if ( ( fullyConnected || distance == 1 ) && nit.GetPixel( i ) != Foreground )
+          {
+          contour = true;
+          }
+        }
+      }
+    oit.Set( contour ? Foreground : 0 );
+    }
+  return output;
+}
+} // end namespace
+
+int itkBitPackedBinaryImageTest( int, char *[] )
+{
+  ImageType::Pointer mask1 = MakeMask( 42, 0.3 );
+  ImageType::Pointer mask2 = MakeMask( 7, 0.5 );
+
+  PackedImageType::Pointer packed1 = Pack( mask1 );
+  PackedImageType::Pointer packed2 = Pack( mask2 );
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( packed1, BitPackedBinaryImage, ImageBase );
+
+  bool passed = true;
+
+  // conversions and pixel access
+  ITK_TEST_EXPECT_EQUAL( packed1->GetWordsPerRow(), 3u );
+  ITK_TEST_EXPECT_EQUAL( packed1->GetNumberOfRows(), 17u * 11u );
+  passed &= Same( mask1, packed1, "Conversion" );
+
+  itk::SizeValueType count = 0;
+  itk::ImageRegionConstIterator< ImageType > it( mask1, mask1->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() == Foreground )
+      {
+      ++count;
+      }
+    if ( packed1->GetPixel( it.GetIndex() ) != ( it.Get() == Foreground ) )
+      {
+      std::cerr << "Wrong pixel at " << it.GetIndex() << std::endl;
+      passed = false;
+      }
+    }
+  ITK_TEST_EXPECT_EQUAL( packed1->CountForegroundPixels(), count );
+
+  // logic operations
+  PackedImageType::Pointer logic = Pack( mask1 );
+  logic->And( packed2 );
+  ImageType::Pointer expected = ImageType::New();
+  expected->SetRegions( mask1->GetBufferedRegion() );
+  expected->Allocate();
+  itk::ImageRegionIterator< ImageType > eit( expected, expected->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< ImageType > it2( mask2, mask2->GetBufferedRegion() );
+  for ( it.GoToBegin(), it2.GoToBegin(), eit.GoToBegin(); !eit.IsAtEnd(); ++it, ++it2, ++eit )
+    {
+    eit.Set( ( it.Get() == Foreground && it2.Get() == Foreground ) ? Foreground : 0 );
+    }
+  passed &= Same( expected, logic, "And" );
+
+  logic = Pack( mask1 );
+  logic->Xor( packed2 );
+  logic->Not();
+  logic->Or( packed1 );
+  for ( it.GoToBegin(), it2.GoToBegin(), eit.GoToBegin(); !eit.IsAtEnd(); ++it, ++it2, ++eit )
+    {
+    const bool a = it.Get() == Foreground;
+    const bool b = it2.Get() == Foreground;
+    eit.Set( ( !( a ^ b ) || a ) ? Foreground : 0 );
+    }
+  passed &= Same( expected, logic, "Xor, Not and Or" );
+
+  // regions must match
+  PackedImageType::Pointer other = PackedImageType::New();
+  ImageType::SizeType otherSize = {{ 4, 4, 4 }};
+  other->SetRegions( otherSize );
+  other->Allocate();
+  ITK_TRY_EXPECT_EXCEPTION( logic->And( other ) );
+
+  // box morphology, with radii across the word boundaries along the rows
+  using SEType = itk::FlatStructuringElement< Dimension >;
+  using DilateType = itk::BinaryDilateImageFilter< ImageType, ImageType, SEType >;
+  using ErodeType = itk::BinaryErodeImageFilter< ImageType, ImageType, SEType >;
+
+  ImageType::SizeType radii[] = { {{ 1, 1, 1 }}, {{ 3, 0, 2 }}, {{ 70, 2, 0 }} };
+  for ( const auto & radius : radii )
+    {
+    SEType kernel = SEType::Box( radius );
+
+    DilateType::Pointer dilate = DilateType::New();
+    dilate->SetInput( mask1 );
+    dilate->SetKernel( kernel );
+    dilate->SetForegroundValue( Foreground );
+    dilate->Update();
+    PackedImageType::Pointer packed = Pack( mask1 );
+    packed->Dilate( radius );
+    passed &= Same( dilate->GetOutput(), packed, "Dilate" );
+
+    ErodeType::Pointer erode = ErodeType::New();
+    erode->SetInput( mask2 );
+    erode->SetKernel( kernel );
+    erode->SetForegroundValue( Foreground );
+    erode->Update();
+    packed = Pack( mask2 );
+    packed->Erode( radius );
+    passed &= Same( erode->GetOutput(), packed, "Erode" );
+    }
+
+  // contours and holes
+  for ( bool fullyConnected : { false, true } )
+    {
+    PackedImageType::Pointer packed = Pack( mask2 );
+    packed->Contour( fullyConnected );
+    passed &= Same( ContourReference( mask2, fullyConnected ), packed, "Contour" );
+
+    using FillholeType = itk::BinaryFillholeImageFilter< ImageType >;
+    FillholeType::Pointer fillhole = FillholeType::New();
+    fillhole->SetInput( mask2 );
+    fillhole->SetForegroundValue( Foreground );
+    fillhole->SetFullyConnected( fullyConnected );
+    fillhole->Update();
+    packed = Pack( mask2 );
+    packed->FillHoles( fullyConnected );
+    passed &= Same( fillhole->GetOutput(), packed, "FillHoles" );
+    }
+
+  if ( !passed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -136,6 +136,8 @@ public:
     BaseSamplerPointer sampler;
     EigenValuesCacheType eigenValsCache;
     EigenVectorsCacheType eigenVecsCache;
+    std::vector<unsigned int> patchPositions;
+    std::vector<PixelType> patchValues;
     };
 
   /** Set/Get flag indicating whether smooth-disc patch weights should be used.
@@ -202,6 +204,15 @@ public:
 
   itkGetConstMacro(NoiseSigma, RealType);
 
+  /** Set/Get the tolerance on the kernel weights of the selected patches.
+   * A lower bound of the distance between two patches is computed from their
+   * weighted sums, and the selected patches whose kernel weight is bounded
+   * by this tolerance are skipped without computing their distance. This
+   * only applies to Euclidean pixels, and to the patches away from the
+   * image boundary. Default = 0, all the selected patches are used. */
+  itkSetClampMacro(PatchWeightTolerance, double, 0.0, 1.0);
+  itkGetConstReferenceMacro(PatchWeightTolerance, double);
+
   /** Set/Get the class used for creating a subsample of patches. */
   itkSetObjectMacro(Sampler, BaseSamplerType);
   itkGetModifiableObjectMacro(Sampler, BaseSamplerType);
@@ -412,6 +423,22 @@ protected:
                                                BaseSamplerPointer& sampler,
                                                ThreadDataStruct& threadData);
 
+  /** Whether the selected patches are read directly in the output buffer by
+   * ComputeEuclideanGradientJointEntropy(), instead of through the
+   * neighborhood iterators of the search space. Both give the same result. */
+  virtual bool CanReadPatchesInBuffer() const;
+
+  /** Compute the gradient of the joint entropy for Euclidean pixels, reading
+   * the selected patches directly in the output buffer. */
+  virtual RealType ComputeEuclideanGradientJointEntropy(const InputImagePatchIterator& currentPatch,
+                                                        InstanceIdentifier currentPatchId,
+                                                        const typename BaseSamplerType::SubsampleType* selectedPatches,
+                                                        ThreadDataStruct& threadData);
+
+  /** Compute the weighted sums of the patches of the output, used to bound
+   * the distances between patches. */
+  virtual void ComputeWeightedPatchSums();
+
   void ApplyUpdate() override;
 
   virtual void ThreadedApplyUpdate(const InputImageRegionType& regionToProcess,
@@ -528,6 +555,16 @@ private:
 
   BaseSamplerPointer                m_Sampler;
   typename ListAdaptorType::Pointer m_SearchSpaceList;
+
+  // The patches are read directly in the output buffer for Euclidean
+  // pixels, at these offsets from their center.
+  bool                         m_UseBufferPatchDistances{ false };
+  std::vector<OffsetValueType> m_PatchBufferOffsets;
+  std::vector<RealValueType>   m_SquaredPatchWeights;
+
+  double                     m_PatchWeightTolerance{ 0.0 };
+  RealValueType              m_SumOfSquaredPatchWeights{ 0.0 };
+  std::vector<RealValueType> m_WeightedPatchSums;
 };
 } // end namespace itk
 
@@ -30,6 +30,7 @@
 #include "itkVectorImageToImageAdaptor.h"
 #include "itkSpatialNeighborSubsampler.h"
 #include "itkMacro.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkMath.h"
 
 namespace itk
@@ -1406,6 +1407,31 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
     m_ThreadData[thread].sampler->SetSample(searchList);
     m_ThreadData[thread].sampler->SetSampleRegion(searchList->GetRegion() );
     }
+
+  const OutputImageType * output = this->m_OutputImage;
+  m_UseBufferPatchDistances = this->CanReadPatchesInBuffer();
+  if( m_UseBufferPatchDistances )
+    {
+    const unsigned int    lengthPatch = this->GetPatchLengthInVoxels();
+    const PatchWeightsType patchWeights = this->GetPatchWeights();
+    const typename OutputImageType::OffsetValueType *offsetTable = output->GetOffsetTable();
+
+    Neighborhood<PixelType, ImageDimension> patch;
+    patch.SetRadius(radius);
+    m_PatchBufferOffsets.resize(lengthPatch);
+    m_SquaredPatchWeights.resize(lengthPatch);
+    for( unsigned int jj = 0; jj < lengthPatch; ++jj )
+      {
+      const typename OutputImageType::OffsetType offset = patch.GetOffset(jj);
+      m_PatchBufferOffsets[jj] = 0;
+      for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        m_PatchBufferOffsets[jj] += offset[dim] * offsetTable[dim];
+        }
+      const RealValueType patchWeight = patchWeights[jj];
+      m_SquaredPatchWeights[jj] = patchWeight * patchWeight;
+      }
+    }
 }
 
 template<typename TInputImage, typename TOutputImage>
@@ -1987,11 +2013,28 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   return sigmaUpdate;
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::CanReadPatchesInBuffer() const
+{
+  // The patches can be read directly in the output buffer when the instance
+  // identifiers of the samples are offsets in this buffer.
+  return this->GetComponentSpace() == Superclass::EUCLIDEAN
+    && std::is_same<PixelType, typename OutputImageType::InternalPixelType>::value
+    && m_SearchSpaceList->GetRegion() == this->m_OutputImage->GetBufferedRegion();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
 ::ComputeImageUpdate()
 {
+  if( m_UseBufferPatchDistances && m_PatchWeightTolerance > 0.0 )
+    {
+    this->ComputeWeightedPatchSums();
+    }
+
   // Set up for multithreaded processing.
   ThreadFilterStruct str;
 
@@ -2007,6 +2050,55 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   this->GetMultiThreader()->SingleMethodExecute();
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::ComputeWeightedPatchSums()
+{
+  // The sums of the squared patch weights times each component of the
+  // pixels, for the patches entirely inside the image. By the Cauchy-Schwarz
+  // inequality, the squared difference of the sums of a component for two
+  // patches divided by the sum of the squared patch weights is a lower bound
+  // of the weighted squared norm of this component of their difference.
+  const OutputImageType * output = this->m_OutputImage;
+  const PixelType *       buffer = output->GetBufferPointer();
+  const unsigned int      lengthPatch = this->GetPatchLengthInVoxels();
+
+  m_SumOfSquaredPatchWeights = 0.0;
+  for( unsigned int jj = 0; jj < lengthPatch; ++jj )
+    {
+    m_SumOfSquaredPatchWeights += m_SquaredPatchWeights[jj];
+    }
+
+  const unsigned int      numberOfComponents = m_NumPixelComponents;
+  m_WeightedPatchSums.resize( output->GetBufferedRegion().GetNumberOfPixels() * numberOfComponents );
+
+  InputImageRegionType interiorRegion = output->GetBufferedRegion();
+  interiorRegion.ShrinkByRadius( this->GetPatchRadiusInVoxels() );
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    interiorRegion,
+    [&]( const InputImageRegionType & region )
+      {
+      ImageRegionConstIteratorWithIndex<OutputImageType> it( output, region );
+      for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+        {
+        const OffsetValueType center = output->ComputeOffset( it.GetIndex() );
+        for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+          {
+          RealValueType sum = 0.0;
+          for( unsigned int jj = 0; jj < lengthPatch; ++jj )
+            {
+            sum += m_SquaredPatchWeights[jj] *
+              this->GetComponent( buffer[center + m_PatchBufferOffsets[jj]], pc );
+            }
+          m_WeightedPatchSums[center * numberOfComponents + pc] = sum;
+          }
+        }
+      },
+    nullptr );
+}
+
 template <typename TInputImage, typename TOutputImage>
 ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
@@ -2269,6 +2361,12 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   sampler->CanSelectQueryOn();
   sampler->Search(currentPatchId, selectedPatches);
 
+  if( m_UseBufferPatchDistances )
+    {
+    return this->ComputeEuclideanGradientJointEntropy(currentPatch, currentPatchId,
+                                                      selectedPatches, threadData);
+    }
+
   const unsigned int numPatches = selectedPatches->GetTotalFrequency();
 
   RealType                             centerPatchDifference = m_ZeroPixel;
@@ -2470,6 +2568,143 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   return gradientJointEntropy;
 }
 
+template <typename TInputImage, typename TOutputImage>
+typename PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::RealType
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::ComputeEuclideanGradientJointEntropy(const InputImagePatchIterator& currentPatch,
+                                       InstanceIdentifier currentPatchId,
+                                       const typename BaseSamplerType::SubsampleType* selectedPatches,
+                                       ThreadDataStruct& threadData)
+{
+  const unsigned int lengthPatch = this->GetPatchLengthInVoxels();
+  const unsigned int center = (lengthPatch - 1) / 2;
+
+  const PixelType * buffer = this->m_OutputImage->GetBufferPointer();
+
+  // Store the current patch, and the positions compared in the order in
+  // which ComputeGradientJointEntropy() sums them: the pairs of positions
+  // symmetric about the center, then the center. The positions outside the
+  // image are ignored, and the selected patches are at least as in bounds
+  // as the current patch.
+  std::vector<unsigned int> & positions = threadData.patchPositions;
+  std::vector<PixelType> &    currentPatchVec = threadData.patchValues;
+  positions.clear();
+  currentPatchVec.resize(lengthPatch);
+  for( unsigned int jj = 0, kk = center+1; jj < center; ++jj, ++kk )
+    {
+    for( const unsigned int position : { jj, kk } )
+      {
+      bool isInBounds;
+      currentPatchVec[position] = currentPatch.GetPixel(position, isInBounds);
+      if( isInBounds )
+        {
+        positions.push_back(position);
+        }
+      }
+    }
+  currentPatchVec[center] = currentPatch.GetPixel(center);
+
+  // The selected patches whose kernel weight is bounded by the tolerance
+  // are skipped. The bound only holds for whole patches.
+  const bool           usePatchWeightBound = m_PatchWeightTolerance > 0.0 && currentPatch.InBounds();
+  const RealValueType *currentWeightedPatchSums = nullptr;
+  RealArrayType        boundFactors(m_NumIndependentComponents);
+  RealValueType        boundThreshold = 0.0;
+  if( usePatchWeightBound )
+    {
+    currentWeightedPatchSums = &m_WeightedPatchSums[currentPatchId * m_NumPixelComponents];
+    for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+      {
+      boundFactors[ic] = 1.0 / ( m_SumOfSquaredPatchWeights * itk::Math::sqr(m_KernelBandwidthSigma[ic]) );
+      }
+    boundThreshold = -2.0 * std::log(m_PatchWeightTolerance);
+    }
+
+  RealValueType sumOfGaussiansJointEntropy = 0.0;
+
+  RealType gradientJointEntropy = m_ZeroPixel;
+  RealType centerPatchDifference = m_ZeroPixel;
+
+  RealArrayType squaredNorm(m_NumIndependentComponents);
+
+  for( const InstanceIdentifier selectedPatchId : selectedPatches->GetIdHolder() )
+    {
+    if( usePatchWeightBound )
+      {
+      // The kernel weight of the patch is the sum of the Gaussians of the
+      // distances accumulated over the components below, so it is bounded
+      // with the sums of the lower bounds of the components. The largest
+      // Gaussian, of the first component alone, is checked first.
+      const RealValueType *selectedWeightedPatchSums = &m_WeightedPatchSums[selectedPatchId * m_NumPixelComponents];
+      RealValueType        distanceBound = 0.0;
+      RealValueType        kernelWeightBound = 0.0;
+      for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+        {
+        const RealValueType sumDifference = selectedWeightedPatchSums[ic] - currentWeightedPatchSums[ic];
+        distanceBound += sumDifference * sumDifference * boundFactors[ic];
+        if( distanceBound <= boundThreshold )
+          {
+          break;
+          }
+        kernelWeightBound += std::exp( -distanceBound / 2.0 );
+        }
+      if( distanceBound > boundThreshold && kernelWeightBound < m_PatchWeightTolerance )
+        {
+        continue;
+        }
+      }
+    const PixelType * selectedPatch = buffer + selectedPatchId;
+
+    RealValueType distanceJointEntropy = 0.0;
+
+    squaredNorm.Fill(0.0);
+    for( const unsigned int position : positions )
+      {
+      const PixelType &   a = currentPatchVec[position];
+      const PixelType &   b = selectedPatch[m_PatchBufferOffsets[position]];
+      const RealValueType squaredWeight = m_SquaredPatchWeights[position];
+      for( unsigned int pc = 0; pc < m_NumPixelComponents; ++pc )
+        {
+        const RealValueType diff = this->GetComponent(b, pc) - this->GetComponent(a, pc);
+        squaredNorm[pc] += squaredWeight * diff * diff;
+        }
+      }
+    // Now compute the center value
+    for( unsigned int pc = 0; pc < m_NumPixelComponents; ++pc )
+      {
+      const RealValueType diff = this->GetComponent(selectedPatch[0], pc) -
+        this->GetComponent(currentPatchVec[center], pc);
+      this->SetComponent(centerPatchDifference, pc, diff);
+      squaredNorm[pc] += m_SquaredPatchWeights[center] * diff * diff;
+      }
+
+    RealValueType gaussianJointEntropy = NumericTraits<RealValueType>::ZeroValue();
+    for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+      {
+      RealValueType kernelSigma = m_KernelBandwidthSigma[ic];
+
+      distanceJointEntropy += squaredNorm[ic] / itk::Math::sqr(kernelSigma);
+
+      gaussianJointEntropy = exp( -distanceJointEntropy / 2.0);
+      sumOfGaussiansJointEntropy += gaussianJointEntropy;
+      }
+    for( unsigned int pc = 0; pc < m_NumPixelComponents; ++pc )
+      {
+      this->SetComponent(gradientJointEntropy, pc,
+                   GetComponent(gradientJointEntropy, pc) + GetComponent(centerPatchDifference,
+                                                                         pc) * gaussianJointEntropy);
+      }
+    } // end for each selected patch
+
+  for( unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+    {
+    this->SetComponent(gradientJointEntropy, pc,
+                 GetComponent(gradientJointEntropy, pc) / (sumOfGaussiansJointEntropy + m_MinProbability) );
+    }
+
+  return gradientJointEntropy;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
@@ -2570,6 +2805,8 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
     os << indent << "NoiseSigmaIsSet: Off" << std::endl;
     }
 
+  os << indent << "PatchWeightTolerance: " << m_PatchWeightTolerance << std::endl;
+
   itkPrintSelfObjectMacro( Sampler );
   itkPrintSelfObjectMacro( UpdateBuffer );
 }
@@ -0,0 +1,218 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkPatchBasedDenoisingImageFilter.h"
+#include "itkUniformRandomSpatialNeighborSubsampler.h"
+#include "itkVector.h"
+#include "itkTestingMacros.h"
+
+
+// Denoise a noisy checkerboard with the patches read in the buffer and
+// through the neighborhood iterators, and check that both results are
+// identical. Then skip the patches whose kernel weight is bounded by a
+// tolerance, and check that the results agree.
+namespace
+{
+
+// The filter which always reads the patches through the neighborhood
+// iterators
+template< typename ImageT >
+class IteratorPatchesDenoisingImageFilter:
+  public itk::PatchBasedDenoisingImageFilter< ImageT, ImageT >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(IteratorPatchesDenoisingImageFilter);
+
+  using Self = IteratorPatchesDenoisingImageFilter;
+  using Superclass = itk::PatchBasedDenoisingImageFilter< ImageT, ImageT >;
+  using Pointer = itk::SmartPointer< Self >;
+
+  itkNewMacro(Self);
+
+protected:
+  IteratorPatchesDenoisingImageFilter() = default;
+
+  bool CanReadPatchesInBuffer() const override
+  {
+    return false;
+  }
+};
+
+template< typename FilterType, typename ImageT >
+int doDenoising( const ImageT * noisyImage, double patchWeightTolerance,
+                 typename ImageT::Pointer & denoisedImage )
+{
+  using SamplerType = itk::Statistics::UniformRandomSpatialNeighborSubsampler<
+    typename FilterType::PatchSampleType, typename ImageT::RegionType >;
+  typename SamplerType::Pointer sampler = SamplerType::New();
+  sampler->SetRadius( 10 );
+  sampler->SetNumberOfResultsRequested( 200 );
+  sampler->CanSelectQueryOff();
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( noisyImage );
+  filter->SetPatchRadius( 2 );
+  filter->SetNumberOfIterations( 2 );
+  filter->SetNoiseModel( FilterType::GAUSSIAN );
+  filter->SetNoiseModelFidelityWeight( 0.1 );
+  filter->SetSampler( sampler );
+  filter->SetPatchWeightTolerance( patchWeightTolerance );
+  ITK_TEST_SET_GET_VALUE( patchWeightTolerance, filter->GetPatchWeightTolerance() );
+
+  // Use 2 threads for consistency
+  filter->SetNumberOfWorkUnits( 2 );
+
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  denoisedImage = filter->GetOutput();
+  return EXIT_SUCCESS;
+}
+
+double PixelDifference( float a, float b )
+{
+  return std::abs( static_cast< double >( a ) - b );
+}
+
+template< unsigned int VLength >
+double PixelDifference( const itk::Vector< float, VLength > & a, const itk::Vector< float, VLength > & b )
+{
+  double difference = 0.0;
+  for( unsigned int c = 0; c < VLength; ++c )
+    {
+    difference = std::max( difference, PixelDifference( a[c], b[c] ) );
+    }
+  return difference;
+}
+
+template< typename ImageT >
+double MaximumDifference( const ImageT * expected, const ImageT * actual )
+{
+  double maximumDifference = 0.0;
+  itk::ImageRegionConstIterator< ImageT > expectedIt( expected, expected->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageT > actualIt( actual, actual->GetLargestPossibleRegion() );
+  for( ; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt )
+    {
+    maximumDifference = std::max( maximumDifference, PixelDifference( expectedIt.Get(), actualIt.Get() ) );
+    }
+  return maximumDifference;
+}
+
+void SetCheckerboardPixel( float & pixel, bool odd, itk::Statistics::MersenneTwisterRandomVariateGenerator * generator )
+{
+  pixel = ( odd ? 200.0f : 50.0f ) + generator->GetNormalVariate( 0.0, 100.0 );
+}
+
+template< unsigned int VLength >
+void SetCheckerboardPixel( itk::Vector< float, VLength > & pixel, bool odd,
+                           itk::Statistics::MersenneTwisterRandomVariateGenerator * generator )
+{
+  for( unsigned int c = 0; c < VLength; ++c )
+    {
+    SetCheckerboardPixel( pixel[c], ( c % 2 ) != odd, generator );
+    }
+}
+
+template< typename ImageT >
+int doTest( unsigned int size )
+{
+  constexpr unsigned int Dimension = ImageT::ImageDimension;
+
+  typename ImageT::Pointer noisyImage = ImageT::New();
+  typename ImageT::SizeType imageSize;
+  imageSize.Fill( size );
+  noisyImage->SetRegions( imageSize );
+  noisyImage->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 321 );
+
+  itk::ImageRegionIteratorWithIndex< ImageT > it( noisyImage, noisyImage->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    unsigned int square = 0;
+    for( unsigned int d = 0; d < Dimension; ++d )
+      {
+      square += it.GetIndex()[d] / 6;
+      }
+    typename ImageT::PixelType pixel;
+    SetCheckerboardPixel( pixel, square % 2, generator );
+    it.Set( pixel );
+    }
+
+  using FilterType = itk::PatchBasedDenoisingImageFilter< ImageT, ImageT >;
+  using IteratorFilterType = IteratorPatchesDenoisingImageFilter< ImageT >;
+
+  typename ImageT::Pointer reference;
+  typename ImageT::Pointer iterated;
+  typename ImageT::Pointer pruned;
+  if( doDenoising< FilterType >( noisyImage.GetPointer(), 0.0, reference ) == EXIT_FAILURE ||
+      doDenoising< IteratorFilterType >( noisyImage.GetPointer(), 0.0, iterated ) == EXIT_FAILURE ||
+      doDenoising< FilterType >( noisyImage.GetPointer(), 1e-6, pruned ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The distances are summed in the same order in the buffer and through
+  // the iterators
+  const double iteratorDifference = MaximumDifference< ImageT >( reference, iterated );
+  if( iteratorDifference != 0.0 )
+    {
+    std::cerr << "Test failed in dimension " << Dimension << "!" << std::endl;
+    std::cerr << "Maximum difference with the patches read through the iterators: "
+              << iteratorDifference << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The skipped patches have a weight below the tolerance: the results only
+  // differ by rounding errors.
+  const double prunedDifference = MaximumDifference< ImageT >( reference, pruned );
+  if( prunedDifference > 0.01 )
+    {
+    std::cerr << "Test failed in dimension " << Dimension << "!" << std::endl;
+    std::cerr << "Maximum difference with the skipped patches: " << prunedDifference << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+int itkPatchBasedDenoisingImageFilterPatchWeightToleranceTest( int, char * [] )
+{
+  int testStatus = EXIT_SUCCESS;
+
+  if( doTest< itk::Image< float, 2 > >( 48 ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+  if( doTest< itk::Image< float, 3 > >( 20 ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+  if( doTest< itk::Image< itk::Vector< float, 2 >, 2 > >( 48 ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
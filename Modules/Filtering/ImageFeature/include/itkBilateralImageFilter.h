@@ -168,6 +168,30 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  /** Use a bilateral grid to approximate the filter. The pixels are
+   * accumulated in a downsampled space-intensity grid, which is blurred
+   * with the domain and range gaussians and interpolated at the input
+   * pixels (Paris and Durand, A Fast Approximation of the Bilateral
+   * Filter using a Signal Processing Approach. ECCV. 2006.). The cost no
+   * longer depends on the size of the domain kernel, and the kernel
+   * radius is not used. The sigmas must be positive, and an exception is
+   * thrown when the grid would be much larger than the image. Default is
+   * off. */
+  itkBooleanMacro(UseBilateralGrid);
+  itkGetConstMacro(UseBilateralGrid, bool);
+  itkSetMacro(UseBilateralGrid, bool);
+
+  /** Set/Get the size of the cells of the bilateral grid in the image
+   * domain, as a fraction of the DomainSigma. Cells are at least one pixel
+   * wide. Default is 0.5. */
+  itkSetClampMacro(GridDomainSampling, double, NumericTraits< double >::min(), NumericTraits< double >::max());
+  itkGetConstMacro(GridDomainSampling, double);
+
+  /** Set/Get the size of the cells of the bilateral grid in the image
+   * range, as a fraction of the RangeSigma. Default is 0.5. */
+  itkSetClampMacro(GridRangeSampling, double, NumericTraits< double >::min(), NumericTraits< double >::max());
+  itkGetConstMacro(GridRangeSampling, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputHasNumericTraitsCheck,
@@ -185,6 +209,10 @@ protected:
   /** PrintSelf. */
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Run the bilateral grid approximation when it is enabled, and the
+   * multi-threaded filter otherwise. */
+  void GenerateData() override;
+
   /** Do some setup before the ThreadedGenerateData */
   void BeforeThreadedGenerateData() override;
 
@@ -200,6 +228,10 @@ protected:
    * \sa ImageToImageFilter::GenerateInputRequestedRegion() */
   void GenerateInputRequestedRegion() override;
 
+  /** Splat the input in a bilateral grid, blur the grid and interpolate it
+   * at the pixels of the output requested region. */
+  void GenerateDataWithBilateralGrid();
+
 private:
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
@@ -227,6 +259,11 @@ private:
   double                m_DynamicRange;
   double                m_DynamicRangeUsed;
   std::vector< double > m_RangeGaussianTable;
+
+  /** Parameters of the bilateral grid approximation */
+  bool   m_UseBilateralGrid{ false };
+  double m_GridDomainSampling{ 0.5 };
+  double m_GridRangeSampling{ 0.5 };
 };
 } // end namespace itk
 
@@ -25,6 +25,8 @@
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include <mutex>
 
 namespace itk
 {
@@ -335,6 +337,313 @@ BilateralImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::GenerateData()
+{
+  if ( !m_UseBilateralGrid )
+    {
+    Superclass::GenerateData();
+    return;
+    }
+
+  this->AllocateOutputs();
+  this->GenerateDataWithBilateralGrid();
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::GenerateDataWithBilateralGrid()
+{
+  // The axis 0 of the grid is the range, the following ones are the axes
+  // of the image.  Each cell holds the sum of the pixel values and the
+  // number of pixels, which are blurred and interpolated together.
+  constexpr unsigned int GridDimension = ImageDimension + 1;
+  using GridOffsetType = OffsetValueType;
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  const typename InputImageType::RegionType  inputRegion = input->GetRequestedRegion();
+  const typename InputImageType::IndexType   inputIndex = inputRegion.GetIndex();
+  const typename InputImageType::SizeType    inputSize = inputRegion.GetSize();
+  const typename InputImageType::SpacingType inputSpacing = input->GetSpacing();
+  const OutputImageRegionType                outputRegion = output->GetRequestedRegion();
+
+  // The size of the cells and the gaussians of the grid are proportional to
+  // the sigmas
+  if ( !( m_RangeSigma > 0.0 ) )
+    {
+    itkExceptionMacro( << "RangeSigma must be positive with the bilateral grid, and is " << m_RangeSigma );
+    }
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    if ( !( m_DomainSigma[d] > 0.0 ) )
+      {
+      itkExceptionMacro( << "DomainSigma must be positive with the bilateral grid, and is " << m_DomainSigma );
+      }
+    }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+
+  // Determine the intensity range of the input
+  double     minimum = NumericTraits< double >::max();
+  double     maximum = NumericTraits< double >::NonpositiveMin();
+  std::mutex mutex;
+  multiThreader->template ParallelizeImageRegion< ImageDimension >( inputRegion,
+    [&]( const OutputImageRegionType & region )
+    {
+    double localMinimum = NumericTraits< double >::max();
+    double localMaximum = NumericTraits< double >::NonpositiveMin();
+    for ( ImageRegionConstIterator< InputImageType > it( input, region ); !it.IsAtEnd(); ++it )
+      {
+      const auto value = static_cast< double >( it.Get() );
+      localMinimum = std::min( localMinimum, value );
+      localMaximum = std::max( localMaximum, value );
+      }
+    std::lock_guard< std::mutex > lock( mutex );
+    minimum = std::min( minimum, localMinimum );
+    maximum = std::max( maximum, localMaximum );
+    }, nullptr );
+  m_DynamicRange = maximum - minimum;
+  m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
+
+  // Size of the cells, in pixels or intensity, and standard deviation and
+  // cut-off of the gaussians, in cells
+  double cellSize[GridDimension];
+  double gridSigma[GridDimension];
+  double gridMu[GridDimension];
+  cellSize[0] = m_GridRangeSampling * m_RangeSigma;
+  gridSigma[0] = m_RangeSigma / cellSize[0];
+  gridMu[0] = m_RangeMu;
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    const double sigmaInPixels = m_DomainSigma[d] / inputSpacing[d];
+    cellSize[d + 1] = std::max( 1.0, m_GridDomainSampling * sigmaInPixels );
+    gridSigma[d + 1] = sigmaInPixels / cellSize[d + 1];
+    gridMu[d + 1] = m_DomainMu;
+    }
+
+  // One more cell than the coordinates of the pixels need, so that the
+  // interpolation never reads outside the grid. A grid much larger than
+  // the image, when the dynamic range is large compared to RangeSigma, is
+  // rejected before its size overflows or exhausts the memory.
+  double gridSizeInCells[GridDimension];
+  gridSizeInCells[0] = std::floor( m_DynamicRange / cellSize[0] ) + 2.0;
+  double numberOfCellsInGrid = gridSizeInCells[0];
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    gridSizeInCells[d + 1] = std::floor( ( inputSize[d] - 1 ) / cellSize[d + 1] ) + 2.0;
+    numberOfCellsInGrid *= gridSizeInCells[d + 1];
+    }
+  const double maximumNumberOfCells =
+    std::max( 8.0 * static_cast< double >( inputRegion.GetNumberOfPixels() ), static_cast< double >( 1 << 24 ) );
+  if ( !( numberOfCellsInGrid <= maximumNumberOfCells ) )
+    {
+    itkExceptionMacro( << "The bilateral grid would have " << numberOfCellsInGrid
+                       << " cells for a dynamic range of " << m_DynamicRange
+                       << ": increase RangeSigma or GridRangeSampling, or turn UseBilateralGrid off" );
+    }
+
+  SizeValueType  gridSize[GridDimension];
+  GridOffsetType gridStride[GridDimension];
+  for ( unsigned int a = 0; a < GridDimension; a++ )
+    {
+    gridSize[a] = static_cast< SizeValueType >( gridSizeInCells[a] );
+    }
+  gridStride[0] = 1;
+  for ( unsigned int a = 1; a < GridDimension; a++ )
+    {
+    gridStride[a] = gridStride[a - 1] * gridSize[a - 1];
+    }
+  const SizeValueType numberOfCells = gridStride[GridDimension - 1] * gridSize[GridDimension - 1];
+
+  // Coordinates of the pixels in the grid, along each axis of the image:
+  // the nearest cell for the splatting, and the lower cell and the
+  // fractional part for the interpolation
+  std::vector< GridOffsetType > nearestCellOffset[ImageDimension];
+  std::vector< GridOffsetType > lowerCellOffset[ImageDimension];
+  std::vector< double >         cellFraction[ImageDimension];
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    nearestCellOffset[d].resize( inputSize[d] );
+    lowerCellOffset[d].resize( inputSize[d] );
+    cellFraction[d].resize( inputSize[d] );
+    for ( SizeValueType i = 0; i < inputSize[d]; i++ )
+      {
+      const double coordinate = i / cellSize[d + 1];
+      const auto   lower = Math::Floor< GridOffsetType >( coordinate );
+      nearestCellOffset[d][i] = Math::Floor< GridOffsetType >( coordinate + 0.5 ) * gridStride[d + 1];
+      lowerCellOffset[d][i] = lower * gridStride[d + 1];
+      cellFraction[d][i] = coordinate - lower;
+      }
+    }
+
+  std::vector< double > grid( 2 * numberOfCells, 0.0 );
+
+  // Splat the pixels in their nearest cell.  Each slice of the grid along
+  // its last axis is filled by a single work unit, from the slices of the
+  // image which are nearest to it.
+  constexpr unsigned int        SplitDimension = ImageDimension - 1;
+  std::vector< IndexValueType > sliceStart( gridSize[GridDimension - 1] + 1, inputSize[SplitDimension] );
+  for ( SizeValueType i = inputSize[SplitDimension]; i-- > 0; )
+    {
+    sliceStart[nearestCellOffset[SplitDimension][i] / gridStride[GridDimension - 1]] = i;
+    }
+  for ( SizeValueType s = gridSize[GridDimension - 1]; s-- > 0; )
+    {
+    sliceStart[s] = std::min( sliceStart[s], sliceStart[s + 1] );
+    }
+
+  multiThreader->ParallelizeArray( 0, gridSize[GridDimension - 1],
+    [&]( SizeValueType s )
+    {
+    if ( sliceStart[s] == sliceStart[s + 1] )
+      {
+      return;
+      }
+    typename InputImageType::RegionType region = inputRegion;
+    region.SetIndex( SplitDimension, inputIndex[SplitDimension] + sliceStart[s] );
+    region.SetSize( SplitDimension, sliceStart[s + 1] - sliceStart[s] );
+
+    ImageScanlineConstIterator< InputImageType > it( input, region );
+    while ( !it.IsAtEnd() )
+      {
+      const typename InputImageType::IndexType index = it.GetIndex();
+      GridOffsetType lineOffset = 0;
+      for ( unsigned int d = 1; d < ImageDimension; d++ )
+        {
+        lineOffset += nearestCellOffset[d][index[d] - inputIndex[d]];
+        }
+      for ( IndexValueType x = index[0] - inputIndex[0]; !it.IsAtEndOfLine(); ++it, ++x )
+        {
+        const auto           value = static_cast< double >( it.Get() );
+        const GridOffsetType cell = lineOffset + nearestCellOffset[0][x]
+                                    + Math::Floor< GridOffsetType >( ( value - minimum ) / cellSize[0] + 0.5 );
+        grid[2 * cell] += value;
+        grid[2 * cell + 1] += 1.0;
+        }
+      it.NextLine();
+      }
+    }, nullptr );
+
+  // Blur the grid with separable gaussians, treating the outside of the
+  // grid as empty
+  for ( unsigned int a = 0; a < GridDimension; a++ )
+    {
+    const auto radius = Math::Ceil< IndexValueType >( gridMu[a] * gridSigma[a] );
+    if ( radius == 0 )
+      {
+      continue;
+      }
+    std::vector< double > kernel( 2 * radius + 1 );
+    for ( IndexValueType j = -radius; j <= radius; j++ )
+      {
+      kernel[j + radius] = std::exp( -0.5 * j * j / ( gridSigma[a] * gridSigma[a] ) );
+      }
+
+    const auto           length = static_cast< IndexValueType >( gridSize[a] );
+    const GridOffsetType stride = gridStride[a];
+    const SizeValueType  numberOfLines = numberOfCells / gridSize[a];
+    const SizeValueType  numberOfChunks = std::min( numberOfLines, static_cast< SizeValueType >( this->GetNumberOfWorkUnits() ) );
+
+    multiThreader->ParallelizeArray( 0, numberOfChunks,
+      [&]( SizeValueType chunk )
+      {
+      std::vector< double > line( 2 * length );
+      for ( SizeValueType l = numberOfLines * chunk / numberOfChunks;
+            l < numberOfLines * ( chunk + 1 ) / numberOfChunks; l++ )
+        {
+        const GridOffsetType start = static_cast< GridOffsetType >( l % stride )
+                                     + static_cast< GridOffsetType >( l / stride ) * stride * length;
+        for ( IndexValueType i = 0; i < length; i++ )
+          {
+          line[2 * i] = grid[2 * ( start + i * stride )];
+          line[2 * i + 1] = grid[2 * ( start + i * stride ) + 1];
+          }
+        for ( IndexValueType i = 0; i < length; i++ )
+          {
+          double value = 0.0;
+          double weight = 0.0;
+          for ( IndexValueType j = std::max( -radius, -i ); j <= std::min( radius, length - 1 - i ); j++ )
+            {
+            value += kernel[j + radius] * line[2 * ( i + j )];
+            weight += kernel[j + radius] * line[2 * ( i + j ) + 1];
+            }
+          grid[2 * ( start + i * stride )] = value;
+          grid[2 * ( start + i * stride ) + 1] = weight;
+          }
+        }
+      }, nullptr );
+    }
+
+  // Interpolate the grid at the output pixels
+  const unsigned int numberOfCorners = 1 << GridDimension;
+  std::vector< GridOffsetType > cornerOffset( numberOfCorners, 0 );
+  for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
+    {
+    for ( unsigned int a = 0; a < GridDimension; a++ )
+      {
+      if ( corner & ( 1 << a ) )
+        {
+        cornerOffset[corner] += gridStride[a];
+        }
+      }
+    }
+
+  multiThreader->template ParallelizeImageRegion< ImageDimension >( outputRegion,
+    [&]( const OutputImageRegionType & region )
+    {
+    ImageScanlineConstIterator< InputImageType > it( input, region );
+    ImageScanlineIterator< OutputImageType >     ot( output, region );
+    GridOffsetType                               lower[GridDimension];
+    double                                       fraction[GridDimension];
+    while ( !it.IsAtEnd() )
+      {
+      const typename InputImageType::IndexType index = it.GetIndex();
+      for ( unsigned int d = 1; d < ImageDimension; d++ )
+        {
+        lower[d + 1] = lowerCellOffset[d][index[d] - inputIndex[d]];
+        fraction[d + 1] = cellFraction[d][index[d] - inputIndex[d]];
+        }
+      for ( IndexValueType x = index[0] - inputIndex[0]; !it.IsAtEndOfLine(); ++it, ++ot, ++x )
+        {
+        const auto   pixel = static_cast< double >( it.Get() );
+        const double coordinate = ( pixel - minimum ) / cellSize[0];
+        lower[0] = Math::Floor< GridOffsetType >( coordinate );
+        fraction[0] = coordinate - lower[0];
+        lower[1] = lowerCellOffset[0][x];
+        fraction[1] = cellFraction[0][x];
+
+        GridOffsetType cell = 0;
+        for ( unsigned int a = 0; a < GridDimension; a++ )
+          {
+          cell += lower[a];
+          }
+        double value = 0.0;
+        double weight = 0.0;
+        for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
+          {
+          double cornerWeight = 1.0;
+          for ( unsigned int a = 0; a < GridDimension; a++ )
+            {
+            cornerWeight *= ( corner & ( 1 << a ) ) ? fraction[a] : 1.0 - fraction[a];
+            }
+          const GridOffsetType c = cell + cornerOffset[corner];
+          value += cornerWeight * grid[2 * c];
+          weight += cornerWeight * grid[2 * c + 1];
+          }
+        ot.Set( static_cast< OutputPixelType >( weight > 0.0 ? value / weight : pixel ) );
+        }
+      it.NextLine();
+      ot.NextLine();
+      }
+    }, this );
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 BilateralImageFilter< TInputImage, TOutputImage >
@@ -350,6 +659,9 @@ BilateralImageFilter< TInputImage, TOutputImage >
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "UseBilateralGrid: " << m_UseBilateralGrid << std::endl;
+  os << indent << "GridDomainSampling: " << m_GridDomainSampling << std::endl;
+  os << indent << "GridRangeSampling: " << m_GridRangeSampling << std::endl;
 }
 } // end namespace itk
 
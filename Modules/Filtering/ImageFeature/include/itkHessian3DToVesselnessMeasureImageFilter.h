@@ -93,6 +93,7 @@ public:
   using OutputImageType = typename Superclass::OutputImageType;
   using InputPixelType = typename InputImageType::PixelType;
   using OutputPixelType = TPixel;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
 
   /** Image dimension = 3. */
   static constexpr unsigned int ImageDimension = InputImageType ::ImageDimension;
@@ -133,11 +134,12 @@ protected:
   ~Hessian3DToVesselnessMeasureImageFilter() override = default;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Generate Data */
-  void GenerateData() override;
+  /** The eigen values are computed pixel by pixel, without an intermediate
+   * image of eigen values. */
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
-  typename EigenAnalysisFilterType::Pointer m_SymmetricEigenValueFilter;
+  typename EigenAnalysisFilterType::FunctorType m_EigenAnalysisFunctor;
 
   double m_Alpha1;
   double m_Alpha2;
@@ -35,44 +35,24 @@ Hessian3DToVesselnessMeasureImageFilter< TPixel >
   m_Alpha2 = 2.0;
 
   // Hessian( Image ) = Jacobian( Gradient ( Image ) )  is symmetric
-  m_SymmetricEigenValueFilter = EigenAnalysisFilterType::New();
-  m_SymmetricEigenValueFilter->OrderEigenValuesBy(
+  m_EigenAnalysisFunctor.OrderEigenValuesBy(
     EigenAnalysisFilterType::FunctorType::OrderByValue);
+
+  this->DynamicMultiThreadingOn();
 }
 
 template< typename TPixel >
 void
 Hessian3DToVesselnessMeasureImageFilter< TPixel >
-::GenerateData()
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
-  itkDebugMacro(<< "Hessian3DToVesselnessMeasureImageFilter generating data ");
-
-  m_SymmetricEigenValueFilter->SetInput( this->GetInput() );
-
-  typename OutputImageType::Pointer output = this->GetOutput();
-
-  using EigenValueOutputImageType = typename EigenAnalysisFilterType::OutputImageType;
-
-  m_SymmetricEigenValueFilter->Update();
-
-  const typename EigenValueOutputImageType::ConstPointer eigenImage =
-    m_SymmetricEigenValueFilter->GetOutput();
-
-  // walk the region of eigen values and get the vesselness measure
-  EigenValueArrayType                                   eigenValue;
-  ImageRegionConstIterator< EigenValueOutputImageType > it;
-  it = ImageRegionConstIterator< EigenValueOutputImageType >(
-    eigenImage, eigenImage->GetRequestedRegion() );
-  ImageRegionIterator< OutputImageType > oit;
-  this->AllocateOutputs();
-  oit = ImageRegionIterator< OutputImageType >( output,
-                                                output->GetRequestedRegion() );
-  oit.GoToBegin();
-  it.GoToBegin();
+  // walk the region of the Hessian and get the vesselness measure
+  ImageRegionConstIterator< InputImageType > it( this->GetInput(), outputRegionForThread );
+  ImageRegionIterator< OutputImageType >     oit( this->GetOutput(), outputRegionForThread );
   while ( !it.IsAtEnd() )
     {
     // Get the eigen value
-    eigenValue = it.Get();
+    const EigenValueArrayType eigenValue = m_EigenAnalysisFunctor( it.Get() );
 
     // normalizeValue <= 0 for bright line structures
     double normalizeValue = std::min(-1.0 * eigenValue[1], -1.0 * eigenValue[0]);
@@ -97,9 +97,9 @@ public:
   /** Hessian computation filter. */
   using HessianFilterType = HessianRecursiveGaussianImageFilter< InputImageType, HessianImageType >;
 
-  /** Update image buffer that holds the best objectness response. This is not redundant from
-   the output image because the latter may not be of float type, which is required for the comparisons
-   between responses at different scales. */
+  /** Type of the image buffer that used to hold the best objectness response. The best
+   response is now kept in the output image, which has the pixel type of the responses of
+   the HessianToMeasureFilter. Kept for backward compatibility. */
   using UpdateBufferType = Image< double, Self::ImageDimension >;
   using BufferValueType = typename UpdateBufferType::ValueType;
 
@@ -132,7 +132,7 @@ public:
 
   /** Methods to turn on/off flag to inform the filter that the Hessian-based measure
    is non-negative (classical measures like Sato's and Frangi's are), hence it has a minimum
-   at zero. In this case, the update buffer is initialized at zero, and the output scale and Hessian
+   at zero. In this case, the output is initialized at zero, and the output scale and Hessian
    are zero in case the Hessian-based measure returns zero for all scales. Otherwise, the minimum
    output scale and Hessian are the ones obtained at scale SigmaMinimum. On by default.
    */
@@ -174,6 +174,14 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
 
+  /** Set/Get the number of pieces in which the Hessian-based measure is
+   * evaluated at each scale. The maximum response is updated piece by
+   * piece, so that only a piece of the measure image is kept in memory.
+   * The HessianToMeasureFilter must support streaming, as the pixel-wise
+   * measures do. Default is 1. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits< unsigned int >::max());
+  itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
+
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -191,12 +199,10 @@ protected:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
 
 private:
-  void UpdateMaximumResponse(double sigma);
+  void UpdateMaximumResponse(double sigma, const OutputRegionType & region, bool firstScale);
 
   double ComputeSigmaValue(int scaleLevel);
 
-  void AllocateUpdateBuffer();
-
   bool m_NonNegativeHessianBasedMeasure;
 
   double m_SigmaMinimum;
@@ -209,10 +215,10 @@ private:
 
   typename HessianFilterType::Pointer m_HessianFilter;
 
-  typename UpdateBufferType::Pointer m_UpdateBuffer;
-
   bool m_GenerateScalesOutput;
   bool m_GenerateHessianOutput;
+
+  unsigned int m_NumberOfStreamDivisions{ 1 };
 };
 } // end namespace itk
 
@@ -20,6 +20,7 @@
 
 #include "itkMultiScaleHessianBasedMeasureImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkMath.h"
 
 /*
@@ -53,9 +54,6 @@ MultiScaleHessianBasedMeasureImageFilter
   m_HessianFilter = HessianFilterType::New();
   m_HessianToMeasureFilter = nullptr;
 
-  //Instantiate Update buffer
-  m_UpdateBuffer = UpdateBufferType::New();
-
   m_GenerateScalesOutput = false;
   m_GenerateHessianOutput = false;
 
@@ -102,39 +100,6 @@ MultiScaleHessianBasedMeasureImageFilter
 }
 
 
-template< typename TInputImage,
-          typename THessianImage,
-          typename TOutputImage >
-void
-MultiScaleHessianBasedMeasureImageFilter
-< TInputImage, THessianImage, TOutputImage >
-::AllocateUpdateBuffer()
-{
-  /* The update buffer looks just like the output and holds the best response
-     in the  objectness measure */
-
-  typename TOutputImage::Pointer output = this->GetOutput();
-
-  // this copies meta data describing the output such as origin,
-  // spacing and the largest region
-  m_UpdateBuffer->CopyInformation(output);
-
-  m_UpdateBuffer->SetRequestedRegion( output->GetRequestedRegion() );
-  m_UpdateBuffer->SetBufferedRegion( output->GetBufferedRegion() );
-  m_UpdateBuffer->Allocate();
-
-  // Update buffer is used for > comparisons so make it really really small,
-  // just to be sure. Thanks to Hauke Heibel.
-  if ( m_NonNegativeHessianBasedMeasure )
-    {
-    m_UpdateBuffer->FillBuffer(itk::NumericTraits< BufferValueType >::ZeroValue());
-    }
-  else
-    {
-    m_UpdateBuffer->FillBuffer( itk::NumericTraits< BufferValueType >::NonpositiveMin() );
-    }
-}
-
 template< typename TInputImage,
           typename THessianImage,
           typename TOutputImage >
@@ -178,8 +143,17 @@ MultiScaleHessianBasedMeasureImageFilter
     hessianImage->FillBuffer(zeroTensor);
     }
 
-  // Allocate the buffer
-  AllocateUpdateBuffer();
+  // The best response is kept in the output, which has the pixel type of
+  // the responses.  Classical measures have a minimum at zero, otherwise
+  // the output is set by the first scale.
+  if ( m_NonNegativeHessianBasedMeasure )
+    {
+    this->GetOutput()->FillBuffer( NumericTraits< OutputPixelType >::ZeroValue() );
+    }
+  else
+    {
+    this->GetOutput()->FillBuffer( NumericTraits< OutputPixelType >::NonpositiveMin() );
+    }
 
   typename InputImageType::ConstPointer input = this->GetInput();
 
@@ -187,6 +161,12 @@ MultiScaleHessianBasedMeasureImageFilter
 
   this->m_HessianFilter->SetNormalizeAcrossScale(true);
 
+  // The measure is evaluated in pieces of the output
+  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
+
+  ImageRegionSplitterSlowDimension::Pointer splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfPieces = splitter->GetNumberOfSplits( outputRegion, m_NumberOfStreamDivisions );
+
   // Create a process accumulator for tracking the progress of this
   // minipipeline
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
@@ -196,9 +176,12 @@ MultiScaleHessianBasedMeasureImageFilter
   if ( m_NumberOfSigmaSteps > 0 )
     {
     progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
-    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
+    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / ( m_NumberOfSigmaSteps * numberOfPieces ) );
     }
 
+  using HessianToMeasureOutputImageType = typename HessianToMeasureFilterType::OutputImageType;
+  HessianToMeasureOutputImageType * measureImage = m_HessianToMeasureFilter->GetOutput();
+
   for( unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel )
     {
     const double sigma  = this->ComputeSigmaValue(scaleLevel);
@@ -209,30 +192,21 @@ MultiScaleHessianBasedMeasureImageFilter
 
     m_HessianToMeasureFilter->SetInput ( m_HessianFilter->GetOutput() );
 
-    m_HessianToMeasureFilter->Update();
-
-    this->UpdateMaximumResponse(sigma);
-    }
-
-  // Write out the best response to the output image
-  // we can assume that the meta-data should match between these two
-  // image, therefore we iterate over the desired output region
-  OutputRegionType                        outputRegion = this->GetOutput()->GetBufferedRegion();
-  ImageRegionIterator< UpdateBufferType > it(m_UpdateBuffer, outputRegion);
-  it.GoToBegin();
+    for ( unsigned int piece = 0; piece < numberOfPieces; ++piece )
+      {
+      OutputRegionType pieceRegion = outputRegion;
+      splitter->GetSplit( piece, numberOfPieces, pieceRegion );
 
-  ImageRegionIterator< TOutputImage > oit(this->GetOutput(), outputRegion);
-  oit.GoToBegin();
+      measureImage->SetRequestedRegion( pieceRegion );
+      measureImage->Update();
 
-  while ( !oit.IsAtEnd() )
-    {
-    oit.Value() = static_cast< OutputPixelType >( it.Get() );
-    ++oit;
-    ++it;
+      this->UpdateMaximumResponse( sigma, pieceRegion, scaleLevel == 0 );
+      }
     }
 
-  // Release data from the update buffer.
-  m_UpdateBuffer->ReleaseData();
+  // Release the Hessian and the measure of the last scale
+  m_HessianFilter->GetOutput()->ReleaseData();
+  measureImage->ReleaseData();
 }
 
 template< typename TInputImage,
@@ -241,66 +215,68 @@ template< typename TInputImage,
 void
 MultiScaleHessianBasedMeasureImageFilter
 < TInputImage, THessianImage, TOutputImage >
-::UpdateMaximumResponse(double sigma)
+::UpdateMaximumResponse(double sigma, const OutputRegionType & region, bool firstScale)
 {
   // the meta-data should match between these images, therefore we
   // iterate over the desired output region
-  OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
-
-  ImageRegionIterator< UpdateBufferType > oit(m_UpdateBuffer, outputRegion);
-
-  typename ScalesImageType::Pointer scalesImage = static_cast< ScalesImageType * >( this->ProcessObject::GetOutput(1) );
-  ImageRegionIterator< ScalesImageType > osit;
-
-  typename HessianImageType::Pointer hessianImage = static_cast< HessianImageType * >( this->ProcessObject::GetOutput(2) );
-  ImageRegionIterator< HessianImageType > ohit;
-
-  oit.GoToBegin();
-  if ( m_GenerateScalesOutput )
-    {
-    osit = ImageRegionIterator< ScalesImageType >(scalesImage, outputRegion);
-    osit.GoToBegin();
-    }
-  if ( m_GenerateHessianOutput )
-    {
-    ohit = ImageRegionIterator< HessianImageType >(hessianImage, outputRegion);
-    ohit.GoToBegin();
-    }
-
   using HessianToMeasureOutputImageType = typename HessianToMeasureFilterType::OutputImageType;
 
-  ImageRegionIterator< HessianToMeasureOutputImageType > it(m_HessianToMeasureFilter->GetOutput(), outputRegion);
-  ImageRegionIterator< HessianImageType >                hit(m_HessianFilter->GetOutput(), outputRegion);
+  TOutputImage * output = this->GetOutput();
+  auto * scalesImage = static_cast< ScalesImageType * >( this->ProcessObject::GetOutput(1) );
+  auto * hessianImage = static_cast< HessianImageType * >( this->ProcessObject::GetOutput(2) );
+  const HessianToMeasureOutputImageType * measureImage = m_HessianToMeasureFilter->GetOutput();
+  const HessianImageType * currentHessianImage = m_HessianFilter->GetOutput();
 
-  it.GoToBegin();
-  hit.GoToBegin();
+  // When the measure may be negative, the first scale sets the output
+  const bool replaceAll = firstScale && !m_NonNegativeHessianBasedMeasure;
 
-  while ( !oit.IsAtEnd() )
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  multiThreader->template ParallelizeImageRegion< ImageDimension >( region,
+    [&]( const OutputRegionType & regionForThread )
     {
-    if ( oit.Value() < it.Value() )
+    ImageRegionIterator< TOutputImage >                         oit(output, regionForThread);
+    ImageRegionConstIterator< HessianToMeasureOutputImageType > it(measureImage, regionForThread);
+    ImageRegionIterator< ScalesImageType >                      osit;
+    ImageRegionIterator< HessianImageType >                     ohit;
+    ImageRegionConstIterator< HessianImageType >                hit;
+    if ( m_GenerateScalesOutput )
       {
-      oit.Value() = it.Value();
+      osit = ImageRegionIterator< ScalesImageType >(scalesImage, regionForThread);
+      }
+    if ( m_GenerateHessianOutput )
+      {
+      ohit = ImageRegionIterator< HessianImageType >(hessianImage, regionForThread);
+      hit = ImageRegionConstIterator< HessianImageType >(currentHessianImage, regionForThread);
+      }
+
+    while ( !oit.IsAtEnd() )
+      {
+      if ( replaceAll || oit.Value() < it.Value() )
+        {
+        oit.Value() = it.Value();
+        if ( m_GenerateScalesOutput )
+          {
+          osit.Value() = static_cast< ScalesPixelType >( sigma );
+          }
+        if ( m_GenerateHessianOutput )
+          {
+          ohit.Value() = hit.Value();
+          }
+        }
+      ++oit;
+      ++it;
       if ( m_GenerateScalesOutput )
         {
-        osit.Value() = static_cast< ScalesPixelType >( sigma );
+        ++osit;
         }
       if ( m_GenerateHessianOutput )
         {
-        ohit.Value() = hit.Value();
+        ++ohit;
+        ++hit;
         }
       }
-    ++oit;
-    ++it;
-    if ( m_GenerateScalesOutput )
-      {
-      ++osit;
-      }
-    if ( m_GenerateHessianOutput )
-      {
-      ++ohit;
-      ++hit;
-      }
-    }
+    }, nullptr );
 }
 
 
@@ -415,6 +391,7 @@ MultiScaleHessianBasedMeasureImageFilter
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
   os << indent << "GenerateHessianOutput: " << m_GenerateHessianOutput << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 }
 } // end namespace itk
 
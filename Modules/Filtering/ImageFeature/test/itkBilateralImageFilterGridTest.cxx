@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// A noisy step edge along the first axis, between the intensities 50 and 150
+template< unsigned int VDimension >
+typename itk::Image< float, VDimension >::Pointer
+MakeNoisyStep( const itk::Size< VDimension > & size )
+{
+  using ImageType = itk::Image< float, VDimension >;
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const float step = it.GetIndex()[0] < static_cast< itk::IndexValueType >( size[0] / 2 ) ? 50.0f : 150.0f;
+    it.Set( step + static_cast< float >( generator->GetNormalVariate( 0.0, 100.0 ) ) );
+    }
+  return image;
+}
+
+// Compare the bilateral grid with the exact filter, and check that the edge
+// is preserved
+template< unsigned int VDimension >
+int
+TestGrid( const itk::Size< VDimension > & size, double domainSigma, unsigned int numberOfWorkUnits )
+{
+  using ImageType = itk::Image< float, VDimension >;
+  using FilterType = itk::BilateralImageFilter< ImageType, ImageType >;
+
+  typename ImageType::Pointer input = MakeNoisyStep< VDimension >( size );
+
+  typename FilterType::Pointer exact = FilterType::New();
+  exact->SetInput( input );
+  exact->SetDomainSigma( domainSigma );
+  exact->SetRangeSigma( 30.0 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( exact->Update() );
+
+  typename FilterType::Pointer grid = FilterType::New();
+  grid->SetInput( input );
+  grid->SetDomainSigma( domainSigma );
+  grid->SetRangeSigma( 30.0 );
+  grid->UseBilateralGridOn();
+  grid->SetNumberOfWorkUnits( numberOfWorkUnits );
+  ITK_TRY_EXPECT_NO_EXCEPTION( grid->Update() );
+
+  double meanDifference = 0.0;
+  double maximumEdgeError = 0.0;
+  double maximumExactEdgeError = 0.0;
+  double numberOfPixels = 0.0;
+
+  itk::ImageRegionConstIterator< ImageType > eit( exact->GetOutput(), input->GetLargestPossibleRegion() );
+  itk::ImageRegionIteratorWithIndex< ImageType > git( grid->GetOutput(), input->GetLargestPossibleRegion() );
+  for ( ; !git.IsAtEnd(); ++eit, ++git )
+    {
+    meanDifference += std::abs( eit.Get() - git.Get() );
+    numberOfPixels += 1.0;
+
+    // the pixels next to the edge keep the intensity of their side
+    const auto x = git.GetIndex()[0] - static_cast< itk::IndexValueType >( size[0] / 2 );
+    if ( x == -1 || x == 0 )
+      {
+      const double step = x < 0 ? 50.0 : 150.0;
+      maximumEdgeError = std::max( maximumEdgeError, std::abs( git.Get() - step ) );
+      maximumExactEdgeError = std::max( maximumExactEdgeError, std::abs( eit.Get() - step ) );
+      }
+    }
+  meanDifference /= numberOfPixels;
+
+  std::cout << "Dimension " << VDimension << ", domain sigma " << domainSigma
+            << ": mean difference with the exact filter " << meanDifference
+            << ", maximum error at the edge " << maximumEdgeError
+            << " (exact filter " << maximumExactEdgeError << ")" << std::endl;
+
+  if ( meanDifference > 1.0 || maximumEdgeError > 1.5 * maximumExactEdgeError )
+    {
+    std::cerr << "The bilateral grid differs too much from the exact filter." << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+int itkBilateralImageFilterGridTest( int, char *[] )
+{
+  using ImageType = itk::Image< float, 2 >;
+  using FilterType = itk::BilateralImageFilter< ImageType, ImageType >;
+
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( filter, BilateralImageFilter, ImageToImageFilter );
+
+  ITK_TEST_SET_GET_BOOLEAN( filter, UseBilateralGrid, true );
+  ITK_TEST_SET_GET_VALUE( 0.5, filter->GetGridDomainSampling() );
+  ITK_TEST_SET_GET_VALUE( 0.5, filter->GetGridRangeSampling() );
+  filter->SetGridDomainSampling( 1.0 );
+  ITK_TEST_SET_GET_VALUE( 1.0, filter->GetGridDomainSampling() );
+  filter->SetGridRangeSampling( 0.25 );
+  ITK_TEST_SET_GET_VALUE( 0.25, filter->GetGridRangeSampling() );
+
+  // A null sigma, or a dynamic range too large for the grid, are rejected
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType imageSize = {{ 16, 16 }};
+  image->SetRegions( imageSize );
+  image->Allocate();
+  image->FillBuffer( 0.0f );
+  filter->SetInput( image );
+  filter->SetRangeSigma( 0.0 );
+  ITK_TRY_EXPECT_EXCEPTION( filter->Update() );
+  filter->SetRangeSigma( 1.0 );
+  filter->SetDomainSigma( 0.0 );
+  ITK_TRY_EXPECT_EXCEPTION( filter->Update() );
+  filter->SetDomainSigma( 2.0 );
+  image->SetPixel( {{ 3, 5 }}, 1e30f );
+  image->Modified();
+  ITK_TRY_EXPECT_EXCEPTION( filter->Update() );
+  image->SetPixel( {{ 3, 5 }}, 100.0f );
+  image->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  int result = EXIT_SUCCESS;
+
+  itk::Size< 2 > size2 = {{ 128, 97 }};
+  if ( TestGrid< 2 >( size2, 2.0, 1 ) == EXIT_FAILURE
+       || TestGrid< 2 >( size2, 5.0, 4 ) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  itk::Size< 3 > size3 = {{ 40, 33, 27 }};
+  if ( TestGrid< 3 >( size3, 2.0, 3 ) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
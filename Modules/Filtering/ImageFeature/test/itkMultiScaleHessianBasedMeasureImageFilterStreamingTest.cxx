@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHessian3DToVesselnessMeasureImageFilter.h"
+#include "itkHessianToObjectnessMeasureImageFilter.h"
+#include "itkMultiScaleHessianBasedMeasureImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+
+using InputImageType = itk::Image< float, Dimension >;
+using OutputImageType = itk::Image< float, Dimension >;
+using HessianPixelType = itk::SymmetricSecondRankTensor< double, Dimension >;
+using HessianImageType = itk::Image< HessianPixelType, Dimension >;
+using MultiScaleFilterType = itk::MultiScaleHessianBasedMeasureImageFilter< InputImageType, HessianImageType, OutputImageType >;
+using MeasureFilterType = MultiScaleFilterType::HessianToMeasureFilterType;
+
+// Two bright tubes of different radii along the last axis, on a ramp
+InputImageType::Pointer
+MakeTubes()
+{
+  InputImageType::SizeType size = {{ 40, 36, 30 }};
+  InputImageType::Pointer  image = InputImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< InputImageType > it( image, image->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const InputImageType::IndexType index = it.GetIndex();
+    const double d1 = itk::Math::sqr( index[0] - 12.0 ) + itk::Math::sqr( index[1] - 18.0 );
+    const double d2 = itk::Math::sqr( index[0] - 28.0 ) + itk::Math::sqr( index[1] - 16.0 );
+    it.Set( static_cast< float >( 100.0 * std::exp( -d1 / 4.0 ) + 80.0 * std::exp( -d2 / 18.0 ) + 0.5 * index[2] ) );
+    }
+  return image;
+}
+
+template< typename TImage >
+bool
+SameImages( const TImage * a, const TImage * b, const char * name )
+{
+  itk::ImageRegionConstIterator< TImage > ait( a, a->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< TImage > bit( b, b->GetBufferedRegion() );
+  for ( ; !ait.IsAtEnd(); ++ait, ++bit )
+    {
+    if ( ait.Get() != bit.Get() )
+      {
+      std::cerr << name << " differs at " << ait.GetIndex() << ": " << ait.Get() << " != " << bit.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Compute the maximum response over the scales with separate filters, and
+// compare it with the multi-scale filter evaluated in pieces
+int
+CompareWithSeparateScales( const InputImageType * input, MeasureFilterType * measureFilter,
+                           bool nonNegative, unsigned int numberOfStreamDivisions )
+{
+  MultiScaleFilterType::Pointer multiScale = MultiScaleFilterType::New();
+  multiScale->SetInput( input );
+  multiScale->SetHessianToMeasureFilter( measureFilter );
+  multiScale->SetSigmaMinimum( 1.0 );
+  multiScale->SetSigmaMaximum( 4.0 );
+  multiScale->SetNumberOfSigmaSteps( 4 );
+  multiScale->SetNonNegativeHessianBasedMeasure( nonNegative );
+  multiScale->GenerateScalesOutputOn();
+  multiScale->GenerateHessianOutputOn();
+  multiScale->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  ITK_TRY_EXPECT_NO_EXCEPTION( multiScale->Update() );
+
+  using HessianFilterType = MultiScaleFilterType::HessianFilterType;
+  HessianFilterType::Pointer hessianFilter = HessianFilterType::New();
+  hessianFilter->SetInput( input );
+  hessianFilter->SetNormalizeAcrossScale( true );
+
+  OutputImageType::Pointer expected = OutputImageType::New();
+  expected->SetRegions( input->GetLargestPossibleRegion() );
+  expected->Allocate();
+  MultiScaleFilterType::ScalesImageType::Pointer expectedScales = MultiScaleFilterType::ScalesImageType::New();
+  expectedScales->SetRegions( input->GetLargestPossibleRegion() );
+  expectedScales->Allocate( true );
+  HessianImageType::Pointer expectedHessian = HessianImageType::New();
+  expectedHessian->SetRegions( input->GetLargestPossibleRegion() );
+  expectedHessian->Allocate();
+  expectedHessian->FillBuffer( HessianPixelType( 0.0 ) );
+
+  for ( unsigned int scale = 0; scale < 4; scale++ )
+    {
+    // logarithmic steps, computed as the multi-scale filter does
+    const double stepSize = ( std::log( 4.0 ) - std::log( 1.0 ) ) / 3.0;
+    const double sigma = std::exp( std::log( 1.0 ) + stepSize * scale );
+    hessianFilter->SetSigma( sigma );
+    measureFilter->SetInput( hessianFilter->GetOutput() );
+    measureFilter->UpdateLargestPossibleRegion();
+
+    itk::ImageRegionConstIterator< OutputImageType > it( measureFilter->GetOutput(), input->GetLargestPossibleRegion() );
+    itk::ImageRegionConstIterator< HessianImageType > hit( hessianFilter->GetOutput(), input->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< OutputImageType > eit( expected, input->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< MultiScaleFilterType::ScalesImageType > sit( expectedScales, input->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< HessianImageType > ehit( expectedHessian, input->GetLargestPossibleRegion() );
+    for ( ; !it.IsAtEnd(); ++it, ++hit, ++eit, ++sit, ++ehit )
+      {
+      const bool first = scale == 0 && !nonNegative;
+      const float previous = scale == 0 ? 0.0f : eit.Get();
+      if ( first || previous < it.Get() )
+        {
+        eit.Set( it.Get() );
+        sit.Set( static_cast< float >( sigma ) );
+        ehit.Set( hit.Get() );
+        }
+      else if ( scale == 0 )
+        {
+        eit.Set( 0.0f );
+        }
+      }
+    }
+
+  if ( !SameImages< OutputImageType >( multiScale->GetOutput(), expected, "Output" )
+       || !SameImages< MultiScaleFilterType::ScalesImageType >( multiScale->GetScalesOutput(), expectedScales, "Scales" )
+       || !SameImages< HessianImageType >( multiScale->GetHessianOutput(), expectedHessian, "Hessian" ) )
+    {
+    std::cerr << "Failure with NonNegativeHessianBasedMeasure " << nonNegative
+              << " and " << numberOfStreamDivisions << " stream divisions" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+int itkMultiScaleHessianBasedMeasureImageFilterStreamingTest( int, char *[] )
+{
+  MultiScaleFilterType::Pointer filter = MultiScaleFilterType::New();
+  ITK_TEST_SET_GET_VALUE( 1, filter->GetNumberOfStreamDivisions() );
+  filter->SetNumberOfStreamDivisions( 0 );
+  ITK_TEST_SET_GET_VALUE( 1, filter->GetNumberOfStreamDivisions() );
+  filter->SetNumberOfStreamDivisions( 6 );
+  ITK_TEST_SET_GET_VALUE( 6, filter->GetNumberOfStreamDivisions() );
+
+  InputImageType::Pointer input = MakeTubes();
+
+  using ObjectnessFilterType = itk::HessianToObjectnessMeasureImageFilter< HessianImageType, OutputImageType >;
+  ObjectnessFilterType::Pointer objectness = ObjectnessFilterType::New();
+  objectness->SetObjectDimension( 1 );
+  objectness->SetBrightObject( true );
+
+  using VesselnessFilterType = itk::Hessian3DToVesselnessMeasureImageFilter< float >;
+  VesselnessFilterType::Pointer vesselness = VesselnessFilterType::New();
+
+  int result = EXIT_SUCCESS;
+  for ( unsigned int divisions : { 1, 7 } )
+    {
+    for ( bool nonNegative : { true, false } )
+      {
+      if ( CompareWithSeparateScales( input, objectness, nonNegative, divisions ) == EXIT_FAILURE
+           || CompareWithSeparateScales( input, vesselness, nonNegative, divisions ) == EXIT_FAILURE )
+        {
+        result = EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
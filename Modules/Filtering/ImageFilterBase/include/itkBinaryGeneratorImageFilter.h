@@ -236,6 +236,25 @@ protected:
   void GenerateOutputInformation() override;
 
 private:
+  /** Applies the functor over the runs of pixels that are contiguous in the
+   * buffers, with plain loops that the compiler can vectorize.  Only
+   * Image's, whose pixels are stored as they are, take this path; false is
+   * returned otherwise. */
+  template< typename TFunctor, typename TInput1, typename TInput2, typename TOutput, typename TRegion >
+  bool GenerateDataOverContiguousRuns(const TFunctor &, const TInput1 *, const TInput2 *, TOutput *,
+                                      const TRegion &)
+  {
+    return false;
+  }
+
+  template< typename TFunctor, typename TInputPixel1, typename TInputPixel2, typename TOutputPixel,
+            unsigned int VImageDimension >
+  bool GenerateDataOverContiguousRuns(const TFunctor & functor,
+                                      const Image< TInputPixel1, VImageDimension > * inputPtr1,
+                                      const Image< TInputPixel2, VImageDimension > * inputPtr2,
+                                      Image< TOutputPixel, VImageDimension > * outputPtr,
+                                      const ImageRegion< VImageDimension > & outputRegionForThread);
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
 };
 } // end namespace itk
@@ -19,6 +19,7 @@
 #define itkBinaryGeneratorImageFilter_hxx
 
 #include "itkBinaryGeneratorImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
@@ -216,6 +217,11 @@ BinaryGeneratorImageFilter< TInputImage1, TInputImage2, TOutputImage >
     return;
     }
 
+  if ( this->GenerateDataOverContiguousRuns(functor, inputPtr1, inputPtr2, outputPtr, outputRegionForThread) )
+    {
+    return;
+    }
+
   if( inputPtr1 && inputPtr2 )
     {
     ImageScanlineConstIterator< TInputImage1 > inputIt1(inputPtr1, outputRegionForThread);
@@ -280,6 +286,75 @@ BinaryGeneratorImageFilter< TInputImage1, TInputImage2, TOutputImage >
     itkGenericExceptionMacro(<<"At most one of the inputs can be a constant.");
     }
 }
+
+template< typename TInputImage1, typename TInputImage2, typename TOutputImage >
+template< typename TFunctor, typename TInputPixel1, typename TInputPixel2, typename TOutputPixel,
+          unsigned int VImageDimension >
+bool
+BinaryGeneratorImageFilter< TInputImage1, TInputImage2, TOutputImage >
+::GenerateDataOverContiguousRuns(const TFunctor & functor,
+                                 const Image< TInputPixel1, VImageDimension > * inputPtr1,
+                                 const Image< TInputPixel2, VImageDimension > * inputPtr2,
+                                 Image< TOutputPixel, VImageDimension > * outputPtr,
+                                 const ImageRegion< VImageDimension > & outputRegionForThread)
+{
+  TOutputPixel *outputBuffer = outputPtr->GetBufferPointer();
+
+  if ( inputPtr1 && inputPtr2 )
+    {
+    const TInputPixel1 *inputBuffer1 = inputPtr1->GetBufferPointer();
+    const TInputPixel2 *inputBuffer2 = inputPtr2->GetBufferPointer();
+    ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+      [inputBuffer1, inputBuffer2, outputBuffer, &functor](const OffsetValueType * offsets, SizeValueType length)
+      {
+      const TInputPixel1 *input1 = inputBuffer1 + offsets[0];
+      const TInputPixel2 *input2 = inputBuffer2 + offsets[1];
+      TOutputPixel *      output = outputBuffer + offsets[2];
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        output[i] = functor(input1[i], input2[i]);
+        }
+      },
+      inputPtr1, inputPtr2, outputPtr );
+    }
+  else if ( inputPtr1 )
+    {
+    const TInputPixel1 *inputBuffer1 = inputPtr1->GetBufferPointer();
+    const TInputPixel2  input2Value = this->GetConstant2();
+    ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+      [inputBuffer1, input2Value, outputBuffer, &functor](const OffsetValueType * offsets, SizeValueType length)
+      {
+      const TInputPixel1 *input1 = inputBuffer1 + offsets[0];
+      TOutputPixel *      output = outputBuffer + offsets[1];
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        output[i] = functor(input1[i], input2Value);
+        }
+      },
+      inputPtr1, outputPtr );
+    }
+  else if ( inputPtr2 )
+    {
+    const TInputPixel1  input1Value = this->GetConstant1();
+    const TInputPixel2 *inputBuffer2 = inputPtr2->GetBufferPointer();
+    ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+      [input1Value, inputBuffer2, outputBuffer, &functor](const OffsetValueType * offsets, SizeValueType length)
+      {
+      const TInputPixel2 *input2 = inputBuffer2 + offsets[0];
+      TOutputPixel *      output = outputBuffer + offsets[1];
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        output[i] = functor(input1Value, input2[i]);
+        }
+      },
+      inputPtr2, outputPtr );
+    }
+  else
+    {
+    return false;
+    }
+  return true;
+}
 } // end namespace itk
 
 #endif
@@ -40,13 +40,18 @@ void
 CastImageFilter< TInputImage, TOutputImage >
 ::GenerateData()
 {
-  if ( this->GetInPlace() && this->CanRunInPlace() )
+  if ( this->ShouldRunInPlace() && this->CanRunInPlace() )
     {
-    // nothing to do, so avoid iterating over all the pixels
-    // for nothing! Allocate the output, generate a fake progress and exit
+    // The output reuses the buffer of the input only when its requested
+    // region is the buffered region of the input
     this->AllocateOutputs();
-    ProgressReporter progress(this, 0, 1);
-    return;
+    if ( this->GetRunningInPlace() )
+      {
+      // nothing to do, so avoid iterating over all the pixels
+      // for nothing! Generate a fake progress and exit
+      ProgressReporter progress(this, 0, 1);
+      return;
+      }
     }
   //else do normal Before+Threaded+After
   Superclass::GenerateData();
@@ -82,34 +82,38 @@ void
 NeighborhoodOperatorImageFilter< TInputImage, TOutputImage, TOperatorValueType >
 ::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
-  using BFC = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>;
-  using FaceListType = typename BFC::FaceListType;
+  using PartitionType = NeighborhoodAlgorithm::ImageNeighborhoodPartition< InputImageType >;
+  using InteriorNeighborhoodType = typename PartitionType::InteriorNeighborhoodType;
 
   NeighborhoodInnerProduct< InputImageType, OperatorValueType, ComputingPixelType > smartInnerProduct;
-  BFC faceCalculator;
-  FaceListType faceList;
 
   OutputImageType *output = this->GetOutput();
   const InputImageType *input   = this->GetInput();
 
-  // Break the input into a series of regions.  The first region is free
-  // of boundary conditions, the rest with boundary conditions. Note,
-  // we pass in the input image and the OUTPUT requested region. We are
-  // only concerned with centering the neighborhood operator at the
-  // pixels that correspond to output pixels.
-  faceList = faceCalculator( input, outputRegionForThread, m_Operator.GetRadius() );
-
-  typename FaceListType::iterator fit;
-  ImageRegionIterator< OutputImageType > it;
+  // Break the input into a series of regions.  The interior region is free
+  // of boundary conditions, the faces need them. Note, we pass in the input
+  // image and the OUTPUT requested region. We are only concerned with
+  // centering the neighborhood operator at the pixels that correspond to
+  // output pixels.
+  const PartitionType partition( input, outputRegionForThread, m_Operator.GetRadius() );
+
+  // Process the interior region through flat offsets in the input buffer.
+  ImageRegionIterator< OutputImageType > it( output, partition.GetInteriorRegion() );
+  const OutputNeighborhoodType & op = m_Operator;
+  partition.ForEachInteriorNeighborhood( [&it, &op, &smartInnerProduct](const InteriorNeighborhoodType & neighborhood)
+    {
+    it.Value() = static_cast< typename OutputImageType::PixelType >( smartInnerProduct(neighborhood, op) );
+    ++it;
+    } );
 
-  // Process non-boundary region and each of the boundary faces.
-  // These are N-d regions which border the edge of the buffer.
+  // Process each of the boundary faces.  These are N-d regions which border
+  // the edge of the buffer.
   ConstNeighborhoodIterator< InputImageType > bit;
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  for ( const auto & face : partition.GetBoundaryFaces() )
     {
-    bit = ConstNeighborhoodIterator< InputImageType >(m_Operator.GetRadius(), input, *fit);
+    bit = ConstNeighborhoodIterator< InputImageType >(m_Operator.GetRadius(), input, face);
     bit.OverrideBoundaryCondition(m_BoundsCondition);
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
+    it = ImageRegionIterator< OutputImageType >(output, face);
     bit.GoToBegin();
     while ( !bit.IsAtEnd() )
       {
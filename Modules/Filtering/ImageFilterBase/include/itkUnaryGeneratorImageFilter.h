@@ -171,6 +171,24 @@ protected:
   void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
 private:
+  /** Applies the functor over the runs of pixels that are contiguous in the
+   * buffers, with plain loops that the compiler can vectorize.  Only
+   * Image's, whose pixels are stored as they are, take this path, when the
+   * input and output regions match; false is returned otherwise. */
+  template< typename TFunctor, typename TInput, typename TOutput, typename TInputRegion, typename TOutputRegion >
+  static bool GenerateDataOverContiguousRuns(const TFunctor &, const TInput *, TOutput *,
+                                             const TInputRegion &, const TOutputRegion &)
+  {
+    return false;
+  }
+
+  template< typename TFunctor, typename TInputPixel, typename TOutputPixel, unsigned int VImageDimension >
+  static bool GenerateDataOverContiguousRuns(const TFunctor & functor,
+                                             const Image< TInputPixel, VImageDimension > * inputPtr,
+                                             Image< TOutputPixel, VImageDimension > * outputPtr,
+                                             const ImageRegion< VImageDimension > & inputRegionForThread,
+                                             const ImageRegion< VImageDimension > & outputRegionForThread);
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
 };
 } // end namespace itk
@@ -19,6 +19,7 @@
 #define itkUnaryGeneratorImageFilter_hxx
 
 #include "itkUnaryGeneratorImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
@@ -110,6 +111,11 @@ UnaryGeneratorImageFilter< TInputImage, TOutputImage >
 
   this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
 
+  if ( GenerateDataOverContiguousRuns(functor, inputPtr, outputPtr, inputRegionForThread, outputRegionForThread) )
+    {
+    return;
+    }
+
   // Define the iterators
   ImageScanlineConstIterator< TInputImage > inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator< TOutputImage > outputIt(outputPtr, outputRegionForThread);
@@ -128,6 +134,38 @@ UnaryGeneratorImageFilter< TInputImage, TOutputImage >
     outputIt.NextLine();
     }
 }
+
+
+template< typename TInputImage, typename TOutputImage >
+template< typename TFunctor, typename TInputPixel, typename TOutputPixel, unsigned int VImageDimension >
+bool
+UnaryGeneratorImageFilter< TInputImage, TOutputImage >
+::GenerateDataOverContiguousRuns(const TFunctor & functor,
+                                 const Image< TInputPixel, VImageDimension > * inputPtr,
+                                 Image< TOutputPixel, VImageDimension > * outputPtr,
+                                 const ImageRegion< VImageDimension > & inputRegionForThread,
+                                 const ImageRegion< VImageDimension > & outputRegionForThread)
+{
+  if ( inputRegionForThread != outputRegionForThread )
+    {
+    return false;
+    }
+
+  const TInputPixel *inputBuffer = inputPtr->GetBufferPointer();
+  TOutputPixel *     outputBuffer = outputPtr->GetBufferPointer();
+  ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+    [inputBuffer, outputBuffer, &functor](const OffsetValueType * offsets, SizeValueType length)
+    {
+    const TInputPixel *input = inputBuffer + offsets[0];
+    TOutputPixel *     output = outputBuffer + offsets[1];
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(input[i]);
+      }
+    },
+    inputPtr, outputPtr );
+  return true;
+}
 } // end namespace itk
 
 #endif
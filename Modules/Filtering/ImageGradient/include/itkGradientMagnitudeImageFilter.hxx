@@ -102,7 +102,6 @@ GradientMagnitudeImageFilter< TInputImage, TOutputImage >
 
   ZeroFluxNeumannBoundaryCondition< TInputImage > nbc;
 
-  ConstNeighborhoodIterator< TInputImage > nit;
   ConstNeighborhoodIterator< TInputImage > bit;
   ImageRegionIterator< TOutputImage >      it;
 
@@ -140,34 +139,45 @@ GradientMagnitudeImageFilter< TInputImage, TOutputImage >
     radius[i]  = op[0].GetRadius()[0];
     }
 
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< TInputImage >::
-  FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< TInputImage > bC;
-  faceList = bC(input, outputRegionForThread, radius);
+  // Split the region into an interior region, free of boundary
+  // conditions, and the data-set boundary "faces"
+  using PartitionType = NeighborhoodAlgorithm::ImageNeighborhoodPartition< TInputImage >;
+  using InteriorNeighborhoodType = typename PartitionType::InteriorNeighborhoodType;
+  const PartitionType partition(input, outputRegionForThread, radius);
 
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< TInputImage >::
-  FaceListType::iterator fit;
-  fit = faceList.begin();
-
-  // Process non-boundary face
-  nit = ConstNeighborhoodIterator< TInputImage >(radius, input, *fit);
+  // The neighborhoods are numbered as in a Neighborhood of this radius
+  Neighborhood< char, ImageDimension > neighborhood;
+  neighborhood.SetRadius(radius);
 
   std::slice          x_slice[ImageDimension];
-  const SizeValueType center = nit.Size() / 2;
+  const SizeValueType center = neighborhood.Size() / 2;
   for ( i = 0; i < ImageDimension; ++i )
     {
-    x_slice[i] = std::slice( center - nit.GetStride(i) * radius[i],
-                             op[i].GetSize()[0], nit.GetStride(i) );
+    x_slice[i] = std::slice( center - neighborhood.GetStride(i) * radius[i],
+                             op[i].GetSize()[0], neighborhood.GetStride(i) );
     }
 
+  // Process the interior region through flat offsets in the input buffer
+  it = ImageRegionIterator< OutputImageType >( output, partition.GetInteriorRegion() );
+  partition.ForEachInteriorNeighborhood( [&](const InteriorNeighborhoodType & n)
+    {
+    RealType a = NumericTraits< RealType >::ZeroValue();
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      const RealType g = SIP(x_slice[d], n, op[d]);
+      a += g * g;
+      }
+    it.Value() = static_cast< OutputPixelType >( std::sqrt(a) );
+    ++it;
+    } );
+
   // Process each of the boundary faces.  These are N-d regions which border
   // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  for ( const auto & face : partition.GetBoundaryFaces() )
     {
     bit = ConstNeighborhoodIterator< InputImageType >(radius,
-                                                      input, *fit);
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
+                                                      input, face);
+    it = ImageRegionIterator< OutputImageType >(output, face);
     bit.OverrideBoundaryCondition(&nbc);
     bit.GoToBegin();
 
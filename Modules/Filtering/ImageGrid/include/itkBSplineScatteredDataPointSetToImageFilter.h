@@ -273,6 +273,17 @@ public:
   itkGetConstReferenceMacro( GenerateOutputImage, bool );
   itkBooleanMacro( GenerateOutputImage );
 
+  /** Set/Get whether the fitting accumulates into tiles of the control point
+   * lattice. The points are sorted along the last parametric dimension and
+   * each thread only allocates and accumulates the slab of the lattice
+   * influenced by its points, instead of a whole lattice. This saves memory
+   * and merge time with many threads and large lattices. The sums are done
+   * in a different order, so the result may differ in the last bits from the
+   * default path. Ignored when the last dimension is closed. Default = false. */
+  itkSetMacro( UseLatticeTiles, bool );
+  itkGetConstReferenceMacro( UseLatticeTiles, bool );
+  itkBooleanMacro( UseLatticeTiles );
+
   /** Get the control point lattice produced by the fitting process. */
   PointDataImagePointer GetPhiLattice()
     {
@@ -324,6 +335,19 @@ private:
   void CollapsePhiLattice( PointDataImageType *, PointDataImageType *,
     const RealType, const unsigned int );
 
+  /** Evaluate the B-spline kernel of a parametric dimension. */
+  double EvaluateKernel( const unsigned int, const RealType ) const;
+
+  /** Whether the fitting accumulates into lattice tiles. */
+  bool UseLatticeTilesForFitting() const;
+
+  /** Sort the points by cell along the last parametric dimension and split
+   * the cells among the threads for the tiled fitting. */
+  void SortPointsByLatticeCell();
+
+  /** Sum the lattice tiles of the threads into whole lattices. */
+  void MergeLatticeTiles( PointDataImagePointer &, RealImagePointer & );
+
   /** Set the grid parametric domain parameters such as the origin, size,
    * spacing, and direction. */
   void SetPhiLatticeParametricDomainParameters();
@@ -335,6 +359,7 @@ private:
   bool                                         m_DoMultilevel{ false };
   bool                                         m_GenerateOutputImage{ true };
   bool                                         m_UsePointWeights{ false };
+  bool                                         m_UseLatticeTiles{ false };
   unsigned int                                 m_MaximumNumberOfLevels{ 1 };
   unsigned int                                 m_CurrentLevel{ 0 };
   ArrayType                                    m_NumberOfControlPoints;
@@ -363,6 +388,10 @@ private:
   std::vector<RealImagePointer>                m_OmegaLatticePerThread;
   std::vector<PointDataImagePointer>           m_DeltaLatticePerThread;
 
+  std::vector<unsigned int>                    m_SortedPointIds;
+  std::vector<SizeValueType>                   m_TilePointRanges;
+  std::vector<SizeValueType>                   m_TileCellRanges;
+
   RealType                                     m_BSplineEpsilon{ static_cast< RealType >( 1e-3 ) };
   bool                                         m_IsFittingComplete{ false };
 };
@@ -19,6 +19,7 @@
 #define itkBSplineScatteredDataPointSetToImageFilter_hxx
 
 #include "itkBSplineScatteredDataPointSetToImageFilter.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageDuplicator.h"
@@ -418,21 +419,128 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
         }
       }
 
+    const bool useLatticeTiles = this->UseLatticeTilesForFitting();
+    if( useLatticeTiles )
+      {
+      this->SortPointsByLatticeCell();
+      }
+
     for( unsigned int n = 0; n < this->GetNumberOfWorkUnits(); n++ )
       {
+      typename RealImageType::RegionType region( size );
+      if( useLatticeTiles )
+        {
+        // The tile of a thread holds the control points influenced by the
+        // points of its cells along the last dimension.
+        const unsigned int lastDimension = ImageDimension - 1;
+        const SizeValueType firstCell = this->m_TileCellRanges[n];
+        const SizeValueType lastCell = this->m_TileCellRanges[n + 1];
+        if( firstCell == lastCell )
+          {
+          this->m_OmegaLatticePerThread[n] = nullptr;
+          this->m_DeltaLatticePerThread[n] = nullptr;
+          continue;
+          }
+        region.SetIndex( lastDimension, static_cast<IndexValueType>( firstCell ) );
+        region.SetSize( lastDimension, std::min<SizeValueType>(
+          lastCell - firstCell + this->m_SplineOrder[lastDimension], size[lastDimension] - firstCell ) );
+        }
+
       this->m_OmegaLatticePerThread[n] = RealImageType::New();
-      this->m_OmegaLatticePerThread[n]->SetRegions( size );
+      this->m_OmegaLatticePerThread[n]->SetRegions( region );
       this->m_OmegaLatticePerThread[n]->Allocate();
       this->m_OmegaLatticePerThread[n]->FillBuffer( 0.0 );
 
       this->m_DeltaLatticePerThread[n] = PointDataImageType::New();
-      this->m_DeltaLatticePerThread[n]->SetRegions( size );
+      this->m_DeltaLatticePerThread[n]->SetRegions( region );
       this->m_DeltaLatticePerThread[n]->Allocate();
       this->m_DeltaLatticePerThread[n]->FillBuffer( NumericTraits<PointDataType>::ZeroValue() );
       }
     }
 }
 
+template<typename TInputPointSet, typename TOutputImage>
+bool
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
+::UseLatticeTilesForFitting() const
+{
+  return this->m_UseLatticeTiles && !this->m_CloseDimension[ImageDimension - 1];
+}
+
+template<typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
+::SortPointsByLatticeCell()
+{
+  const TInputPointSet *input = this->GetInput();
+  const unsigned int lastDimension = ImageDimension - 1;
+  const SizeValueType numberOfPoints = input->GetNumberOfPoints();
+  const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnits();
+
+  // The cell of a point along the last dimension, computed as in
+  // ThreadedGenerateDataForFitting(). The points outside the parametric
+  // domain are put in the border cells: they are reported by the fitting.
+
+  const unsigned int numberOfCells =
+    this->m_CurrentNumberOfControlPoints[lastDimension] - this->m_SplineOrder[lastDimension];
+  const RealType r = static_cast<RealType>( numberOfCells ) /
+    ( static_cast<RealType>( this->m_Size[lastDimension] - 1 ) * this->m_Spacing[lastDimension] );
+
+  std::vector<unsigned int> pointCells( numberOfPoints );
+  std::vector<SizeValueType> cellStarts( numberOfCells + 1, 0 );
+  for( SizeValueType n = 0; n < numberOfPoints; n++ )
+    {
+    PointType point;
+    point.Fill( 0.0 );
+    input->GetPoint( n, &point );
+
+    const RealType p = ( point[lastDimension] - this->m_Origin[lastDimension] ) * r;
+    unsigned int cell = 0;
+    if( p >= static_cast<RealType>( numberOfCells ) )
+      {
+      cell = numberOfCells - 1;
+      }
+    else if( p > NumericTraits<RealType>::ZeroValue() )
+      {
+      cell = static_cast<unsigned int>( p );
+      }
+    pointCells[n] = cell;
+    ++cellStarts[cell + 1];
+    }
+
+  // Counting sort of the points by cell.
+
+  for( unsigned int c = 0; c < numberOfCells; c++ )
+    {
+    cellStarts[c + 1] += cellStarts[c];
+    }
+  this->m_SortedPointIds.resize( numberOfPoints );
+  std::vector<SizeValueType> nextPosition( cellStarts.begin(), cellStarts.end() - 1 );
+  for( SizeValueType n = 0; n < numberOfPoints; n++ )
+    {
+    this->m_SortedPointIds[nextPosition[pointCells[n]]++] = static_cast<unsigned int>( n );
+    }
+
+  // Give each thread a range of cells holding about the same number of
+  // points.
+
+  this->m_TileCellRanges.assign( numberOfThreads + 1, 0 );
+  for( ThreadIdType n = 1; n < numberOfThreads; n++ )
+    {
+    const SizeValueType target = numberOfPoints * n / numberOfThreads;
+    this->m_TileCellRanges[n] = std::max( this->m_TileCellRanges[n - 1], static_cast<SizeValueType>(
+      std::lower_bound( cellStarts.begin(), cellStarts.end(), target ) - cellStarts.begin() ) );
+    this->m_TileCellRanges[n] = std::min<SizeValueType>( this->m_TileCellRanges[n], numberOfCells );
+    }
+  this->m_TileCellRanges[numberOfThreads] = numberOfCells;
+
+  this->m_TilePointRanges.resize( numberOfThreads + 1 );
+  for( ThreadIdType n = 0; n <= numberOfThreads; n++ )
+    {
+    this->m_TilePointRanges[n] = cellStarts[this->m_TileCellRanges[n]];
+    }
+}
+
 template<typename TInputPointSet, typename TOutputImage>
 unsigned int
 BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
@@ -479,17 +587,32 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
 
   typename RealImageType::SizeType size;
 
+  unsigned int numberOfNeighbors = 1;
   for( unsigned int i = 0; i < ImageDimension; i++ )
     {
     size[i] = this->m_SplineOrder[i] + 1;
+    numberOfNeighbors *= size[i];
     }
-  RealImagePointer neighborhoodWeightImage = RealImageType::New();
-  neighborhoodWeightImage->SetRegions( size );
-  neighborhoodWeightImage->Allocate();
-  neighborhoodWeightImage->FillBuffer( 0.0 );
 
-  ImageRegionIteratorWithIndex<RealImageType> ItW(
-    neighborhoodWeightImage, neighborhoodWeightImage->GetRequestedRegion() );
+  // The offsets of the control points influenced by a point, in raster
+  // order, and their weights. The weights are separable: they are the
+  // products of B-spline weights evaluated once per dimension.
+  std::vector<typename RealImageType::IndexType> neighborOffsets( numberOfNeighbors );
+  for( unsigned int m = 0; m < numberOfNeighbors; m++ )
+    {
+    unsigned int remainder = m;
+    for( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      neighborOffsets[m][i] = remainder % size[i];
+      remainder /= size[i];
+      }
+    }
+  std::vector<RealType> neighborWeights( numberOfNeighbors );
+  std::vector<double>   axisWeights[ImageDimension];
+  for( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    axisWeights[i].resize( size[i] );
+    }
 
   RealArrayType p;
   RealArrayType r;
@@ -504,19 +627,33 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
 
   // Determine which points should be handled by this particular thread.
 
-  ThreadIdType numberOfThreads = this->GetNumberOfWorkUnits();
-  auto numberOfPointsPerThread = static_cast<SizeValueType>(
-    input->GetNumberOfPoints() / numberOfThreads );
+  const bool useLatticeTiles = this->UseLatticeTilesForFitting();
 
-  unsigned int start = threadId * numberOfPointsPerThread;
-  unsigned int end = start + numberOfPointsPerThread;
-  if( threadId == this->GetNumberOfWorkUnits() - 1 )
+  SizeValueType start;
+  SizeValueType end;
+  if( useLatticeTiles )
     {
-    end = input->GetNumberOfPoints();
+    start = this->m_TilePointRanges[threadId];
+    end = this->m_TilePointRanges[threadId + 1];
     }
+  else
+    {
+    ThreadIdType numberOfThreads = this->GetNumberOfWorkUnits();
+    auto numberOfPointsPerThread = static_cast<SizeValueType>(
+      input->GetNumberOfPoints() / numberOfThreads );
 
-  for( unsigned int n = start; n < end; n++ )
+    start = threadId * numberOfPointsPerThread;
+    end = start + numberOfPointsPerThread;
+    if( threadId == this->GetNumberOfWorkUnits() - 1 )
+      {
+      end = input->GetNumberOfPoints();
+      }
+    }
+
+  for( SizeValueType m = start; m < end; m++ )
     {
+    const unsigned int n = useLatticeTiles ? this->m_SortedPointIds[m] : static_cast<unsigned int>( m );
+
     PointType point;
     point.Fill( 0.0 );
 
@@ -544,58 +681,36 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
           << " is outside the corresponding parametric domain of [0, "
           << totalNumberOfSpans << ")." );
         }
+
+      for( unsigned int k = 0; k < size[i]; k++ )
+        {
+        RealType u = static_cast<RealType>( p[i] -
+          static_cast<unsigned>( p[i] ) - static_cast<IndexValueType>( k ) ) + 0.5 *
+          static_cast<RealType>( this->m_SplineOrder[i] - 1 );
+        axisWeights[i][k] = this->EvaluateKernel( i, u );
+        }
       }
 
     RealType w2Sum = 0.0;
-    for( ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW )
+    for( unsigned int m2 = 0; m2 < numberOfNeighbors; m2++ )
       {
       RealType B = 1.0;
-      typename RealImageType::IndexType idx = ItW.GetIndex();
       for( unsigned int i = 0; i < ImageDimension; i++ )
         {
-        RealType u = static_cast<RealType>( p[i] -
-          static_cast<unsigned>( p[i] ) - idx[i] ) + 0.5 *
-          static_cast<RealType>( this->m_SplineOrder[i] - 1 );
-
-        switch( this->m_SplineOrder[i] )
-          {
-          case 0:
-            {
-            B *= this->m_KernelOrder0->Evaluate( u );
-            break;
-            }
-          case 1:
-            {
-            B *= this->m_KernelOrder1->Evaluate( u );
-            break;
-            }
-          case 2:
-            {
-            B *= this->m_KernelOrder2->Evaluate( u );
-            break;
-            }
-          case 3:
-            {
-            B *= this->m_KernelOrder3->Evaluate( u );
-            break;
-            }
-          default:
-            {
-            B *= this->m_Kernel[i]->Evaluate( u );
-            break;
-            }
-          }
+        B *= axisWeights[i][neighborOffsets[m2][i]];
         }
-      ItW.Set( B );
+      neighborWeights[m2] = B;
       w2Sum += B * B;
       }
 
     RealImageType * currentThreadOmegaLattice = this->m_OmegaLatticePerThread[threadId];
     PointDataImageType * currentThreadDeltaLattice = this->m_DeltaLatticePerThread[threadId];
 
-    for( ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW )
+    const RealType wc = this->m_PointWeights->GetElement(n);
+    const PointDataType pointData = this->m_InputPointData->GetElement( n );
+    for( unsigned int m2 = 0; m2 < numberOfNeighbors; m2++ )
       {
-      typename RealImageType::IndexType idx = ItW.GetIndex();
+      typename RealImageType::IndexType idx = neighborOffsets[m2];
       for( unsigned int i = 0; i < ImageDimension; i++ )
         {
         idx[i] += static_cast<unsigned>( p[i] );
@@ -604,11 +719,10 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
           idx[i] %= size[i];
           }
         }
-      RealType wc = this->m_PointWeights->GetElement(n);
-      RealType t = ItW.Get();
+      RealType t = neighborWeights[m2];
       currentThreadOmegaLattice->SetPixel( idx,
         currentThreadOmegaLattice->GetPixel( idx ) + wc * t * t );
-      PointDataType data = this->m_InputPointData->GetElement( n );
+      PointDataType data = pointData;
       data *= ( t * t * t * wc / w2Sum );
       currentThreadDeltaLattice->SetPixel( idx,
         currentThreadDeltaLattice->GetPixel( idx ) + data );
@@ -637,12 +751,8 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
     collapsedPhiLattices[i]->SetRegions( size );
     collapsedPhiLattices[i]->Allocate();
     }
-  using ImageDuplicatorType = ImageDuplicator<PointDataImageType>;
-  typename ImageDuplicatorType::Pointer duplicator = ImageDuplicatorType::New();
-  duplicator->SetInputImage( this->m_PhiLattice );
-  duplicator->Update();
-
-  collapsedPhiLattices[ImageDimension] = duplicator->GetOutput();
+  // The lattice is only read by the collapse.
+  collapsedPhiLattices[ImageDimension] = this->m_PhiLattice;
 
   ArrayType totalNumberOfSpans;
   for( unsigned int i = 0; i < ImageDimension; i++ )
@@ -736,37 +846,54 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
     // Accumulate all the delta lattice and omega lattice values to
     // calculate the final phi lattice.
 
-    ImageRegionIterator< PointDataImageType > ItD(
-      this->m_DeltaLatticePerThread[0],
-      this->m_DeltaLatticePerThread[0]->GetLargestPossibleRegion() );
-    ImageRegionIterator< RealImageType > ItO(
-      this->m_OmegaLatticePerThread[0],
-      this->m_OmegaLatticePerThread[0]->GetLargestPossibleRegion() );
-
-    for( ThreadIdType n = 1; n < this->GetNumberOfWorkUnits(); n++ )
+    PointDataImagePointer deltaLattice;
+    RealImagePointer      omegaLattice;
+    if( this->UseLatticeTilesForFitting() )
       {
-      ImageRegionIterator< PointDataImageType > Itd(
-        this->m_DeltaLatticePerThread[n],
-        this->m_DeltaLatticePerThread[n]->GetLargestPossibleRegion() );
-      ImageRegionIterator< RealImageType > Ito(
-        this->m_OmegaLatticePerThread[n],
-        this->m_OmegaLatticePerThread[n]->GetLargestPossibleRegion() );
-
-      ItD.GoToBegin();
-      ItO.GoToBegin();
-      Itd.GoToBegin();
-      Ito.GoToBegin();
-      while( !ItD.IsAtEnd() )
+      this->MergeLatticeTiles( deltaLattice, omegaLattice );
+      }
+    else
+      {
+      deltaLattice = this->m_DeltaLatticePerThread[0];
+      omegaLattice = this->m_OmegaLatticePerThread[0];
+
+      ImageRegionIterator< PointDataImageType > ItD(
+        deltaLattice, deltaLattice->GetLargestPossibleRegion() );
+      ImageRegionIterator< RealImageType > ItO(
+        omegaLattice, omegaLattice->GetLargestPossibleRegion() );
+
+      for( ThreadIdType n = 1; n < this->GetNumberOfWorkUnits(); n++ )
         {
-        ItD.Set( ItD.Get() + Itd.Get() );
-        ItO.Set( ItO.Get() + Ito.Get() );
+        ImageRegionIterator< PointDataImageType > Itd(
+          this->m_DeltaLatticePerThread[n],
+          this->m_DeltaLatticePerThread[n]->GetLargestPossibleRegion() );
+        ImageRegionIterator< RealImageType > Ito(
+          this->m_OmegaLatticePerThread[n],
+          this->m_OmegaLatticePerThread[n]->GetLargestPossibleRegion() );
+
+        ItD.GoToBegin();
+        ItO.GoToBegin();
+        Itd.GoToBegin();
+        Ito.GoToBegin();
+        while( !ItD.IsAtEnd() )
+          {
+          ItD.Set( ItD.Get() + Itd.Get() );
+          ItO.Set( ItO.Get() + Ito.Get() );
 
-        ++ItD;
-        ++ItO;
-        ++Itd;
-        ++Ito;
+          ++ItD;
+          ++ItO;
+          ++Itd;
+          ++Ito;
+          }
         }
       }
+    this->m_DeltaLatticePerThread.clear();
+    this->m_OmegaLatticePerThread.clear();
+
+    ImageRegionConstIterator< PointDataImageType > ItD(
+      deltaLattice, deltaLattice->GetLargestPossibleRegion() );
+    ImageRegionConstIterator< RealImageType > ItO(
+      omegaLattice, omegaLattice->GetLargestPossibleRegion() );
 
     // Generate the control point lattice
 
@@ -811,6 +938,73 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
     }
 }
 
+template<typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
+::MergeLatticeTiles( PointDataImagePointer & deltaLattice, RealImagePointer & omegaLattice )
+{
+  const unsigned int lastDimension = ImageDimension - 1;
+
+  typename RealImageType::SizeType size;
+  for( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    if( this->m_CloseDimension[i] )
+      {
+      size[i] = this->m_CurrentNumberOfControlPoints[i] - this->m_SplineOrder[i];
+      }
+    else
+      {
+      size[i] = this->m_CurrentNumberOfControlPoints[i];
+      }
+    }
+
+  deltaLattice = PointDataImageType::New();
+  deltaLattice->SetRegions( size );
+  deltaLattice->Allocate();
+  omegaLattice = RealImageType::New();
+  omegaLattice->SetRegions( size );
+  omegaLattice->Allocate();
+
+  // Each slice of the lattices along the last dimension is the sum of the
+  // slices of the tiles overlapping it, added in the order of the threads.
+  // The slices are independent and are merged in parallel.
+
+  const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnits();
+  auto mergeSlice = [&]( SizeValueType slice )
+    {
+    typename RealImageType::RegionType sliceRegion( size );
+    sliceRegion.SetIndex( lastDimension, static_cast<IndexValueType>( slice ) );
+    sliceRegion.SetSize( lastDimension, 1 );
+
+    ImageRegionIterator< PointDataImageType > ItD( deltaLattice, sliceRegion );
+    ImageRegionIterator< RealImageType > ItO( omegaLattice, sliceRegion );
+    for( ItD.GoToBegin(), ItO.GoToBegin(); !ItD.IsAtEnd(); ++ItD, ++ItO )
+      {
+      ItD.Set( NumericTraits<PointDataType>::ZeroValue() );
+      ItO.Set( NumericTraits<RealType>::ZeroValue() );
+      }
+
+    for( ThreadIdType n = 0; n < numberOfThreads; n++ )
+      {
+      if( this->m_OmegaLatticePerThread[n].IsNull() ||
+          !this->m_OmegaLatticePerThread[n]->GetLargestPossibleRegion().IsInside( sliceRegion ) )
+        {
+        continue;
+        }
+      ImageRegionConstIterator< PointDataImageType > Itd(
+        this->m_DeltaLatticePerThread[n], sliceRegion );
+      ImageRegionConstIterator< RealImageType > Ito(
+        this->m_OmegaLatticePerThread[n], sliceRegion );
+      for( ItD.GoToBegin(), ItO.GoToBegin(); !ItD.IsAtEnd(); ++ItD, ++ItO, ++Itd, ++Ito )
+        {
+        ItD.Set( ItD.Get() + Itd.Get() );
+        ItO.Set( ItO.Get() + Ito.Get() );
+        }
+      }
+    };
+  this->GetMultiThreader()->ParallelizeArray( 0, size[lastDimension], mergeSlice, nullptr );
+}
+
 template<typename TInputPointSet, typename TOutputImage>
 void
 BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
@@ -974,24 +1168,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
 ::UpdatePointSet()
 {
   const TInputPointSet *input = this->GetInput();
-  PointDataImagePointer collapsedPhiLattices[ImageDimension + 1];
-  for( unsigned int i = 0; i < ImageDimension; i++ )
-    {
-    collapsedPhiLattices[i] = PointDataImageType::New();
-    collapsedPhiLattices[i]->SetOrigin( this->m_PhiLattice->GetOrigin() );
-    collapsedPhiLattices[i]->SetSpacing( this->m_PhiLattice->GetSpacing() );
-    collapsedPhiLattices[i]->SetDirection( this->m_PhiLattice->GetDirection() );
 
-    typename PointDataImageType::SizeType size;
-    size.Fill( 1 );
-    for( unsigned int j = 0; j < i; j++ )
-      {
-      size[j] = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[j];
-      }
-    collapsedPhiLattices[i]->SetRegions( size );
-    collapsedPhiLattices[i]->Allocate();
-    }
-  collapsedPhiLattices[ImageDimension] = this->m_PhiLattice;
   ArrayType totalNumberOfSpans;
   for( unsigned int i = 0; i < ImageDimension; i++ )
     {
@@ -1021,61 +1198,107 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
     epsilon[i] = r[i] * this->m_Spacing[i] * this->m_BSplineEpsilon;
     }
 
-  FixedArray<RealType, ImageDimension> U;
-  FixedArray<RealType, ImageDimension> currentU;
-  currentU.Fill( -1 );
-
   typename PointDataImageType::IndexType startPhiIndex =
     this->m_PhiLattice->GetLargestPossibleRegion().GetIndex();
 
+  using PointIdentifier = typename PointDataContainerType::ElementIdentifier;
+  std::vector<PointIdentifier> pointIds;
+  pointIds.reserve( this->m_InputPointData->Size() );
   typename PointDataContainerType::ConstIterator ItIn =
     this->m_InputPointData->Begin();
   while( ItIn != this->m_InputPointData->End() )
     {
-    PointType point;
-    point.Fill( 0.0 );
+    pointIds.push_back( ItIn.Index() );
+    ++ItIn;
+    }
+  std::vector<PointDataType> pointData( pointIds.size() );
 
-    input->GetPoint( ItIn.Index(), &point );
+  // The points are evaluated in parallel, in chunks of consecutive points,
+  // each chunk with its own collapsed lattices so that the collapse is
+  // reused between neighboring points.
 
+  const SizeValueType numberOfPoints = pointIds.size();
+  const SizeValueType numberOfChunks = std::max<SizeValueType>( 1,
+    std::min<SizeValueType>( this->GetNumberOfWorkUnits(), numberOfPoints ) );
+
+  auto evaluateChunk = [&]( SizeValueType chunk )
+    {
+    PointDataImagePointer collapsedPhiLattices[ImageDimension + 1];
     for( unsigned int i = 0; i < ImageDimension; i++ )
       {
-      U[i] = static_cast<RealType>( totalNumberOfSpans[i] ) *
-        static_cast<RealType>( point[i] - this->m_Origin[i] ) /
-        ( static_cast<RealType>( this->m_Size[i] - 1 ) * this->m_Spacing[i] );
-
-      if( std::abs( U[i] - static_cast<RealType>( totalNumberOfSpans[i] ) ) <= epsilon[i] )
+      collapsedPhiLattices[i] = PointDataImageType::New();
+      collapsedPhiLattices[i]->SetOrigin( this->m_PhiLattice->GetOrigin() );
+      collapsedPhiLattices[i]->SetSpacing( this->m_PhiLattice->GetSpacing() );
+      collapsedPhiLattices[i]->SetDirection( this->m_PhiLattice->GetDirection() );
+
+      typename PointDataImageType::SizeType size;
+      size.Fill( 1 );
+      for( unsigned int j = 0; j < i; j++ )
         {
-        U[i] = static_cast<RealType>( totalNumberOfSpans[i] ) - epsilon[i];
-        }
-      if( U[i] < NumericTraits<RealType>::ZeroValue() && std::abs( U[i] ) <= epsilon[i] )
-        {
-        U[i] = NumericTraits<RealType>::ZeroValue();
+        size[j] = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[j];
         }
+      collapsedPhiLattices[i]->SetRegions( size );
+      collapsedPhiLattices[i]->Allocate();
+      }
+    collapsedPhiLattices[ImageDimension] = this->m_PhiLattice;
 
-      if( U[i] < NumericTraits<RealType>::ZeroValue() ||
-          U[i] >= static_cast<RealType>( totalNumberOfSpans[i] ) )
+    FixedArray<RealType, ImageDimension> U;
+    FixedArray<RealType, ImageDimension> currentU;
+    currentU.Fill( -1 );
+
+    const SizeValueType start = numberOfPoints * chunk / numberOfChunks;
+    const SizeValueType end = numberOfPoints * ( chunk + 1 ) / numberOfChunks;
+    for( SizeValueType n = start; n < end; n++ )
+      {
+      PointType point;
+      point.Fill( 0.0 );
+
+      input->GetPoint( pointIds[n], &point );
+
+      for( unsigned int i = 0; i < ImageDimension; i++ )
         {
-        itkExceptionMacro( "The collapse point component " << U[i]
-          << " is outside the corresponding parametric domain of [0, "
-          << totalNumberOfSpans[i] << ")." );
+        U[i] = static_cast<RealType>( totalNumberOfSpans[i] ) *
+          static_cast<RealType>( point[i] - this->m_Origin[i] ) /
+          ( static_cast<RealType>( this->m_Size[i] - 1 ) * this->m_Spacing[i] );
+
+        if( std::abs( U[i] - static_cast<RealType>( totalNumberOfSpans[i] ) ) <= epsilon[i] )
+          {
+          U[i] = static_cast<RealType>( totalNumberOfSpans[i] ) - epsilon[i];
+          }
+        if( U[i] < NumericTraits<RealType>::ZeroValue() && std::abs( U[i] ) <= epsilon[i] )
+          {
+          U[i] = NumericTraits<RealType>::ZeroValue();
+          }
+
+        if( U[i] < NumericTraits<RealType>::ZeroValue() ||
+            U[i] >= static_cast<RealType>( totalNumberOfSpans[i] ) )
+          {
+          itkExceptionMacro( "The collapse point component " << U[i]
+            << " is outside the corresponding parametric domain of [0, "
+            << totalNumberOfSpans[i] << ")." );
+          }
         }
-      }
-    for( int i = ImageDimension - 1; i >= 0; i-- )
-      {
-      if( Math::NotExactlyEquals(U[i], currentU[i]) )
+      for( int i = ImageDimension - 1; i >= 0; i-- )
         {
-        for( int j = i; j >= 0; j-- )
+        if( Math::NotExactlyEquals(U[i], currentU[i]) )
           {
-          this->CollapsePhiLattice( collapsedPhiLattices[j + 1],
-            collapsedPhiLattices[j], U[j], j );
-          currentU[j] = U[j];
+          for( int j = i; j >= 0; j-- )
+            {
+            this->CollapsePhiLattice( collapsedPhiLattices[j + 1],
+              collapsedPhiLattices[j], U[j], j );
+            currentU[j] = U[j];
+            }
+          break;
           }
-        break;
         }
+      pointData[n] = collapsedPhiLattices[0]->GetPixel( startPhiIndex );
       }
-    this->m_OutputPointData->InsertElement( ItIn.Index(),
-      collapsedPhiLattices[0]->GetPixel( startPhiIndex ) );
-    ++ItIn;
+    };
+  this->GetMultiThreader()->ParallelizeArray( 0, numberOfChunks, evaluateChunk, nullptr );
+
+  for( SizeValueType n = 0; n < numberOfPoints; n++ )
+    {
+    this->m_OutputPointData->InsertElement( pointIds[n], pointData[n] );
     }
 }
 
@@ -1086,57 +1309,74 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
   PointDataImageType *collapsedLattice,
   const RealType u, const unsigned int dimension )
 {
-  ImageRegionIteratorWithIndex< PointDataImageType > It(
-    collapsedLattice, collapsedLattice->GetLargestPossibleRegion() );
+  // The B-spline weights along the collapsed dimension are the same for all
+  // the pixels of the collapsed lattice, and are evaluated once. The
+  // collapsed lattice spans the dimensions below the collapsed one, so a
+  // pixel of the lattice is a pixel of the collapsed lattice plus a multiple
+  // of its number of pixels.
+
+  const unsigned int numberOfWeights = this->m_SplineOrder[dimension] + 1;
+  const SizeValueType latticeSize =
+    lattice->GetLargestPossibleRegion().GetSize()[dimension];
+
+  std::vector<RealType>      weights( numberOfWeights );
+  std::vector<SizeValueType> latticeIndices( numberOfWeights );
+  for( unsigned int i = 0; i < numberOfWeights; i++ )
+    {
+    auto index = static_cast<IndexValueType>( static_cast<unsigned int>( u ) + i );
+    weights[i] = this->EvaluateKernel( dimension, u - index + 0.5 *
+      static_cast<RealType>( this->m_SplineOrder[dimension] - 1 ) );
+    if( this->m_CloseDimension[dimension] )
+      {
+      index %= latticeSize;
+      }
+    latticeIndices[i] = static_cast<SizeValueType>( index );
+    }
 
-  for( It.GoToBegin(); !It.IsAtEnd(); ++It )
+  const SizeValueType numberOfCollapsedPixels =
+    collapsedLattice->GetBufferedRegion().GetNumberOfPixels();
+  const PointDataType *latticeBuffer = lattice->GetBufferPointer();
+  PointDataType *collapsedBuffer = collapsedLattice->GetBufferPointer();
+
+  for( SizeValueType q = 0; q < numberOfCollapsedPixels; q++ )
     {
     PointDataType data;
     data.Fill( 0.0 );
-    typename PointDataImageType::IndexType idx = It.GetIndex();
-    for( unsigned int i = 0; i < this->m_SplineOrder[dimension] + 1; i++ )
+    for( unsigned int i = 0; i < numberOfWeights; i++ )
       {
-      idx[dimension] = static_cast<unsigned int>( u ) + i;
-      RealType v = u - idx[dimension] + 0.5 * static_cast<RealType>(
-        this->m_SplineOrder[dimension] - 1 );
+      data += ( latticeBuffer[q + latticeIndices[i] * numberOfCollapsedPixels] * weights[i] );
+      }
+    collapsedBuffer[q] = data;
+    }
+}
 
-      RealType B = 0.0;
-      switch( this->m_SplineOrder[dimension] )
-        {
-        case 0:
-          {
-          B = this->m_KernelOrder0->Evaluate( v );
-          break;
-          }
-        case 1:
-          {
-          B = this->m_KernelOrder1->Evaluate( v );
-          break;
-          }
-        case 2:
-          {
-          B = this->m_KernelOrder2->Evaluate( v );
-          break;
-          }
-        case 3:
-          {
-          B = this->m_KernelOrder3->Evaluate( v );
-          break;
-          }
-        default:
-          {
-          B = this->m_Kernel[dimension]->Evaluate( v );
-          break;
-          }
-        }
-      if( this->m_CloseDimension[dimension] )
-        {
-        idx[dimension] %=
-          lattice->GetLargestPossibleRegion().GetSize()[dimension];
-        }
-      data += ( lattice->GetPixel( idx ) * B );
+template<typename TInputPointSet, typename TOutputImage>
+double
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
+::EvaluateKernel( const unsigned int dimension, const RealType u ) const
+{
+  switch( this->m_SplineOrder[dimension] )
+    {
+    case 0:
+      {
+      return this->m_KernelOrder0->Evaluate( u );
+      }
+    case 1:
+      {
+      return this->m_KernelOrder1->Evaluate( u );
+      }
+    case 2:
+      {
+      return this->m_KernelOrder2->Evaluate( u );
+      }
+    case 3:
+      {
+      return this->m_KernelOrder3->Evaluate( u );
+      }
+    default:
+      {
+      return this->m_Kernel[dimension]->Evaluate( u );
       }
-    It.Set( data );
     }
 }
 
@@ -1216,6 +1456,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>
   os << indent << "Do multi level: " << this->m_DoMultilevel << std::endl;
   os << indent << "Generate output image: " << this->m_GenerateOutputImage << std::endl;
   os << indent << "Use point weights: " << this->m_UsePointWeights << std::endl;
+  os << indent << "Use lattice tiles: " << this->m_UseLatticeTiles << std::endl;
   os << indent << "Maximum number of levels: " << this->m_MaximumNumberOfLevels << std::endl;
   os << indent << "Current level: " << this->m_CurrentLevel << std::endl;
   os << indent << "Number of control points: "
@@ -150,7 +150,7 @@ PasteImageFilter< TInputImage, TSourceImage, TOutputImage >
   //    thread, so copy data as needed from both the source and
   //    destination.
   //
-  if ( !useSource && !( this->GetInPlace() && this->CanRunInPlace() ) )
+  if ( !useSource && !this->GetRunningInPlace() )
     {
     // Paste region is outside this thread, so just copy the destination
     // input to the output
@@ -176,7 +176,7 @@ PasteImageFilter< TInputImage, TSourceImage, TOutputImage >
     // copy the destination to the output then overwrite the
     // appropriate output pixels with the source.
 
-     if ( !( this->GetInPlace() && this->CanRunInPlace() ) )
+     if ( !this->GetRunningInPlace() )
        {
        // Copy destination to output
        ImageAlgorithm::Copy( destPtr, outputPtr, outputRegionForThread, outputRegionForThread );
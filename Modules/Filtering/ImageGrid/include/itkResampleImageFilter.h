@@ -342,6 +342,33 @@ private:
   template <typename TPixel>
   static PixelType CastPixelWithBoundsChecking(const TPixel value);
 
+  /** Cast pixel from interpolator output to PixelType, into outputValue.
+   * A VariableLengthVector outputValue is only reallocated when its length
+   * changes. */
+  static void CastPixelWithBoundsChecking(const ComponentType value, PixelType & outputValue);
+
+  template <typename TPixel>
+  static void CastPixelWithBoundsChecking(const TPixel & value, PixelType & outputValue);
+
+  /** Evaluate the interpolator into value.  The VariableLengthVector
+   * values of VectorImage's are reused from pixel to pixel, instead of
+   * being allocated for each pixel. */
+  template <typename TValue>
+  static void EvaluateInterpolatorInto(const InterpolatorType * interpolator,
+                                       const ContinuousInputIndexType & index,
+                                       VariableLengthVector< TValue > & value)
+  {
+    interpolator->EvaluateAtContinuousIndexInto(index, value);
+  }
+
+  template <typename TValue>
+  static void EvaluateInterpolatorInto(const InterpolatorType * interpolator,
+                                       const ContinuousInputIndexType & index,
+                                       TValue & value)
+  {
+    value = interpolator->EvaluateAtContinuousIndex(index);
+  }
+
   SizeType                m_Size;         // Size of the output image
   InterpolatorPointerType m_Interpolator; // Image function for
                                           // interpolation
@@ -319,6 +319,48 @@ auto ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType,
 }
 
 
+template< typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType >
+void
+ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType >
+::CastPixelWithBoundsChecking(const ComponentType value, PixelType & outputValue)
+{
+  outputValue = CastComponentWithBoundsChecking(value);
+}
+
+
+template< typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType >
+template <typename TPixel>
+void
+ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType >
+::CastPixelWithBoundsChecking(const TPixel & value, PixelType & outputValue)
+{
+  static_assert(std::is_same<TPixel, InterpolatorOutputType>::value,
+    "TPixel should just be the same as the InterpolatorOutputType!");
+  static_assert(!std::is_same<TPixel, ComponentType>::value,
+    "For ComponentType there is a more efficient overload, that should be called instead!");
+
+  const unsigned int nComponents = InterpolatorConvertType::GetNumberOfComponents(value);
+
+  if ( NumericTraits<PixelType>::GetLength(outputValue) != nComponents )
+    {
+    NumericTraits<PixelType>::SetLength(outputValue, nComponents);
+    }
+
+  for (unsigned int n = 0; n < nComponents; ++n)
+  {
+    const ComponentType component = InterpolatorConvertType::GetNthComponent(n, value);
+    PixelConvertType::SetNthComponent(n, outputValue,
+      Self::CastComponentWithBoundsChecking(component));
+  }
+}
+
+
 template< typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -350,6 +392,11 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTra
 
   using OutputType = typename InterpolatorType::OutputType;
 
+  // The values are reused from pixel to pixel, so that variable length
+  // pixels are not allocated for each pixel
+  OutputType value;
+  PixelType  outputValue;
+
   // Walk the output region
   outIt.GoToBegin();
 
@@ -362,12 +409,12 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTra
     inputPoint = transformPtr->TransformPoint(outputPoint);
     const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
 
-    OutputType value;
     // Evaluate input at right position and copy to the output
     if( m_Interpolator->IsInsideBuffer(inputIndex) && ( !isSpecialCoordinatesImage || isInsideInput ) )
       {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set( Self::CastPixelWithBoundsChecking(value) );
+      Self::EvaluateInterpolatorInto(m_Interpolator.GetPointer(), inputIndex, value);
+      Self::CastPixelWithBoundsChecking(value, outputValue);
+      outIt.Set( outputValue );
       }
     else
       {
@@ -414,7 +461,10 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTra
   // Cache information from the superclass
   PixelType defaultValue = this->GetDefaultPixelValue();
 
-  using OutputType = typename InterpolatorType::OutputType;
+  // The values are reused from pixel to pixel, so that variable length
+  // pixels are not allocated for each pixel
+  OutputType value;
+  PixelType  outputValue;
 
   // As we walk across a scan line in the output image, we trace
   // an oriented/scaled/translated line in the input image. Each scan
@@ -463,12 +513,12 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType, TTra
         inputIndex[i] += alpha * ( endIndex[i] - startIndex[i] );
         }
 
-      OutputType value;
       // Evaluate input at right position and copy to the output
       if ( m_Interpolator->IsInsideBuffer(inputIndex) )
         {
-        value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set( Self::CastPixelWithBoundsChecking(value) );
+        Self::EvaluateInterpolatorInto(m_Interpolator.GetPointer(), inputIndex, value);
+        Self::CastPixelWithBoundsChecking(value, outputValue);
+        outIt.Set( outputValue );
         }
       else
         {
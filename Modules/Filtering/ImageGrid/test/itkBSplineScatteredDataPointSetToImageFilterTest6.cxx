@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPointSet.h"
+#include "itkBSplineScatteredDataPointSetToImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+
+/**
+ * In this test, we approximate a 3-D scalar field from random scattered
+ * points, with and without the lattice tiles, and check that both fittings
+ * agree on the control point lattice and on the sampled output.
+ */
+namespace
+{
+
+constexpr unsigned int ParametricDimension = 3;
+constexpr unsigned int DataDimension = 1;
+
+using RealType = float;
+using VectorType = itk::Vector<RealType, DataDimension>;
+using VectorImageType = itk::Image<VectorType, ParametricDimension>;
+using PointSetType = itk::PointSet<VectorImageType::PixelType, ParametricDimension>;
+using FilterType = itk::BSplineScatteredDataPointSetToImageFilter<PointSetType, VectorImageType>;
+
+FilterType::Pointer
+Fit( const PointSetType * pointSet, bool useLatticeTiles, unsigned int numberOfWorkUnits )
+{
+  VectorImageType::SizeType size;
+  size.Fill( 40 );
+  VectorImageType::PointType origin;
+  origin.Fill( 0 );
+  VectorImageType::SpacingType spacing;
+  spacing.Fill( 1 );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetOrigin( origin );
+  filter->SetSpacing( spacing );
+  filter->SetSize( size );
+  filter->SetInput( pointSet );
+  filter->SetSplineOrder( 3 );
+  FilterType::ArrayType ncps;
+  ncps.Fill( 6 );
+  filter->SetNumberOfControlPoints( ncps );
+  filter->SetNumberOfLevels( 3 );
+  filter->SetUseLatticeTiles( useLatticeTiles );
+  filter->SetNumberOfWorkUnits( numberOfWorkUnits );
+  filter->Update();
+
+  return filter;
+}
+
+template<typename TImage>
+double
+MaximumDifference( const TImage * image1, const TImage * image2 )
+{
+  double maximumDifference = 0.0;
+  itk::ImageRegionConstIterator<TImage> It1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator<TImage> It2( image2, image2->GetLargestPossibleRegion() );
+  for( ; !It1.IsAtEnd(); ++It1, ++It2 )
+    {
+    maximumDifference = std::max( maximumDifference,
+      static_cast<double>( ( It1.Get() - It2.Get() ).GetNorm() ) );
+    }
+  return maximumDifference;
+}
+
+bool
+CompareFittings( const PointSetType * pointSet, const char * description )
+{
+  FilterType::Pointer reference;
+  ITK_TRY_EXPECT_NO_EXCEPTION( reference = Fit( pointSet, false, 1 ) );
+
+  bool passed = true;
+  for( unsigned int numberOfWorkUnits : { 1, 3, 8 } )
+    {
+    FilterType::Pointer tiled;
+    ITK_TRY_EXPECT_NO_EXCEPTION( tiled = Fit( pointSet, true, numberOfWorkUnits ) );
+
+    const double latticeDifference =
+      MaximumDifference<VectorImageType>( reference->GetPhiLattice(), tiled->GetPhiLattice() );
+    const double outputDifference =
+      MaximumDifference<VectorImageType>( reference->GetOutput(), tiled->GetOutput() );
+    if( latticeDifference > 1e-3 || outputDifference > 1e-3 )
+      {
+      std::cerr << "Test failed for " << description << " with " << numberOfWorkUnits
+        << " work units!" << std::endl;
+      std::cerr << "Maximum lattice difference: " << latticeDifference
+        << ", maximum output difference: " << outputDifference << std::endl;
+      passed = false;
+      }
+    }
+  return passed;
+}
+
+} // end namespace
+
+int itkBSplineScatteredDataPointSetToImageFilterTest6( int, char * [] )
+{
+  FilterType::Pointer filter = FilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN( filter, UseLatticeTiles, false );
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  // Points spread over the whole domain.
+  PointSetType::Pointer pointSet = PointSetType::New();
+  for( unsigned int n = 0; n < 2000; n++ )
+    {
+    PointSetType::PointType point;
+    for( unsigned int d = 0; d < ParametricDimension; d++ )
+      {
+      point[d] = generator->GetUniformVariate( 0.0, 39.0 );
+      }
+    VectorType data;
+    data[0] = std::sin( 0.2 * point[0] ) + std::cos( 0.1 * point[1] * point[2] / 39.0 )
+      + generator->GetNormalVariate( 0.0, 0.01 );
+    pointSet->SetPoint( n, point );
+    pointSet->SetPointData( n, data );
+    }
+
+  // Points gathered in a few slices, which leaves some tiles empty.
+  PointSetType::Pointer slicePointSet = PointSetType::New();
+  for( unsigned int n = 0; n < 500; n++ )
+    {
+    PointSetType::PointType point;
+    point[0] = generator->GetUniformVariate( 0.0, 39.0 );
+    point[1] = generator->GetUniformVariate( 0.0, 39.0 );
+    point[2] = 20.0 + generator->GetIntegerVariate( 2 );
+    VectorType data;
+    data[0] = generator->GetUniformVariate( -1.0, 1.0 );
+    slicePointSet->SetPoint( n, point );
+    slicePointSet->SetPointData( n, data );
+    }
+
+  bool passed = true;
+  passed &= CompareFittings( pointSet, "spread points" );
+  passed &= CompareFittings( slicePointSet, "points in a few slices" );
+
+  if( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
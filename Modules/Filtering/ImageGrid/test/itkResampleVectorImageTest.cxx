@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkResampleImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVectorImage.h"
+#include "itkVectorIndexSelectionCastImageFilter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Resamples a VectorImage, whose pixels are VariableLengthVector's, and
+// checks that each component matches the resampling of the scalar image of
+// this component, and that the number of allocations does not grow with the
+// number of output pixels.
+namespace
+{
+// The allocations are counted by the global operator new of the test driver
+std::atomic< itk::SizeValueType > numberOfAllocations( 0 );
+} // end namespace
+
+void * operator new( std::size_t size )
+{
+  ++numberOfAllocations;
+  void * pointer = std::malloc( size > 0 ? size : 1 );
+  if ( pointer == nullptr )
+    {
+    throw std::bad_alloc();
+    }
+  return pointer;
+}
+
+void operator delete( void * pointer ) noexcept
+{
+  std::free( pointer );
+}
+
+void operator delete( void * pointer, std::size_t ) noexcept
+{
+  std::free( pointer );
+}
+
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+constexpr unsigned int NumberOfComponents = 3;
+
+using ComponentType = float;
+using VectorImageType = itk::VectorImage< ComponentType, Dimension >;
+using ScalarImageType = itk::Image< ComponentType, Dimension >;
+
+// An affine transform that ResampleImageFilter resamples pixel by pixel
+class NonlinearAffineTransform:
+  public itk::AffineTransform< double, Dimension >
+{
+public:
+  using Self = NonlinearAffineTransform;
+  using Superclass = itk::AffineTransform< double, Dimension >;
+  using Pointer = itk::SmartPointer< Self >;
+  using ConstPointer = itk::SmartPointer< const Self >;
+
+  itkSimpleNewMacro(Self);
+  itkTypeMacro(NonlinearAffineTransform, AffineTransform);
+
+  TransformCategoryType GetTransformCategory() const override
+  {
+    return Self::UnknownTransformCategory;
+  }
+};
+
+template< typename TTransform >
+bool
+ResampleAndCompare( const VectorImageType * input, const TTransform * transform )
+{
+  using VectorResampleType = itk::ResampleImageFilter< VectorImageType, VectorImageType >;
+  using ScalarResampleType = itk::ResampleImageFilter< ScalarImageType, ScalarImageType >;
+  using SelectionType = itk::VectorIndexSelectionCastImageFilter< VectorImageType, ScalarImageType >;
+
+  VectorResampleType::PixelType defaultValue( NumberOfComponents );
+  defaultValue.Fill( -1.0f );
+
+  auto vectorResample = VectorResampleType::New();
+  vectorResample->SetInput( input );
+  vectorResample->SetTransform( transform );
+  vectorResample->SetDefaultPixelValue( defaultValue );
+  vectorResample->UseReferenceImageOn();
+  vectorResample->SetReferenceImage( input );
+  vectorResample->Update();
+  const VectorImageType * vectorOutput = vectorResample->GetOutput();
+
+  for ( unsigned int component = 0; component < NumberOfComponents; ++component )
+    {
+    auto selection = SelectionType::New();
+    selection->SetInput( input );
+    selection->SetIndex( component );
+
+    auto scalarResample = ScalarResampleType::New();
+    scalarResample->SetInput( selection->GetOutput() );
+    scalarResample->SetTransform( transform );
+    scalarResample->SetDefaultPixelValue( -1.0f );
+    scalarResample->UseReferenceImageOn();
+    scalarResample->SetReferenceImage( input );
+    scalarResample->Update();
+
+    itk::ImageRegionConstIteratorWithIndex< ScalarImageType > it( scalarResample->GetOutput(),
+      scalarResample->GetOutput()->GetBufferedRegion() );
+    for ( ; !it.IsAtEnd(); ++it )
+      {
+      const ComponentType vectorValue = vectorOutput->GetPixel( it.GetIndex() )[component];
+      if ( std::abs( vectorValue - it.Get() ) > 1e-4f )
+        {
+        std::cerr << "Component " << component << " at " << it.GetIndex() << " is " << vectorValue
+                  << " instead of " << it.Get() << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Number of allocations made by the resampling of the image into an output
+// image of the given size
+template< typename TTransform >
+itk::SizeValueType
+CountResampleAllocations( const VectorImageType * input, const TTransform * transform,
+                          const VectorImageType::SizeType & outputSize )
+{
+  using VectorResampleType = itk::ResampleImageFilter< VectorImageType, VectorImageType >;
+
+  auto vectorResample = VectorResampleType::New();
+  vectorResample->SetInput( input );
+  vectorResample->SetTransform( transform );
+  vectorResample->SetSize( outputSize );
+  vectorResample->SetNumberOfWorkUnits( 1 );
+
+  const itk::SizeValueType numberOfAllocationsBefore = numberOfAllocations;
+  vectorResample->Update();
+  return numberOfAllocations - numberOfAllocationsBefore;
+}
+
+} // end namespace
+
+int itkResampleVectorImageTest( int, char *[] )
+{
+  VectorImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 23;
+  VectorImageType::Pointer input = VectorImageType::New();
+  input->SetRegions( size );
+  input->SetNumberOfComponentsPerPixel( NumberOfComponents );
+  input->Allocate();
+  VectorImageType::PixelType value( NumberOfComponents );
+  for ( itk::ImageRegionIteratorWithIndex< VectorImageType > it( input, input->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const VectorImageType::IndexType index = it.GetIndex();
+    for ( unsigned int component = 0; component < NumberOfComponents; ++component )
+      {
+      value[component] = static_cast< ComponentType >( ( index[0] * ( component + 3 ) + index[1] * index[1] * ( component + 1 ) ) % 101 );
+      }
+    it.Set( value );
+    }
+
+  // The selection of a component of a VectorImage
+  using SelectionType = itk::VectorIndexSelectionCastImageFilter< VectorImageType, ScalarImageType >;
+  auto selection = SelectionType::New();
+  selection->SetInput( input );
+  selection->SetIndex( 2 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( selection->Update() );
+  for ( itk::ImageRegionConstIteratorWithIndex< ScalarImageType > it( selection->GetOutput(),
+        selection->GetOutput()->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    ITK_TEST_EXPECT_EQUAL( it.Get(), input->GetPixel( it.GetIndex() )[2] );
+    }
+  selection->SetIndex( NumberOfComponents );
+  ITK_TRY_EXPECT_EXCEPTION( selection->Update() );
+
+  // A linear transform, resampled scan line by scan line
+  using AffineTransformType = itk::AffineTransform< double, Dimension >;
+  auto affineTransform = AffineTransformType::New();
+  AffineTransformType::OutputVectorType translation;
+  translation[0] = 2.3;
+  translation[1] = -1.7;
+  affineTransform->Rotate2D( 0.2 );
+  affineTransform->Translate( translation );
+  ITK_TEST_EXPECT_TRUE( ResampleAndCompare( input.GetPointer(), affineTransform.GetPointer() ) );
+
+  // and pixel by pixel
+  auto nonlinearTransform = NonlinearAffineTransform::New();
+  nonlinearTransform->Rotate2D( -0.3 );
+  nonlinearTransform->Translate( translation );
+  ITK_TEST_EXPECT_TRUE( ResampleAndCompare( input.GetPointer(), nonlinearTransform.GetPointer() ) );
+
+  // The interpolated values and the output pixels are reused: growing the
+  // output by thousands of pixels must not add any allocation
+  VectorImageType::SizeType smallSize;
+  smallSize.Fill( 20 );
+  VectorImageType::SizeType largeSize;
+  largeSize.Fill( 80 );
+  for ( unsigned int pixelByPixel = 0; pixelByPixel < 2; ++pixelByPixel )
+    {
+    const itk::SizeValueType smallAllocations = pixelByPixel
+      ? CountResampleAllocations( input.GetPointer(), nonlinearTransform.GetPointer(), smallSize )
+      : CountResampleAllocations( input.GetPointer(), affineTransform.GetPointer(), smallSize );
+    const itk::SizeValueType largeAllocations = pixelByPixel
+      ? CountResampleAllocations( input.GetPointer(), nonlinearTransform.GetPointer(), largeSize )
+      : CountResampleAllocations( input.GetPointer(), affineTransform.GetPointer(), largeSize );
+    std::cout << ( pixelByPixel ? "Pixel by pixel: " : "Scan line by scan line: " )
+              << smallAllocations << " allocations for " << smallSize << " pixels, "
+              << largeAllocations << " for " << largeSize << std::endl;
+    ITK_TEST_EXPECT_TRUE( largeAllocations <= smallAllocations );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -115,7 +115,7 @@ void
 ClampImageFilter< TInputImage, TOutputImage >
 ::GenerateData()
   {
-  if( this->GetInPlace() && this->CanRunInPlace()
+  if( this->ShouldRunInPlace() && this->CanRunInPlace()
     && this->GetLowerBound() <= NumericTraits< OutputPixelType >::NonpositiveMin()
     && this->GetUpperBound() >= NumericTraits< OutputPixelType >::max() )
     {
@@ -123,9 +123,14 @@ ClampImageFilter< TInputImage, TOutputImage >
     // and the specified bounds are equal to the output-type limits,
     // then there is nothing to do. To avoid iterating over all the pixels for
     // nothing, graft the input to the output, generate a fake progress and exit.
+    // The input is grafted only when its buffered region is the requested
+    // region of the output.
     this->AllocateOutputs();
-    ProgressReporter progress(this, 0, 1);
-    return;
+    if( this->GetRunningInPlace() )
+      {
+      ProgressReporter progress(this, 0, 1);
+      return;
+      }
     }
   Superclass::GenerateData();
   }
@@ -0,0 +1,289 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPointwiseExpressionImageFilter_h
+#define itkPointwiseExpressionImageFilter_h
+
+#include "itkInPlaceImageFilter.h"
+#include "itkMath.h"
+#include "itkNumericTraits.h"
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class Compose
+ * \brief Functor applying a first unary functor, then a second one to the
+ * result.
+ *
+ * Compose lets a chain of pixel-wise operations be evaluated as a single
+ * functor, so that UnaryGeneratorImageFilter or
+ * PointwiseExpressionImageFilter visit the pixels once for the whole
+ * chain.  MakeComposition() builds the composition of any number of
+ * functors.
+ *
+ * \ingroup ITKImageIntensity
+ */
+template< typename TFirst, typename TSecond >
+class Compose
+{
+public:
+  Compose() = default;
+  Compose(const TFirst & first, const TSecond & second):
+    m_First(first),
+    m_Second(second)
+  {}
+
+  bool operator!=(const Compose & other) const
+  {
+    return m_First != other.m_First || m_Second != other.m_Second;
+  }
+
+  bool operator==(const Compose & other) const
+  {
+    return !( *this != other );
+  }
+
+  template< typename TInput >
+  inline auto operator()(const TInput & A) const -> decltype( std::declval< TSecond >()( std::declval< TFirst >()( A ) ) )
+  {
+    return m_Second( m_First( A ) );
+  }
+
+  const TFirst & GetFirst() const { return m_First; }
+  const TSecond & GetSecond() const { return m_Second; }
+
+private:
+  TFirst  m_First;
+  TSecond m_Second;
+};
+
+/** \class BindSecond
+ * \brief Functor applying a binary functor with a constant second operand.
+ *
+ * BindSecond turns the binary functors of itkArithmeticOpsFunctors.h, such
+ * as Add2 or Mult, in unary functors that can be composed.
+ *
+ * \ingroup ITKImageIntensity
+ */
+template< typename TFunctor, typename TConstant >
+class BindSecond
+{
+public:
+  BindSecond() = default;
+  BindSecond(const TFunctor & functor, const TConstant & constant):
+    m_Functor(functor),
+    m_Constant(constant)
+  {}
+
+  bool operator!=(const BindSecond & other) const
+  {
+    return m_Functor != other.m_Functor || Math::NotExactlyEquals(m_Constant, other.m_Constant);
+  }
+
+  bool operator==(const BindSecond & other) const
+  {
+    return !( *this != other );
+  }
+
+  template< typename TInput >
+  inline auto operator()(const TInput & A) const -> decltype( std::declval< TFunctor >()( A, std::declval< TConstant >() ) )
+  {
+    return m_Functor(A, m_Constant);
+  }
+
+private:
+  TFunctor  m_Functor;
+  TConstant m_Constant{};
+};
+
+/** Composition of functors, applied from the first to the last. */
+template< typename TFunctor >
+TFunctor MakeComposition(const TFunctor & functor)
+{
+  return functor;
+}
+
+template< typename TFirst, typename TSecond, typename... TOthers >
+auto MakeComposition(const TFirst & first, const TSecond & second, const TOthers & ... others)
+  -> decltype( MakeComposition( Compose< TFirst, TSecond >( first, second ), others ... ) )
+{
+  return MakeComposition( Compose< TFirst, TSecond >( first, second ), others ... );
+}
+} // end namespace Functor
+
+/** \class PointwiseExpressionImageFilter
+ * \brief Evaluates a chain of pixel-wise operations in a single pass.
+ *
+ * A pipeline of pixel-wise filters, for instance ShiftScaleImageFilter,
+ * ClampImageFilter, SigmoidImageFilter and MultiplyImageFilter, reads and
+ * writes a whole image for each filter.  This filter applies the whole
+ * chain of operations while it visits the pixels once, so that a chain
+ * bound by the memory bandwidth runs as fast as a single operation.
+ *
+ * The operations are appended in the order they are applied, either at
+ * run time with the Append methods, which are available in the wrapped
+ * languages:
+ *
+   \code
+   filter->AppendShiftScale( -100.0, 0.01 );
+   filter->AppendClamp( -1.0, 1.0 );
+   filter->AppendSigmoid( 0.2, 0.0, 0.0, 1.0 );
+   \endcode
+ *
+ * or as C++ functors, which may be composed at compile time with
+ * Functor::MakeComposition():
+ *
+   \code
+   filter->AppendFunctor( Functor::MakeComposition(
+     Functor::Abs< double, double >(),
+     Functor::BindSecond< Functor::Mult< double, double, double >, double >( {}, 2.0 ) ) );
+   \endcode
+ *
+ * The pixels of each line are converted to InternalPixelType, processed by
+ * blocks of BlockSize pixels that stay in the cache while all the
+ * operations are applied to them, and cast to the output pixel type.
+ * Each operation runs as a tight loop over a block, which the compiler can
+ * vectorize.
+ *
+ * The filter can run in place.  Without operations, it casts the input
+ * pixels to the output pixel type.  The images must have scalar pixels.
+ *
+ * \sa UnaryGeneratorImageFilter
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageIntensity
+ */
+template< typename TInputImage, typename TOutputImage = TInputImage,
+          typename TInternalPixel = typename NumericTraits< typename TInputImage::PixelType >::RealType >
+class ITK_TEMPLATE_EXPORT PointwiseExpressionImageFilter:
+  public InPlaceImageFilter< TInputImage, TOutputImage >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(PointwiseExpressionImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = PointwiseExpressionImageFilter;
+  using Superclass = InPlaceImageFilter< TInputImage, TOutputImage >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PointwiseExpressionImageFilter, InPlaceImageFilter);
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using InternalPixelType = TInternalPixel;
+
+  /** An operation processes in place a block of pixels of the given
+   * length. */
+  using OperationType = std::function< void (InternalPixelType *, SizeValueType) >;
+
+  /** The number of pixels processed at once by the operations. */
+  static constexpr SizeValueType BlockSize = 256;
+
+  /** Append x -> ( x + shift ) * scale, as ShiftScaleImageFilter. */
+  void AppendShiftScale(double shift, double scale);
+
+  /** Append the clamping to [lower, upper], as ClampImageFilter. */
+  void AppendClamp(double lower, double upper);
+
+  /** Append the sigmoid of SigmoidImageFilter. */
+  void AppendSigmoid(double alpha, double beta, double outputMinimum, double outputMaximum);
+
+  /** Append x -> x + constant. */
+  void AppendAdd(double constant);
+
+  /** Append x -> x - constant. */
+  void AppendSubtract(double constant);
+
+  /** Append x -> x * constant. */
+  void AppendMultiply(double constant);
+
+  /** Append x -> x / constant.  The constant must not be zero. */
+  void AppendDivide(double constant);
+
+  /** Append x -> min( x, constant ). */
+  void AppendMinimum(double constant);
+
+  /** Append x -> max( x, constant ). */
+  void AppendMaximum(double constant);
+
+  /** Append the absolute value, square, square root, exponential and natural
+   * logarithm. */
+  void AppendAbs();
+  void AppendSquare();
+  void AppendSqrt();
+  void AppendExp();
+  void AppendLog();
+
+#if !defined( ITK_WRAPPING_PARSER )
+  /** Append a unary functor, or a composition of functors, taking and
+   * returning InternalPixelType values.  The functor is copied and called
+   * concurrently by the threads. */
+  template< typename TFunctor >
+  void AppendFunctor(const TFunctor & functor)
+  {
+    this->AppendOperation( [functor](InternalPixelType * block, SizeValueType length)
+      {
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        block[i] = static_cast< InternalPixelType >( functor( block[i] ) );
+        }
+      } );
+  }
+
+  /** Append an operation working on whole blocks. */
+  void AppendOperation(const OperationType & operation);
+#endif // !defined( ITK_WRAPPING_PARSER )
+
+  /** Remove all the operations. */
+  void ClearOperations();
+
+  /** The number of operations applied to each pixel. */
+  SizeValueType GetNumberOfOperations() const
+  {
+    return static_cast< SizeValueType >( m_Operations.size() );
+  }
+
+protected:
+  PointwiseExpressionImageFilter();
+  ~PointwiseExpressionImageFilter() override = default;
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::vector< OperationType > m_Operations;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkPointwiseExpressionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,274 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPointwiseExpressionImageFilter_hxx
+#define itkPointwiseExpressionImageFilter_hxx
+
+#include "itkPointwiseExpressionImageFilter.h"
+#include "itkAbsImageFilter.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkClampImageFilter.h"
+#include "itkExpImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkLogImageFilter.h"
+#include "itkMaximumImageFilter.h"
+#include "itkMinimumImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkSqrtImageFilter.h"
+#include "itkSquareImageFilter.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::PointwiseExpressionImageFilter()
+{
+  this->InPlaceOff();
+  this->DynamicMultiThreadingOn();
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendShiftScale(double shift, double scale)
+{
+  const auto internalShift = static_cast< InternalPixelType >( shift );
+  const auto internalScale = static_cast< InternalPixelType >( scale );
+  this->AppendOperation( [internalShift, internalScale](InternalPixelType * block, SizeValueType length)
+    {
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      block[i] = ( block[i] + internalShift ) * internalScale;
+      }
+    } );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendClamp(double lower, double upper)
+{
+  Functor::Clamp< InternalPixelType, InternalPixelType > clamp;
+  clamp.SetBounds( static_cast< InternalPixelType >( lower ), static_cast< InternalPixelType >( upper ) );
+  this->AppendFunctor(clamp);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendSigmoid(double alpha, double beta, double outputMinimum, double outputMaximum)
+{
+  if ( Math::ExactlyEquals(alpha, 0.0) )
+    {
+    itkExceptionMacro(<< "The alpha of the sigmoid must not be zero.");
+    }
+  Functor::Sigmoid< InternalPixelType, InternalPixelType > sigmoid;
+  sigmoid.SetAlpha(alpha);
+  sigmoid.SetBeta(beta);
+  sigmoid.SetOutputMinimum( static_cast< InternalPixelType >( outputMinimum ) );
+  sigmoid.SetOutputMaximum( static_cast< InternalPixelType >( outputMaximum ) );
+  this->AppendFunctor(sigmoid);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendAdd(double constant)
+{
+  using AddType = Functor::Add2< InternalPixelType, InternalPixelType, InternalPixelType >;
+  this->AppendFunctor( Functor::BindSecond< AddType, InternalPixelType >( AddType(),
+                                                                          static_cast< InternalPixelType >( constant ) ) );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendSubtract(double constant)
+{
+  using SubtractType = Functor::Sub2< InternalPixelType, InternalPixelType, InternalPixelType >;
+  this->AppendFunctor( Functor::BindSecond< SubtractType, InternalPixelType >(
+                         SubtractType(), static_cast< InternalPixelType >( constant ) ) );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendMultiply(double constant)
+{
+  using MultiplyType = Functor::Mult< InternalPixelType, InternalPixelType, InternalPixelType >;
+  this->AppendFunctor( Functor::BindSecond< MultiplyType, InternalPixelType >(
+                         MultiplyType(), static_cast< InternalPixelType >( constant ) ) );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendDivide(double constant)
+{
+  if ( Math::ExactlyEquals(constant, 0.0) )
+    {
+    itkExceptionMacro(<< "The divisor must not be zero.");
+    }
+  // Division by a constant is a multiplication by its reciprocal
+  this->AppendMultiply(1.0 / constant);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendMinimum(double constant)
+{
+  using MinimumType = Functor::Minimum< InternalPixelType, InternalPixelType, InternalPixelType >;
+  this->AppendFunctor( Functor::BindSecond< MinimumType, InternalPixelType >(
+                         MinimumType(), static_cast< InternalPixelType >( constant ) ) );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendMaximum(double constant)
+{
+  using MaximumType = Functor::Maximum< InternalPixelType, InternalPixelType, InternalPixelType >;
+  this->AppendFunctor( Functor::BindSecond< MaximumType, InternalPixelType >(
+                         MaximumType(), static_cast< InternalPixelType >( constant ) ) );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendAbs()
+{
+  this->AppendFunctor( Functor::Abs< InternalPixelType, InternalPixelType >() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendSquare()
+{
+  this->AppendFunctor( Functor::Square< InternalPixelType, InternalPixelType >() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendSqrt()
+{
+  this->AppendFunctor( Functor::Sqrt< InternalPixelType, InternalPixelType >() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendExp()
+{
+  this->AppendFunctor( Functor::Exp< InternalPixelType, InternalPixelType >() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendLog()
+{
+  this->AppendFunctor( Functor::Log< InternalPixelType, InternalPixelType >() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::AppendOperation(const OperationType & operation)
+{
+  m_Operations.push_back(operation);
+  this->Modified();
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::ClearOperations()
+{
+  if ( !m_Operations.empty() )
+    {
+    m_Operations.clear();
+    this->Modified();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  if ( size0 == 0 )
+    {
+    return;
+    }
+
+  const TInputImage *inputPtr = this->GetInput();
+  TOutputImage *     outputPtr = this->GetOutput(0);
+
+  // Define the portion of the input to walk for this thread, using
+  // the CallCopyOutputRegionToInputRegion method allows for the input
+  // and output images to be different dimensions
+  typename TInputImage::RegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  ImageScanlineConstIterator< TInputImage > inputIt(inputPtr, inputRegionForThread);
+  ImageScanlineIterator< TOutputImage >     outputIt(outputPtr, outputRegionForThread);
+
+  InternalPixelType block[BlockSize];
+
+  // The lines are contiguous in memory, so that they are processed through
+  // pointers, by blocks that stay in the cache while all the operations
+  // are applied.
+  while ( !inputIt.IsAtEnd() )
+    {
+    const InputPixelType *input = &inputIt.Value();
+    OutputPixelType *     output = &outputIt.Value();
+    for ( SizeValueType begin = 0; begin < size0; begin += BlockSize )
+      {
+      const SizeValueType length = ( size0 - begin < BlockSize ) ? size0 - begin : BlockSize;
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        block[i] = static_cast< InternalPixelType >( input[begin + i] );
+        }
+      for ( const OperationType & operation : m_Operations )
+        {
+        operation(block, length);
+        }
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        output[begin + i] = static_cast< OutputPixelType >( block[i] );
+        }
+      }
+    inputIt.NextLine();
+    outputIt.NextLine();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TInternalPixel >
+void
+PointwiseExpressionImageFilter< TInputImage, TOutputImage, TInternalPixel >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfOperations: " << m_Operations.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -94,6 +94,17 @@ public:
       }
   }
 
+  /** Use the closed-form solver for 2x2 and 3x3 matrices.
+   * \sa SymmetricEigenAnalysis::SetUseClosedFormSolver */
+  void SetUseClosedFormSolver(bool useClosedFormSolver)
+  {
+    m_Calculator.SetUseClosedFormSolver(useClosedFormSolver);
+  }
+  bool GetUseClosedFormSolver() const
+  {
+    return m_Calculator.GetUseClosedFormSolver();
+  }
+
 private:
   CalculatorType m_Calculator;
 };
@@ -155,6 +166,17 @@ public:
       }
   }
 
+  /** Use the closed-form solver for 2x2 and 3x3 matrices.
+   * \sa SymmetricEigenAnalysis::SetUseClosedFormSolver */
+  void SetUseClosedFormSolver(bool useClosedFormSolver)
+  {
+    m_Calculator.SetUseClosedFormSolver(useClosedFormSolver);
+  }
+  bool GetUseClosedFormSolver() const
+  {
+    return m_Calculator.GetUseClosedFormSolver();
+  }
+
 private:
   CalculatorType m_Calculator;
 };
@@ -222,6 +244,22 @@ public:
     this->GetFunctor().OrderEigenValuesBy(order);
   }
 
+  /** Use the closed-form solver, which is faster than the iterative one,
+   * for 2x2 and 3x3 matrices. Default is false. */
+  void SetUseClosedFormSolver(bool useClosedFormSolver)
+  {
+    if ( this->GetFunctor().GetUseClosedFormSolver() != useClosedFormSolver )
+      {
+      this->GetFunctor().SetUseClosedFormSolver(useClosedFormSolver);
+      this->Modified();
+      }
+  }
+  bool GetUseClosedFormSolver() const
+  {
+    return this->GetFunctor().GetUseClosedFormSolver();
+  }
+  itkBooleanMacro(UseClosedFormSolver);
+
   /** Run-time type information (and related methods).   */
   itkTypeMacro(SymmetricEigenAnalysisImageFilter, UnaryFunctorImageFilter);
 
@@ -230,7 +268,10 @@ public:
 
   /** Print internal ivars */
   void PrintSelf(std::ostream & os, Indent indent) const override
-  { this->Superclass::PrintSelf(os, indent); }
+  {
+    this->Superclass::PrintSelf(os, indent);
+    os << indent << "UseClosedFormSolver: " << this->GetUseClosedFormSolver() << std::endl;
+  }
 
   /** Set the dimension of the tensor. (For example the SymmetricSecondRankTensor
    * is a pxp matrix) */
@@ -316,6 +357,22 @@ public:
     this->GetFunctor().OrderEigenValuesBy(order);
   }
 
+  /** Use the closed-form solver, which is faster than the iterative one,
+   * for 2x2 and 3x3 matrices. Default is false. */
+  void SetUseClosedFormSolver(bool useClosedFormSolver)
+  {
+    if ( this->GetFunctor().GetUseClosedFormSolver() != useClosedFormSolver )
+      {
+      this->GetFunctor().SetUseClosedFormSolver(useClosedFormSolver);
+      this->Modified();
+      }
+  }
+  bool GetUseClosedFormSolver() const
+  {
+    return this->GetFunctor().GetUseClosedFormSolver();
+  }
+  itkBooleanMacro(UseClosedFormSolver);
+
   /** Run-time type information (and related methods).   */
   itkTypeMacro(SymmetricEigenAnalysisFixedDimensionImageFilter, UnaryFunctorImageFilter);
 
@@ -324,7 +381,10 @@ public:
 
   /** Print internal ivars */
   void PrintSelf(std::ostream & os, Indent indent) const override
-  { this->Superclass::PrintSelf(os, indent); }
+  {
+    this->Superclass::PrintSelf(os, indent);
+    os << indent << "UseClosedFormSolver: " << this->GetUseClosedFormSolver() << std::endl;
+  }
 
   /** GetDimension of the matrix. Dimension is fixed by template parameter, no SetDimension. */
   unsigned int GetDimension() const
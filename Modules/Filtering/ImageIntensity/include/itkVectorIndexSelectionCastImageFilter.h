@@ -19,6 +19,8 @@
 #define itkVectorIndexSelectionCastImageFilter_h
 
 #include "itkUnaryFunctorImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkVectorImage.h"
 
 namespace itk
 {
@@ -100,6 +102,8 @@ public:
   using Pointer = SmartPointer< Self >;
   using ConstPointer = SmartPointer< const Self >;
 
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
@@ -165,6 +169,54 @@ protected:
         << numberOfComponents);
       }
   }
+
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override
+  {
+    if ( !this->SelectComponentOverContiguousRuns(this->GetInput(), this->GetOutput(), outputRegionForThread) )
+      {
+      Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+      }
+  }
+
+private:
+  /** Reads the selected component in place in the buffer of a VectorImage,
+   * which stores the components of each pixel contiguously, instead of
+   * going through a VariableLengthVector per pixel.  false is returned for
+   * other images. */
+  template< typename TInput, typename TOutput, typename TRegion >
+  bool SelectComponentOverContiguousRuns(const TInput *, TOutput *, const TRegion &)
+  {
+    return false;
+  }
+
+  template< typename TInputPixel, typename TOutputPixel, unsigned int VImageDimension >
+  bool SelectComponentOverContiguousRuns(const VectorImage< TInputPixel, VImageDimension > * inputPtr,
+                                         Image< TOutputPixel, VImageDimension > * outputPtr,
+                                         const ImageRegion< VImageDimension > & outputRegionForThread)
+  {
+    typename TInputImage::RegionType inputRegionForThread;
+    this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+    if ( inputRegionForThread != outputRegionForThread )
+      {
+      return false;
+      }
+
+    const SizeValueType numberOfComponents = inputPtr->GetNumberOfComponentsPerPixel();
+    const TInputPixel * inputBuffer = inputPtr->GetBufferPointer() + this->GetIndex();
+    TOutputPixel *      outputBuffer = outputPtr->GetBufferPointer();
+    ImageAlgorithm::ForEachContiguousRun( outputRegionForThread,
+      [inputBuffer, outputBuffer, numberOfComponents](const OffsetValueType * offsets, SizeValueType length)
+      {
+      const TInputPixel *input = inputBuffer + offsets[0] * numberOfComponents;
+      TOutputPixel *     output = outputBuffer + offsets[1];
+      for ( SizeValueType i = 0; i < length; ++i )
+        {
+        output[i] = static_cast< TOutputPixel >( input[i * numberOfComponents] );
+        }
+      },
+      inputPtr, outputPtr );
+    return true;
+  }
 };
 } // end namespace itk
 
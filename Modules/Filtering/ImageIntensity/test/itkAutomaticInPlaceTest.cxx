@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAbsImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Checks that the pixel-wise filters of a chain run in place when their
+// inputs are released after their execution anyway, and only then.
+int itkAutomaticInPlaceTest( int, char* [] )
+{
+  using ImageType = itk::Image< float, 2 >;
+  using AbsType = itk::AbsImageFilter< ImageType, ImageType >;
+  using MultiplyType = itk::MultiplyImageFilter< ImageType, ImageType, ImageType >;
+  using AddType = itk::AddImageFilter< ImageType, ImageType, ImageType >;
+
+  ImageType::Pointer input = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill( 16 );
+  input->SetRegions( size );
+  input->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( input, input->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( it.GetIndex()[0] ) - static_cast< float >( it.GetIndex()[1] ) );
+    }
+
+  AbsType::Pointer abs = AbsType::New();
+  abs->SetInput( input );
+  abs->ReleaseDataFlagOn();
+
+  MultiplyType::Pointer multiply = MultiplyType::New();
+  multiply->SetInput( abs->GetOutput() );
+  multiply->SetConstant( 2.0f );
+  multiply->ReleaseDataFlagOn();
+
+  AddType::Pointer add = AddType::New();
+  add->SetInput( multiply->GetOutput() );
+  add->SetConstant( 1.0f );
+
+  ITK_TEST_EXPECT_TRUE( !AddType::GetGlobalAutomaticInPlace() );
+
+  auto check = [&]() -> bool {
+    itk::ImageRegionConstIterator< ImageType > in( input, input->GetBufferedRegion() );
+    itk::ImageRegionConstIterator< ImageType > out( add->GetOutput(), add->GetOutput()->GetBufferedRegion() );
+    for ( ; !in.IsAtEnd(); ++in, ++out )
+      {
+      if ( itk::Math::NotExactlyEquals( out.Get(), 2.0f * std::abs( in.Get() ) + 1.0f ) )
+        {
+        std::cerr << "Wrong output " << out.Get() << " for input " << in.Get() << std::endl;
+        return false;
+        }
+      }
+    return true;
+  };
+
+  // Without automatic in-place execution, nothing runs in place since the
+  // functor filters have InPlace off by default
+  ITK_TRY_EXPECT_NO_EXCEPTION( add->Update() );
+  ITK_TEST_EXPECT_TRUE( check() );
+  ITK_TEST_EXPECT_TRUE( !abs->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( !multiply->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( !add->GetRanInPlace() );
+
+  // With it, the filters whose input is released reuse its buffer, but the
+  // input of the application is never overwritten
+  AddType::SetGlobalAutomaticInPlace( true );
+  ITK_TEST_EXPECT_TRUE( AbsType::GetGlobalAutomaticInPlace() );
+  abs->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION( add->Update() );
+  ITK_TEST_EXPECT_TRUE( check() );
+  ITK_TEST_EXPECT_TRUE( !abs->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( multiply->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( add->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( abs->GetOutput()->GetBufferedRegion().GetNumberOfPixels() == 0 );
+
+  // An input that is kept is not overwritten
+  multiply->ReleaseDataFlagOff();
+  abs->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION( add->Update() );
+  ITK_TEST_EXPECT_TRUE( check() );
+  ITK_TEST_EXPECT_TRUE( multiply->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( !add->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( multiply->GetOutput()->GetBufferedRegion().GetNumberOfPixels() > 0 );
+  ITK_TEST_EXPECT_TRUE( multiply->GetOutput()->GetBufferPointer() != add->GetOutput()->GetBufferPointer() );
+
+  AddType::SetGlobalAutomaticInPlace( false );
+
+  // A filter asked to run in place does not when the requested region of
+  // its output is not the buffered region of its input, and it then
+  // computes the output
+  using CastType = itk::CastImageFilter< ImageType, ImageType >;
+  CastType::Pointer cast = CastType::New();
+  cast->SetInput( input );
+  cast->InPlaceOn();
+  ImageType::RegionType requestedRegion;
+  requestedRegion.SetIndex( 0, 2 );
+  requestedRegion.SetIndex( 1, 3 );
+  requestedRegion.SetSize( 0, 5 );
+  requestedRegion.SetSize( 1, 7 );
+  cast->GetOutput()->SetRequestedRegion( requestedRegion );
+  ITK_TRY_EXPECT_NO_EXCEPTION( cast->Update() );
+  ITK_TEST_EXPECT_TRUE( !cast->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( cast->GetOutput()->GetBufferPointer() != input->GetBufferPointer() );
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it( cast->GetOutput(), requestedRegion ); !it.IsAtEnd(); ++it )
+    {
+    ITK_TEST_EXPECT_EQUAL( it.Get(), input->GetPixel( it.GetIndex() ) );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPointwiseExpressionImageFilter.h"
+#include "itkAbsImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+template< typename TImage1, typename TImage2 >
+bool
+SameImages( const TImage1 * expected, const TImage2 * result, double tolerance )
+{
+  itk::ImageRegionConstIterator< TImage1 > expectedIt( expected, expected->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< TImage2 > resultIt( result, result->GetBufferedRegion() );
+  for ( ; !expectedIt.IsAtEnd(); ++expectedIt, ++resultIt )
+    {
+    if ( std::abs( static_cast< double >( expectedIt.Get() ) - static_cast< double >( resultIt.Get() ) ) > tolerance )
+      {
+      std::cerr << "Expected " << static_cast< double >( expectedIt.Get() ) << " but got "
+                << static_cast< double >( resultIt.Get() ) << " at " << expectedIt.GetIndex() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+} // end namespace
+
+int itkPointwiseExpressionImageFilterTest( int, char* [] )
+{
+  using ImageType = itk::Image< float, 3 >;
+  using CharImageType = itk::Image< unsigned char, 3 >;
+  using FilterType = itk::PointwiseExpressionImageFilter< ImageType >;
+
+  // Lines longer than a block, and a region that is not a multiple of it
+  ImageType::Pointer input = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 601;
+  size[1] = 7;
+  size[2] = 5;
+  input->SetRegions( size );
+  input->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( input, input->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( ( it.GetIndex()[0] * 7 + it.GetIndex()[1] * 13 + it.GetIndex()[2] * 29 ) % 400 ) );
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( filter, PointwiseExpressionImageFilter, InPlaceImageFilter );
+
+  // Without operations, the filter copies its input
+  filter->SetInput( input );
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  ITK_TEST_EXPECT_TRUE( SameImages( input.GetPointer(), filter->GetOutput(), 0.0 ) );
+
+  // The chain of filters ShiftScale -> Clamp -> Sigmoid -> Multiply -> Add
+  using ShiftScaleType = itk::ShiftScaleImageFilter< ImageType, ImageType >;
+  ShiftScaleType::Pointer shiftScale = ShiftScaleType::New();
+  shiftScale->SetInput( input );
+  shiftScale->SetShift( -200.0 );
+  shiftScale->SetScale( 0.01 );
+
+  using ClampType = itk::ClampImageFilter< ImageType, ImageType >;
+  ClampType::Pointer clamp = ClampType::New();
+  clamp->SetInput( shiftScale->GetOutput() );
+  clamp->SetBounds( -1.5f, 1.5f );
+
+  using SigmoidType = itk::SigmoidImageFilter< ImageType, ImageType >;
+  SigmoidType::Pointer sigmoid = SigmoidType::New();
+  sigmoid->SetInput( clamp->GetOutput() );
+  sigmoid->SetAlpha( 0.5 );
+  sigmoid->SetBeta( 0.25 );
+  sigmoid->SetOutputMinimum( 0.0f );
+  sigmoid->SetOutputMaximum( 1.0f );
+
+  using MultiplyType = itk::MultiplyImageFilter< ImageType, ImageType, ImageType >;
+  MultiplyType::Pointer multiply = MultiplyType::New();
+  multiply->SetInput( sigmoid->GetOutput() );
+  multiply->SetConstant( 200.0f );
+
+  using AddType = itk::AddImageFilter< ImageType, ImageType, ImageType >;
+  AddType::Pointer add = AddType::New();
+  add->SetInput( multiply->GetOutput() );
+  add->SetConstant( 10.0f );
+  ITK_TRY_EXPECT_NO_EXCEPTION( add->Update() );
+
+  // evaluated in a single pass
+  filter->AppendShiftScale( -200.0, 0.01 );
+  filter->AppendClamp( -1.5, 1.5 );
+  filter->AppendSigmoid( 0.5, 0.25, 0.0, 1.0 );
+  filter->AppendMultiply( 200.0 );
+  filter->AppendAdd( 10.0 );
+  ITK_TEST_EXPECT_EQUAL( filter->GetNumberOfOperations(), 5u );
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  ITK_TEST_EXPECT_TRUE( SameImages( add->GetOutput(), filter->GetOutput(), 1e-3 ) );
+
+  // and with the output cast to another pixel type
+  using CastingFilterType = itk::PointwiseExpressionImageFilter< ImageType, CharImageType, float >;
+  CastingFilterType::Pointer castingFilter = CastingFilterType::New();
+  castingFilter->SetInput( input );
+  castingFilter->AppendShiftScale( -200.0, 0.01 );
+  castingFilter->AppendClamp( -1.5, 1.5 );
+  castingFilter->AppendSigmoid( 0.5, 0.25, 0.0, 1.0 );
+  castingFilter->AppendMultiply( 200.0 );
+  castingFilter->AppendAdd( 10.0 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( castingFilter->Update() );
+  ITK_TEST_EXPECT_TRUE( SameImages( add->GetOutput(), castingFilter->GetOutput(), 1.0 ) );
+
+  // The other operations
+  filter->ClearOperations();
+  ITK_TEST_EXPECT_EQUAL( filter->GetNumberOfOperations(), 0u );
+  filter->AppendSubtract( 100.0 );
+  filter->AppendSquare();
+  filter->AppendSqrt();
+  filter->AppendAdd( 100.0 );
+  filter->AppendMaximum( 100.0 );
+  filter->AppendMinimum( 300.0 );
+  filter->AppendSubtract( 100.0 );
+  filter->AppendDivide( 0.5 );
+  filter->AppendLog();
+  filter->AppendExp();
+  filter->AppendDivide( 2.0 );
+  filter->AppendAbs();
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  ImageType::Pointer expected = ImageType::New();
+  expected->SetRegions( size );
+  expected->Allocate();
+  itk::ImageRegionConstIterator< ImageType > inputIt( input, input->GetBufferedRegion() );
+  for ( itk::ImageRegionIterator< ImageType > it( expected, expected->GetBufferedRegion() ); !it.IsAtEnd(); ++it, ++inputIt )
+    {
+    const float value = std::min( std::max( std::abs( inputIt.Get() - 100.0f ) + 100.0f, 100.0f ), 300.0f );
+    it.Set( value - 100.0f );
+    }
+  ITK_TEST_EXPECT_TRUE( SameImages( expected.GetPointer(), filter->GetOutput(), 1e-3 ) );
+
+  // A composition of functors, in place
+  using DoubleAbsType = itk::Functor::Abs< double, double >;
+  using DoubleMultiplyType = itk::Functor::Mult< double, double, double >;
+  using DoubleAddType = itk::Functor::Add2< double, double, double >;
+  filter->ClearOperations();
+  filter->AppendFunctor( itk::Functor::MakeComposition(
+    itk::Functor::BindSecond< DoubleAddType, double >( DoubleAddType(), -200.0 ), DoubleAbsType(),
+    itk::Functor::BindSecond< DoubleMultiplyType, double >( DoubleMultiplyType(), 2.0 ) ) );
+  ITK_TEST_EXPECT_EQUAL( filter->GetNumberOfOperations(), 1u );
+  using AbsType = itk::AbsImageFilter< ImageType, ImageType >;
+  AbsType::Pointer abs = AbsType::New();
+  abs->SetInput( shiftScale->GetOutput() );
+  shiftScale->SetScale( 2.0 );
+  ITK_TRY_EXPECT_NO_EXCEPTION( abs->Update() );
+
+  ImageType::Pointer inputCopy = ImageType::New();
+  inputCopy->SetRegions( size );
+  inputCopy->Allocate();
+  itk::ImageRegionConstIterator< ImageType > sourceIt( input, input->GetBufferedRegion() );
+  for ( itk::ImageRegionIterator< ImageType > it( inputCopy, inputCopy->GetBufferedRegion() ); !it.IsAtEnd(); ++it, ++sourceIt )
+    {
+    it.Set( sourceIt.Get() );
+    }
+  filter->SetInput( inputCopy );
+  filter->InPlaceOn();
+  const float * buffer = inputCopy->GetBufferPointer();
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  ITK_TEST_EXPECT_TRUE( filter->GetRanInPlace() );
+  ITK_TEST_EXPECT_TRUE( filter->GetOutput()->GetBufferPointer() == buffer );
+  ITK_TEST_EXPECT_TRUE( SameImages( abs->GetOutput(), filter->GetOutput(), 1e-3 ) );
+
+  // Invalid parameters
+  ITK_TRY_EXPECT_EXCEPTION( filter->AppendDivide( 0.0 ) );
+  ITK_TRY_EXPECT_EXCEPTION( filter->AppendSigmoid( 0.0, 0.0, 0.0, 1.0 ) );
+  ITK_TRY_EXPECT_EXCEPTION( filter->AppendClamp( 1.0, -1.0 ) );
+  ITK_TEST_EXPECT_EQUAL( filter->GetNumberOfOperations(), 1u );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
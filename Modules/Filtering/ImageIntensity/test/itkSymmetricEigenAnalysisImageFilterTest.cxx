@@ -343,6 +343,8 @@ int itkSymmetricEigenAnalysisImageFilterTest( int argc, char* argv[] )
   ITK_EXERCISE_BASIC_OBJECT_METHODS( filter, SymmetricEigenAnalysisImageFilter,
     UnaryFunctorImageFilter );
 
+  ITK_TEST_SET_GET_BOOLEAN( filter, UseClosedFormSolver, false );
+
 
   // Get the input arguments
   auto order = static_cast< FilterType::FunctorType::EigenValueOrderType >( std::stoi( argv[2] ) );
@@ -373,6 +375,8 @@ int itkSymmetricEigenAnalysisImageFilterTest( int argc, char* argv[] )
   ITK_EXERCISE_BASIC_OBJECT_METHODS( filterFixedDimension, SymmetricEigenAnalysisFixedDimensionImageFilter,
     UnaryFunctorImageFilter );
 
+  ITK_TEST_SET_GET_BOOLEAN( filterFixedDimension, UseClosedFormSolver, false );
+
   int testFixedDimensionResult = itk::SymmetricEigenAnalysisFixedDimensionImageFilterHelper<
     Dimension, InputImageType, InternalImageType, OutputImageType >::Exercise( orderFixedDimension, outputFilenameFixedDimension );
 
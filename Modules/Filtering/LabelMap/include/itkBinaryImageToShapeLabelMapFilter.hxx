@@ -33,6 +33,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   m_ComputeFeretDiameter = false;
   m_ComputePerimeter = true;
   m_ComputeOrientedBoundingBox = false;
+  m_ComputePrincipalMoments = true;
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -87,6 +88,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
   valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
+  valuator->SetComputePrincipalMoments(m_ComputePrincipalMoments);
   progress->RegisterInternalFilter(valuator, .5f);
 
   valuator->GraftOutput( this->GetOutput() );
@@ -110,6 +112,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
+  os << indent << "ComputePrincipalMoments: " << m_ComputePrincipalMoments << std::endl;
 }
 } // end namespace itk
 #endif
@@ -31,6 +31,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   m_ComputeFeretDiameter = false;
   m_ComputePerimeter = true;
   m_ComputeOrientedBoundingBox = false;
+  m_ComputePrincipalMoments = true;
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -83,6 +84,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
   valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
+  valuator->SetComputePrincipalMoments(m_ComputePrincipalMoments);
   progress->RegisterInternalFilter(valuator, .5f);
 
   valuator->GraftOutput( this->GetOutput() );
@@ -102,6 +104,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
+  os << indent << "ComputePrincipalMoments: " << m_ComputePrincipalMoments << std::endl;
 }
 } // end namespace itk
 #endif
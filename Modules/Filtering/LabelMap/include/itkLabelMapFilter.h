@@ -29,7 +29,9 @@
 #define itkLabelMapFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -42,6 +44,10 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The label objects are gathered in an array before the threads start, and
+ * the threads take them by chunks with an atomic counter, so the many small
+ * objects of a large label map do not contend on a lock.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -129,9 +135,10 @@ protected:
   std::mutex m_LabelObjectContainerLock;
 
 private:
-  typename InputImageType::Iterator m_LabelObjectIterator;
-  float                             m_InverseNumberOfLabelObjects{ 1.0f };
-  SizeValueType                     m_NumberOfLabelObjectsProcessed{ 1 };
+  std::vector< LabelObjectType * > m_LabelObjects;
+  std::atomic< SizeValueType >     m_NextLabelObject{ 0 };
+  SizeValueType                    m_LabelObjectChunkSize{ 1 };
+  float                            m_InverseNumberOfLabelObjects{ 1.0f };
 };
 } // end namespace itk
 
@@ -70,18 +70,29 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::BeforeThreadedGenerateData()
 {
-  m_LabelObjectIterator =  typename InputImageType::Iterator(this->GetLabelMap());
+  InputImageType * labelMap = this->GetLabelMap();
+  const SizeValueType numberOfLabelObjects = labelMap->GetNumberOfLabelObjects();
 
-  if(Math::ExactlyEquals(this->GetLabelMap()->GetNumberOfLabelObjects(), 0.0))
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve( numberOfLabelObjects );
+  for ( typename InputImageType::Iterator it( labelMap ); !it.IsAtEnd(); ++it )
+    {
+    m_LabelObjects.push_back( it.GetLabelObject() );
+    }
+  m_NextLabelObject = 0;
+
+  // Several chunks per work unit, to balance the objects of different sizes
+  m_LabelObjectChunkSize = std::max< SizeValueType >( 1,
+    numberOfLabelObjects / ( 16 * static_cast< SizeValueType >( this->GetNumberOfWorkUnits() ) ) );
+
+  if(Math::ExactlyEquals(numberOfLabelObjects, 0.0))
     {
     m_InverseNumberOfLabelObjects = NumericTraits<float>::max();
     }
   else
     {
-    m_InverseNumberOfLabelObjects = 1.0f/this->GetLabelMap()->GetNumberOfLabelObjects();
+    m_InverseNumberOfLabelObjects = 1.0f/numberOfLabelObjects;
     }
-  //TODO: set number of work units to be equal to GetNumberOfLabelObjects()
-  m_NumberOfLabelObjectsProcessed = 0;
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -89,6 +100,7 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::AfterThreadedGenerateData()
 {
+  std::vector< LabelObjectType * >().swap( m_LabelObjects );
   this->UpdateProgress(1.0);
 }
 
@@ -97,45 +109,34 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::DynamicThreadedGenerateData( const OutputImageRegionType & )
 {
+  const SizeValueType numberOfLabelObjects = m_LabelObjects.size();
+
   while ( true )
     {
-    LabelObjectType *labelObject;
-    // begin mutex lock
-    {
-    std::lock_guard< std::mutex > lock( m_LabelObjectContainerLock );
-
-    if ( m_LabelObjectIterator.IsAtEnd() )
+    // take the next chunk of objects. The objects are not accessed through
+    // the label map, so the processed object may be removed from it.
+    const SizeValueType begin = m_NextLabelObject.fetch_add( m_LabelObjectChunkSize );
+    if ( begin >= numberOfLabelObjects )
       {
-      // mutex lock holder deleted
       return;
       }
+    const SizeValueType end = std::min( begin + m_LabelObjectChunkSize, numberOfLabelObjects );
 
-    // get the label object
-    labelObject = m_LabelObjectIterator.GetLabelObject();
-
-    // increment the iterator now, so it will not be invalidated if the object
-    // is destroyed
-    ++m_LabelObjectIterator;
-    ++m_NumberOfLabelObjectsProcessed;
-
-    // unlock the mutex, so the other threads can get an object
-    }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
-
-    // all threads needs to check the abort flag
-    if ( this->GetAbortGenerateData() )
+    for ( SizeValueType i = begin; i < end; ++i )
       {
-      std::string    msg;
-      ProcessAborted e(__FILE__, __LINE__);
-      msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
-      e.SetDescription(msg);
-      throw e;
+      // run the user defined method for that object
+      this->ThreadedProcessLabelObject( m_LabelObjects[i] );
+
+      // all threads needs to check the abort flag
+      if ( this->GetAbortGenerateData() )
+        {
+        std::string    msg;
+        ProcessAborted e(__FILE__, __LINE__);
+        msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
+        e.SetDescription(msg);
+        throw e;
+        }
       }
-
     }
 }
 
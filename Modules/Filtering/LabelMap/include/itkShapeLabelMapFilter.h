@@ -29,15 +29,13 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * The perimeter and the Feret diameter are computed from the lines of
+ * the objects, without a label image: the perimeter counts the
+ * intercepts between the sorted lines of neighbor rows, and the Feret
+ * diameter is searched among the vertices of the convex hull of the
+ * ends of the lines.
+ * SetLabelImage() is kept for backward compatibility; the label image
+ * is not used anymore.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -127,6 +125,16 @@ public:
   itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
   itkBooleanMacro(ComputeOrientedBoundingBox);
 
+  /**
+   * Set/Get whether the principal moments and axes, the elongation, the
+   * flatness and the equivalent ellipsoid diameter should be computed or
+   * not. They are always computed when the oriented bounding box is.
+   * Default value is true.
+   */
+  itkSetMacro(ComputePrincipalMoments, bool);
+  itkGetConstReferenceMacro(ComputePrincipalMoments, bool);
+  itkBooleanMacro(ComputePrincipalMoments);
+
   /** Set the label image */
   void SetLabelImage(const TLabelImage *input)
   {
@@ -149,10 +157,12 @@ private:
   bool                   m_ComputeFeretDiameter;
   bool                   m_ComputePerimeter;
   bool                   m_ComputeOrientedBoundingBox;
+  bool                   m_ComputePrincipalMoments;
   LabelImageConstPointer m_LabelImage;
 
   void ComputeFeretDiameter(LabelObjectType *labelObject);
   void ComputePerimeter(LabelObjectType *labelObject);
+  void ComputePrincipalMoments(LabelObjectType *labelObject, MatrixType centralMoments, double equivalentRadius);
   void ComputeOrientedBoundingBox(LabelObjectType *labelObject);
 
   using Offset2Type = itk::Offset<2>;
@@ -30,8 +30,10 @@
 #include "vnl/algo/vnl_symmetric_eigensystem.h"
 #include "itkMath.h"
 #include "itkLexicographicCompare.h"
+#include <algorithm>
 #include <deque>
 #include <map>
+#include <vector>
 
 namespace itk
 {
@@ -42,6 +44,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   m_ComputeFeretDiameter = false;
   m_ComputePerimeter = true;
   m_ComputeOrientedBoundingBox = false;
+  m_ComputePrincipalMoments = true;
 }
 
 template< typename TImage, typename TLabelImage >
@@ -50,22 +53,6 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 ::BeforeThreadedGenerateData()
 {
   Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if ( m_ComputeFeretDiameter )
-    {
-    if ( !m_LabelImage )
-      {
-      // generate an image of the labelized image
-      using LCI2IType = LabelMapToLabelImageFilter< TImage, LabelImageType >;
-      typename LCI2IType::Pointer lci2i = LCI2IType::New();
-      lci2i->SetInput( this->GetOutput() );
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-      }
-    }
 }
 
 template< typename TImage, typename TLabelImage >
@@ -75,6 +62,9 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 {
   ImageType *            output = this->GetOutput();
 
+  // The oriented bounding box is computed in the principal axes
+  const bool computePrincipalMoments = m_ComputePrincipalMoments || m_ComputeOrientedBoundingBox;
+
   // Compute the size per pixel, to be used later
   double sizePerPixel = 1;
 
@@ -213,6 +203,12 @@ ShapeLabelMapFilter< TImage, TLabelImage >
         }
       }
 
+    if ( !computePrincipalMoments )
+      {
+      ++lit;
+      continue;
+      }
+
     // moments computation
     //
     //  This computation has changed from what is documented in the
@@ -315,6 +311,48 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   typename LabelObjectType::CentroidType physicalCentroid;
   output->TransformContinuousIndexToPhysicalPoint(centroid, physicalCentroid);
 
+  double physicalSize = nbOfPixels * sizePerPixel;
+  double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
+  double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
+
+  // Set the values in the object
+  labelObject->SetNumberOfPixels(nbOfPixels);
+  labelObject->SetPhysicalSize(physicalSize);
+  labelObject->SetBoundingBox(boundingBox);
+  labelObject->SetCentroid(physicalCentroid);
+  labelObject->SetNumberOfPixelsOnBorder(nbOfPixelsOnBorder);
+  labelObject->SetPerimeterOnBorder(perimeterOnBorder);
+  labelObject->SetEquivalentSphericalRadius(equivalentRadius);
+  labelObject->SetEquivalentSphericalPerimeter(equivalentPerimeter);
+
+  if ( computePrincipalMoments )
+    {
+    this->ComputePrincipalMoments(labelObject, centralMoments, equivalentRadius);
+    }
+
+  if ( m_ComputeFeretDiameter )
+    {
+    this->ComputeFeretDiameter(labelObject);
+    }
+
+  if ( m_ComputePerimeter )
+    {
+    this->ComputePerimeter(labelObject);
+    }
+
+   if ( m_ComputeOrientedBoundingBox )
+    {
+    this->ComputeOrientedBoundingBox(labelObject);
+    }
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ComputePrincipalMoments(LabelObjectType *labelObject, MatrixType centralMoments, double equivalentRadius)
+{
+  const typename LabelObjectType::CentroidType & physicalCentroid = labelObject->GetCentroid();
+
   // Center the second order moments
   for ( unsigned int i = 0; i < ImageDimension; i++ )
     {
@@ -379,10 +417,6 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       }
     }
 
-  double physicalSize = nbOfPixels * sizePerPixel;
-  double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
-  double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
-
   // Compute equivalent ellipsoid radius
   VectorType ellipsoidDiameter;
   double     edet = 1.0;
@@ -400,35 +434,11 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       }
     }
 
-  // Set the values in the object
-  labelObject->SetNumberOfPixels(nbOfPixels);
-  labelObject->SetPhysicalSize(physicalSize);
-  labelObject->SetBoundingBox(boundingBox);
-  labelObject->SetCentroid(physicalCentroid);
-  labelObject->SetNumberOfPixelsOnBorder(nbOfPixelsOnBorder);
-  labelObject->SetPerimeterOnBorder(perimeterOnBorder);
   labelObject->SetPrincipalMoments(principalMoments);
   labelObject->SetPrincipalAxes(principalAxes);
   labelObject->SetElongation(elongation);
-  labelObject->SetEquivalentSphericalRadius(equivalentRadius);
-  labelObject->SetEquivalentSphericalPerimeter(equivalentPerimeter);
   labelObject->SetEquivalentEllipsoidDiameter(ellipsoidDiameter);
   labelObject->SetFlatness(flatness);
-
-  if ( m_ComputeFeretDiameter )
-    {
-    this->ComputeFeretDiameter(labelObject);
-    }
-
-  if ( m_ComputePerimeter )
-    {
-    this->ComputePerimeter(labelObject);
-    }
-
-   if ( m_ComputeOrientedBoundingBox )
-    {
-    this->ComputeOrientedBoundingBox(labelObject);
-    }
 }
 
 template< typename TImage, typename TLabelImage >
@@ -436,40 +446,101 @@ void
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::ComputeFeretDiameter(LabelObjectType *labelObject)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
+  // The largest distance between two pixels of the object is reached
+  // between two vertices of its convex hull. Only the ends of the lines can
+  // be such vertices and, in each plane of the first two axes, only the
+  // vertices of the convex hull of the ends in that plane.
+  using IndexListType = std::vector< IndexType >;
+  IndexListType ends;
+  ends.reserve( 2 * labelObject->GetNumberOfLines() );
 
-  using IndexListType = typename std::deque< IndexType >;
-  IndexListType idxList;
-
-  using NeighborIteratorType = typename itk::ConstNeighborhoodIterator< LabelImageType >;
-  SizeType neighborHoodRadius;
-  neighborHoodRadius.Fill(1);
-  NeighborIteratorType                        it( neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion() );
-  ConstantBoundaryCondition< LabelImageType > lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
+  typename LabelObjectType::ConstLineIterator lit( labelObject );
+  while( ! lit.IsAtEnd() )
+    {
+    IndexType idx = lit.GetLine().GetIndex();
+    ends.push_back( idx );
+    if ( lit.GetLine().GetLength() > 1 )
+      {
+      idx[0] += lit.GetLine().GetLength() - 1;
+      ends.push_back( idx );
+      }
+    ++lit;
+    }
 
-  using NeighborIndexType = typename NeighborIteratorType::NeighborIndexType;
+  // sort the ends by plane, then by the axis 1 and the axis 0
+  const auto lexicographicCompare = []( const IndexType & a, const IndexType & b )
+    {
+    for ( int i = ImageDimension - 1; i >= 0; i-- )
+      {
+      if ( a[i] != b[i] )
+        {
+        return a[i] < b[i];
+        }
+      }
+    return false;
+    };
+  std::sort( ends.begin(), ends.end(), lexicographicCompare );
 
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit( labelObject );
-  while( ! iit.IsAtEnd() )
+  // Andrew's monotone chain in each plane, in the (axis 1, axis 0) basis
+  constexpr unsigned int axis1 = ImageDimension > 1 ? 1 : 0;
+  const auto cross = []( const IndexType & o, const IndexType & a, const IndexType & b )
+    {
+    return ( a[axis1] - o[axis1] ) * ( b[0] - o[0] ) - ( a[0] - o[0] ) * ( b[axis1] - o[axis1] );
+    };
+  const auto samePlane = []( const IndexType & a, const IndexType & b )
     {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    for ( unsigned int i = 2; i < ImageDimension; i++ )
+      {
+      if ( a[i] != b[i] )
+        {
+        return false;
+        }
+      }
+    return true;
+    };
 
-    // Push the pixel in the list if it is on the border of the object
-    for ( NeighborIndexType i = 0; i < it.Size(); i++ )
+  IndexListType idxList;
+  IndexListType hull;
+  auto planeBegin = ends.begin();
+  while ( planeBegin != ends.end() )
+    {
+    auto planeEnd = planeBegin + 1;
+    while ( planeEnd != ends.end() && samePlane( *planeBegin, *planeEnd ) )
+      {
+      ++planeEnd;
+      }
+    if ( ImageDimension < 2 || planeEnd - planeBegin <= 3 )
+      {
+      idxList.insert( idxList.end(), planeBegin, planeEnd );
+      }
+    else
       {
-      if ( it.GetPixel(i) != label )
+      hull.clear();
+      // lower hull
+      for ( auto pIt = planeBegin; pIt != planeEnd; ++pIt )
         {
-        idxList.push_back( iit.GetIndex() );
-        break;
+        while ( hull.size() >= 2 && cross( hull[hull.size() - 2], hull.back(), *pIt ) <= 0 )
+          {
+          hull.pop_back();
+          }
+        hull.push_back( *pIt );
         }
+      // upper hull
+      const size_t lowerSize = hull.size() + 1;
+      for ( auto pIt = planeEnd - 1; pIt != planeBegin; --pIt )
+        {
+        const IndexType & p = *( pIt - 1 );
+        while ( hull.size() >= lowerSize && cross( hull[hull.size() - 2], hull.back(), p ) <= 0 )
+          {
+          hull.pop_back();
+          }
+        hull.push_back( p );
+        }
+      // the first point is also the last one
+      hull.pop_back();
+      idxList.insert( idxList.end(), hull.begin(), hull.end() );
       }
-    ++iit;
+    planeBegin = planeEnd;
     }
 
   ImageType *output = this->GetOutput();
@@ -510,110 +581,121 @@ void
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::ComputePerimeter(LabelObjectType *labelObject)
 {
-  // store the lines in a N-1D image of vectors
-  using VectorLineType = std::deque< typename LabelObjectType::LineType >;
-  using LineImageType = itk::Image< VectorLineType, ImageDimension - 1 >;
-  typename LineImageType::Pointer lineImage = LineImageType::New();
-  typename LineImageType::IndexType lIdx;
-  typename LineImageType::SizeType lSize;
-  RegionType boundingBox = labelObject->GetBoundingBox();
-  for( unsigned int i=0; i<ImageDimension-1; i++ )
-    {
-    lIdx[i] = boundingBox.GetIndex()[i+1];
-    lSize[i] = boundingBox.GetSize()[i+1];
-    }
-  typename LineImageType::RegionType lRegion;
-  lRegion.SetIndex( lIdx );
-  lRegion.SetSize( lSize );
-  // enlarge the region a bit to avoid boundary problems
-  typename LineImageType::RegionType elRegion(lRegion);
-  lSize.Fill(1);
-  elRegion.PadByRadius(lSize);
-  // std::cout << boundingBox << "  " << lRegion << "  " << elRegion << std::endl;
-  // now initialize the image
-  lineImage->SetRegions( elRegion );
-  lineImage->Allocate();
-  lineImage->FillBuffer( VectorLineType() );
-
-  // std::cout << "lineContainer.size(): " << lineContainer.size() << std::endl;
-
-  // Iterate over all the lines and fill the image of lines
+  using LineType = typename LabelObjectType::LineType;
+
+  // sort the lines: the lines of a row, along the axis 0, are then
+  // contiguous and ordered, and the rows are in the order of the buffer of
+  // an N-1D image over the bounding box, padded by one row on each side
+  std::vector< LineType > lines;
+  lines.reserve( labelObject->GetNumberOfLines() );
   typename LabelObjectType::ConstLineIterator lit( labelObject );
   while( ! lit.IsAtEnd() )
     {
-    const IndexType & idx = lit.GetLine().GetIndex();
-    for( unsigned int i=0; i<ImageDimension-1; i++ )
+    lines.push_back( lit.GetLine() );
+    ++lit;
+    }
+  typename Functor::LabelObjectLineComparator< LineType > comparator;
+  if ( !std::is_sorted( lines.begin(), lines.end(), comparator ) )
+    {
+    std::sort( lines.begin(), lines.end(), comparator );
+    }
+
+  const RegionType boundingBox = labelObject->GetBoundingBox();
+  OffsetValueType rowStride[ImageDimension];
+  SizeValueType   numberOfRows = 1;
+  for( unsigned int i=1; i<ImageDimension; i++ )
+    {
+    rowStride[i] = numberOfRows;
+    numberOfRows *= boundingBox.GetSize()[i] + 2;
+    }
+  const auto rowOfLine = [&]( const LineType & line )
+    {
+    OffsetValueType row = 0;
+    for( unsigned int i=1; i<ImageDimension; i++ )
       {
-      lIdx[i] = idx[i+1];
+      row += ( line.GetIndex()[i] - boundingBox.GetIndex()[i] + 1 ) * rowStride[i];
       }
-    lineImage->GetPixel( lIdx ).push_back( lit.GetLine() );
-    ++lit;
+    return row;
+    };
+
+  // the lines of the row r are lines[rowStart[r]] to lines[rowStart[r+1]-1]
+  std::vector< SizeValueType > rowStart( numberOfRows + 1, 0 );
+  for( const LineType & line : lines )
+    {
+    ++rowStart[rowOfLine( line ) + 1];
+    }
+  for( SizeValueType r = 0; r < numberOfRows; r++ )
+    {
+    rowStart[r + 1] += rowStart[r];
     }
 
-  // a data structure to store the number of intercepts on each direction
-  using MapInterceptType = typename std::map<OffsetType, SizeValueType, Functor::LexicographicCompare>;
-  MapInterceptType intercepts;
-  // int nbOfDirections = (int)std::pow( 2.0, (int)ImageDimension ) - 1;
-  // intecepts.resize(nbOfDirections + 1);  // code begins at position 1
+  // the neighbor rows, with full connectivity, and the corresponding
+  // directions, encoded with one bit per axis
+  std::vector< OffsetValueType > neighborRowOffsets;
+  std::vector< unsigned int >    neighborDirections;
+  const unsigned int numberOfNeighbors = static_cast< unsigned int >( std::pow( 3.0, ImageDimension - 1.0 ) );
+  for( unsigned int n = 0; n < numberOfNeighbors; n++ )
+    {
+    OffsetValueType rowOffset = 0;
+    unsigned int    direction = 0;
+    unsigned int    code = n;
+    for( unsigned int i=1; i<ImageDimension; i++ )
+      {
+      const int o = static_cast< int >( code % 3 ) - 1;
+      code /= 3;
+      rowOffset += o * rowStride[i];
+      if( o != 0 )
+        {
+        direction |= 1u << i;
+        }
+      }
+    if( rowOffset != 0 )
+      {
+      neighborRowOffsets.push_back( rowOffset );
+      neighborDirections.push_back( direction );
+      }
+    }
 
-  // now iterate over the vectors of lines
-  using LineImageIteratorType = ConstShapedNeighborhoodIterator< LineImageType >;
-  LineImageIteratorType lIt( lSize, lineImage, lRegion ); // the original, non padded region
-  setConnectivity( &lIt, true );
-  for( lIt.GoToBegin(); !lIt.IsAtEnd(); ++lIt )
+  // the number of intercepts on each direction
+  std::vector< SizeValueType > intercepts( 1u << ImageDimension, 0 );
+
+  // now iterate over the rows of the bounding box
+  for( SizeValueType r = 0; r < lines.size(); r = rowStart[rowOfLine( lines[r] ) + 1] )
     {
-    const VectorLineType & ls = lIt.GetCenterPixel();
+    const OffsetValueType row = rowOfLine( lines[r] );
+    const LineType * lsBegin = lines.data() + rowStart[row];
+    const LineType * lsEnd = lines.data() + rowStart[row + 1];
 
     // there are two intercepts on the 0 axis for each line
-    OffsetType no;
-    no.Fill(0);
-    no[0] = 1;
-    // std::cout << no << "-> " << 2 * ls.size() << std::endl;
-    intercepts[no] += 2 * static_cast<SizeValueType>( ls.size() );
+    intercepts[1] += 2 * static_cast<SizeValueType>( lsEnd - lsBegin );
 
     // and look at the neighbors
-    typename LineImageIteratorType::ConstIterator ci;
-    for (ci = lIt.Begin(); ci != lIt.End(); ci++)
-      {
-          // std::cout << "-------------" << std::endl;
-      // the vector of lines in the neighbor
-      const VectorLineType & ns = ci.Get();
-      // prepare the offset to be stored in the intercepts map
-      typename LineImageType::OffsetType lno = ci.GetNeighborhoodOffset();
-      no[0] = 0;
-      for( unsigned int i=0; i<ImageDimension-1; i++ )
-        {
-        no[i+1] = itk::Math::abs(lno[i]);
-        }
-      OffsetType dno = no; // offset for the diagonal
-      dno[0] = 1;
+    for( unsigned int n = 0; n < neighborRowOffsets.size(); n++ )
+      {
+      // the lines in the neighbor
+      const LineType * nsBegin = lines.data() + rowStart[row + neighborRowOffsets[n]];
+      const LineType * nsEnd = lines.data() + rowStart[row + neighborRowOffsets[n] + 1];
+      const unsigned int no = neighborDirections[n];
+      const unsigned int dno = no | 1u; // the diagonal
 
       // now process the two lines to search the pixels on the contour of the object
-      if( ls.empty() )
-        {
-        // std::cout << "ls.empty()" << std::endl;
-        // nothing to do
-        }
-      if( ns.empty() )
+      if( nsBegin == nsEnd )
         {
         // no line in the neighbors - all the lines in ls are on the contour
-        for( auto li = ls.begin(); li != ls.end(); ++li )
+        for( const LineType * li = lsBegin; li != lsEnd; ++li )
           {
-          // std::cout << "ns.empty()" << std::endl;
-          const typename LabelObjectType::LineType & l = *li;
           // add as much intercepts as the line size
-          intercepts[no] += l.GetLength();
+          intercepts[no] += li->GetLength();
           // and 2 times as much diagonal intercepts as the line size
-          intercepts[dno] += l.GetLength() * 2;
+          intercepts[dno] += li->GetLength() * 2;
           }
         }
       else
         {
-        // std::cout << "else" << std::endl;
         // TODO - fix the code when the line starts at  NumericTraits<IndexValueType>::NonpositiveMin()
         // or end at  NumericTraits<IndexValueType>::max()
-        auto li = ls.begin();
-        auto ni = ns.begin();
+        const LineType * li = lsBegin;
+        const LineType * ni = nsBegin;
 
         IndexValueType lZero = 0;
         IndexValueType lMin = 0;
@@ -622,7 +704,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
         IndexValueType nMin = NumericTraits<IndexValueType>::NonpositiveMin() + 1;
         IndexValueType nMax = ni->GetIndex()[0] - 1;
 
-        while( li!=ls.end() )
+        while( li!=lsEnd )
           {
           // update the current line min and max. Neighbor line data is already up to date.
           lMin = li->GetIndex()[0];
@@ -630,12 +712,6 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 
           // add as much intercepts as intersections of the 2 lines
           intercepts[no] += std::max( lZero, std::min(lMax, nMax) - std::max(lMin, nMin) + 1 );
-          // std::cout << "============" << std::endl;
-          // std::cout << "  lMin:" << lMin << " lMax:" << lMax << " nMin:" << nMin << " nMax:" << nMax;
-          // std::cout << " count: " << std::max( 0l, std::min(lMax, nMax) - std::max(lMin, nMin) + 1 ) << std::endl;
-          // std::cout << "  " << no << ": " << intercepts[no] << std::endl;
-          // std::cout << std::max( lZero, std::min(lMax, nMax+1) - std::max(lMin, nMin+1) + 1 ) << std::endl;
-          // std::cout << std::max( lZero, std::min(lMax, nMax-1) - std::max(lMin, nMin-1) + 1 ) << std::endl;
           // left diagonal intercepts
           intercepts[dno] += std::max( lZero, std::min(lMax, nMax+1) - std::max(lMin, nMin+1) + 1 );
           // right diagonal intercepts
@@ -648,7 +724,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
             nMin = ni->GetIndex()[0] + ni->GetLength();
             ni++;
 
-            if( ni != ns.end() )
+            if( ni != nsEnd )
               {
               nMax = ni->GetIndex()[0] - 1;
               }
@@ -663,13 +739,23 @@ ShapeLabelMapFilter< TImage, TLabelImage >
             li++;
             }
           }
-
         }
       }
     }
 
   // compute the perimeter based on the intercept counts
-  double perimeter = PerimeterFromInterceptCount( intercepts, this->GetOutput()->GetSpacing() );
+  using MapInterceptType = typename std::map<OffsetType, SizeValueType, Functor::LexicographicCompare>;
+  MapInterceptType interceptMap;
+  for( unsigned int direction = 1; direction < intercepts.size(); direction++ )
+    {
+    OffsetType no;
+    for( unsigned int i=0; i<ImageDimension; i++ )
+      {
+      no[i] = ( direction >> i ) & 1u;
+      }
+    interceptMap[no] = intercepts[direction];
+    }
+  double perimeter = PerimeterFromInterceptCount( interceptMap, this->GetOutput()->GetSpacing() );
   labelObject->SetPerimeter( perimeter );
   labelObject->SetRoundness( labelObject->GetEquivalentSphericalPerimeter() / perimeter );
   labelObject->SetPerimeterOnBorderRatio( labelObject->GetPerimeterOnBorder() / perimeter );
@@ -938,6 +1024,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
+  os << indent << "ComputePrincipalMoments: " << m_ComputePrincipalMoments << std::endl;
 }
 
 } // end namespace itk
@@ -19,7 +19,10 @@
 #include "itkGTest.h"
 
 #include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
+#include <vector>
 
 
 namespace Math = itk::Math;
@@ -451,3 +454,103 @@ TEST_F(ShapeLabelMapFixture,2D_T2x4)
     labelObject->Print(std::cout);
     }
 }
+
+
+TEST_F(ShapeLabelMapFixture,RandomObjects_FeretDiameter)
+{
+  // The Feret diameter, computed on the convex hull of the lines, is
+  // compared with the maximum distance between all the pixels of the objects
+  using Utils = FixtureUtilities<3>;
+
+  Utils::ImageType::Pointer image( Utils::CreateImage() );
+  Utils::ImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 1.0;
+  spacing[2] = 1.9;
+  image->SetSpacing(spacing);
+
+  unsigned int seed = 1234;
+  for (itk::ImageRegionIterator<Utils::ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+    seed = seed * 1103515245u + 12345u;
+    it.Set( static_cast<Utils::PixelType>( ( seed >> 16 ) % 5 ) );
+    }
+
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+  L2SType::Pointer l2s = L2SType::New();
+  l2s->SetInput( image );
+  l2s->ComputeFeretDiameterOn();
+  l2s->Update();
+
+  for (Utils::PixelType label = 1; label < 5; ++label)
+    {
+    std::vector<Utils::ImageType::IndexType> indices;
+    for (itk::ImageRegionConstIteratorWithIndex<Utils::ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+      {
+      if (it.Get() == label)
+        {
+        indices.push_back(it.GetIndex());
+        }
+      }
+    double expected = 0.0;
+    for (size_t i = 0; i < indices.size(); ++i)
+      {
+      for (size_t j = i + 1; j < indices.size(); ++j)
+        {
+        double length = 0.0;
+        for (unsigned int d = 0; d < 3; ++d)
+          {
+          length += std::pow( ( indices[i][d] - indices[j][d] ) * spacing[d], 2 );
+          }
+        expected = std::max(expected, length);
+        }
+      }
+    EXPECT_DOUBLE_EQ(std::sqrt(expected), l2s->GetOutput()->GetLabelObject(label)->GetFeretDiameter());
+    }
+}
+
+
+TEST_F(ShapeLabelMapFixture,RandomObjects_WorkUnitsAndPrincipalMoments)
+{
+  // The attributes must not depend on the number of work units, and
+  // disabling the principal moments must not change the other attributes
+  using Utils = FixtureUtilities<2>;
+
+  Utils::ImageType::Pointer image( Utils::CreateImage() );
+
+  unsigned int seed = 42;
+  for (itk::ImageRegionIterator<Utils::ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+    seed = seed * 1103515245u + 12345u;
+    it.Set( static_cast<Utils::PixelType>( ( seed >> 16 ) % 40 ) );
+    }
+
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+  L2SType::Pointer reference = L2SType::New();
+  reference->SetInput( image );
+  reference->ComputeFeretDiameterOn();
+  reference->SetNumberOfWorkUnits(1);
+  reference->Update();
+
+  L2SType::Pointer l2s = L2SType::New();
+  EXPECT_TRUE(l2s->GetComputePrincipalMoments());
+  l2s->SetInput( image );
+  l2s->ComputeFeretDiameterOn();
+  l2s->ComputePrincipalMomentsOff();
+  l2s->SetNumberOfWorkUnits(7);
+  l2s->Update();
+
+  ASSERT_EQ(reference->GetOutput()->GetNumberOfLabelObjects(), l2s->GetOutput()->GetNumberOfLabelObjects());
+  for (Utils::PixelType label = 1; label < 40; ++label)
+    {
+    const Utils::LabelObjectType * expected = reference->GetOutput()->GetLabelObject(label);
+    const Utils::LabelObjectType * labelObject = l2s->GetOutput()->GetLabelObject(label);
+    EXPECT_EQ(expected->GetNumberOfPixels(), labelObject->GetNumberOfPixels());
+    EXPECT_EQ(expected->GetBoundingBox(), labelObject->GetBoundingBox());
+    EXPECT_EQ(expected->GetCentroid(), labelObject->GetCentroid());
+    EXPECT_EQ(expected->GetPerimeter(), labelObject->GetPerimeter());
+    EXPECT_EQ(expected->GetFeretDiameter(), labelObject->GetFeretDiameter());
+    EXPECT_EQ(expected->GetEquivalentSphericalRadius(), labelObject->GetEquivalentSphericalRadius());
+    EXPECT_EQ(Utils::LabelObjectType::VectorType(0.0), labelObject->GetPrincipalMoments());
+    }
+}
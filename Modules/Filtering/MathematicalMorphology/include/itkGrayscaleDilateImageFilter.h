@@ -111,7 +111,10 @@ public:
 
   itkGetConstMacro(Boundary, PixelType);
 
-  /** Set/Get the backend filter class. */
+  /** Set/Get the backend filter class.  SetKernel() selects ANCHOR for the
+   * decomposable flat kernels.  For a box, whose lines are all along the
+   * image axes, VHGW processes the lines in place and is usually faster;
+   * select it with SetAlgorithm(VHGW) once the kernel is set. */
   void SetAlgorithm(int algo);
 
   itkGetConstMacro(Algorithm, int);
@@ -23,6 +23,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include <queue>
+#include <vector>
 
 //#define BASIC
 #define COPY
@@ -43,6 +44,13 @@ namespace itk
  * applications and efficient algorithms" -- IEEE Transactions on
  * Image processing, Vol 2, No 2, pp 176-201, April 1993
  *
+ * When several work units are available, the image is split in slabs
+ * along its last dimension. The three steps of the algorithm run in
+ * parallel in each slab, then the values are propagated across the
+ * borders of the slabs, and the FIFO step is run again in the slabs
+ * which received new values, until nothing changes anymore. The result
+ * is the same as with the single threaded algorithm.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -135,6 +143,17 @@ public:
   itkGetConstReferenceMacro(UseInternalCopy, bool);
   itkBooleanMacro(UseInternalCopy);
 
+  /**
+   * Split the image in slabs processed in parallel when more than one work
+   * unit is available. Default is UseParallelTilesOff. The output does not
+   * depend on this option. The tiles are processed in the output and mask
+   * buffers, without the padded copies, so UseInternalCopy has no effect
+   * on this path.
+   */
+  itkSetMacro(UseParallelTiles, bool);
+  itkGetConstReferenceMacro(UseParallelTiles, bool);
+  itkBooleanMacro(UseParallelTiles);
+
 protected:
   ReconstructionImageFilter();
   ~ReconstructionImageFilter() override = default;
@@ -158,6 +177,11 @@ protected:
 private:
   bool m_FullyConnected;
   bool m_UseInternalCopy;
+  bool m_UseParallelTiles;
+
+  /** Reconstruction of the output requested region split in
+   * numberOfTiles slabs. */
+  void GenerateDataInTiles(unsigned int numberOfTiles, ProgressReporter & progress);
 
   using FaceCalculatorType = typename itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< OutputImageType >;
 
@@ -26,6 +26,8 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template< typename TInputImage, typename TOutputImage, typename TCompare >
@@ -34,6 +36,7 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
 {
   m_FullyConnected = false;
   m_UseInternalCopy = true;
+  m_UseParallelTiles = false;
 }
 
 template< typename TInputImage, typename TOutputImage, typename TCompare >
@@ -125,6 +128,17 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
     itkExceptionMacro(<< "Marker and mask must have the same size.");
     }
 
+  const SizeValueType numberOfSlices =
+    output->GetRequestedRegion().GetSize()[OutputImageDimension - 1];
+  if ( m_UseParallelTiles && OutputImageDimension > 1
+       && this->GetNumberOfWorkUnits() > 1 && numberOfSlices > 1 )
+    {
+    this->GenerateDataInTiles(
+      static_cast< unsigned int >( std::min< SizeValueType >( this->GetNumberOfWorkUnits(), numberOfSlices ) ),
+      progress);
+    return;
+    }
+
   // create padded versions of the marker image and the mask image
   using PadType = typename itk::ConstantPadImageFilter< InputImageType, InputImageType >;
 
@@ -388,6 +402,348 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
     }
 }
 
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::GenerateDataInTiles(unsigned int numberOfTiles, ProgressReporter & progress)
+{
+  constexpr unsigned int Dimension = OutputImageDimension;
+  constexpr unsigned int SplitDimension = Dimension - 1;
+
+  using OffsetType = typename OutputImageType::OffsetType;
+  using FifoType = std::queue< OffsetValueType >;
+
+  TCompare compare;
+
+  OutputImageType *       output = this->GetOutput();
+  const MarkerImageType * markerImage = this->GetMarkerImage();
+  const MaskImageType *   maskImage = this->GetMaskImage();
+
+  const OutputImageRegionType region = output->GetRequestedRegion();
+  const typename OutputImageType::SizeType size = region.GetSize();
+
+  if ( maskImage->GetBufferedRegion().GetSize() != size )
+    {
+    itkExceptionMacro(<< "The mask must be buffered on its whole size.");
+    }
+
+  // copy the marker to the output, and check the preconditions
+  InputIteratorType  markerIt( markerImage, markerImage->GetRequestedRegion() );
+  InputIteratorType  maskIt( maskImage, maskImage->GetBufferedRegion() );
+  OutputIteratorType outIt( output, region );
+  for ( ; !outIt.IsAtEnd(); ++markerIt, ++maskIt, ++outIt )
+    {
+    const auto V = static_cast< OutputImagePixelType >( markerIt.Get() );
+    if ( compare( V, static_cast< OutputImagePixelType >( maskIt.Get() ) ) )
+      {
+      if ( compare(0, 1) )
+        {
+        itkExceptionMacro(<< "Marker pixels must be <= mask pixels.");
+        }
+      else
+        {
+        itkExceptionMacro(<< "Marker pixels must be >= mask pixels.");
+        }
+      }
+    outIt.Set(V);
+    progress.CompletedPixel();
+    }
+
+  OutputImagePixelType *      out = output->GetBufferPointer();
+  const MaskImagePixelType *  mask = maskImage->GetBufferPointer();
+
+  OffsetValueType strides[Dimension];
+  strides[0] = 1;
+  for ( unsigned int d = 1; d < Dimension; d++ )
+    {
+    strides[d] = strides[d - 1] * size[d - 1];
+    }
+
+  // The neighbors, split between the ones before and after the center
+  // in raster order
+  struct Neighbor
+  {
+    OffsetType      offset;
+    OffsetValueType linear;
+  };
+  std::vector< Neighbor > neighbors;
+  std::vector< Neighbor > previousNeighbors;
+  std::vector< Neighbor > laterNeighbors;
+  {
+    OffsetType offset;
+    offset.Fill(-1);
+    for ( ;; )
+      {
+      unsigned int nonZero = 0;
+      OffsetValueType linear = 0;
+      for ( unsigned int d = 0; d < Dimension; d++ )
+        {
+        nonZero += offset[d] != 0;
+        linear += offset[d] * strides[d];
+        }
+      if ( nonZero == 1 || ( nonZero > 1 && m_FullyConnected ) )
+        {
+        neighbors.push_back( { offset, linear } );
+        ( linear < 0 ? previousNeighbors : laterNeighbors ).push_back( { offset, linear } );
+        }
+      unsigned int d = 0;
+      while ( d < Dimension && offset[d] == 1 )
+        {
+        offset[d++] = -1;
+        }
+      if ( d == Dimension )
+        {
+        break;
+        }
+      ++offset[d];
+      }
+  }
+
+  // the tiles are slabs along the slowest axis
+  std::vector< IndexValueType > tileStart( numberOfTiles + 1 );
+  for ( unsigned int t = 0; t <= numberOfTiles; t++ )
+    {
+    tileStart[t] = static_cast< IndexValueType >( size[SplitDimension] * t / numberOfTiles );
+    }
+  std::vector< FifoType > fifos( numberOfTiles );
+
+  // the upper bounds of the coordinates, excluded, in a tile
+  auto upperBound = [&]( unsigned int tile, unsigned int d ) -> IndexValueType
+    {
+      return d == SplitDimension ? tileStart[tile + 1] : static_cast< IndexValueType >( size[d] );
+    };
+  auto lowerBound = [&]( unsigned int tile, unsigned int d ) -> IndexValueType
+    {
+      return d == SplitDimension ? tileStart[tile] : 0;
+    };
+
+  // propagate the value of p to its neighbor n, as in the FIFO step of the
+  // serial algorithm
+  auto propagate = [&]( OffsetValueType p, OffsetValueType n, FifoType & fifo )
+    {
+      const OutputImagePixelType V = out[p];
+      const OutputImagePixelType VN = out[n];
+      const auto                 iN = static_cast< OutputImagePixelType >( mask[n] );
+      if ( compare(V, VN) && Math::NotAlmostEquals(iN, VN) )
+        {
+        out[n] = compare(iN, V) ? V : iN;
+        fifo.push(n);
+        }
+    };
+
+  auto processFifo = [&]( unsigned int tile )
+    {
+      FifoType & fifo = fifos[tile];
+      while ( !fifo.empty() )
+        {
+        const OffsetValueType p = fifo.front();
+        fifo.pop();
+        IndexValueType idx[Dimension];
+        OffsetValueType remainder = p;
+        for ( unsigned int d = Dimension; d-- > 0; )
+          {
+          idx[d] = remainder / strides[d];
+          remainder -= idx[d] * strides[d];
+          }
+        for ( const auto & neighbor : neighbors )
+          {
+          bool inside = true;
+          for ( unsigned int d = 0; d < Dimension; d++ )
+            {
+            const IndexValueType c = idx[d] + neighbor.offset[d];
+            inside &= c >= lowerBound(tile, d) && c < upperBound(tile, d);
+            }
+          if ( inside )
+            {
+            propagate(p, p + neighbor.linear, fifo);
+            }
+          }
+        }
+    };
+
+  // The raster and anti-raster passes of the serial algorithm, restricted
+  // to a tile. The rows are visited in raster order, and only the
+  // neighbors in the tile are considered: the coordinates other than x are
+  // checked once per row, and x only at the ends of the rows.
+  auto processTile = [&]( SizeValueType tile )
+    {
+      const SizeValueType rowLength = size[0];
+      SizeValueType numberOfRows = 1;
+      for ( unsigned int d = 1; d < Dimension; d++ )
+        {
+        numberOfRows *= upperBound(tile, d) - lowerBound(tile, d);
+        }
+
+      auto rowIndex = [&]( SizeValueType row, IndexValueType idx[] )
+        {
+          OffsetValueType linear = 0;
+          idx[0] = 0;
+          for ( unsigned int d = 1; d < Dimension; d++ )
+            {
+            const SizeValueType length = upperBound(tile, d) - lowerBound(tile, d);
+            idx[d] = lowerBound(tile, d) + static_cast< IndexValueType >( row % length );
+            row /= length;
+            linear += idx[d] * strides[d];
+            }
+          return linear;
+        };
+
+      auto rowNeighbors = [&]( const std::vector< Neighbor > & all, const IndexValueType idx[],
+                               std::vector< Neighbor > & inRow )
+        {
+          inRow.clear();
+          for ( const auto & neighbor : all )
+            {
+            bool inside = true;
+            for ( unsigned int d = 1; d < Dimension; d++ )
+              {
+              const IndexValueType c = idx[d] + neighbor.offset[d];
+              inside &= c >= lowerBound(tile, d) && c < upperBound(tile, d);
+              }
+            if ( inside )
+              {
+              inRow.push_back(neighbor);
+              }
+            }
+        };
+
+      auto xInside = [&]( IndexValueType x, const Neighbor & neighbor )
+        {
+          const IndexValueType c = x + neighbor.offset[0];
+          return c >= 0 && c < static_cast< IndexValueType >( rowLength );
+        };
+
+      IndexValueType          idx[Dimension];
+      std::vector< Neighbor > inRow;
+
+      // forward raster order
+      for ( SizeValueType row = 0; row < numberOfRows; row++ )
+        {
+        const OffsetValueType base = rowIndex(row, idx);
+        rowNeighbors(previousNeighbors, idx, inRow);
+        for ( IndexValueType x = 0; x < static_cast< IndexValueType >( rowLength ); x++ )
+          {
+          const OffsetValueType p = base + x;
+          OutputImagePixelType  V = out[p];
+          for ( const auto & neighbor : inRow )
+            {
+            if ( xInside(x, neighbor) && compare(out[p + neighbor.linear], V) )
+              {
+              V = out[p + neighbor.linear];
+              }
+            }
+          const auto iV = static_cast< OutputImagePixelType >( mask[p] );
+          out[p] = compare(V, iV) ? iV : V;
+          }
+        }
+
+      // reverse raster order, filling the fifo with the pixels which can
+      // still propagate
+      FifoType & fifo = fifos[tile];
+      for ( SizeValueType row = numberOfRows; row-- > 0; )
+        {
+        const OffsetValueType base = rowIndex(row, idx);
+        rowNeighbors(laterNeighbors, idx, inRow);
+        for ( IndexValueType x = static_cast< IndexValueType >( rowLength ); x-- > 0; )
+          {
+          const OffsetValueType p = base + x;
+          OutputImagePixelType  V = out[p];
+          for ( const auto & neighbor : inRow )
+            {
+            if ( xInside(x, neighbor) && compare(out[p + neighbor.linear], V) )
+              {
+              V = out[p + neighbor.linear];
+              }
+            }
+          const auto iV = static_cast< OutputImagePixelType >( mask[p] );
+          if ( compare(V, iV) )
+            {
+            V = iV;
+            }
+          out[p] = V;
+
+          for ( const auto & neighbor : inRow )
+            {
+            if ( xInside(x, neighbor) )
+              {
+              const OffsetValueType n = p + neighbor.linear;
+              if ( compare(V, out[n]) && compare(static_cast< OutputImagePixelType >( mask[n] ), out[n]) )
+                {
+                fifo.push(p);
+                break;
+                }
+              }
+            }
+          }
+        }
+
+      processFifo(tile);
+    };
+
+  // Propagate across the boundaries between the tiles. This only reads and
+  // writes the two planes on both sides of each boundary, and is done
+  // serially between the parallel steps.
+  auto exchange = [&]()
+    {
+      bool changed = false;
+      for ( unsigned int t = 0; t + 1 < numberOfTiles; t++ )
+        {
+        const IndexValueType planes[2] = { tileStart[t + 1] - 1, tileStart[t + 1] };
+        for ( unsigned int side = 0; side < 2; side++ )
+          {
+          const IndexValueType direction = side == 0 ? 1 : -1;
+          FifoType &           fifo = fifos[side == 0 ? t + 1 : t];
+          const SizeValueType  numberOfPixels = region.GetNumberOfPixels() / size[SplitDimension];
+          for ( SizeValueType i = 0; i < numberOfPixels; i++ )
+            {
+            IndexValueType  idx[Dimension];
+            SizeValueType   rest = i;
+            OffsetValueType p = planes[side] * strides[SplitDimension];
+            for ( unsigned int d = 0; d < SplitDimension; d++ )
+              {
+              idx[d] = static_cast< IndexValueType >( rest % size[d] );
+              rest /= size[d];
+              p += idx[d] * strides[d];
+              }
+            for ( const auto & neighbor : neighbors )
+              {
+              if ( neighbor.offset[SplitDimension] != direction )
+                {
+                continue;
+                }
+              bool inside = true;
+              for ( unsigned int d = 0; d < SplitDimension; d++ )
+                {
+                const IndexValueType c = idx[d] + neighbor.offset[d];
+                inside &= c >= 0 && c < static_cast< IndexValueType >( size[d] );
+                }
+              if ( inside )
+                {
+                propagate(p, p + neighbor.linear, fifo);
+                }
+              }
+            }
+          changed |= !fifo.empty();
+          }
+        }
+      return changed;
+    };
+
+  // The copy of the marker was the first third of the progress, the
+  // passes in the tiles are the second one, and the exchanges share the
+  // last third, each one taking half of what remains.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->ParallelizeArray(0, numberOfTiles, processTile, nullptr);
+  float currentProgress = 2.0f / 3.0f;
+  this->UpdateProgress(currentProgress);
+  while ( exchange() )
+    {
+    multiThreader->ParallelizeArray(0, numberOfTiles, [&]( SizeValueType tile ) { processFifo(tile); }, nullptr);
+    currentProgress += ( 1.0f - currentProgress ) / 2.0f;
+    this->UpdateProgress(currentProgress);
+    }
+}
+
 template< typename TInputImage, typename TOutputImage, typename TCompare >
 void
 ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
@@ -398,6 +754,7 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
   os << indent << "FullyConnected: "  << m_FullyConnected << std::endl;
   os << indent << "MarkerValue: " << m_MarkerValue << std::endl;
   os << indent << "UseInternalCopy: " << m_UseInternalCopy << std::endl;
+  os << indent << "UseParallelTiles: " << m_UseParallelTiles << std::endl;
 }
 }
 #endif
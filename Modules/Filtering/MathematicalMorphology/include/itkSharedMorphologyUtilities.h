@@ -73,6 +73,11 @@ MakeEnlargedFace(const TInputImage *input,
 template< typename TLine >
 unsigned int GetLinePixels(const TLine line);
 
+// true if the line is parallel to one of the image axes, in which
+// case axis is set to the index of that axis
+template< typename TLine >
+bool IsAxisAlignedLine(const TLine line, unsigned int & axis);
+
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -22,6 +22,7 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include "itkMath.h"
 #include <list>
 
 namespace itk
@@ -422,6 +423,22 @@ unsigned int GetLinePixels(const TLine line)
   N *= correction;
   return (int)( N + 0.5 );
 }
+
+template< typename TLine >
+bool IsAxisAlignedLine(const TLine line, unsigned int & axis)
+{
+  unsigned int nonZero = 0;
+
+  for ( unsigned int i = 0; i < TLine::Dimension; i++ )
+    {
+    if ( Math::NotExactlyEquals(line[i], 0.0f) )
+      {
+      axis = i;
+      ++nonZero;
+      }
+    }
+  return nonZero == 1;
+}
 } // namespace itk
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "itkVanHerkGilWermanErodeDilateImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageAlgorithm.h"
 
 #include "itkVanHerkGilWermanUtilities.h"
 
@@ -98,12 +99,26 @@ VanHerkGilWermanErodeDilateImageFilter< TImage, TKernel, TFunction1 >
       ++SELength;
       }
 
-    InputImageRegionType BigFace = MakeEnlargedFace< InputImageType, KernelLType >(input, IReg, ThisLine);
+    unsigned int axis;
+    if ( IsAxisAlignedLine< KernelLType >(ThisLine, axis) )
+      {
+      // lines along an image axis (boxes and the axis aligned parts of
+      // polygons) are processed in place, many lines at a time
+      if ( input.GetPointer() != internalbuffer.GetPointer() )
+        {
+        ImageAlgorithm::Copy(input.GetPointer(), internalbuffer.GetPointer(), IReg, IReg);
+        }
+      DoAxisAlignedLines< TImage, TFunction1 >(internalbuffer, m_Boundary, axis, SELength, forward, reverse);
+      }
+    else
+      {
+      InputImageRegionType BigFace = MakeEnlargedFace< InputImageType, KernelLType >(input, IReg, ThisLine);
 
-    DoFace< TImage, BresType, TFunction1, KernelLType >(input, output, m_Boundary, ThisLine,
-                                                        TheseOffsets, SELength,
-                                                        buffer, forward,
-                                                        reverse, IReg, BigFace);
+      DoFace< TImage, BresType, TFunction1, KernelLType >(input, output, m_Boundary, ThisLine,
+                                                          TheseOffsets, SELength,
+                                                          buffer, forward,
+                                                          reverse, IReg, BigFace);
+      }
 
     // after the first pass the input will be taken from the output
     input = internalbuffer;
@@ -53,6 +53,19 @@ void DoFace(typename TImage::ConstPointer input,
             std::vector<typename TImage::PixelType> & rExtBuffer,
             const typename TImage::RegionType AllImage,
             const typename TImage::RegionType face);
+
+// Process every line parallel to the given axis of image, in place.
+// Neighbouring lines are processed together, one row of the extreme
+// buffers per line position, so that the inner loops run over
+// contiguous memory for all but the fastest moving axis. The result
+// is identical to DoFace for the same axis aligned line.
+template< typename TImage, typename TFunction >
+void DoAxisAlignedLines(typename TImage::Pointer image,
+                        typename TImage::PixelType border,
+                        const unsigned int axis,
+                        const unsigned int KernLen,
+                        std::vector<typename TImage::PixelType> & fExtBuffer,
+                        std::vector<typename TImage::PixelType> & rExtBuffer);
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -22,6 +22,7 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -209,6 +210,177 @@ void DoFace(typename TImage::ConstPointer input,
     }
 }
 
+template< typename TImage, typename TFunction >
+void DoAxisAlignedLines(typename TImage::Pointer image,
+                        typename TImage::PixelType border,
+                        const unsigned int axis,
+                        const unsigned int KernLen,
+                        std::vector<typename TImage::PixelType> & fExtBuffer,
+                        std::vector<typename TImage::PixelType> & rExtBuffer)
+{
+  using PixelType = typename TImage::PixelType;
+
+  // number of lines processed together
+  constexpr SizeValueType BlockWidth = 64;
+
+  const typename TImage::SizeType size = image->GetBufferedRegion().GetSize();
+  const SizeValueType len = size[axis];
+  if ( len == 0 || image->GetBufferedRegion().GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  SizeValueType inner = 1;
+  for ( unsigned int d = 0; d < axis; d++ )
+    {
+    inner *= size[d];
+    }
+  SizeValueType outer = 1;
+  for ( unsigned int d = axis + 1; d < TImage::ImageDimension; d++ )
+    {
+    outer *= size[d];
+    }
+
+  // Lines along the fastest axis are contiguous, so neighbouring lines
+  // are a full line apart. Along the other axes, the lines sharing the
+  // slower coordinates are adjacent in memory.
+  SizeValueType along = inner;
+  SizeValueType across = 1;
+  SizeValueType linesPerGroup = inner;
+  SizeValueType groups = outer;
+  SizeValueType groupStride = inner * len;
+  if ( axis == 0 )
+    {
+    along = 1;
+    across = len;
+    linesPerGroup = outer;
+    groups = 1;
+    groupStride = 0;
+    }
+
+  // like DoFace, each line is padded with a border pixel at both ends
+  const SizeValueType padded = len + 2;
+  const SizeValueType last = padded - 1;
+  const SizeValueType half = KernLen / 2;
+
+  const SizeValueType width = std::min(BlockWidth, linesPerGroup);
+  if ( fExtBuffer.size() < padded * width )
+    {
+    fExtBuffer.resize(padded * width);
+    }
+  if ( rExtBuffer.size() < padded * width )
+    {
+    rExtBuffer.resize(padded * width);
+    }
+
+  PixelType * const buffer = image->GetBufferPointer();
+  TFunction m_TF;
+
+  for ( SizeValueType g = 0; g < groups; g++ )
+    {
+    for ( SizeValueType first = 0; first < linesPerGroup; first += BlockWidth )
+      {
+      const SizeValueType w = std::min(BlockWidth, linesPerGroup - first);
+      PixelType * const base = buffer + g * groupStride + first * across;
+
+      // forward extremes, restarted at every multiple of KernLen. The
+      // padding rows are the border value.
+      for ( SizeValueType c = 0; c < w; c++ )
+        {
+        fExtBuffer[c] = border;
+        }
+      for ( SizeValueType i = 1; i < last; i++ )
+        {
+        const PixelType * src = base + ( i - 1 ) * along;
+        const SizeValueType row = i * w;
+        if ( i % KernLen == 0 )
+          {
+          for ( SizeValueType c = 0; c < w; c++ )
+            {
+            fExtBuffer[row + c] = src[c * across];
+            }
+          }
+        else
+          {
+          for ( SizeValueType c = 0; c < w; c++ )
+            {
+            fExtBuffer[row + c] = m_TF(src[c * across], fExtBuffer[row - w + c]);
+            }
+          }
+        }
+      for ( SizeValueType c = 0, row = last * w; c < w; c++ )
+        {
+        fExtBuffer[row + c] = ( last % KernLen == 0 ) ? border : m_TF(border, fExtBuffer[row - w + c]);
+        }
+
+      // reverse extremes, restarted at the end of every block
+      for ( SizeValueType c = 0, row = last * w; c < w; c++ )
+        {
+        rExtBuffer[row + c] = border;
+        }
+      for ( SizeValueType i = last - 1; i > 0; i-- )
+        {
+        const PixelType * src = base + ( i - 1 ) * along;
+        const SizeValueType row = i * w;
+        if ( ( i + 1 ) % KernLen == 0 )
+          {
+          for ( SizeValueType c = 0; c < w; c++ )
+            {
+            rExtBuffer[row + c] = src[c * across];
+            }
+          }
+        else
+          {
+          for ( SizeValueType c = 0; c < w; c++ )
+            {
+            rExtBuffer[row + c] = m_TF(src[c * across], rExtBuffer[row + w + c]);
+            }
+          }
+        }
+      for ( SizeValueType c = 0; c < w; c++ )
+        {
+        rExtBuffer[c] = ( KernLen == 1 ) ? border : m_TF(border, rExtBuffer[w + c]);
+        }
+
+      // the window [j - half, j + half] spans at most two blocks, and
+      // is clipped to the padded line
+      for ( SizeValueType j = 1; j <= len; j++ )
+        {
+        PixelType * dst = base + ( j - 1 ) * along;
+        if ( j <= half )
+          {
+          const SizeValueType f = std::min(j + half, last) * w;
+          for ( SizeValueType c = 0; c < w; c++ )
+            {
+            dst[c * across] = fExtBuffer[f + c];
+            }
+          }
+        else
+          {
+          const SizeValueType lo = j - half;
+          const SizeValueType hi = std::min(j + half, last);
+          const SizeValueType r = lo * w;
+          if ( hi == last && lo / KernLen == last / KernLen )
+            {
+            for ( SizeValueType c = 0; c < w; c++ )
+              {
+              dst[c * across] = rExtBuffer[r + c];
+              }
+            }
+          else
+            {
+            const SizeValueType f = hi * w;
+            for ( SizeValueType c = 0; c < w; c++ )
+              {
+              dst[c * across] = m_TF(rExtBuffer[r + c], fExtBuffer[f + c]);
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
 } // namespace itk
 
 #endif
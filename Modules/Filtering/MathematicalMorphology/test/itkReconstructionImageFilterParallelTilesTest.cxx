@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+
+// A random mask, and a marker equal to the mask on a few seeds and to
+// background elsewhere, so that the values travel far from the seeds
+template< typename TImage >
+void
+MakeMarkerAndMask( const typename TImage::SizeType & size,
+                   typename TImage::PixelType background,
+                   typename TImage::Pointer & marker,
+                   typename TImage::Pointer & mask )
+{
+  marker = TImage::New();
+  marker->SetRegions( size );
+  marker->Allocate();
+  mask = TImage::New();
+  mask->SetRegions( size );
+  mask->Allocate();
+
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 5678 );
+
+  itk::ImageRegionIterator< TImage > markerIt( marker, marker->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< TImage > maskIt( mask, mask->GetLargestPossibleRegion() );
+  for ( ; !maskIt.IsAtEnd(); ++markerIt, ++maskIt )
+    {
+    // mostly bright values with some darker walls
+    const auto value = static_cast< typename TImage::PixelType >(
+      generator->GetUniformVariate( 0, 1 ) < 0.3 ? generator->GetIntegerVariate( 100 )
+                                                 : 100 + generator->GetIntegerVariate( 155 ) );
+    maskIt.Set( value );
+    markerIt.Set( generator->GetUniformVariate( 0, 1 ) < 0.002 ? value : background );
+    }
+}
+
+template< typename TImage >
+bool
+SameImages( const TImage * a, const TImage * b )
+{
+  itk::ImageRegionConstIterator< TImage > ait( a, a->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > bit( b, b->GetLargestPossibleRegion() );
+  for ( ; !ait.IsAtEnd(); ++ait, ++bit )
+    {
+    if ( ait.Get() != bit.Get() )
+      {
+      std::cerr << "Images differ at " << ait.GetIndex() << ": "
+                << static_cast< int >( ait.Get() ) << " != " << static_cast< int >( bit.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Run the filter on a single thread and split in tiles, and check that
+// both give the same output
+template< typename TFilter >
+bool
+CompareWithTiles( const typename TFilter::InputImageType * marker,
+                  const typename TFilter::InputImageType * mask,
+                  bool fullyConnected )
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  typename TFilter::Pointer serial = TFilter::New();
+  serial->SetMarkerImage( marker );
+  serial->SetMaskImage( mask );
+  serial->SetFullyConnected( fullyConnected );
+  serial->UseParallelTilesOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION( serial->Update() );
+
+  bool passed = true;
+  for ( unsigned int workUnits = 2; workUnits <= 64; workUnits *= 4 )
+    {
+    typename TFilter::Pointer tiled = TFilter::New();
+    tiled->SetMarkerImage( marker );
+    tiled->SetMaskImage( mask );
+    tiled->SetFullyConnected( fullyConnected );
+    tiled->SetNumberOfWorkUnits( workUnits );
+    tiled->UseParallelTilesOn();
+    ITK_TRY_EXPECT_NO_EXCEPTION( tiled->Update() );
+
+    if ( !SameImages< ImageType >( serial->GetOutput(), tiled->GetOutput() ) )
+      {
+      std::cerr << "Failure with " << workUnits << " work units, FullyConnected: "
+                << fullyConnected << std::endl;
+      passed = false;
+      }
+    }
+  return passed;
+}
+
+template< unsigned int VDimension >
+bool
+TestDimension( const itk::Size< VDimension > & size )
+{
+  using PixelType = unsigned char;
+  using ImageType = itk::Image< PixelType, VDimension >;
+  using DilationType = itk::ReconstructionByDilationImageFilter< ImageType, ImageType >;
+  using ErosionType = itk::ReconstructionByErosionImageFilter< ImageType, ImageType >;
+
+  typename ImageType::Pointer marker;
+  typename ImageType::Pointer mask;
+  typename ImageType::Pointer invertedMarker = ImageType::New();
+  typename ImageType::Pointer invertedMask = ImageType::New();
+
+  MakeMarkerAndMask< ImageType >( size, 0, marker, mask );
+
+  // the dual problem for the erosion
+  for ( auto * image : { invertedMarker.GetPointer(), invertedMask.GetPointer() } )
+    {
+    image->SetRegions( size );
+    image->Allocate();
+    }
+  itk::ImageRegionConstIterator< ImageType > markerIt( marker, marker->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageType > maskIt( mask, mask->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< ImageType >      invertedMarkerIt( invertedMarker, marker->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< ImageType >      invertedMaskIt( invertedMask, mask->GetLargestPossibleRegion() );
+  for ( ; !markerIt.IsAtEnd(); ++markerIt, ++maskIt, ++invertedMarkerIt, ++invertedMaskIt )
+    {
+    invertedMarkerIt.Set( 255 - markerIt.Get() );
+    invertedMaskIt.Set( 255 - maskIt.Get() );
+    }
+
+  bool passed = true;
+  for ( bool fullyConnected : { false, true } )
+    {
+    passed &= CompareWithTiles< DilationType >( marker, mask, fullyConnected );
+    passed &= CompareWithTiles< ErosionType >( invertedMarker, invertedMask, fullyConnected );
+    }
+  return passed;
+}
+
+} // end namespace
+
+int itkReconstructionImageFilterParallelTilesTest( int, char *[] )
+{
+  using FilterType = itk::ReconstructionByDilationImageFilter< itk::Image< unsigned char, 2 >,
+                                                               itk::Image< unsigned char, 2 > >;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_TEST_EXPECT_TRUE( !filter->GetUseParallelTiles() );
+  ITK_TEST_SET_GET_BOOLEAN( filter, UseParallelTiles, true );
+
+  bool passed = true;
+
+  itk::Size< 2 > size2 = {{ 83, 61 }};
+  passed &= TestDimension< 2 >( size2 );
+
+  itk::Size< 3 > size3 = {{ 31, 27, 40 }};
+  passed &= TestDimension< 3 >( size3 );
+
+  if ( !passed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
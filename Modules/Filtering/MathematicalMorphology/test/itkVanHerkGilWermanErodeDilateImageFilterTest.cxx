@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+template< typename TImage >
+typename TImage::Pointer
+MakeRandomImage( const typename TImage::SizeType & size )
+{
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( size );
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  itk::ImageRegionIterator< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< typename TImage::PixelType >( generator->GetIntegerVariate( 255 ) ) );
+    }
+  return image;
+}
+
+template< typename TImage >
+bool
+SameImages( const TImage * a, const TImage * b )
+{
+  itk::ImageRegionConstIterator< TImage > ait( a, a->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > bit( b, b->GetLargestPossibleRegion() );
+  for ( ; !ait.IsAtEnd(); ++ait, ++bit )
+    {
+    if ( ait.Get() != bit.Get() )
+      {
+      std::cerr << "Images differ at " << ait.GetIndex() << ": "
+                << static_cast< int >( ait.Get() ) << " != " << static_cast< int >( bit.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Run the filter with the reference algorithm and with the van Herk/Gil-Werman
+// one, and check that both give the same output
+template< typename TFilter >
+bool
+CompareAlgorithms( const typename TFilter::InputImageType * input,
+                   const typename TFilter::KernelType & kernel,
+                   int referenceAlgorithm,
+                   const typename TFilter::PixelType boundary,
+                   unsigned int workUnits )
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  typename TFilter::Pointer reference = TFilter::New();
+  reference->SetInput( input );
+  reference->SetKernel( kernel );
+  reference->SetAlgorithm( referenceAlgorithm );
+  reference->SetBoundary( boundary );
+  reference->SetNumberOfWorkUnits( workUnits );
+
+  typename TFilter::Pointer vhgw = TFilter::New();
+  vhgw->SetInput( input );
+  vhgw->SetKernel( kernel );
+  vhgw->SetAlgorithm( TFilter::VHGW );
+  vhgw->SetBoundary( boundary );
+  vhgw->SetNumberOfWorkUnits( workUnits );
+
+  ITK_TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+  ITK_TRY_EXPECT_NO_EXCEPTION( vhgw->Update() );
+
+  return SameImages< ImageType >( reference->GetOutput(), vhgw->GetOutput() );
+}
+
+} // end namespace
+
+int itkVanHerkGilWermanErodeDilateImageFilterTest( int, char *[] )
+{
+  using PixelType = unsigned char;
+
+  // boxes only have lines along the image axes
+  constexpr unsigned int Dimension3 = 3;
+  using Image3Type = itk::Image< PixelType, Dimension3 >;
+  using SE3Type = itk::FlatStructuringElement< Dimension3 >;
+  using Dilate3Type = itk::GrayscaleDilateImageFilter< Image3Type, Image3Type, SE3Type >;
+  using Erode3Type = itk::GrayscaleErodeImageFilter< Image3Type, Image3Type, SE3Type >;
+
+  Image3Type::SizeType size3 = {{ 37, 29, 23 }};
+  Image3Type::Pointer  input3 = MakeRandomImage< Image3Type >( size3 );
+
+  SE3Type::RadiusType radius3;
+  radius3[0] = 3;
+  radius3[1] = 1;
+  radius3[2] = 5;
+  const SE3Type box = SE3Type::Box( radius3 );
+
+  // a kernel wider than the image along the last axis
+  SE3Type::RadiusType bigRadius3;
+  bigRadius3[0] = 2;
+  bigRadius3[1] = 0;
+  bigRadius3[2] = 15;
+  const SE3Type bigBox = SE3Type::Box( bigRadius3 );
+
+  bool passed = true;
+  for ( unsigned int workUnits = 1; workUnits <= 4; workUnits += 3 )
+    {
+    passed &= CompareAlgorithms< Dilate3Type >( input3, box, Dilate3Type::BASIC,
+                                                itk::NumericTraits< PixelType >::NonpositiveMin(), workUnits );
+    passed &= CompareAlgorithms< Erode3Type >( input3, box, Erode3Type::BASIC,
+                                               itk::NumericTraits< PixelType >::max(), workUnits );
+    // a boundary value which takes part in the result
+    passed &= CompareAlgorithms< Dilate3Type >( input3, box, Dilate3Type::BASIC, 200, workUnits );
+    passed &= CompareAlgorithms< Erode3Type >( input3, bigBox, Erode3Type::BASIC, 50, workUnits );
+    }
+
+  // polygons mix lines along the axes and diagonal lines, which are
+  // processed differently
+  constexpr unsigned int Dimension2 = 2;
+  using Image2Type = itk::Image< PixelType, Dimension2 >;
+  using SE2Type = itk::FlatStructuringElement< Dimension2 >;
+  using Dilate2Type = itk::GrayscaleDilateImageFilter< Image2Type, Image2Type, SE2Type >;
+
+  Image2Type::SizeType size2 = {{ 71, 53 }};
+  Image2Type::Pointer  input2 = MakeRandomImage< Image2Type >( size2 );
+
+  SE2Type::RadiusType radius2;
+  radius2.Fill( 6 );
+  const SE2Type polygon = SE2Type::Polygon( radius2, 4 );
+  passed &= CompareAlgorithms< Dilate2Type >( input2, polygon, Dilate2Type::ANCHOR, 100, 2 );
+
+  // a box keeps the anchor algorithm unless VHGW is selected
+  Dilate3Type::Pointer dilate = Dilate3Type::New();
+  dilate->SetKernel( box );
+  ITK_TEST_EXPECT_EQUAL( dilate->GetAlgorithm(), static_cast< int >( Dilate3Type::ANCHOR ) );
+  dilate->SetAlgorithm( Dilate3Type::VHGW );
+  ITK_TEST_EXPECT_EQUAL( dilate->GetAlgorithm(), static_cast< int >( Dilate3Type::VHGW ) );
+  Erode3Type::Pointer erode = Erode3Type::New();
+  erode->SetKernel( box );
+  ITK_TEST_EXPECT_EQUAL( erode->GetAlgorithm(), static_cast< int >( Erode3Type::ANCHOR ) );
+  erode->SetAlgorithm( Erode3Type::VHGW );
+  ITK_TEST_EXPECT_EQUAL( erode->GetAlgorithm(), static_cast< int >( Erode3Type::VHGW ) );
+
+  if ( !passed )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
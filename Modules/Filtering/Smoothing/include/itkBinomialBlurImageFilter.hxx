@@ -126,13 +126,10 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
 
   // How big is the input image?
   typename TInputImage::SizeType size = inputPtr->GetRequestedRegion().GetSize();
-  typename TInputImage::IndexType startIndex = inputPtr->GetRequestedRegion().GetIndex();
 
   // Iterator Typedefs for this routine
   using TempIterator = ImageRegionIterator< TTempImage >;
-  using TempReverseIterator = ImageRegionReverseIterator< TTempImage >;
   using InputIterator = ImageRegionConstIterator< TInputImage >;
-  using OutputIterator = ImageRegionIterator< TOutputImage >;
 
   // Create a progress reporter
   ProgressReporter progress(this, 0,
@@ -148,10 +145,13 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
     tempIt.Set( static_cast< double >( inputIt.Get() ) );
     }
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  typename TTempImage::IndexType index;
-  typename TTempImage::IndexType indexShift;
+  // The temporary image is buffered over its whole region, so that the
+  // neighbor of a pixel along a dimension is at a fixed offset in the
+  // buffer.  The buffer is a sequence of blocks of size[dim] lines along
+  // dim, and the pixels are averaged with their neighbor in the order of
+  // the previous index based loops.
+  double * const      tempBuffer = tempPtr->GetBufferPointer();
+  const SizeValueType numberOfPixels = tempRegion.GetNumberOfPixels();
 
   // How many times has the algorithm executed? (for debug)
   int num_reps = 0;
@@ -169,84 +169,57 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
     // blur each dimension
     for ( unsigned int dim = 0; dim < NDimensions; dim++ )
       {
-      TempIterator tempItDir = TempIterator( tempPtr,
-                                             tempPtr->GetRequestedRegion() );
-      tempItDir.GoToBegin();
-      while ( !tempItDir.IsAtEnd() )
+      const SizeValueType lineLength = size[dim];
+      if ( lineLength < 2 )
         {
-        // determine the index of the output pixel
-        index = tempItDir.GetIndex();
+        continue;
+        }
+      const SizeValueType stride = static_cast< SizeValueType >( tempPtr->GetOffsetTable()[dim] );
+      const SizeValueType blockLength = stride * lineLength;
 
-        if ( index[dim] <
-             ( startIndex[dim] + static_cast< typename TTempImage::OffsetValueType >( size[dim] ) - 1 ) )
+      for ( SizeValueType block = 0; block < numberOfPixels; block += blockLength )
+        {
+        double * const blockBuffer = tempBuffer + block;
+        for ( SizeValueType j = 0; j + 1 < lineLength; ++j )
           {
-          // Figure out the location of the "neighbor" pixel
-          for ( unsigned int i = 0; i < NDimensions; i++ )
+          double * const line = blockBuffer + j * stride;
+          for ( SizeValueType k = 0; k < stride; ++k )
             {
-            if ( i == dim )
-              {
-              indexShift.m_InternalArray[i] = index.m_InternalArray[i] + 1;
-              }
-            else
-              {
-              indexShift.m_InternalArray[i] = index.m_InternalArray[i];
-              }
-            }
-
-          // Average the pixel of interest and shifted pixel
-          pixelA = tempPtr->GetPixel(index);
-          pixelB = tempPtr->GetPixel(indexShift);
+            // Average the pixel of interest and shifted pixel
+            pixelA = line[k];
+            pixelB = line[k + stride];
 
-          pixelA += pixelB;
-          pixelA = pixelA / 2.0;
+            pixelA += pixelB;
+            pixelA = pixelA / 2.0;
 
-          tempPtr->SetPixel(index, pixelA);
-          progress.CompletedPixel();
+            line[k] = pixelA;
+            progress.CompletedPixel();
+            }
           }
-
-        ++tempItDir;
         } // end walk the image forwards
 
       itkDebugMacro(<< "End processing forward dimension " << dim);
 
       //----------------------Reverse pass----------------------
-      TempReverseIterator tempReverseIt =
-        TempReverseIterator( tempPtr, tempPtr->GetRequestedRegion() );
-
-      tempReverseIt.GoToBegin();
-
-      while ( !tempReverseIt.IsAtEnd() )
+      for ( SizeValueType block = numberOfPixels; block > 0; block -= blockLength )
         {
-        // determine the index of the output pixel
-        index = tempReverseIt.GetIndex();
-
-        if ( index[dim] > startIndex[dim] )
+        double * const blockBuffer = tempBuffer + block - blockLength;
+        for ( SizeValueType j = lineLength - 1; j > 0; --j )
           {
-          // Figure out the location of the "neighbor" pixel
-          for ( unsigned int i = 0; i < NDimensions; i++ )
+          double * const line = blockBuffer + j * stride;
+          for ( SizeValueType k = stride; k > 0; --k )
             {
-            if ( i == dim )
-              {
-              indexShift.m_InternalArray[i] = index.m_InternalArray[i] - 1;
-              }
-            else
-              {
-              indexShift.m_InternalArray[i] = index.m_InternalArray[i];
-              }
-            }
+            // Average the pixel of interest and shifted pixel
+            pixelA = line[k - 1];
+            pixelB = line[k - 1 - stride];
 
-          // Average the pixel of interest and shifted pixel
-          pixelA = tempPtr->GetPixel(index);
-          pixelB = tempPtr->GetPixel(indexShift);
+            pixelA += pixelB;
+            pixelA = pixelA / 2;
 
-          pixelA += pixelB;
-          pixelA = pixelA / 2;
-
-          tempPtr->SetPixel(index, pixelA);
-          progress.CompletedPixel();
+            line[k - 1] = pixelA;
+            progress.CompletedPixel();
+            }
           }
-
-        ++tempReverseIt;
         } // end walk the image backwards
 
       itkDebugMacro(<< "End processing reverse dimension " << dim);
@@ -50,23 +50,38 @@ MeanImageFilter< TInputImage, TOutputImage >
   typename OutputImageType::Pointer output = this->GetOutput();
   typename  InputImageType::ConstPointer input  = this->GetInput();
 
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
+  // Split the region into an interior region, free of boundary
+  // conditions, and the data-set boundary "faces"
+  using PartitionType = NeighborhoodAlgorithm::ImageNeighborhoodPartition< InputImageType >;
+  using InteriorNeighborhoodType = typename PartitionType::InteriorNeighborhoodType;
+  const PartitionType partition( input, outputRegionForThread, this->GetRadius() );
 
   InputRealType sum;
 
+  // Process the interior region through flat offsets in the input buffer.
+  it = ImageRegionIterator< OutputImageType >( output, partition.GetInteriorRegion() );
+  partition.ForEachInteriorNeighborhood( [&it](const InteriorNeighborhoodType & neighborhood)
+    {
+    const unsigned int neighborhoodSize = neighborhood.Size();
+    InputRealType neighborhoodSum = NumericTraits< InputRealType >::ZeroValue();
+    for ( unsigned int n = 0; n < neighborhoodSize; ++n )
+      {
+      neighborhoodSum += static_cast< InputRealType >( neighborhood.GetPixel(n) );
+      }
+
+    // get the mean value
+    it.Set( static_cast< OutputPixelType >( neighborhoodSum / double(neighborhoodSize) ) );
+    ++it;
+    } );
+
   // Process each of the boundary faces.  These are N-d regions which border
   // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  for ( const auto & face : partition.GetBoundaryFaces() )
     {
     bit = ConstNeighborhoodIterator< InputImageType >(this->GetRadius(),
-                                                      input, *fit);
+                                                      input, face);
     unsigned int neighborhoodSize = bit.Size();
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
+    it = ImageRegionIterator< OutputImageType >(output, face);
     bit.OverrideBoundaryCondition(&nbc);
     bit.GoToBegin();
 
@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinomialBlurImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+// Blurs random images, and checks that the output is the one of the
+// original algorithm: for each repetition and each dimension, every pixel
+// is averaged with its next neighbor walking forwards, then with its
+// previous neighbor walking backwards, in double precision.
+namespace
+{
+
+template< typename TImage >
+std::vector< double >
+ReferenceBlur( const TImage * input, unsigned int repetitions )
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  const typename TImage::SizeType size = input->GetLargestPossibleRegion().GetSize();
+
+  std::vector< double > values;
+  for ( itk::ImageRegionConstIterator< TImage > it( input, input->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    values.push_back( static_cast< double >( it.Get() ) );
+    }
+
+  for ( unsigned int rep = 0; rep < repetitions; ++rep )
+    {
+    itk::SizeValueType stride = 1;
+    for ( unsigned int dim = 0; dim < Dimension; ++dim )
+      {
+      for ( itk::SizeValueType offset = 0; offset < values.size(); ++offset )
+        {
+        if ( ( offset / stride ) % size[dim] < size[dim] - 1 )
+          {
+          values[offset] = ( values[offset] + values[offset + stride] ) / 2.0;
+          }
+        }
+      for ( itk::SizeValueType offset = values.size(); offset-- > 0; )
+        {
+        if ( ( offset / stride ) % size[dim] > 0 )
+          {
+          values[offset] = ( values[offset] + values[offset - stride] ) / 2.0;
+          }
+        }
+      stride *= size[dim];
+      }
+    }
+  return values;
+}
+
+template< typename TImage >
+int
+CompareWithReference( const typename TImage::SizeType & size, unsigned int repetitions )
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  typename TImage::Pointer input = TImage::New();
+  input->SetRegions( size );
+  input->Allocate();
+  for ( itk::ImageRegionIterator< TImage > it( input, input->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< typename TImage::PixelType >( generator->GetUniformVariate( -1000.0, 1000.0 ) ) );
+    }
+
+  using FilterType = itk::BinomialBlurImageFilter< TImage, TImage >;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( input );
+  filter->SetRepetitions( repetitions );
+  ITK_TEST_SET_GET_VALUE( repetitions, filter->GetRepetitions() );
+  ITK_TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  const std::vector< double > expected = ReferenceBlur( input.GetPointer(), repetitions );
+  auto expectedIt = expected.cbegin();
+  for ( itk::ImageRegionConstIteratorWithIndex< TImage > it( filter->GetOutput(),
+          filter->GetOutput()->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it, ++expectedIt )
+    {
+    const auto expectedValue = static_cast< typename TImage::PixelType >( *expectedIt );
+    if ( it.Get() != expectedValue )
+      {
+      std::cerr << "Test failed with " << repetitions << " repetitions on an image of size " << size << std::endl;
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of " << expectedValue << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+int itkBinomialBlurImageFilterTest( int, char *[] )
+{
+  int testStatus = EXIT_SUCCESS;
+
+  using ImageType2D = itk::Image< float, 2 >;
+  using ImageType3D = itk::Image< short, 3 >;
+
+  ImageType2D::SizeType size2D;
+  size2D[0] = 23;
+  size2D[1] = 17;
+  ImageType3D::SizeType size3D;
+  size3D[0] = 9;
+  size3D[1] = 8;
+  size3D[2] = 7;
+  for ( unsigned int repetitions : { 1u, 3u } )
+    {
+    if ( CompareWithReference< ImageType2D >( size2D, repetitions ) == EXIT_FAILURE )
+      {
+      testStatus = EXIT_FAILURE;
+      }
+    if ( CompareWithReference< ImageType3D >( size3D, repetitions ) == EXIT_FAILURE )
+      {
+      testStatus = EXIT_FAILURE;
+      }
+    }
+
+  using FilterType = itk::BinomialBlurImageFilter< ImageType2D, ImageType2D >;
+  FilterType::Pointer filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( filter, BinomialBlurImageFilter, ImageToImageFilter );
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
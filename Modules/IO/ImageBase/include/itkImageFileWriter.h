@@ -160,6 +160,15 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the maximum number of pieces held at once: the one the
+   * upstream pipeline generates, and the ones waiting to be written.  With
+   * more than one, the pieces are written in the ThreadPool, in order,
+   * while the next ones are generated, and the input no longer holds the
+   * last piece once written.  The default, one, writes each piece before
+   * the next one is generated. \sa StreamingPieceQueue */
+  itkSetClampMacro(NumberOfPiecesInFlight, unsigned int, 1, NumericTraits< unsigned int >::max());
+  itkGetConstReferenceMacro(NumberOfPiecesInFlight, unsigned int);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void Update() override
@@ -208,6 +217,9 @@ protected:
   void GenerateData() override;
 
 private:
+  /** Writes the IORegion of the ImageIO from an image buffering it. */
+  void WriteImageData(const InputImageType *input);
+
   std::string m_FileName;
 
   ImageIOBase::Pointer m_ImageIO;
@@ -215,6 +227,7 @@ private:
 
   ImageIORegion m_PasteIORegion{ TInputImage::ImageDimension };
   unsigned int  m_NumberOfStreamDivisions{ 1 };
+  unsigned int  m_NumberOfPiecesInFlight{ 1 };
   bool          m_UserSpecifiedIORegion{ false };
 
   bool m_FactorySpecifiedImageIO{ false }; // did factory mechanism set the ImageIO?
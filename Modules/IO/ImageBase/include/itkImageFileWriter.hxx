@@ -32,6 +32,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include "itkStreamingPieceQueue.h"
 #include <complex>
 
 namespace itk
@@ -285,6 +286,10 @@ ImageFileWriter< TInputImage >
    */
   unsigned int piece;
 
+  // The pieces are written in order, in the ThreadPool, as they are
+  // generated
+  StreamingPieceQueue queue( m_NumberOfPiecesInFlight, true );
+
   for ( piece = 0;
         piece < numDivisions && !this->GetAbortGenerateData();
         piece++ )
@@ -337,13 +342,34 @@ ImageFileWriter< TInputImage >
         }
       }
 
-    m_ImageIO->SetIORegion(streamIORegion);
+    if ( queue.IsPipelined() && nonConstInput->GetSource()
+         && input->GetBufferedRegion() == streamRegion )
+      {
+      // The piece keeps the buffer, and the pipeline generates the next
+      // piece in a new one while this one is written
+      InputImagePointer pieceImage = InputImageType::New();
+      pieceImage->Graft( input );
+      nonConstInput->ReleaseData();
+      queue.Push( [this, pieceImage, streamIORegion]()
+        {
+        m_ImageIO->SetIORegion(streamIORegion);
+        this->WriteImageData( pieceImage );
+        } );
+      }
+    else
+      {
+      // The ImageIO is only used by one piece at a time
+      queue.WaitForAll();
+
+      m_ImageIO->SetIORegion(streamIORegion);
 
-    // write the data
-    this->GenerateData();
+      // write the data
+      this->GenerateData();
+      }
 
     this->UpdateProgress( static_cast<float>( piece + 1 ) / static_cast<float>( numDivisions ) );
     }
+  queue.WaitForAll();
 
   // Notify end event observers
   this->InvokeEvent( EndEvent() );
@@ -358,7 +384,15 @@ void
 ImageFileWriter< TInputImage >
 ::GenerateData()
 {
-  const InputImageType *input = this->GetInput();
+  this->WriteImageData( this->GetInput() );
+}
+
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::WriteImageData(const InputImageType *input)
+{
   InputImageRegionType  largestRegion = input->GetLargestPossibleRegion();
   InputImagePointer     cacheImage;
 
@@ -432,6 +466,7 @@ ImageFileWriter< TInputImage >
 
   os << indent << "IO Region: " << m_PasteIORegion << "\n";
   os << indent << "Number of Stream Divisions: " << m_NumberOfStreamDivisions << "\n";
+  os << indent << "Number of Pieces In Flight: " << m_NumberOfPiecesInFlight << "\n";
   os << indent << "CompressionLevel: " << m_CompressionLevel << "\n";
 
   if ( m_UseCompression )
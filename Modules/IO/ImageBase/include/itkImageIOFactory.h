@@ -51,6 +51,9 @@ public:
   typedef enum { ReadMode, WriteMode } FileModeType;
 
   /** Create the appropriate ImageIO depending on the particulars of the file.
+   * The ImageIO's that declare the extension of the file are asked first,
+   * then the other ones, in the order of the registered factories.  Only the
+   * ImageIO's that are asked are instantiated.
     */
   static ImageIOBasePointer CreateImageIO(const char *path, FileModeType mode);
 
@@ -18,6 +18,8 @@
 
 #include "itkImageIOFactory.h"
 
+#include <algorithm>
+#include <cctype>
 #include <mutex>
 
 
@@ -27,43 +29,159 @@ namespace itk
 namespace
 {
 std::mutex createImageIOLock;
+
+/** An ImageIO registered in the factories, with the file extensions it
+ * declares, in lower case. */
+struct RegisteredImageIO
+{
+  std::string                        m_Name;
+  ImageIOBase::ArrayOfExtensionsType m_ReadExtensions;
+  ImageIOBase::ArrayOfExtensionsType m_WriteExtensions;
+};
+
+/** The registered ImageIO's, in the order of the factories, and the
+ * names they were computed from.  Guarded by createImageIOLock. */
+std::vector< std::string >       registeredImageIONames;
+std::vector< RegisteredImageIO > registeredImageIOs;
+
+std::string
+ToLower(std::string s)
+{
+  std::transform( s.begin(), s.end(), s.begin(),
+                  [](unsigned char c) { return static_cast< char >( std::tolower(c) ); } );
+  return s;
 }
 
 ImageIOBase::Pointer
-ImageIOFactory::CreateImageIO(const char *path, FileModeType mode)
+CreateRegisteredImageIO(const std::string & name)
 {
-  std::list< ImageIOBase::Pointer > possibleImageIO;
+  LightObject::Pointer object = ObjectFactoryBase::CreateInstance( "itkImageIOBase", name.c_str() );
+  auto * io = dynamic_cast< ImageIOBase * >( object.GetPointer() );
+  if ( object && !io )
+    {
+    std::cerr << "Error ImageIO factory did not return an ImageIOBase: "
+              << object->GetNameOfClass()
+              << std::endl;
+    }
+  return io;
+}
 
-  std::lock_guard< std::mutex > mutexHolder( createImageIOLock );
+/** Updates the registered ImageIO's when the factories, or their enabled
+ * overrides, changed.  Each ImageIO is only instantiated then, to query
+ * its file extensions. */
+void
+UpdateRegisteredImageIOs()
+{
+  std::vector< std::string > names;
+  for ( auto & factory : ObjectFactoryBase::GetRegisteredFactories() )
+    {
+    const std::list< std::string > classNames = factory->GetClassOverrideNames();
+    const std::list< std::string > overrideNames = factory->GetClassOverrideWithNames();
+    const std::list< bool >        enableFlags = factory->GetEnableFlags();
+    auto overrideName = overrideNames.begin();
+    auto enableFlag = enableFlags.begin();
+    for ( auto & className : classNames )
+      {
+      if ( className == "itkImageIOBase" && *enableFlag
+           && std::find( names.begin(), names.end(), *overrideName ) == names.end() )
+        {
+        names.push_back( *overrideName );
+        }
+      ++overrideName;
+      ++enableFlag;
+      }
+    }
+  if ( names == registeredImageIONames )
+    {
+    return;
+    }
 
-  for (auto & allobject : ObjectFactoryBase::CreateAllInstance("itkImageIOBase"))
+  registeredImageIOs.clear();
+  for ( auto & name : names )
     {
-    auto * io = dynamic_cast< ImageIOBase * >( allobject.GetPointer() );
+    RegisteredImageIO registered;
+    registered.m_Name = name;
+    ImageIOBase::Pointer io = CreateRegisteredImageIO( name );
     if ( io )
       {
-      possibleImageIO.emplace_back(io);
+      for ( auto & extension : io->GetSupportedReadExtensions() )
+        {
+        registered.m_ReadExtensions.push_back( ToLower( extension ) );
+        }
+      for ( auto & extension : io->GetSupportedWriteExtensions() )
+        {
+        registered.m_WriteExtensions.push_back( ToLower( extension ) );
+        }
+      }
+    registeredImageIOs.push_back( registered );
+    }
+  registeredImageIONames = names;
+}
+
+bool
+HasExtension(const std::string & lowerCasePath, const ImageIOBase::ArrayOfExtensionsType & extensions)
+{
+  for ( auto & extension : extensions )
+    {
+    if ( !extension.empty() && lowerCasePath.size() >= extension.size()
+         && lowerCasePath.compare( lowerCasePath.size() - extension.size(), extension.size(), extension ) == 0 )
+      {
+      return true;
+      }
+    }
+  return false;
+}
+}
+
+ImageIOBase::Pointer
+ImageIOFactory::CreateImageIO(const char *path, FileModeType mode)
+{
+  std::lock_guard< std::mutex > mutexHolder( createImageIOLock );
+
+  UpdateRegisteredImageIOs();
+
+  // The ImageIO's that declare the extension of the file are asked first,
+  // so that the file is usually opened by a single CanReadFile() call.  The
+  // others are asked next, in the order of the factories, as some ImageIO's
+  // read files whatever their extension.  The ImageIO's are instantiated
+  // only when they are asked.
+  const std::string lowerCasePath = ToLower( path ? path : "" );
+  std::vector< const RegisteredImageIO * > plausibleImageIOs;
+  std::vector< const RegisteredImageIO * > otherImageIOs;
+  for ( auto & registered : registeredImageIOs )
+    {
+    const ImageIOBase::ArrayOfExtensionsType & extensions =
+      mode == ReadMode ? registered.m_ReadExtensions : registered.m_WriteExtensions;
+    if ( HasExtension( lowerCasePath, extensions ) )
+      {
+      plausibleImageIOs.push_back( &registered );
       }
     else
       {
-      std::cerr << "Error ImageIO factory did not return an ImageIOBase: "
-                << allobject->GetNameOfClass()
-                << std::endl;
+      otherImageIOs.push_back( &registered );
       }
     }
-  for (auto & k : possibleImageIO)
+  plausibleImageIOs.insert( plausibleImageIOs.end(), otherImageIOs.begin(), otherImageIOs.end() );
+
+  for ( auto & registered : plausibleImageIOs )
     {
+    ImageIOBase::Pointer io = CreateRegisteredImageIO( registered->m_Name );
+    if ( !io )
+      {
+      continue;
+      }
     if ( mode == ReadMode )
       {
-      if ( k->CanReadFile(path) )
+      if ( io->CanReadFile(path) )
         {
-        return k;
+        return io;
         }
       }
     else if ( mode == WriteMode )
       {
-      if ( k->CanWriteFile(path) )
+      if ( io->CanWriteFile(path) )
         {
-        return k;
+        return io;
         }
       }
     }
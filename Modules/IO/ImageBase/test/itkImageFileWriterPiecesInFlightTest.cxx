@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Writes a streamed pipeline with several pieces in flight, and checks that
+// the file holds the same image as the pipeline run whole.
+namespace
+{
+
+using ImageType = itk::Image< unsigned short, 3 >;
+using ShiftScaleType = itk::ShiftScaleImageFilter< ImageType, ImageType >;
+using WriterType = itk::ImageFileWriter< ImageType >;
+using ReaderType = itk::ImageFileReader< ImageType >;
+
+bool
+SameImage( const ImageType * expected, const std::string & fileName )
+{
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->Update();
+  const ImageType * actual = reader->GetOutput();
+  if ( actual->GetLargestPossibleRegion() != expected->GetLargestPossibleRegion() )
+    {
+    std::cerr << fileName << " has region " << actual->GetLargestPossibleRegion() << std::endl;
+    return false;
+    }
+  itk::ImageRegionConstIteratorWithIndex< ImageType > expectedIt( expected, expected->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageType >          actualIt( actual, expected->GetLargestPossibleRegion() );
+  for ( ; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt )
+    {
+    if ( expectedIt.Get() != actualIt.Get() )
+      {
+      std::cerr << "Pixel " << expectedIt.GetIndex() << " of " << fileName << " is " << actualIt.Get()
+                << " instead of " << expectedIt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+} // end namespace
+
+int itkImageFileWriterPiecesInFlightTest( int argc, char *argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = argv[1];
+
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 20;
+  size[1] = 18;
+  size[2] = 24;
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< unsigned short >( index[0] + 20 * index[1] + 360 * index[2] ) );
+    }
+
+  ShiftScaleType::Pointer shiftScale = ShiftScaleType::New();
+  shiftScale->SetInput( image );
+  shiftScale->SetShift( 3.0 );
+  shiftScale->Update();
+  ImageType::Pointer expected = shiftScale->GetOutput();
+  expected->DisconnectPipeline();
+
+  WriterType::Pointer writer = WriterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS( writer, ImageFileWriter, ProcessObject );
+  ITK_TEST_EXPECT_EQUAL( writer->GetNumberOfPiecesInFlight(), 1u );
+  writer->SetNumberOfPiecesInFlight( 0 );
+  ITK_TEST_EXPECT_EQUAL( writer->GetNumberOfPiecesInFlight(), 1u );
+
+  for ( unsigned int numberOfPiecesInFlight : { 1u, 2u, 3u, 8u } )
+    {
+    // The pieces generated by the pipeline are written in the background
+    const std::string fileName = directory + "/itkImageFileWriterPiecesInFlightTest_"
+      + std::to_string( numberOfPiecesInFlight ) + ".mha";
+    shiftScale->Modified();
+    writer->SetInput( shiftScale->GetOutput() );
+    writer->SetFileName( fileName );
+    writer->SetNumberOfStreamDivisions( 6 );
+    writer->SetNumberOfPiecesInFlight( numberOfPiecesInFlight );
+    ITK_TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+    ITK_TEST_EXPECT_TRUE( SameImage( expected, fileName ) );
+
+    // An image without a source is written piece by piece
+    const std::string imageFileName = directory + "/itkImageFileWriterPiecesInFlightTest_image_"
+      + std::to_string( numberOfPiecesInFlight ) + ".mha";
+    writer->SetInput( expected );
+    writer->SetFileName( imageFileName );
+    ITK_TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+    ITK_TEST_EXPECT_TRUE( SameImage( expected, imageFileName ) );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+// CreateImageIO() asks first the ImageIO's that declare the extension of
+// the file.  Checks that it returns the same ImageIO as asking all of them,
+// in the order of the factories.
+namespace
+{
+
+std::string
+ExpectedImageIO( const std::string & path, itk::ImageIOFactory::FileModeType mode )
+{
+  for ( auto & object : itk::ObjectFactoryBase::CreateAllInstance( "itkImageIOBase" ) )
+    {
+    auto * io = dynamic_cast< itk::ImageIOBase * >( object.GetPointer() );
+    if ( io && ( mode == itk::ImageIOFactory::ReadMode ? io->CanReadFile( path.c_str() ) : io->CanWriteFile( path.c_str() ) ) )
+      {
+      return io->GetNameOfClass();
+      }
+    }
+  return "none";
+}
+
+bool
+CheckImageIO( const std::string & path, itk::ImageIOFactory::FileModeType mode )
+{
+  itk::ImageIOBase::Pointer io = itk::ImageIOFactory::CreateImageIO( path.c_str(), mode );
+  const std::string name = io ? io->GetNameOfClass() : "none";
+  const std::string expected = ExpectedImageIO( path, mode );
+  std::cout << path << ( mode == itk::ImageIOFactory::ReadMode ? " read by " : " written by " ) << name << std::endl;
+  if ( name != expected )
+    {
+    std::cerr << "Expected " << expected << " instead of " << name << " for " << path << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end namespace
+
+int itkImageIOFactoryTest( int argc, char *argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = argv[1];
+  const std::string metaFile = directory + "/itkImageIOFactoryTest.mha";
+  const std::string upperCaseFile = directory + "/itkImageIOFactoryTest.MHA";
+  const std::string noExtensionFile = directory + "/itkImageIOFactoryTest_mha";
+
+  using ImageType = itk::Image< unsigned char, 2 >;
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill( 8 );
+  image->SetRegions( size );
+  image->Allocate( true );
+  using WriterType = itk::ImageFileWriter< ImageType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetFileName( metaFile );
+  ITK_TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+  itksys::SystemTools::CopyAFile( metaFile, upperCaseFile );
+  itksys::SystemTools::CopyAFile( metaFile, noExtensionFile );
+
+  itk::ImageIOBase::Pointer io = itk::ImageIOFactory::CreateImageIO( metaFile.c_str(), itk::ImageIOFactory::ReadMode );
+  ITK_TEST_EXPECT_TRUE( io.IsNotNull() );
+  ITK_TEST_EXPECT_EQUAL( std::string( io->GetNameOfClass() ), std::string( "MetaImageIO" ) );
+
+  // A new ImageIO is created at each call
+  ITK_TEST_EXPECT_TRUE( io != itk::ImageIOFactory::CreateImageIO( metaFile.c_str(), itk::ImageIOFactory::ReadMode ) );
+
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( metaFile, itk::ImageIOFactory::ReadMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( upperCaseFile, itk::ImageIOFactory::ReadMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( noExtensionFile, itk::ImageIOFactory::ReadMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( directory + "/itkImageIOFactoryTest_missing.mha", itk::ImageIOFactory::ReadMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( directory + "/itkImageIOFactoryTest.mhd", itk::ImageIOFactory::WriteMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( directory + "/itkImageIOFactoryTest.dcm", itk::ImageIOFactory::WriteMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( directory + "/itkImageIOFactoryTest.unknown", itk::ImageIOFactory::WriteMode ) );
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( "", itk::ImageIOFactory::ReadMode ) );
+
+  // The ImageIO's disabled in their factory are no longer asked
+  for ( auto & factory : itk::ObjectFactoryBase::GetRegisteredFactories() )
+    {
+    factory->SetEnableFlag( false, "itkImageIOBase", "itkMetaImageIO" );
+    }
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( metaFile, itk::ImageIOFactory::ReadMode ) );
+  for ( auto & factory : itk::ObjectFactoryBase::GetRegisteredFactories() )
+    {
+    factory->SetEnableFlag( true, "itkImageIOBase", "itkMetaImageIO" );
+    }
+  ITK_TEST_EXPECT_TRUE( CheckImageIO( metaFile, itk::ImageIOFactory::ReadMode ) );
+
+  // An override is created by name
+  itk::LightObject::Pointer object = itk::ObjectFactoryBase::CreateInstance( "itkImageIOBase", "itkMetaImageIO" );
+  ITK_TEST_EXPECT_TRUE( object.IsNotNull() );
+  ITK_TEST_EXPECT_EQUAL( std::string( object->GetNameOfClass() ), std::string( "MetaImageIO" ) );
+  ITK_TEST_EXPECT_TRUE( itk::ObjectFactoryBase::CreateInstance( "itkImageIOBase", "itkNoSuchImageIO" ).IsNull() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
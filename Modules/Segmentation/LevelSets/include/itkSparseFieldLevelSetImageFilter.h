@@ -312,6 +312,22 @@ public:
   void InterpolateSurfaceLocationOff()
   { this->SetInterpolateSurfaceLocation(false); }
 
+  /** Get/Set the value of the MemoryOrderedLayers flag.  When this flag is
+      on, the nodes of every sparse field layer are relinked in the order of
+      their position in the image buffer after each update, so that the
+      traversals of the layers in CalculateChange and ApplyUpdate visit the
+      output and status images sequentially instead of in the order in which
+      nodes happened to be pushed.  Only the nodes that moved into a layer
+      since the previous update are sorted, then merged into the others, so
+      a layer that did not change costs a single pass.  The
+      order in which active layer nodes are visited can affect how ties
+      between neighbors moving in opposite directions are resolved, so the
+      results may differ very slightly from those obtained with the flag
+      off.  Turned off by default. */
+  itkSetMacro(MemoryOrderedLayers, bool);
+  itkGetConstMacro(MemoryOrderedLayers, bool);
+  itkBooleanMacro(MemoryOrderedLayers);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputEqualityComparableCheck,
@@ -413,6 +429,11 @@ protected:
   /** */
   void ProcessOutsideList(LayerType *OutsideList, StatusType ChangeToStatus);
 
+  /** Relinks the nodes of all the sparse field layers in the order of their
+   *  index in the image buffer.  Called after the layers have been
+   *  (re)constructed when MemoryOrderedLayers is on. */
+  void SortLayersInMemoryOrder();
+
   itkGetConstMacro(ValueZero, ValueType);
   itkGetConstMacro(ValueOne, ValueType);
 
@@ -491,6 +512,9 @@ protected:
       (speed), advection, or curvature terms should turn this flag off. */
   bool m_InterpolateSurfaceLocation{true};
 
+  /** When on, layer nodes are kept sorted in image buffer order. */
+  bool m_MemoryOrderedLayers{false};
+
   const InputImageType *m_InputImage;
   OutputImageType      *m_OutputImage;
 
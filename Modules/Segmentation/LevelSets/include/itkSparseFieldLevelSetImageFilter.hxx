@@ -211,6 +211,38 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   // Finally, we update all of the layer values (excluding the active layer,
   // which has already been updated).
   this->PropagateAllLayerValues();
+
+  // Restore the memory order of the layers, which the promotions and
+  // demotions above have scrambled.
+  if ( m_MemoryOrderedLayers )
+    {
+    this->SortLayersInMemoryOrder();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::SortLayersInMemoryOrder()
+{
+  // For an image buffer, increasing memory order is the lexicographic order
+  // of the indices starting with the slowest varying (last) dimension.
+  auto memoryOrder = []( const LayerNodeType *a, const LayerNodeType *b )
+    {
+    for ( int d = ImageDimension - 1; d >= 0; --d )
+      {
+      if ( a->m_Value[d] != b->m_Value[d] )
+        {
+        return a->m_Value[d] < b->m_Value[d];
+        }
+      }
+    return false;
+    };
+
+  for ( auto & layer : m_Layers )
+    {
+    layer->Sort(memoryOrder);
+    }
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -616,6 +648,11 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   // Initialize layer values using the active layer as seeds.
   this->PropagateAllLayerValues();
 
+  if ( m_MemoryOrderedLayers )
+    {
+    this->SortLayersInMemoryOrder();
+    }
+
   // Initialize pixels inside and outside the sparse field layers to positive
   // and negative values, respectively.  This is not necessary for the
   // calculations, but is useful for presenting a more intuitive output to the
@@ -1187,7 +1224,8 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   unsigned int i;
   os << indent << "m_IsoSurfaceValue: " << m_IsoSurfaceValue << std::endl;
   itkPrintSelfObjectMacro( LayerNodeStore );
-  os << indent << "m_BoundsCheckingActive: " << m_BoundsCheckingActive;
+  os << indent << "m_BoundsCheckingActive: " << m_BoundsCheckingActive << std::endl;
+  os << indent << "m_MemoryOrderedLayers: " << m_MemoryOrderedLayers << std::endl;
   for ( i = 0; i < m_Layers.size(); i++ )
     {
     os << indent << "m_Layers[" << i << "]: size="
@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkShapeDetectionLevelSetImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Segments a square with the sparse field layers kept in memory order, and
+// checks that the layers are ordered after the evolution and that the
+// segmentation matches the one obtained with the layers in push order.
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image< float, Dimension >;
+
+class OrderCheckingFilter:
+  public itk::ShapeDetectionLevelSetImageFilter< ImageType, ImageType >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(OrderCheckingFilter);
+
+  using Self = OrderCheckingFilter;
+  using Superclass = itk::ShapeDetectionLevelSetImageFilter< ImageType, ImageType >;
+  using Pointer = itk::SmartPointer< Self >;
+
+  itkNewMacro(Self);
+
+  bool LayersAreInMemoryOrder() const
+  {
+    for ( auto & layer : this->m_Layers )
+      {
+      const ImageType::IndexType *previous = nullptr;
+      for ( auto it = layer->Begin(); it != layer->End(); ++it )
+        {
+        if ( previous && ( ( *previous )[1] > it->m_Value[1]
+                           || ( ( *previous )[1] == it->m_Value[1] && ( *previous )[0] >= it->m_Value[0] ) ) )
+          {
+          return false;
+          }
+        previous = &it->m_Value;
+        }
+      }
+    return true;
+  }
+
+protected:
+  OrderCheckingFilter() = default;
+};
+
+ImageType::Pointer
+Segment( const ImageType * initial, const ImageType * feature, bool memoryOrdered, unsigned int & numberOfInsidePixels )
+{
+  OrderCheckingFilter::Pointer filter = OrderCheckingFilter::New();
+  filter->SetInput( initial );
+  filter->SetFeatureImage( feature );
+  filter->SetPropagationScaling( 1.0 );
+  filter->SetCurvatureScaling( 0.1 );
+  filter->SetMaximumRMSError( 0.02 );
+  filter->SetNumberOfIterations( 100 );
+  filter->SetMemoryOrderedLayers( memoryOrdered );
+  filter->Update();
+  if ( filter->GetMemoryOrderedLayers() != memoryOrdered )
+    {
+    std::cerr << "MemoryOrderedLayers was not set" << std::endl;
+    return nullptr;
+    }
+  if ( memoryOrdered && !filter->LayersAreInMemoryOrder() )
+    {
+    std::cerr << "The layers are not in memory order" << std::endl;
+    return nullptr;
+    }
+
+  ImageType::Pointer output = filter->GetOutput();
+  numberOfInsidePixels = 0;
+  for ( itk::ImageRegionConstIterator< ImageType > it( output, output->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    numberOfInsidePixels += it.Get() <= 0.0f;
+    }
+  return output;
+}
+
+} // end namespace
+
+int itkSparseFieldLevelSetMemoryOrderedLayersTest( int, char *[] )
+{
+  ImageType::SizeType size;
+  size.Fill( 64 );
+
+  // The level set starts as the signed distance to a disk inside a square
+  // of high speed
+  ImageType::Pointer initial = ImageType::New();
+  initial->SetRegions( size );
+  initial->Allocate();
+  ImageType::Pointer feature = ImageType::New();
+  feature->SetRegions( size );
+  feature->Allocate();
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( initial, initial->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    const double dx = index[0] - 30.0;
+    const double dy = index[1] - 34.0;
+    it.Set( static_cast< float >( std::sqrt( dx * dx + dy * dy ) - 5.0 ) );
+    const bool inSquare = index[0] >= 12 && index[0] < 50 && index[1] >= 14 && index[1] < 52;
+    feature->SetPixel( index, inSquare ? 1.0f : 0.01f );
+    }
+
+  unsigned int pushOrderInside = 0;
+  unsigned int memoryOrderInside = 0;
+  ImageType::Pointer pushOrder = Segment( initial, feature, false, pushOrderInside );
+  ImageType::Pointer memoryOrder = Segment( initial, feature, true, memoryOrderInside );
+  ITK_TEST_EXPECT_TRUE( pushOrder.IsNotNull() && memoryOrder.IsNotNull() );
+  std::cout << pushOrderInside << " pixels inside in push order, " << memoryOrderInside
+            << " in memory order" << std::endl;
+
+  // The front grew from the disk into the square
+  ITK_TEST_EXPECT_TRUE( pushOrderInside > 1000 );
+
+  unsigned int numberOfDifferences = 0;
+  itk::ImageRegionConstIterator< ImageType > pushIt( pushOrder, pushOrder->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< ImageType > memoryIt( memoryOrder, memoryOrder->GetBufferedRegion() );
+  for ( ; !pushIt.IsAtEnd(); ++pushIt, ++memoryIt )
+    {
+    numberOfDifferences += ( pushIt.Get() <= 0.0f ) != ( memoryIt.Get() <= 0.0f );
+    }
+  std::cout << numberOfDifferences << " pixels segmented differently" << std::endl;
+  ITK_TEST_EXPECT_TRUE( numberOfDifferences <= pushOrderInside / 100 );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -265,6 +265,17 @@ protected:
   friend class LevelSetEvolutionComputeIterationThreader< LevelSetType, SplitLevelSetPartitionerType, Self >;
   using SplitLevelSetComputeIterationThreaderType = LevelSetEvolutionComputeIterationThreader< LevelSetType, SplitLevelSetPartitionerType, Self >;
   typename SplitLevelSetComputeIterationThreaderType::Pointer m_SplitLevelSetComputeIterationThreader;
+
+  /** When there are several level sets, the zero layer nodes of all of them
+   *  are concatenated and split among the threads in a single execution. */
+  using NodeToProcessType = std::pair< LevelSetIdentifierType, typename LevelSetType::LayerConstIterator >;
+  using NodesToProcessType = std::vector< NodeToProcessType >;
+  NodesToProcessType m_NodesToProcessWhenThreading;
+
+  using SplitLevelSetsPartitionerType = ThreadedIndexedContainerPartitioner;
+  friend class LevelSetEvolutionComputeIterationThreader< LevelSetType, SplitLevelSetsPartitionerType, Self >;
+  using SplitLevelSetsComputeIterationThreaderType = LevelSetEvolutionComputeIterationThreader< LevelSetType, SplitLevelSetsPartitionerType, Self >;
+  typename SplitLevelSetsComputeIterationThreaderType::Pointer m_SplitLevelSetsComputeIterationThreader;
 };
 
 
@@ -215,6 +215,7 @@ LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDi
 ::LevelSetEvolution()
 {
   this->m_SplitLevelSetComputeIterationThreader = SplitLevelSetComputeIterationThreaderType::New();
+  this->m_SplitLevelSetsComputeIterationThreader = SplitLevelSetsComputeIterationThreaderType::New();
 }
 
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
@@ -235,6 +236,7 @@ LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDi
 ::SetNumberOfWorkUnits( const ThreadIdType numberOfThreads)
 {
   this->m_SplitLevelSetComputeIterationThreader->SetNumberOfWorkUnits( numberOfThreads );
+  this->m_SplitLevelSetsComputeIterationThreader->SetNumberOfWorkUnits( numberOfThreads );
 }
 
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
@@ -279,12 +281,40 @@ void
 LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDimension > >
 ::ComputeIteration()
 {
+  if( this->m_LevelSetContainer->Size() > 1 )
+    {
+    // Schedule the zero layers of all the level sets at once, so that small
+    // level sets do not each pay for starting and joining the threads.
+    this->m_NodesToProcessWhenThreading.clear();
+
+    typename LevelSetContainerType::ConstIterator it = this->m_LevelSetContainer->Begin();
+    while( it != this->m_LevelSetContainer->End() )
+      {
+      const LevelSetIdentifierType levelSetId = it->GetIdentifier();
+      const LevelSetLayerType & zeroLayer = it->GetLevelSet()->GetLayer( LevelSetType::ZeroLayer() );
+      for( auto nodeIt = zeroLayer.begin(); nodeIt != zeroLayer.end(); ++nodeIt )
+        {
+        this->m_NodesToProcessWhenThreading.push_back( NodeToProcessType( levelSetId, nodeIt ) );
+        }
+      ++it;
+      }
+
+    if( !this->m_NodesToProcessWhenThreading.empty() )
+      {
+      typename SplitLevelSetsPartitionerType::DomainType completeDomain;
+      completeDomain[0] = 0;
+      completeDomain[1] = this->m_NodesToProcessWhenThreading.size() - 1;
+      this->m_SplitLevelSetsComputeIterationThreader->Execute( this, completeDomain );
+      }
+    return;
+    }
+
   this->m_LevelSetContainerIteratorToProcessWhenThreading = this->m_LevelSetContainer->Begin();
 
   while( this->m_LevelSetContainerIteratorToProcessWhenThreading != this->m_LevelSetContainer->End() )
     {
     typename LevelSetType::ConstPointer levelSet = this->m_LevelSetContainerIteratorToProcessWhenThreading->GetLevelSet();
-    const LevelSetLayerType zeroLayer = levelSet->GetLayer( 0 );
+    const LevelSetLayerType & zeroLayer = levelSet->GetLayer( 0 );
     auto layerBegin = zeroLayer.begin();
     auto layerEnd = zeroLayer.end();
     typename SplitLevelSetPartitionerType::DomainType completeDomain( layerBegin, layerEnd );
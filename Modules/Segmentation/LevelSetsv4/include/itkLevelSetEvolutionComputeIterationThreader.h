@@ -20,6 +20,7 @@
 
 #include "itkDomainThreader.h"
 #include "itkThreadedImageRegionPartitioner.h"
+#include "itkThreadedIndexedContainerPartitioner.h"
 #include "itkThreadedIteratorRangePartitioner.h"
 
 #include "itkLevelSetDenseImage.h"
@@ -192,6 +193,64 @@ protected:
   NodePairsPerThreadType m_NodePairsPerThread;
 };
 
+// For several Whitaker sparse level sets split by putting part of the
+// concatenated zero layers of all the level sets in each thread, so that the
+// threads are started once per iteration instead of once per level set.
+template< typename TOutput, unsigned int VDimension, typename TLevelSetEvolution >
+class ITK_TEMPLATE_EXPORT LevelSetEvolutionComputeIterationThreader<
+      WhitakerSparseLevelSetImage< TOutput, VDimension >,
+      ThreadedIndexedContainerPartitioner,
+      TLevelSetEvolution
+      >
+  : public DomainThreader< ThreadedIndexedContainerPartitioner, TLevelSetEvolution >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(LevelSetEvolutionComputeIterationThreader);
+
+  /** Standard class type aliases. */
+  using Self = LevelSetEvolutionComputeIterationThreader;
+  using Superclass = DomainThreader< ThreadedIndexedContainerPartitioner, TLevelSetEvolution >;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Run time type information. */
+  itkTypeMacro( LevelSetEvolutionComputeIterationThreader, DomainThreader );
+
+  /** Standard New macro. */
+  itkNewMacro( Self );
+
+  /** Superclass types. */
+  using DomainType = typename Superclass::DomainType;
+  using AssociateType = typename Superclass::AssociateType;
+
+  /** Types of the associate class. */
+  using LevelSetEvolutionType = TLevelSetEvolution;
+  using LevelSetType = typename LevelSetEvolutionType::LevelSetType;
+  using IndexType = typename LevelSetType::IndexType;
+  using RegionType = typename LevelSetType::RegionType;
+  using OffsetType = typename LevelSetType::OffsetType;
+  using LevelSetContainerType = typename LevelSetEvolutionType::LevelSetContainerType;
+  using LevelSetIdentifierType = typename LevelSetEvolutionType::LevelSetIdentifierType;
+  using LevelSetInputType = typename LevelSetEvolutionType::LevelSetInputType;
+  using LevelSetOutputType = typename LevelSetEvolutionType::LevelSetOutputType;
+  using LevelSetDataType = typename LevelSetEvolutionType::LevelSetDataType;
+  using TermContainerType = typename LevelSetEvolutionType::TermContainerType;
+  using NodePairType = typename LevelSetEvolutionType::NodePairType;
+
+protected:
+  LevelSetEvolutionComputeIterationThreader() = default;
+
+  void BeforeThreadedExecution() override;
+
+  void ThreadedExecution( const DomainType & indexSubRange, const ThreadIdType threadId ) override;
+
+  void AfterThreadedExecution() override;
+
+  using LevelSetNodePairType = std::pair< LevelSetIdentifierType, NodePairType >;
+  using NodePairsPerThreadType = std::vector< std::vector< LevelSetNodePairType > >;
+  NodePairsPerThreadType m_NodePairsPerThread;
+};
+
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
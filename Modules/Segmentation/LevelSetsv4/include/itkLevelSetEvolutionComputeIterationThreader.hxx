@@ -213,13 +213,105 @@ LevelSetEvolutionComputeIterationThreader<
   LevelSetIdentifierType levelSetId = it->GetIdentifier();
   typename LevelSetEvolutionType::LevelSetLayerType * levelSetLayerUpdateBuffer = this->m_Associate->m_UpdateBuffer[ levelSetId ];
 
+  // The threads processed consecutive ranges of the zero layer, so the pairs
+  // arrive in increasing order and can be appended at the end of the map in
+  // amortized constant time.
   const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnitsUsed();
   for( ThreadIdType ii = 0; ii < numberOfThreads; ++ii )
     {
     typename std::vector< NodePairType >::const_iterator pairIt = this->m_NodePairsPerThread[ii].begin();
     while( pairIt != this->m_NodePairsPerThread[ii].end() )
       {
-      levelSetLayerUpdateBuffer->insert( *pairIt );
+      levelSetLayerUpdateBuffer->insert( levelSetLayerUpdateBuffer->end(), *pairIt );
+      ++pairIt;
+      }
+    }
+}
+
+template< typename TOutput, unsigned int VDimension, typename TLevelSetEvolution >
+void
+LevelSetEvolutionComputeIterationThreader<
+      WhitakerSparseLevelSetImage< TOutput, VDimension >,
+      ThreadedIndexedContainerPartitioner,
+      TLevelSetEvolution >
+::BeforeThreadedExecution()
+{
+  const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnitsUsed();
+  this->m_NodePairsPerThread.resize( numberOfThreads );
+
+  for( ThreadIdType ii = 0; ii < numberOfThreads; ++ii )
+    {
+    this->m_NodePairsPerThread[ii].clear();
+    }
+}
+
+template< typename TOutput, unsigned int VDimension, typename TLevelSetEvolution >
+void
+LevelSetEvolutionComputeIterationThreader<
+      WhitakerSparseLevelSetImage< TOutput, VDimension >,
+      ThreadedIndexedContainerPartitioner,
+      TLevelSetEvolution >
+::ThreadedExecution( const DomainType & indexSubRange,
+                     const ThreadIdType threadId )
+{
+  const typename LevelSetEvolutionType::NodesToProcessType & nodes = this->m_Associate->m_NodesToProcessWhenThreading;
+  std::vector< LevelSetNodePairType > & nodePairs = this->m_NodePairsPerThread[threadId];
+  nodePairs.reserve( indexSubRange[1] - indexSubRange[0] + 1 );
+
+  // The nodes are grouped by level set, so the term container and the domain
+  // offset only have to be looked up when crossing into the next level set.
+  LevelSetIdentifierType levelSetId = nodes[ indexSubRange[0] ].first;
+  typename TermContainerType::Pointer termContainer = this->m_Associate->m_EquationContainer->GetEquation( levelSetId );
+  OffsetType offset = this->m_Associate->m_LevelSetContainer->GetLevelSet( levelSetId )->GetDomainOffset();
+
+  for( IndexValueType ii = indexSubRange[0]; ii <= indexSubRange[1]; ++ii )
+    {
+    if( nodes[ii].first != levelSetId )
+      {
+      levelSetId = nodes[ii].first;
+      termContainer = this->m_Associate->m_EquationContainer->GetEquation( levelSetId );
+      offset = this->m_Associate->m_LevelSetContainer->GetLevelSet( levelSetId )->GetDomainOffset();
+      }
+
+    const LevelSetInputType levelsetIndex = nodes[ii].second->first;
+    LevelSetInputType inputIndex = levelsetIndex + offset;
+
+    LevelSetDataType characteristics;
+
+    termContainer->ComputeRequiredData( inputIndex, characteristics );
+
+    const auto temp_update = static_cast< LevelSetOutputType >( termContainer->Evaluate( inputIndex, characteristics ) );
+
+    nodePairs.push_back( LevelSetNodePairType( levelSetId, NodePairType( levelsetIndex, temp_update ) ) );
+    }
+}
+
+template< typename TOutput, unsigned int VDimension, typename TLevelSetEvolution >
+void
+LevelSetEvolutionComputeIterationThreader<
+      WhitakerSparseLevelSetImage< TOutput, VDimension >,
+      ThreadedIndexedContainerPartitioner,
+      TLevelSetEvolution >
+::AfterThreadedExecution()
+{
+  // Consecutive threads processed consecutive ranges of the concatenated zero
+  // layers, so the updates of each level set arrive in increasing order and
+  // can be appended at the end of its update buffer.
+  typename LevelSetEvolutionType::LevelSetLayerType * levelSetLayerUpdateBuffer = nullptr;
+  LevelSetIdentifierType levelSetId{};
+
+  const ThreadIdType numberOfThreads = this->GetNumberOfWorkUnitsUsed();
+  for( ThreadIdType ii = 0; ii < numberOfThreads; ++ii )
+    {
+    auto pairIt = this->m_NodePairsPerThread[ii].cbegin();
+    while( pairIt != this->m_NodePairsPerThread[ii].cend() )
+      {
+      if( levelSetLayerUpdateBuffer == nullptr || pairIt->first != levelSetId )
+        {
+        levelSetId = pairIt->first;
+        levelSetLayerUpdateBuffer = this->m_Associate->m_UpdateBuffer[ levelSetId ];
+        }
+      levelSetLayerUpdateBuffer->insert( levelSetLayerUpdateBuffer->end(), pairIt->second );
       ++pairIt;
       }
     }
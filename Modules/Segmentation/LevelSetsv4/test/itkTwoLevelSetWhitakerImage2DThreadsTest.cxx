@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkSinRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetEvolution.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Evolves two Whitaker sparse level sets together, once with a single work
+ * unit and once with several work units, and checks that scheduling the zero
+ * layers of both level sets across threads gives identical results, which
+ * are those of the evolution of one level set at a time.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using InputPixelType = unsigned short;
+using InputImageType = itk::Image< InputPixelType, Dimension >;
+using InputIteratorType = itk::ImageRegionIteratorWithIndex< InputImageType >;
+
+using PixelType = float;
+using SparseLevelSetType = itk::WhitakerSparseLevelSetImage< PixelType, Dimension >;
+using OutputImageType = itk::Image< signed char, Dimension >;
+
+void
+FillSquare( InputImageType * image, itk::IndexValueType start, itk::SizeValueType length, InputPixelType value )
+{
+  InputImageType::IndexType index;
+  index.Fill( start );
+  InputImageType::SizeType size;
+  size.Fill( length );
+  InputImageType::RegionType region( index, size );
+
+  InputIteratorType it( image, region );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( value );
+    }
+}
+
+OutputImageType::Pointer
+EvolveTwoLevelSets( InputImageType * input, itk::ThreadIdType numberOfWorkUnits )
+{
+  using BinaryToSparseAdaptorType =
+      itk::BinaryImageToLevelSetImageAdaptor< InputImageType, SparseLevelSetType >;
+
+  using IdentifierType = itk::IdentifierType;
+  using LevelSetContainerType = itk::LevelSetContainer< IdentifierType, SparseLevelSetType >;
+
+  using IdListType = std::list< IdentifierType >;
+  using IdListImageType = itk::Image< IdListType, Dimension >;
+  using CacheImageType = itk::Image< short, Dimension >;
+  using DomainMapImageFilterType =
+      itk::LevelSetDomainMapImageFilter< IdListImageType, CacheImageType >;
+
+  using ChanAndVeseInternalTermType =
+      itk::LevelSetEquationChanAndVeseInternalTerm< InputImageType, LevelSetContainerType >;
+  using ChanAndVeseExternalTermType =
+      itk::LevelSetEquationChanAndVeseExternalTerm< InputImageType, LevelSetContainerType >;
+  using TermContainerType =
+      itk::LevelSetEquationTermContainer< InputImageType, LevelSetContainerType >;
+  using EquationContainerType = itk::LevelSetEquationContainer< TermContainerType >;
+  using LevelSetEvolutionType = itk::LevelSetEvolution< EquationContainerType, SparseLevelSetType >;
+
+  using LevelSetOutputRealType = SparseLevelSetType::OutputRealType;
+  using HeavisideFunctionBaseType =
+      itk::SinRegularizedHeavisideStepFunction< LevelSetOutputRealType, LevelSetOutputRealType >;
+  using StoppingCriterionType =
+      itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion< LevelSetContainerType >;
+
+  HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+  heaviside->SetEpsilon( 1.0 );
+
+  IdListType listIds;
+  listIds.push_back( 1 );
+  listIds.push_back( 2 );
+
+  IdListImageType::Pointer idImage = IdListImageType::New();
+  idImage->SetRegions( input->GetLargestPossibleRegion() );
+  idImage->Allocate();
+  idImage->FillBuffer( listIds );
+
+  DomainMapImageFilterType::Pointer domainMapFilter = DomainMapImageFilterType::New();
+  domainMapFilter->SetInput( idImage );
+  domainMapFilter->Update();
+
+  LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside( heaviside );
+  lscontainer->SetDomainMapFilter( domainMapFilter );
+
+  EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer( lscontainer );
+
+  std::vector< SparseLevelSetType::Pointer > levelSets;
+  for( IdentifierType id = 0; id < 2; ++id )
+    {
+    // Initialize each level set with a different square.
+    InputImageType::Pointer binary = InputImageType::New();
+    binary->SetRegions( input->GetLargestPossibleRegion() );
+    binary->CopyInformation( input );
+    binary->Allocate();
+    binary->FillBuffer( itk::NumericTraits< InputPixelType >::ZeroValue() );
+    FillSquare( binary, 10 + 40 * id, 20, itk::NumericTraits< InputPixelType >::OneValue() );
+
+    BinaryToSparseAdaptorType::Pointer adaptor = BinaryToSparseAdaptorType::New();
+    adaptor->SetInputImage( binary );
+    adaptor->Initialize();
+    levelSets.push_back( adaptor->GetModifiableLevelSet() );
+
+    lscontainer->AddLevelSet( id, levelSets.back(), false );
+
+    ChanAndVeseInternalTermType::Pointer cvInternalTerm = ChanAndVeseInternalTermType::New();
+    cvInternalTerm->SetInput( input );
+    cvInternalTerm->SetCoefficient( 1.0 );
+
+    ChanAndVeseExternalTermType::Pointer cvExternalTerm = ChanAndVeseExternalTermType::New();
+    cvExternalTerm->SetInput( input );
+    cvExternalTerm->SetCoefficient( 1.0 );
+
+    TermContainerType::Pointer termContainer = TermContainerType::New();
+    termContainer->SetInput( input );
+    termContainer->SetCurrentLevelSetId( id );
+    termContainer->SetLevelSetContainer( lscontainer );
+    termContainer->AddTerm( 0, cvInternalTerm );
+    termContainer->AddTerm( 1, cvExternalTerm );
+
+    equationContainer->AddEquation( id, termContainer );
+    }
+
+  StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations( 10 );
+
+  LevelSetEvolutionType::Pointer evolution = LevelSetEvolutionType::New();
+  evolution->SetEquationContainer( equationContainer );
+  evolution->SetStoppingCriterion( criterion );
+  evolution->SetLevelSetContainer( lscontainer );
+  evolution->SetNumberOfWorkUnits( numberOfWorkUnits );
+  evolution->Update();
+
+  // Encode the layer of both level sets in a single image.
+  OutputImageType::Pointer output = OutputImageType::New();
+  output->SetRegions( input->GetLargestPossibleRegion() );
+  output->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< OutputImageType > oIt( output, output->GetLargestPossibleRegion() );
+  for( oIt.GoToBegin(); !oIt.IsAtEnd(); ++oIt )
+    {
+    const OutputImageType::IndexType idx = oIt.GetIndex();
+    oIt.Set( static_cast< signed char >( 10 * levelSets[0]->GetLabelMap()->GetPixel( idx )
+                                         + levelSets[1]->GetLabelMap()->GetPixel( idx ) ) );
+    }
+  return output;
+}
+
+// The number of pixels in the zero layer of each level set, and a checksum
+// of the positions of the layers of both
+void
+Signature( const OutputImageType * output, unsigned int & zeroLayer0, unsigned int & zeroLayer1, unsigned int & checksum )
+{
+  zeroLayer0 = 0;
+  zeroLayer1 = 0;
+  checksum = 0;
+  unsigned int position = 0;
+  itk::ImageRegionConstIterator< OutputImageType > it( output, output->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it, ++position )
+    {
+    const int value = it.Get();
+    const int label0 = ( value + 35 ) / 10 - 3;
+    const int label1 = value - 10 * label0;
+    zeroLayer0 += ( label0 == 0 );
+    zeroLayer1 += ( label1 == 0 );
+    checksum = 31 * checksum + static_cast< unsigned int >( value + 35 ) * ( position + 1 );
+    }
+}
+} // end namespace
+
+int itkTwoLevelSetWhitakerImage2DThreadsTest( int, char* [] )
+{
+  InputImageType::SizeType size;
+  size.Fill( 100 );
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+  input->FillBuffer( itk::NumericTraits< InputPixelType >::ZeroValue() );
+  FillSquare( input, 20, 50, 100 );
+
+  OutputImageType::Pointer serialOutput;
+  OutputImageType::Pointer threadedOutput;
+  ITK_TRY_EXPECT_NO_EXCEPTION( serialOutput = EvolveTwoLevelSets( input, 1 ) );
+  ITK_TRY_EXPECT_NO_EXCEPTION( threadedOutput = EvolveTwoLevelSets( input, 4 ) );
+
+  itk::ImageRegionConstIterator< OutputImageType > sIt( serialOutput, serialOutput->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< OutputImageType > tIt( threadedOutput, threadedOutput->GetLargestPossibleRegion() );
+  unsigned int numberOfDifferences = 0;
+  for( sIt.GoToBegin(), tIt.GoToBegin(); !sIt.IsAtEnd(); ++sIt, ++tIt )
+    {
+    if( sIt.Get() != tIt.Get() )
+      {
+      ++numberOfDifferences;
+      }
+    }
+
+  if( numberOfDifferences != 0 )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << numberOfDifferences << " pixels differ between the serial and the threaded evolution." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The same layers as evolving the level sets one at a time, as done
+  // before the zero layers of all of them were scheduled together
+  unsigned int zeroLayer0;
+  unsigned int zeroLayer1;
+  unsigned int checksum;
+  Signature( serialOutput, zeroLayer0, zeroLayer1, checksum );
+  std::cout << "Zero layers of " << zeroLayer0 << " and " << zeroLayer1 << " pixels, checksum " << checksum << std::endl;
+  ITK_TEST_EXPECT_EQUAL( zeroLayer0, 77u );
+  ITK_TEST_EXPECT_EQUAL( zeroLayer1, 92u );
+  ITK_TEST_EXPECT_EQUAL( checksum, 1688460412u );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -64,6 +64,10 @@ namespace itk
  * Chapter 9.2 of Pierre Soille's book "Morphological Image Analysis:
  * Principles and Applications", Second Edition, Springer, 2003.
  *
+ * The flooding works on the offsets of the pixels in the buffers. With the
+ * integer input pixel types of at most 16 bits, the hierarchical queue is an
+ * array of buckets indexed by the pixel value, instead of a map.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
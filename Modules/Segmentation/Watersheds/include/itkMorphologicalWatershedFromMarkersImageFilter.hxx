@@ -19,8 +19,12 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_hxx
 
 #include <algorithm>
+#include <cmath>
+#include <map>
 #include <queue>
 #include <list>
+#include <type_traits>
+#include <vector>
 #include "itkMorphologicalWatershedFromMarkersImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionIterator.h"
@@ -33,6 +37,109 @@
 namespace itk
 {
 
+namespace detail
+{
+/** \class WatershedHierarchicalQueue
+ * \brief The hierarchical queue of the morphological watershed.
+ *
+ * The pixels are stored by level, in the order of their insertion. The
+ * levels of the integer types of at most 16 bits are stored in an array
+ * indexed by the pixel value, the other ones in a map. The front level is
+ * the one of lowest value; it can grow while it is processed, but the
+ * levels are never added below it.
+ *
+ * \ingroup ITKWatersheds
+ */
+template< typename TValue,
+          bool VUseBuckets = std::is_integral< TValue >::value && !std::is_same< TValue, bool >::value
+                             && sizeof( TValue ) <= 2 >
+class WatershedHierarchicalQueue
+{
+public:
+  using LevelType = std::vector< OffsetValueType >;
+
+  void Push( const TValue & value, OffsetValueType offset )
+  {
+    m_Levels[value].push_back( offset );
+  }
+
+  bool Empty() const
+  {
+    return m_Levels.empty();
+  }
+
+  TValue GetFrontValue() const
+  {
+    return m_Levels.begin()->first;
+  }
+
+  LevelType & GetFrontLevel()
+  {
+    return m_Levels.begin()->second;
+  }
+
+  void PopFrontLevel()
+  {
+    m_Levels.erase( m_Levels.begin() );
+  }
+
+private:
+  std::map< TValue, LevelType > m_Levels;
+};
+
+template< typename TValue >
+class WatershedHierarchicalQueue< TValue, true >
+{
+public:
+  using LevelType = std::vector< OffsetValueType >;
+
+  WatershedHierarchicalQueue():
+    m_Levels( size_t( 1 ) << ( 8 * sizeof( TValue ) ) )
+  {}
+
+  void Push( const TValue & value, OffsetValueType offset )
+  {
+    const size_t level = ToLevel( value );
+    m_Levels[level].push_back( offset );
+    m_Front = std::min( m_Front, level );
+  }
+
+  bool Empty()
+  {
+    while ( m_Front < m_Levels.size() && m_Levels[m_Front].empty() )
+      {
+      ++m_Front;
+      }
+    return m_Front == m_Levels.size();
+  }
+
+  TValue GetFrontValue() const
+  {
+    return static_cast< TValue >( static_cast< long >( m_Front ) + NumericTraits< TValue >::NonpositiveMin() );
+  }
+
+  LevelType & GetFrontLevel()
+  {
+    return m_Levels[m_Front];
+  }
+
+  void PopFrontLevel()
+  {
+    // release the memory of the processed level
+    LevelType().swap( m_Levels[m_Front] );
+  }
+
+private:
+  static size_t ToLevel( const TValue & value )
+  {
+    return static_cast< size_t >( static_cast< long >( value ) - NumericTraits< TValue >::NonpositiveMin() );
+  }
+
+  std::vector< LevelType > m_Levels;
+  size_t                   m_Front{ 0 };
+};
+} // end namespace detail
+
 template< typename TInputImage, typename TLabelImage >
 MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
 ::MorphologicalWatershedFromMarkersImageFilter()
@@ -90,7 +197,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
   // The 2 algorithms are very similar and so are integrated in the same filter.
 
   //---------------------------------------------------------------------------
-  // declare the vars common to the 2 algorithms: constants, iterators,
+  // declare the vars common to the 2 algorithms: constants, neighbors,
   // hierarchical queue, progress reporter, and status image
   // also allocate output images and verify preconditions
   //---------------------------------------------------------------------------
@@ -119,40 +226,84 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     itkExceptionMacro(<< "Marker and input must have the same size.");
     }
 
+  // The three images are entirely buffered, with the same size: the pixels
+  // are designated by their offset in the buffers. The neighbors are visited
+  // in the same order as with a shaped neighborhood iterator, so the labels
+  // and the watershed lines do not depend on the representation.
+  const LabelImagePixelType * marker = markerImage->GetBufferPointer();
+  const InputImagePixelType * input = inputImage->GetBufferPointer();
+  LabelImagePixelType *       output = outputImage->GetBufferPointer();
+
+  const LabelImageRegionType region = outputImage->GetBufferedRegion();
+  const typename LabelImageType::SizeType size = region.GetSize();
+  const OffsetValueType *                 offsetTable = outputImage->GetOffsetTable();
+  const auto                              numberOfPixels = static_cast< OffsetValueType >( region.GetNumberOfPixels() );
+
+  using OffsetType = typename LabelImageType::OffsetType;
+  std::vector< OffsetType >      neighbors;
+  std::vector< OffsetValueType > neighborOffsets;
+  {
+  OffsetType neighbor;
+  const auto numberOfNeighborhoodPixels = static_cast< unsigned int >( std::pow( 3.0, double( ImageDimension ) ) );
+  for ( unsigned int n = 0; n < numberOfNeighborhoodPixels; ++n )
+    {
+    unsigned int code = n;
+    unsigned int nonZero = 0;
+    OffsetValueType linearOffset = 0;
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      neighbor[d] = static_cast< OffsetValueType >( code % 3 ) - 1;
+      code /= 3;
+      nonZero += ( neighbor[d] != 0 );
+      linearOffset += neighbor[d] * offsetTable[d];
+      }
+    if ( nonZero == 1 || ( m_FullyConnected && nonZero > 0 ) )
+      {
+      neighbors.push_back( neighbor );
+      neighborOffsets.push_back( linearOffset );
+      }
+    }
+  }
+  const auto numberOfNeighbors = static_cast< unsigned int >( neighbors.size() );
+
+  // the neighbor nb of the pixel at offset, in the image or not. The pixels
+  // that are not on the border of the image have all their neighbors in it.
+  IndexType  pixelIndex;
+  bool       onBorder = false;
+  const auto moveTo = [&]( OffsetValueType offset )
+    {
+    onBorder = false;
+    for ( unsigned int d = ImageDimension; d > 0; --d )
+      {
+      pixelIndex[d - 1] = offset / offsetTable[d - 1];
+      offset -= pixelIndex[d - 1] * offsetTable[d - 1];
+      if ( pixelIndex[d - 1] == 0 || pixelIndex[d - 1] + 1 == static_cast< IndexValueType >( size[d - 1] ) )
+        {
+        onBorder = true;
+        }
+      }
+    };
+  const auto isInside = [&]( unsigned int nb )
+    {
+    if ( !onBorder )
+      {
+      return true;
+      }
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      const IndexValueType i = pixelIndex[d] + neighbors[nb][d];
+      if ( i < 0 || i >= static_cast< IndexValueType >( size[d] ) )
+        {
+        return false;
+        }
+      }
+    return true;
+    };
+
   // FAH (in french: File d'Attente Hierarchique)
-  using QueueType = std::queue< IndexType >;
-  using MapType = std::map< InputImagePixelType, QueueType >;
-  MapType fah;
-
-  // the radius which will be used for all the shaped iterators
-  Size< ImageDimension > radius;
-  radius.Fill(1);
-
-  // iterator for the marker image
-  using MarkerIteratorType = ConstShapedNeighborhoodIterator< LabelImageType >;
-  typename MarkerIteratorType::ConstIterator nmIt;
-  MarkerIteratorType
-  markerIt( radius, markerImage, markerImage->GetRequestedRegion() );
-  // add a boundary constant to avoid adding pixels on the border in the fah
-  ConstantBoundaryCondition< LabelImageType > lcbc;
-  lcbc.SetConstant( NumericTraits< LabelImagePixelType >::max() );
-  markerIt.OverrideBoundaryCondition(&lcbc);
-  setConnectivity(&markerIt, m_FullyConnected);
-
-  // iterator for the input image
-  using InputIteratorType = ConstShapedNeighborhoodIterator< InputImageType >;
-  InputIteratorType
-  inputIt( radius, inputImage, inputImage->GetRequestedRegion() );
-  typename InputIteratorType::ConstIterator niIt;
-  setConnectivity(&inputIt, m_FullyConnected);
-
-  // iterator for the output image
-  using OutputIteratorType = ShapedNeighborhoodIterator< LabelImageType >;
-  using OffsetType = typename OutputIteratorType::OffsetType;
-  typename OutputIteratorType::Iterator noIt;
-  OutputIteratorType
-  outputIt( radius, outputImage, outputImage->GetRequestedRegion() );
-  setConnectivity(&outputIt, m_FullyConnected);
+  using QueueType = detail::WatershedHierarchicalQueue< InputImagePixelType >;
+  using LevelType = typename QueueType::LevelType;
+  QueueType fah;
 
   //---------------------------------------------------------------------------
   // Meyer's algorithm
@@ -165,72 +316,36 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     //  - init FAH with indexes of background pixels with marker pixel(s) in
     //    their neighborhood
 
-    ConstantBoundaryCondition< LabelImageType > lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(wsLabel);
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    // create a temporary image to store the state of each pixel (processed or
-    // not)
-    using StatusImageType = Image< bool, ImageDimension >;
-    typename StatusImageType::Pointer statusImage = StatusImageType::New();
-    statusImage->SetRegions( markerImage->GetLargestPossibleRegion() );
-    statusImage->Allocate();
-
-    // iterator for the status image
-    using StatusIteratorType = ShapedNeighborhoodIterator< StatusImageType >;
-    typename StatusIteratorType::Iterator nsIt;
-    StatusIteratorType
-                                                 statusIt( radius, statusImage, outputImage->GetRequestedRegion() );
-    ConstantBoundaryCondition< StatusImageType > bcbc;
-    bcbc.SetConstant(true);    // outside pixel are already processed
-    statusIt.OverrideBoundaryCondition(&bcbc);
-    setConnectivity(&statusIt, m_FullyConnected);
-
-    // the status image must be initialized before the first stage. In the
-    // first stage, the set to true are the neighbors of the marker (and the
-    // marker) so it's difficult (impossible ?) to init the status image at
-    // the same time
-    // the overhead should be small
-    statusImage->FillBuffer(false);
-
-    for ( markerIt.GoToBegin(), statusIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin();
-          !markerIt.IsAtEnd();
-          ++markerIt, ++outputIt )
+    // the state of each pixel: processed (or in the fah) or not. The pixels
+    // outside of the image are already processed.
+    std::vector< bool > status( numberOfPixels, false );
+
+    for ( OffsetValueType offset = 0; offset < numberOfPixels; ++offset )
       {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = marker[offset];
       if ( markerPixel != bgLabel )
         {
-        IndexType idx = markerIt.GetIndex();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - statusIt.GetIndex();
-        statusIt += shift;
-        inputIt += shift;
-
         // this pixel belongs to a marker
         // mark it as already processed
-        statusIt.SetCenterPixel(true);
+        status[offset] = true;
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[offset] = markerPixel;
         // and increase progress because this pixel will not be used in the
         // flooding stage.
         progress.CompletedPixel();
 
         // search the background pixels in the neighborhood
-        for ( nmIt = markerIt.Begin(), nsIt = statusIt.Begin(), niIt = inputIt.Begin();
-              nmIt != markerIt.End();
-              nmIt++, nsIt++, niIt++ )
+        moveTo( offset );
+        for ( unsigned int nb = 0; nb < numberOfNeighbors; ++nb )
           {
-          if ( !nsIt.Get() && nmIt.Get() == bgLabel )
+          const OffsetValueType n = offset + neighborOffsets[nb];
+          if ( isInside( nb ) && !status[n] && marker[n] == bgLabel )
             {
             // this neighbor is a background pixel and is not already
             // processed; add its index to fah
-            fah[niIt.Get()].push( markerIt.GetIndex()
-                                  + nmIt.GetNeighborhoodOffset() );
+            fah.Push( input[n], n );
             // mark it as already in the fah to avoid adding it several times
-            nsIt.Set(true);
+            status[n] = true;
             }
           }
         }
@@ -238,94 +353,79 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         {
         // Some pixels may be never processed so, by default, non marked pixels
         // must be marked as watershed
-        outputIt.SetCenterPixel(wsLabel);
+        output[offset] = wsLabel;
         }
       // one more pixel done in the init stage
       progress.CompletedPixel();
       }
-    // fill the borders of the status image with "true"
-    //FillSides<StatusImageType>(statusImage, true);
-    // Now disable the boundary checks
-    //outputIt.NeedToUseBoundaryConditionOff();
-    //statusIt.NeedToUseBoundaryConditionOff();
-    //inputIt.NeedToUseBoundaryConditionOff();
     // end of init stage
 
-    // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    statusIt.GoToBegin();
-    inputIt.GoToBegin();
-
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
+      // the current level. The pixels of lower values found while flooding it
+      // are added to it, and it is removed from the fah once done.
+      const InputImagePixelType currentValue = fah.GetFrontValue();
+      LevelType &               currentQueue = fah.GetFrontLevel();
 
-      while ( !currentQueue.empty() )
+      for ( size_t front = 0; front < currentQueue.size(); ++front )
         {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        statusIt += shift;
-        inputIt += shift;
+        const OffsetValueType offset = currentQueue[front];
+        moveTo( offset );
 
         // iterate over the neighbors. If there is only one marker value, give
         // that value to the pixel, else keep it as is (watershed line)
-        LabelImagePixelType marker = wsLabel;
+        LabelImagePixelType label = wsLabel;
         bool                collision = false;
-        for ( noIt = outputIt.Begin(); noIt != outputIt.End(); noIt++ )
+        for ( unsigned int nb = 0; nb < numberOfNeighbors; ++nb )
           {
-          LabelImagePixelType o = noIt.Get();
+          if ( !isInside( nb ) )
+            {
+            // outside pixel are watershed so they won't be use to find real
+            // watershed pixels
+            continue;
+            }
+          const LabelImagePixelType o = output[offset + neighborOffsets[nb]];
           if ( o != wsLabel )
             {
-            if ( marker != wsLabel && o != marker )
+            if ( label != wsLabel && o != label )
               {
               collision = true;
               break;
               }
             else
-                  { marker = o; }
+                  { label = o; }
             }
           }
         if ( !collision )
           {
           // set the marker value
-          outputIt.SetCenterPixel(marker);
+          output[offset] = label;
           // and propagate to the neighbors
-          for ( niIt = inputIt.Begin(), nsIt = statusIt.Begin();
-                niIt != inputIt.End();
-                niIt++, nsIt++ )
+          for ( unsigned int nb = 0; nb < numberOfNeighbors; ++nb )
             {
-            if ( !nsIt.Get() )
+            const OffsetValueType n = offset + neighborOffsets[nb];
+            if ( isInside( nb ) && !status[n] )
               {
               // the pixel is not yet processed. add it to the fah
-              InputImagePixelType GrayVal = niIt.Get();
+              const InputImagePixelType GrayVal = input[n];
               if ( GrayVal <= currentValue )
                 {
-                currentQueue.push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
+                currentQueue.push_back( n );
                 }
               else
                 {
-                fah[GrayVal].push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
+                fah.Push( GrayVal, n );
                 }
               // mark it as already in the fah
-              nsIt.Set(true);
+              status[n] = true;
               }
             }
           }
         // one more pixel in the flooding stage
         progress.CompletedPixel();
         }
+      fah.PopFrontLevel();
       }
     }
 
@@ -339,31 +439,20 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     //  - init FAH with indexes of pixels with background pixel in their
     //    neighborhood
 
-    ConstantBoundaryCondition< LabelImageType > lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant( NumericTraits< LabelImagePixelType >::max() );
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    for ( markerIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin();
-          !markerIt.IsAtEnd();
-          ++markerIt, ++outputIt )
+    for ( OffsetValueType offset = 0; offset < numberOfPixels; ++offset )
       {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = marker[offset];
       if ( markerPixel != bgLabel )
         {
-        IndexType  idx = markerIt.GetIndex();
-        OffsetType shift = idx - inputIt.GetIndex();
-        inputIt += shift;
-
         // this pixels belongs to a marker
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[offset] = markerPixel;
         // search if it has background pixel in its neighborhood
         bool haveBgNeighbor = false;
-        for ( nmIt = markerIt.Begin(); nmIt != markerIt.End(); nmIt++ )
+        moveTo( offset );
+        for ( unsigned int nb = 0; nb < numberOfNeighbors; ++nb )
           {
-          if ( nmIt.Get() == bgLabel )
+          if ( isInside( nb ) && marker[offset + neighborOffsets[nb]] == bgLabel )
             {
             haveBgNeighbor = true;
             break;
@@ -372,7 +461,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         if ( haveBgNeighbor )
           {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push( markerIt.GetIndex() );
+          fah.Push( input[offset], offset );
           }
         else
           {
@@ -383,63 +472,49 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         }
       else
         {
-        outputIt.SetCenterPixel(wsLabel);
+        output[offset] = wsLabel;
         }
       progress.CompletedPixel();
       }
     // end of init stage
 
-    // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    inputIt.GoToBegin();
-
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
+      // the current level
+      const InputImagePixelType currentValue = fah.GetFrontValue();
+      LevelType &               currentQueue = fah.GetFrontLevel();
 
-      while ( !currentQueue.empty() )
+      for ( size_t front = 0; front < currentQueue.size(); ++front )
         {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        inputIt += shift;
-
-        LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
-        // get the current value of the pixel
-        // iterate over neighbors to propagate the marker
-        for ( noIt = outputIt.Begin(), niIt = inputIt.Begin();
-              noIt != outputIt.End();
-              noIt++, niIt++ )
+        const OffsetValueType offset = currentQueue[front];
+        moveTo( offset );
+
+        const LabelImagePixelType currentMarker = output[offset];
+        // iterate over neighbors to propagate the marker. The pixels outside
+        // of the image are never labeled.
+        for ( unsigned int nb = 0; nb < numberOfNeighbors; ++nb )
           {
-          if ( noIt.Get() == wsLabel )
+          const OffsetValueType n = offset + neighborOffsets[nb];
+          if ( isInside( nb ) && output[n] == wsLabel )
             {
             // the pixel is not yet processed. It can be labeled with the
             // current label
-            noIt.Set(currentMarker);
-            InputImagePixelType GrayVal = niIt.Get();
+            output[n] = currentMarker;
+            const InputImagePixelType GrayVal = input[n];
             if ( GrayVal <= currentValue )
               {
-              currentQueue.push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
+              currentQueue.push_back( n );
               }
             else
               {
-              fah[GrayVal].push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
+              fah.Push( GrayVal, n );
               }
             progress.CompletedPixel();
             }
           }
         }
+      fah.PopFrontLevel();
       }
     }
 }
@@ -23,6 +23,10 @@
 #include "itkWatershedSegmentTreeGenerator.h"
 #include "itkWatershedRelabeler.h"
 #include "itkWatershedMiniPipelineProgressCommand.h"
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace itk
 {
@@ -32,7 +36,7 @@ namespace itk
  *
  * \par Overview and terminology
  * \par
- * This filter implements a non-streaming version of an image segmentation
+ * This filter implements an image segmentation
  * algorithm commonly known as "watershed segmentation".   Watershed
  * segmentation gets its name from the manner in which the algorithm  segments
  * regions into catchment basins. If a function \f$ f \f$ is a continuous
@@ -75,9 +79,9 @@ namespace itk
  * algorithm components in the namespace "watershed").  For a more complete
  * picture of the implementation, refer to the documentation of those components.
  * The component classes were designed to operate in either a data-streaming or
- * a non-data-streaming mode.  The pipeline constructed in this class'
- * GenerateData() method does not support streaming, but is the common use case
- * for the components.
+ * a non-data-streaming mode.  By default, the pipeline constructed in this
+ * class' GenerateData() method does not stream, which is the common use case
+ * for the components; see the streaming notes below.
  *
  * \par Description of the input to this filter
  * The input to this filter is a scalar itk::Image of any dimensionality.  This
@@ -138,6 +142,20 @@ namespace itk
  * Threshold and Level parameters are controlled through the class'
  * Get/SetThreshold() and Get/SetLevel() methods.
  *
+ * \par Streaming
+ * When NumberOfStreamDivisions is larger than one, the input is segmented in
+ * slabs along its last dimension.  Each slab, padded by one slice on the
+ * sides it shares with its neighbors, is requested from the upstream pipeline
+ * on its own, so a streaming reader never holds the complete volume.  The
+ * initial segmentation of each slab is written to a temporary file.  The
+ * segments that flow across the boundary between two slabs, and the flat
+ * regions that span several slabs, are merged through an equivalency table,
+ * and the adjacencies across the boundaries are added to the segment table.
+ * The output requested region is then honored, so that a streaming writer
+ * only holds a piece of the labeled image at a time.  With a Threshold above
+ * zero, one extra pass over the input computes its range.  The segment table
+ * stays in memory.
+ *
  * \ingroup WatershedSegmentation
  * \ingroup ITKWatersheds
  *
@@ -225,6 +243,13 @@ public:
 
   itkGetConstMacro(Level, double);
 
+  /** Set/Get the number of slabs in which the input is segmented.  The
+   * default is 1, which segments the whole input at once.  See the
+   * streaming notes in the class documentation. */
+  void SetNumberOfStreamDivisions(unsigned int);
+
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
   /** Get the basic segmentation from the Segmenter member filter. */
   typename watershed::Segmenter< InputImageType >::OutputImageType *
   GetBasicSegmentation()
@@ -265,7 +290,67 @@ protected:
    */
   void PrepareOutputs() override;
 
+  /** When streaming, only the first slab of the input is requested before
+   * the execution; the others are requested by GenerateData(). */
+  void GenerateInputRequestedRegion() override;
+
 private:
+  using SegmenterType = watershed::Segmenter< InputImageType >;
+  using BoundaryType = typename SegmenterType::BoundaryType;
+  using FaceValuesType = std::vector< ScalarType >;
+
+  /** A flat region that touches a slab boundary.  The outlet is its lowest
+   * neighbor, the first one in the order in which the segmenter visits the
+   * pixels and their neighbors. */
+  struct FlatRegionType
+  {
+    ScalarType value;
+    ScalarType outletValue;
+    IdentifierType outletLabel;
+    OffsetValueType outletOffset;
+    unsigned int outletNeighbor;
+  };
+  using FlatRegionMapType = std::map< IdentifierType, FlatRegionType >;
+
+  /** Segments the input slab by slab into the temporary file, resolving the
+   * boundary between each slab and the previous one. */
+  void GenerateStreamedSegmentation();
+
+  /** Relabels the requested region of the output from the temporary file. */
+  void GenerateStreamedOutput();
+
+  /** Returns the number of slabs, which are at least two slices thick. */
+  unsigned int GetNumberOfStreamedSlabs() const;
+
+  /** Returns the given slab of the input, optionally padded by one slice on
+   * the sides it shares with the other slabs. */
+  RegionType GetStreamedSlab(unsigned int slab, bool padded) const;
+
+  /** Returns the offset of a pixel in the largest possible region. */
+  OffsetValueType GetStreamedOffset(const IndexType & index) const;
+
+  /** Finds the outlets of the flat regions of the given slab that touch its
+   * boundaries, within the slab. */
+  void FindFlatRegionOutlets(const RegionType & slab, FlatRegionMapType & flats) const;
+
+  /** Joins the segments that flow across the boundary between two slabs,
+   * and adds their adjacencies to the segment table.  The flat regions that
+   * touch the boundary are only linked, and resolved by ResolveFlatRegions(). */
+  void ResolveBoundary(BoundaryType *low, const FaceValuesType & lowValues,
+                       BoundaryType *high, const FaceValuesType & highValues,
+                       FlatRegionMapType & flats, EquivalencyTable *flatEquivalencies);
+
+  /** Joins each flat region that crosses slab boundaries to the segment of
+   * its lowest neighbor. */
+  void ResolveFlatRegions(const FlatRegionMapType & flats, EquivalencyTable *flatEquivalencies);
+
+  /** Returns a value of the input as seen by the segmenter. */
+  ScalarType GetStreamedValue(ScalarType value) const;
+
+  /** Copies the given slice of the input, as seen by the segmenter. */
+  void CopyFaceValues(const RegionType & slice, FaceValuesType & values) const;
+
+
   /** A Percentage of the maximum depth (max - min pixel value) in the input
    *  image.  This percentage will be used to threshold the minimum values in
    *  the image. */
@@ -289,6 +374,15 @@ private:
 
   unsigned long m_ObserverTag;
 
+  unsigned int m_NumberOfStreamDivisions{1};
+
+  /** State kept between the executions of a streamed segmentation: the
+   * equivalencies across the slab boundaries, the threshold applied by the
+   * segmenter, and the temporary file of initial labels. */
+  EquivalencyTable::Pointer m_BoundaryEquivalencies;
+  ScalarType m_StreamedThreshold;
+  std::unique_ptr< std::FILE, int ( * )( std::FILE * ) > m_BasicSegmentationFile{ nullptr, &std::fclose };
+
   bool m_LevelChanged;
   bool m_ThresholdChanged;
   bool m_InputChanged;
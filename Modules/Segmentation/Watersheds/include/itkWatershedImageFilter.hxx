@@ -18,6 +18,11 @@
 #ifndef itkWatershedImageFilter_hxx
 #define itkWatershedImageFilter_hxx
 #include "itkWatershedImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
+#include <cstdint>
 
 namespace itk
 {
@@ -76,6 +81,23 @@ CLANG_PRAGMA_POP    \
     }
 }
 
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::SetNumberOfStreamDivisions(unsigned int val)
+{
+  val = std::max( val, 1u );
+  if ( val != m_NumberOfStreamDivisions )
+    {
+    m_NumberOfStreamDivisions = val;
+
+    // The segment table of a streamed segmentation is not the one of a
+    // non-streamed segmentation.
+    m_InputChanged = true;
+    this->Modified();
+    }
+}
+
 template< typename TInputImage >
 WatershedImageFilter< TInputImage >
 ::WatershedImageFilter()
@@ -106,6 +128,9 @@ WatershedImageFilter< TInputImage >
   m_ObserverTag = m_TreeGenerator->AddObserver(ProgressEvent(), c);
   m_Relabeler->AddObserver(ProgressEvent(), c);
 
+  m_BoundaryEquivalencies = EquivalencyTable::New();
+  m_StreamedThreshold = NumericTraits< ScalarType >::ZeroValue();
+
   m_InputChanged = true;
   m_LevelChanged = true;
   m_ThresholdChanged = true;
@@ -117,7 +142,26 @@ WatershedImageFilter< TInputImage >
 ::EnlargeOutputRequestedRegion(DataObject *data)
 {
   Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
+
+  // A streamed segmentation is relabeled piece by piece
+  if ( m_NumberOfStreamDivisions == 1 )
+    {
+    data->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if ( m_NumberOfStreamDivisions > 1 && this->GetInput() )
+    {
+    const_cast< InputImageType * >( this->GetInput() )
+    ->SetRequestedRegion( this->GetStreamedSlab(0, true) );
+    }
 }
 
 template< typename TInputImage >
@@ -178,6 +222,36 @@ void
 WatershedImageFilter< TInputImage >
 ::GenerateData()
 {
+  if ( m_NumberOfStreamDivisions > 1 )
+    {
+    if ( m_InputChanged
+         || ( this->GetInput()->GetPipelineMTime() > m_GenerateDataMTime )
+         || m_ThresholdChanged
+         || !m_BasicSegmentationFile )
+      {
+      this->GenerateStreamedSegmentation();
+      }
+    else if ( m_LevelChanged && m_Level > m_TreeGenerator->GetHighestCalculatedFloodLevel() )
+      {
+      m_TreeGenerator->Update();
+      }
+    this->GenerateStreamedOutput();
+
+    m_GenerateDataMTime.Modified();
+    m_InputChanged = false;
+    m_LevelChanged = false;
+    m_ThresholdChanged = false;
+    return;
+    }
+
+  // A previous streamed execution may have left the mini-pipeline set up
+  // for streaming
+  m_BasicSegmentationFile.reset();
+  m_Segmenter->SetDoBoundaryAnalysis(false);
+  m_Segmenter->SetSortEdgeLists(true);
+  m_Segmenter->SetUseInputRange(false);
+  m_TreeGenerator->SetMerge(false);
+
   // Set the largest possible region in the segmenter
   m_Segmenter->SetLargestPossibleRegion( this->GetInput()
                                          ->GetLargestPossibleRegion() );
@@ -209,6 +283,475 @@ WatershedImageFilter< TInputImage >
   m_ThresholdChanged = false;
 }
 
+template< typename TInputImage >
+unsigned int
+WatershedImageFilter< TInputImage >
+::GetNumberOfStreamedSlabs() const
+{
+  // Slabs are at least two slices thick, so that the low and high faces of a
+  // slab are distinct.
+  const SizeValueType length = this->GetInput()->GetLargestPossibleRegion().GetSize(ImageDimension - 1);
+  return static_cast< unsigned int >(
+    std::max< SizeValueType >( std::min< SizeValueType >( m_NumberOfStreamDivisions, length / 2 ), 1 ) );
+}
+
+template< typename TInputImage >
+typename WatershedImageFilter< TInputImage >::RegionType
+WatershedImageFilter< TInputImage >
+::GetStreamedSlab(unsigned int slab, bool padded) const
+{
+  constexpr unsigned int axis = ImageDimension - 1;
+  const RegionType largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  const SizeValueType length = largestRegion.GetSize(axis);
+  const SizeValueType slabs = this->GetNumberOfStreamedSlabs();
+
+  const auto begin = static_cast< IndexValueType >( slab * length / slabs );
+  const auto end = static_cast< IndexValueType >( ( slab + 1 ) * length / slabs );
+
+  RegionType region = largestRegion;
+  region.SetIndex( axis, largestRegion.GetIndex(axis) + begin );
+  region.SetSize( axis, static_cast< SizeValueType >( end - begin ) );
+  if ( padded )
+    {
+    region.PadByRadius(1);
+    region.Crop(largestRegion);
+    }
+  return region;
+}
+
+template< typename TInputImage >
+typename WatershedImageFilter< TInputImage >::ScalarType
+WatershedImageFilter< TInputImage >
+::GetStreamedValue(ScalarType value) const
+{
+  // Apply the thresholding of the segmenter, so that the values seen across
+  // slabs match the ones within a slab.
+  ScalarType maximum = NumericTraits< ScalarType >::max();
+  if ( NumericTraits< ScalarType >::IsInteger )
+    {
+    maximum -= NumericTraits< ScalarType >::OneValue();
+    }
+  return std::min( std::max( value, m_StreamedThreshold ), maximum );
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::CopyFaceValues(const RegionType & slice, FaceValuesType & values) const
+{
+  values.clear();
+  values.reserve( slice.GetNumberOfPixels() );
+  for ( ImageRegionConstIterator< InputImageType > it( this->GetInput(), slice ); !it.IsAtEnd(); ++it )
+    {
+    values.push_back( this->GetStreamedValue( it.Get() ) );
+    }
+}
+
+template< typename TInputImage >
+OffsetValueType
+WatershedImageFilter< TInputImage >
+::GetStreamedOffset(const IndexType & index) const
+{
+  const RegionType largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  OffsetValueType offset = 0;
+  for ( int d = ImageDimension - 1; d >= 0; --d )
+    {
+    offset = offset * static_cast< OffsetValueType >( largestRegion.GetSize(d) )
+             + ( index[d] - largestRegion.GetIndex(d) );
+    }
+  return offset;
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::FindFlatRegionOutlets(const RegionType & slab, FlatRegionMapType & flats) const
+{
+  if ( flats.empty() )
+    {
+    return;
+    }
+
+  // Visit the neighbors in the order of the connectivity of the segmenter:
+  // the negative ones from the last dimension to the first, then the
+  // positive ones from the first dimension to the last.
+  const InputImageType *input = this->GetInput();
+  for ( ImageRegionConstIteratorWithIndex< OutputImageType > it( m_Segmenter->GetOutputImage(), slab ); !it.IsAtEnd();
+        ++it )
+    {
+    auto flat = flats.find( it.Get() );
+    if ( flat == flats.end() )
+      {
+      continue;
+      }
+    const IndexType index = it.GetIndex();
+    for ( unsigned int neighbor = 0; neighbor < 2 * ImageDimension; ++neighbor )
+      {
+      IndexType neighborIndex = index;
+      if ( neighbor < ImageDimension )
+        {
+        --neighborIndex[ImageDimension - 1 - neighbor];
+        }
+      else
+        {
+        ++neighborIndex[neighbor - ImageDimension];
+        }
+      if ( !slab.IsInside(neighborIndex) )
+        {
+        continue;
+        }
+      const ScalarType value = this->GetStreamedValue( input->GetPixel(neighborIndex) );
+      if ( value < flat->second.outletValue )
+        {
+        flat->second.outletValue = value;
+        flat->second.outletLabel = m_Segmenter->GetOutputImage()->GetPixel(neighborIndex);
+        flat->second.outletOffset = this->GetStreamedOffset(index);
+        flat->second.outletNeighbor = neighbor;
+        }
+      }
+    }
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::ResolveBoundary(BoundaryType *low, const FaceValuesType & lowValues,
+                  BoundaryType *high, const FaceValuesType & highValues,
+                  FlatRegionMapType & flats, EquivalencyTable *flatEquivalencies)
+{
+  using FaceType = typename BoundaryType::face_t;
+  using SegmentTableType = typename SegmenterType::SegmentTableType;
+  using EdgeType = typename SegmentTableType::edge_pair_t;
+  constexpr unsigned int axis = ImageDimension - 1;
+
+  // A pixel that flows across the boundary joins the segment of its
+  // neighbor, unless it belongs to a flat region, whose outlet is only known
+  // once all the slabs are segmented.
+  auto flowAcross = [&]( IdentifierType from, bool flows, OffsetValueType offset, unsigned int neighbor,
+                         IdentifierType to, ScalarType toValue ) {
+    auto flat = flats.find(from);
+    if ( flat != flats.end() )
+      {
+      FlatRegionType & region = flat->second;
+      if ( toValue < region.outletValue
+           || ( Math::AlmostEquals( toValue, region.outletValue )
+                && std::make_pair( offset, neighbor ) < std::make_pair( region.outletOffset, region.outletNeighbor ) ) )
+        {
+        region.outletValue = toValue;
+        region.outletLabel = to;
+        region.outletOffset = offset;
+        region.outletNeighbor = neighbor;
+        }
+      }
+    else if ( flows )
+      {
+      m_BoundaryEquivalencies->Add(from, to);
+      }
+  };
+
+  // The high face of the low slab touches the low face of the high slab.
+  // Edges are located between two adjacent pixels of different segments, and
+  // their height is the larger of the two values, as in the segmenter.
+  std::map< std::pair< IdentifierType, IdentifierType >, ScalarType > edges;
+  const typename BoundaryType::IndexType lowSlabFace(axis, 1);
+  const typename BoundaryType::IndexType highSlabFace(axis, 0);
+  ImageRegionConstIterator< FaceType > lowIt( low->GetFace(lowSlabFace),
+                                              low->GetFace(lowSlabFace)->GetBufferedRegion() );
+  ImageRegionConstIterator< FaceType > highIt( high->GetFace(highSlabFace),
+                                               high->GetFace(highSlabFace)->GetBufferedRegion() );
+  const OffsetValueType lowOffset =
+    this->GetStreamedOffset( low->GetFace(lowSlabFace)->GetBufferedRegion().GetIndex() );
+  const OffsetValueType highOffset =
+    this->GetStreamedOffset( high->GetFace(highSlabFace)->GetBufferedRegion().GetIndex() );
+  for ( size_t i = 0; !lowIt.IsAtEnd(); ++lowIt, ++highIt, ++i )
+    {
+    const IdentifierType a = lowIt.Get().label;
+    const IdentifierType b = highIt.Get().label;
+    if ( a == b || a == SegmenterType::NULL_LABEL || b == SegmenterType::NULL_LABEL )
+      {
+      continue;
+      }
+
+    if ( Math::AlmostEquals( lowValues[i], highValues[i] ) )
+      {
+      // Both pixels are parts of the same flat region
+      flatEquivalencies->Add(a, b);
+      }
+    else if ( highValues[i] < lowValues[i] )
+      {
+      flowAcross( a, lowIt.Get().flow != SegmenterType::NULL_FLOW, lowOffset + i, 2 * ImageDimension - 1,
+                  b, highValues[i] );
+      }
+    else
+      {
+      flowAcross( b, highIt.Get().flow != SegmenterType::NULL_FLOW, highOffset + i, 0, a, lowValues[i] );
+      }
+
+    const ScalarType height = std::max( lowValues[i], highValues[i] );
+    for ( const auto & key : { std::make_pair(a, b), std::make_pair(b, a) } )
+      {
+      auto result = edges.insert( std::make_pair(key, height) );
+      if ( !result.second && height < result.first->second )
+        {
+        result.first->second = height;
+        }
+      }
+    }
+
+  SegmentTableType *segments = m_Segmenter->GetSegmentTable();
+  for ( const auto & edge : edges )
+    {
+    typename SegmentTableType::segment_t *segment = segments->Lookup(edge.first.first);
+    if ( segment == nullptr )
+      {
+      itkExceptionMacro(<< "Segment " << edge.first.first << " on a slab boundary is not in the segment table.");
+      }
+    segment->edge_list.push_back( EdgeType(edge.first.second, edge.second) );
+    }
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::ResolveFlatRegions(const FlatRegionMapType & flats, EquivalencyTable *flatEquivalencies)
+{
+  // The parts of a flat region that crosses slab boundaries drain together
+  // to the outlet that the segmenter would find first in the whole input.
+  std::map< IdentifierType, const FlatRegionType * > outlets;
+  for ( const auto & flat : flats )
+    {
+    const IdentifierType root = flatEquivalencies->RecursiveLookup(flat.first);
+    auto result = outlets.insert( std::make_pair( root, &flat.second ) );
+    const FlatRegionType *outlet = result.first->second;
+    if ( !result.second
+         && ( flat.second.outletValue < outlet->outletValue
+              || ( Math::AlmostEquals( flat.second.outletValue, outlet->outletValue )
+                   && std::make_pair( flat.second.outletOffset, flat.second.outletNeighbor )
+                      < std::make_pair( outlet->outletOffset, outlet->outletNeighbor ) ) ) )
+      {
+      result.first->second = &flat.second;
+      }
+    }
+  for ( const auto & flat : flats )
+    {
+    const IdentifierType root = flatEquivalencies->RecursiveLookup(flat.first);
+    if ( root != flat.first )
+      {
+      m_BoundaryEquivalencies->Add(flat.first, root);
+      }
+    const FlatRegionType *outlet = outlets[root];
+    if ( outlet->outletValue < flat.second.value )
+      {
+      m_BoundaryEquivalencies->Add(flat.first, outlet->outletLabel);
+      }
+    }
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::GenerateStreamedSegmentation()
+{
+  constexpr unsigned int axis = ImageDimension - 1;
+  auto * input = const_cast< InputImageType * >( this->GetInput() );
+  const RegionType largestRegion = input->GetLargestPossibleRegion();
+  const unsigned int slabs = this->GetNumberOfStreamedSlabs();
+
+  WatershedMiniPipelineProgressCommand::Pointer c =
+    dynamic_cast< WatershedMiniPipelineProgressCommand * >(
+      m_TreeGenerator->GetCommand(m_ObserverTag) );
+  c->SetCount(0.0);
+  c->SetNumberOfFilters(slabs + 1);
+
+  // The range of the whole input.  It is needed before the segmentation only
+  // to threshold all the slabs alike.
+  ScalarType minimum = NumericTraits< ScalarType >::max();
+  ScalarType maximum = NumericTraits< ScalarType >::NonpositiveMin();
+  auto updateRange = [&]( const RegionType & slab ) {
+    for ( ImageRegionConstIterator< InputImageType > it( input, slab ); !it.IsAtEnd(); ++it )
+      {
+      minimum = std::min( minimum, it.Get() );
+      maximum = std::max( maximum, it.Get() );
+      }
+  };
+  auto capMaximum = [&]() {
+    if ( NumericTraits< ScalarType >::IsInteger
+CLANG_PRAGMA_PUSH
+CLANG_SUPPRESS_Wfloat_equal
+         && maximum == NumericTraits< ScalarType >::max() )
+CLANG_PRAGMA_POP
+      {
+      maximum -= NumericTraits< ScalarType >::OneValue();
+      }
+  };
+
+  m_StreamedThreshold = NumericTraits< ScalarType >::NonpositiveMin();
+  if ( m_Threshold > 0.0 )
+    {
+    for ( unsigned int slab = 0; slab < slabs; ++slab )
+      {
+      const RegionType region = this->GetStreamedSlab(slab, false);
+      input->SetRequestedRegion(region);
+      input->PropagateRequestedRegion();
+      input->UpdateOutputData();
+      updateRange(region);
+      }
+    capMaximum();
+    m_StreamedThreshold = static_cast< ScalarType >( ( m_Threshold * ( maximum - minimum ) ) + minimum );
+    }
+
+  m_Segmenter->SetDoBoundaryAnalysis(true);
+  m_Segmenter->SetSortEdgeLists(false);
+  m_Segmenter->SetUseInputRange(m_Threshold > 0.0);
+  m_Segmenter->SetInputMinimum(minimum);
+  m_Segmenter->SetInputMaximum(maximum);
+  m_Segmenter->SetLargestPossibleRegion(largestRegion);
+  m_Segmenter->SetCurrentLabel(1);
+  m_Segmenter->GetSegmentTable()->Clear();
+  m_BoundaryEquivalencies->Clear();
+
+  m_BasicSegmentationFile.reset( std::tmpfile() );
+  if ( !m_BasicSegmentationFile )
+    {
+    itkExceptionMacro(<< "Could not create the temporary file of the streamed segmentation.");
+    }
+
+  typename BoundaryType::Pointer previousBoundary;
+  FaceValuesType previousFaceValues;
+  FaceValuesType faceValues;
+  std::vector< IdentifierType > labels;
+  FlatRegionMapType flats;
+  EquivalencyTable::Pointer flatEquivalencies = EquivalencyTable::New();
+  for ( unsigned int slab = 0; slab < slabs; ++slab )
+    {
+    const RegionType region = this->GetStreamedSlab(slab, false);
+
+    // The segmenter pulls the padded slab from the upstream pipeline
+    typename BoundaryType::Pointer boundary = BoundaryType::New();
+    m_Segmenter->SetBoundary(boundary);
+    m_Segmenter->GetOutputImage()->SetRequestedRegion( this->GetStreamedSlab(slab, true) );
+    m_Segmenter->Modified();
+    m_Segmenter->Update();
+    if ( m_Threshold <= 0.0 )
+      {
+      updateRange(region);
+      }
+
+    labels.clear();
+    labels.reserve( region.GetNumberOfPixels() );
+    for ( ImageRegionConstIterator< OutputImageType > it( m_Segmenter->GetOutputImage(), region ); !it.IsAtEnd();
+          ++it )
+      {
+      labels.push_back( it.Get() );
+      }
+    if ( std::fwrite( labels.data(), sizeof( IdentifierType ), labels.size(), m_BasicSegmentationFile.get() )
+         != labels.size() )
+      {
+      itkExceptionMacro(<< "Could not write the temporary file of the streamed segmentation.");
+      }
+
+    // Join the segments across the boundary with the previous slab
+    RegionType slice = region;
+    slice.SetSize(axis, 1);
+    FlatRegionMapType slabFlats;
+    for ( unsigned int side = 0; side < 2; ++side )
+      {
+      if ( boundary->GetValid(axis, side) )
+        {
+        for ( const auto & flat : *boundary->GetFlatHash(axis, side) )
+          {
+          const FlatRegionType flatRegion = { flat.second.value, flat.second.value, SegmenterType::NULL_LABEL, 0, 0 };
+          slabFlats.insert( std::make_pair( flat.first, flatRegion ) );
+          }
+        }
+      }
+    this->FindFlatRegionOutlets(region, slabFlats);
+    flats.insert( slabFlats.begin(), slabFlats.end() );
+    if ( previousBoundary )
+      {
+      this->CopyFaceValues(slice, faceValues);
+      this->ResolveBoundary(previousBoundary, previousFaceValues, boundary, faceValues, flats, flatEquivalencies);
+      }
+    slice.SetIndex( axis, region.GetIndex(axis) + static_cast< IndexValueType >( region.GetSize(axis) ) - 1 );
+    this->CopyFaceValues(slice, previousFaceValues);
+    previousBoundary = boundary;
+    }
+  std::fflush( m_BasicSegmentationFile.get() );
+  this->ResolveFlatRegions(flats, flatEquivalencies);
+
+  if ( m_Threshold <= 0.0 )
+    {
+    capMaximum();
+    }
+  m_Segmenter->GetSegmentTable()->SortEdgeLists();
+  m_Segmenter->GetSegmentTable()->SetMaximumDepth( static_cast< ScalarType >( maximum - minimum ) );
+
+  m_TreeGenerator->SetMerge(true);
+  m_TreeGenerator->SetInputEquivalencyTable(m_BoundaryEquivalencies);
+  m_TreeGenerator->SetHighestCalculatedFloodLevel(0.0);
+  m_TreeGenerator->Modified();
+  m_TreeGenerator->Update();
+}
+
+template< typename TInputImage >
+void
+WatershedImageFilter< TInputImage >
+::GenerateStreamedOutput()
+{
+  constexpr unsigned int axis = ImageDimension - 1;
+  const RegionType largestRegion = this->GetInput()->GetLargestPossibleRegion();
+
+  OutputImageType *output = this->GetOutput();
+  const RegionType requestedRegion = output->GetRequestedRegion();
+  output->SetBufferedRegion(requestedRegion);
+  output->Allocate();
+
+  // Read the whole slices of the initial segmentation that cover the
+  // requested region
+  RegionType slices = largestRegion;
+  slices.SetIndex( axis, requestedRegion.GetIndex(axis) );
+  slices.SetSize( axis, requestedRegion.GetSize(axis) );
+  typename OutputImageType::Pointer labels = OutputImageType::New();
+  labels->CopyInformation(output);
+  labels->SetRegions(slices);
+  labels->Allocate();
+
+  const auto sliceSize = static_cast< std::int64_t >( largestRegion.GetNumberOfPixels() / largestRegion.GetSize(axis) );
+  const std::int64_t offset =
+    ( requestedRegion.GetIndex(axis) - largestRegion.GetIndex(axis) ) * sliceSize
+    * static_cast< std::int64_t >( sizeof( IdentifierType ) );
+#if defined( _WIN32 )
+  const int seek = _fseeki64( m_BasicSegmentationFile.get(), offset, SEEK_SET );
+#else
+  const int seek = fseeko( m_BasicSegmentationFile.get(), static_cast< off_t >( offset ), SEEK_SET );
+#endif
+  const size_t count = slices.GetNumberOfPixels();
+  if ( seek != 0
+       || std::fread( labels->GetBufferPointer(), sizeof( IdentifierType ), count, m_BasicSegmentationFile.get() )
+       != count )
+    {
+    itkExceptionMacro(<< "Could not read the temporary file of the streamed segmentation.");
+    }
+
+  // Merge the segments across the slab boundaries, then the segments of the
+  // tree up to the flood level, as the relabeler does.
+  SegmenterType::RelabelImage(labels, requestedRegion, m_BoundaryEquivalencies);
+
+  EquivalencyTable::Pointer merges = EquivalencyTable::New();
+  auto * tree = m_TreeGenerator->GetOutputSegmentTree();
+  if ( !tree->Empty() )
+    {
+    const auto mergeLimit = static_cast< ScalarType >( m_Level * tree->Back().saliency );
+    for ( auto it = tree->Begin(); it != tree->End() && it->saliency <= mergeLimit; ++it )
+      {
+      merges->Add(it->from, it->to);
+      }
+    SegmenterType::RelabelImage(labels, requestedRegion, merges);
+    }
+
+  ImageAlgorithm::Copy( labels.GetPointer(), output, requestedRegion, requestedRegion );
+}
+
 template< typename TInputImage >
 void
 WatershedImageFilter< TInputImage >
@@ -217,6 +760,7 @@ WatershedImageFilter< TInputImage >
   Superclass::PrintSelf(os, indent);
   os << indent << "Threshold: " << m_Threshold << std::endl;
   os << indent << "Level: " << m_Level << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 }
 } // end namespace itk
 
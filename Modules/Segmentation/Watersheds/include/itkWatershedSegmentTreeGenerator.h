@@ -209,6 +209,11 @@ protected:
 
   void MergeEquivalencies();
 
+  /** Merges the segments of the input equivalency table in the given
+   * segment table, which is the working copy of the input unless
+   * ConsumeInput is on. */
+  void MergeEquivalencies(SegmentTableTypePointer);
+
   /** Methods required by the itk pipeline */
   void GenerateOutputRequestedRegion(DataObject *output) override;
 
@@ -82,7 +82,7 @@ void SegmentTreeGenerator< TScalar >
     input->Modified();
     input->SortEdgeLists();
 
-    if ( m_Merge == true )   {      this->MergeEquivalencies();    }
+    if ( m_Merge == true )   {      this->MergeEquivalencies(input);    }
 
     this->CompileMergeList(input, mergeList);
     this->ExtractMergeHierarchy(input, mergeList);
@@ -91,7 +91,7 @@ void SegmentTreeGenerator< TScalar >
     {
     seg->Copy(*input); // copy the input
     seg->SortEdgeLists();
-    if ( m_Merge == true )   {      this->MergeEquivalencies();    }
+    if ( m_Merge == true )   {      this->MergeEquivalencies(seg);    }
     this->CompileMergeList(seg, mergeList);
     this->ExtractMergeHierarchy(seg, mergeList);
     }
@@ -108,7 +108,13 @@ template< typename TScalar >
 void SegmentTreeGenerator< TScalar >
 ::MergeEquivalencies()
 {
-  typename SegmentTableType::Pointer segTable = this->GetInputSegmentTable();
+  this->MergeEquivalencies( this->GetInputSegmentTable() );
+}
+
+template< typename TScalar >
+void SegmentTreeGenerator< TScalar >
+::MergeEquivalencies(SegmentTableTypePointer segTable)
+{
   typename EquivalencyTableType::Pointer eqTable  =
     this->GetInputEquivalencyTable();
   typename EquivalencyTableType::Iterator it;
@@ -231,6 +231,19 @@ public:
   itkGetConstMacro(SortEdgeLists, bool);
   itkSetMacro(SortEdgeLists, bool);
 
+  /** Gets/Sets the minimum and maximum values of the complete volume being
+   * streamed.  When UseInputRange is on, the threshold and the maximum depth
+   * of the segment table are computed from this range instead of the range
+   * of the chunk being processed, so that all the chunks are thresholded
+   * alike.  The default is off.  Only necessary for streaming
+   * applications. */
+  itkSetMacro(InputMinimum, InputPixelType);
+  itkGetConstMacro(InputMinimum, InputPixelType);
+  itkSetMacro(InputMaximum, InputPixelType);
+  itkGetConstMacro(InputMaximum, InputPixelType);
+  itkSetMacro(UseInputRange, bool);
+  itkGetConstMacro(UseInputRange, bool);
+
 protected:
   /** Structure storing information about image flat regions.
    * Flat regions are connected pixels of the same value.  */
@@ -368,6 +381,9 @@ private:
 
   bool            m_SortEdgeLists;
   bool            m_DoBoundaryAnalysis;
+  bool            m_UseInputRange;
+  InputPixelType  m_InputMinimum;
+  InputPixelType  m_InputMaximum;
   double          m_Threshold;
   double          m_MaximumFloodLevel;
   IdentifierType  m_CurrentLabel;
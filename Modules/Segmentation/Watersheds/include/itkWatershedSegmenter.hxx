@@ -174,7 +174,15 @@ void Segmenter< TInputImage >::GenerateData()
   //
   //
   InputPixelType minimum, maximum;
-  Self::MinMax(input, regionToProcess, minimum, maximum);
+  if ( m_UseInputRange == true )
+    {
+    minimum = m_InputMinimum;
+    maximum = m_InputMaximum;
+    }
+  else
+    {
+    Self::MinMax(input, regionToProcess, minimum, maximum);
+    }
   // cap the maximum in the image so that we can always define a pixel
   // value that is one greater than the maximum value in the image.
   if ( NumericTraits< InputPixelType >::IsInteger
@@ -185,6 +193,14 @@ CLANG_PRAGMA_POP
     {
     maximum -= NumericTraits< InputPixelType >::OneValue();
     }
+  // The boundary flow analysis below looks at the padding along the true
+  // data set boundaries before the retaining wall is built, so the padding
+  // must already hold the wall value.
+  if ( m_DoBoundaryAnalysis == true )
+    {
+    thresholdImage->FillBuffer( maximum + NumericTraits< InputPixelType >::OneValue() );
+    }
+
   // threshold the image.
   Self::Threshold( thresholdImage, input, regionToProcess, regionToProcess,
                    static_cast< InputPixelType >( ( m_Threshold * ( maximum - minimum ) ) + minimum ) );
@@ -473,16 +489,18 @@ void Segmenter< TInputImage >
       searchIt.GoToBegin();
       labelIt.GoToBegin();
 
+      // The connectivity lists the negative neighbors from the last
+      // dimension to the first, then the positive neighbors from the first
+      // dimension to the last (see GenerateConnectivity).
       if ( ( idx ).second == 0 )
         {
         // Low face
-        cPos = m_Connectivity.index[( idx ).first];
+        cPos = m_Connectivity.index[( ImageDimension - 1 ) - ( idx ).first];
         }
       else
         {
         // High face
-        cPos = m_Connectivity.index[( ImageDimension - 1 )
-                                    + ( ImageDimension - ( idx ).first )];
+        cPos = m_Connectivity.index[ImageDimension + ( idx ).first];
         }
 
       while ( !searchIt.IsAtEnd() )
@@ -539,11 +557,20 @@ void Segmenter< TInputImage >
           {
           if ( searchIt.GetPixel(cPos) < searchIt.GetPixel(nCenter) )
             {
+            // Break ties the way GradientDescent does: the first of the
+            // lowest neighbors in connectivity order is the path.
             isSteepest = true;
+            bool beforeCPos = true;
             for ( i = 0; i < m_Connectivity.size; i++ )
               {
               nPos = m_Connectivity.index[i];
-              if ( searchIt.GetPixel(nPos) < searchIt.GetPixel(cPos) )
+              if ( nPos == cPos )
+                {
+                beforeCPos = false;
+                }
+              else if ( searchIt.GetPixel(nPos) < searchIt.GetPixel(cPos)
+                        || ( beforeCPos && Math::AlmostEquals( searchIt.GetPixel(nPos),
+                                                               searchIt.GetPixel(cPos) ) ) )
                 {
                 isSteepest = false;
                 break;
@@ -579,7 +606,9 @@ void Segmenter< TInputImage >
                   + output->ComputeOffset( labelIt.GetIndex() );
                 tempFlatRegion.value =
                   searchIt.GetPixel(nCenter);
-                tempFlatRegion.is_on_boundary = false;
+                // The flat region drains across the boundary, so where it
+                // drains must be resolved together with the neighbor chunk.
+                tempFlatRegion.is_on_boundary = true;
                 flatRegions[m_CurrentLabel] = tempFlatRegion;
                 break;
                 }
@@ -1148,6 +1177,10 @@ void Segmenter< TInputImage >
       ( *b ).second.bounds_min = ( *a ).second.bounds_min;
       ( *b ).second.min_label_ptr = ( *a ).second.min_label_ptr;
       }
+    if ( ( *a ).second.is_on_boundary )
+      {
+      ( *b ).second.is_on_boundary = true;
+      }
 
     regions.erase(a);
     }
@@ -1360,6 +1393,9 @@ Segmenter< TInputImage >
   m_CurrentLabel = 1;
   m_DoBoundaryAnalysis = false;
   m_SortEdgeLists = true;
+  m_UseInputRange = false;
+  m_InputMinimum = NumericTraits< InputPixelType >::ZeroValue();
+  m_InputMaximum = NumericTraits< InputPixelType >::ZeroValue();
   m_Connectivity.direction = nullptr;
   m_Connectivity.index = nullptr;
   typename OutputImageType::Pointer img =
@@ -1391,6 +1427,11 @@ Segmenter< TInputImage >
   os << indent << "Threshold: " << m_Threshold << std::endl;
   os << indent << "MaximumFloodLevel: " << m_MaximumFloodLevel << std::endl;
   os << indent << "CurrentLabel: " << m_CurrentLabel << std::endl;
+  os << indent << "UseInputRange: " << m_UseInputRange << std::endl;
+  os << indent << "InputMinimum: "
+     << static_cast< typename NumericTraits< InputPixelType >::PrintType >( m_InputMinimum ) << std::endl;
+  os << indent << "InputMaximum: "
+     << static_cast< typename NumericTraits< InputPixelType >::PrintType >( m_InputMaximum ) << std::endl;
 }
 } // end namespace watershed
 } // end namespace itk
@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+using LabelPixelType = unsigned short;
+
+// The number of pixels on the watershed lines and a checksum of the labels,
+// for each MarkWatershedLine and FullyConnected
+struct Signature
+{
+  itk::SizeValueType numberOfLinePixels;
+  unsigned int       checksum;
+};
+
+// The flooding of the integer images of at most 16 bits uses a bucket queue,
+// the one of the other images a map: the labels and the watershed lines must
+// be the same, and the same as with the flooding through the neighborhood
+// iterators and the priority queue of the previous implementation, given by
+// the expected signatures.
+template< unsigned int VDimension >
+int
+CompareQueues( const itk::Size< VDimension > & size, const Signature expected[2][2] )
+{
+  using CharImageType = itk::Image< unsigned char, VDimension >;
+  using ShortImageType = itk::Image< short, VDimension >;
+  using FloatImageType = itk::Image< float, VDimension >;
+  using LabelImageType = itk::Image< LabelPixelType, VDimension >;
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 2019 );
+
+  // a noisy relief with a few markers
+  typename CharImageType::Pointer input = CharImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+  typename LabelImageType::Pointer markers = LabelImageType::New();
+  markers->SetRegions( size );
+  markers->Allocate();
+  itk::ImageRegionIteratorWithIndex< CharImageType > it( input, input->GetLargestPossibleRegion() );
+  itk::ImageRegionIteratorWithIndex< LabelImageType > mit( markers, markers->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++mit )
+    {
+    double relief = 0.0;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      relief += 40.0 * std::sin( 0.3 * ( d + 1 ) * it.GetIndex()[d] );
+      }
+    it.Set( static_cast< unsigned char >( 128.0 + relief + generator->GetUniformVariate( 0.0, 8.0 ) ) );
+    mit.Set( generator->GetVariateWithOpenRange() < 0.01 ? generator->GetIntegerVariate( 8 ) + 1 : 0 );
+    }
+
+  using ShortCastType = itk::CastImageFilter< CharImageType, ShortImageType >;
+  typename ShortCastType::Pointer shortCast = ShortCastType::New();
+  shortCast->SetInput( input );
+  using FloatCastType = itk::CastImageFilter< CharImageType, FloatImageType >;
+  typename FloatCastType::Pointer floatCast = FloatCastType::New();
+  floatCast->SetInput( input );
+
+  int result = EXIT_SUCCESS;
+  for ( bool markWatershedLine : { true, false } )
+    {
+    for ( bool fullyConnected : { false, true } )
+      {
+      using CharFilterType = itk::MorphologicalWatershedFromMarkersImageFilter< CharImageType, LabelImageType >;
+      typename CharFilterType::Pointer charFilter = CharFilterType::New();
+      charFilter->SetInput( input );
+      charFilter->SetMarkerImage( markers );
+      charFilter->SetMarkWatershedLine( markWatershedLine );
+      charFilter->SetFullyConnected( fullyConnected );
+      ITK_TRY_EXPECT_NO_EXCEPTION( charFilter->Update() );
+
+      using ShortFilterType = itk::MorphologicalWatershedFromMarkersImageFilter< ShortImageType, LabelImageType >;
+      typename ShortFilterType::Pointer shortFilter = ShortFilterType::New();
+      shortFilter->SetInput( shortCast->GetOutput() );
+      shortFilter->SetMarkerImage( markers );
+      shortFilter->SetMarkWatershedLine( markWatershedLine );
+      shortFilter->SetFullyConnected( fullyConnected );
+      ITK_TRY_EXPECT_NO_EXCEPTION( shortFilter->Update() );
+
+      using FloatFilterType = itk::MorphologicalWatershedFromMarkersImageFilter< FloatImageType, LabelImageType >;
+      typename FloatFilterType::Pointer floatFilter = FloatFilterType::New();
+      floatFilter->SetInput( floatCast->GetOutput() );
+      floatFilter->SetMarkerImage( markers );
+      floatFilter->SetMarkWatershedLine( markWatershedLine );
+      floatFilter->SetFullyConnected( fullyConnected );
+      ITK_TRY_EXPECT_NO_EXCEPTION( floatFilter->Update() );
+
+      itk::SizeValueType numberOfLinePixels = 0;
+      unsigned int       checksum = 0;
+      itk::ImageRegionConstIterator< LabelImageType > cit( charFilter->GetOutput(), input->GetLargestPossibleRegion() );
+      itk::ImageRegionConstIterator< LabelImageType > sit( shortFilter->GetOutput(), input->GetLargestPossibleRegion() );
+      itk::ImageRegionConstIterator< LabelImageType > fit( floatFilter->GetOutput(), input->GetLargestPossibleRegion() );
+      itk::ImageRegionConstIterator< LabelImageType > mcit( markers, input->GetLargestPossibleRegion() );
+      for ( ; !cit.IsAtEnd(); ++cit, ++sit, ++fit, ++mcit )
+        {
+        if ( cit.Get() != fit.Get() || sit.Get() != fit.Get() )
+          {
+          std::cerr << "The labels differ at " << fit.GetIndex() << ": " << cit.Get() << ", " << sit.Get()
+                    << " and " << fit.Get() << std::endl;
+          result = EXIT_FAILURE;
+          break;
+          }
+        if ( mcit.Get() != 0 && cit.Get() != mcit.Get() )
+          {
+          std::cerr << "The marker at " << mcit.GetIndex() << " is not preserved." << std::endl;
+          result = EXIT_FAILURE;
+          break;
+          }
+        numberOfLinePixels += ( cit.Get() == 0 );
+        checksum = 31u * checksum + cit.Get();
+        }
+
+      std::cout << "Dimension " << VDimension << ", MarkWatershedLine " << markWatershedLine
+                << ", FullyConnected " << fullyConnected << ": " << numberOfLinePixels
+                << " pixels on the watershed lines, checksum " << checksum << std::endl;
+      const Signature & expectedSignature = expected[markWatershedLine][fullyConnected];
+      if ( numberOfLinePixels != expectedSignature.numberOfLinePixels || checksum != expectedSignature.checksum )
+        {
+        std::cerr << "Expected " << expectedSignature.numberOfLinePixels << " pixels on the watershed lines, checksum "
+                  << expectedSignature.checksum << std::endl;
+        result = EXIT_FAILURE;
+        }
+      if ( !markWatershedLine && numberOfLinePixels != 0 )
+        {
+        std::cerr << "All the pixels must be labeled without watershed lines." << std::endl;
+        result = EXIT_FAILURE;
+        }
+      }
+    }
+  return result;
+}
+
+} // end namespace
+
+int itkMorphologicalWatershedFromMarkersImageFilterTest2( int, char *[] )
+{
+  int result = EXIT_SUCCESS;
+
+  // The signatures are indexed by MarkWatershedLine, then FullyConnected
+  const Signature expected2[2][2] = { { { 0u, 3095225401u }, { 0u, 263674191u } },
+                                      { { 708u, 2951683057u }, { 924u, 3888320887u } } };
+  itk::Size< 2 > size2 = {{ 97, 64 }};
+  if ( CompareQueues< 2 >( size2, expected2 ) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  const Signature expected3[2][2] = { { { 0u, 1557342889u }, { 0u, 1725953826u } },
+                                      { { 3424u, 602460813u }, { 6080u, 2617565585u } } };
+  itk::Size< 3 > size3 = {{ 31, 27, 20 }};
+  if ( CompareQueues< 3 >( size3, expected3 ) == EXIT_FAILURE )
+    {
+    result = EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
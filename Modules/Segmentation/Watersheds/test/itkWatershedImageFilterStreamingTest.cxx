@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWatershedImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include <map>
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using LabelImageType = itk::Image< itk::IdentifierType, Dimension >;
+
+// Two label images are equal up to the values of the labels when the labels
+// of one map one to one onto the labels of the other.
+bool
+SamePartition( const LabelImageType * expected, const LabelImageType * result, size_t & numberOfLabels )
+{
+  std::map< itk::IdentifierType, itk::IdentifierType > forward;
+  std::map< itk::IdentifierType, itk::IdentifierType > backward;
+  itk::ImageRegionConstIterator< LabelImageType > expectedIt( expected, expected->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< LabelImageType > resultIt( result, result->GetLargestPossibleRegion() );
+  for ( ; !expectedIt.IsAtEnd(); ++expectedIt, ++resultIt )
+    {
+    if ( forward.insert( std::make_pair( expectedIt.Get(), resultIt.Get() ) ).first->second != resultIt.Get()
+         || backward.insert( std::make_pair( resultIt.Get(), expectedIt.Get() ) ).first->second != expectedIt.Get() )
+      {
+      return false;
+      }
+    }
+  numberOfLabels = forward.size();
+  return true;
+}
+
+template< typename TPixel >
+int
+TestStreaming( double threshold, double level )
+{
+  using ImageType = itk::Image< TPixel, Dimension >;
+  using FloatImageType = itk::Image< float, Dimension >;
+
+  // A smoothed random volume with many catchment basins
+  FloatImageType::Pointer noise = FloatImageType::New();
+  FloatImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 33;
+  size[2] = 29;
+  noise->SetRegions( size );
+  noise->Allocate();
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 20190612 );
+  for ( itk::ImageRegionIterator< FloatImageType > it( noise, noise->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( generator->GetUniformVariate( 0.0, 255.0 ) ) );
+    }
+
+  using SmoothingType = itk::DiscreteGaussianImageFilter< FloatImageType, FloatImageType >;
+  typename SmoothingType::Pointer smoothing = SmoothingType::New();
+  smoothing->SetInput( noise );
+  smoothing->SetVariance( 2.0 );
+
+  using CastType = itk::CastImageFilter< FloatImageType, ImageType >;
+  typename CastType::Pointer cast = CastType::New();
+  cast->SetInput( smoothing->GetOutput() );
+
+  using WatershedType = itk::WatershedImageFilter< ImageType >;
+  typename WatershedType::Pointer reference = WatershedType::New();
+  reference->SetInput( cast->GetOutput() );
+  reference->SetThreshold( threshold );
+  reference->SetLevel( level );
+  reference->Update();
+
+  int result = EXIT_SUCCESS;
+  for ( unsigned int divisions : { 2, 3, 7 } )
+    {
+    // A pipeline of its own, so that the input is not already buffered
+    typename CastType::Pointer streamedCast = CastType::New();
+    streamedCast->SetInput( smoothing->GetOutput() );
+
+    typename WatershedType::Pointer watershed = WatershedType::New();
+    watershed->SetInput( streamedCast->GetOutput() );
+    watershed->SetThreshold( threshold );
+    watershed->SetLevel( level );
+    watershed->SetNumberOfStreamDivisions( divisions );
+    ITK_TEST_SET_GET_VALUE( divisions, watershed->GetNumberOfStreamDivisions() );
+
+    using StreamingType = itk::StreamingImageFilter< LabelImageType, LabelImageType >;
+    StreamingType::Pointer streaming = StreamingType::New();
+    streaming->SetInput( watershed->GetOutput() );
+    streaming->SetNumberOfStreamDivisions( 4 );
+    ITK_TRY_EXPECT_NO_EXCEPTION( streaming->Update() );
+
+    // Neither the input nor the output of the watershed were held at once
+    if ( streamedCast->GetOutput()->GetBufferedRegion() == streamedCast->GetOutput()->GetLargestPossibleRegion()
+         || watershed->GetOutput()->GetBufferedRegion() == watershed->GetOutput()->GetLargestPossibleRegion() )
+      {
+      std::cerr << "With " << divisions << " divisions, the input or the output was not streamed." << std::endl;
+      result = EXIT_FAILURE;
+      }
+
+    size_t numberOfLabels = 0;
+    if ( !SamePartition( reference->GetOutput(), streaming->GetOutput(), numberOfLabels ) )
+      {
+      std::cerr << "With " << divisions << " divisions, threshold " << threshold << " and level " << level
+                << ", the streamed segmentation differs from the non-streamed one." << std::endl;
+      result = EXIT_FAILURE;
+      }
+    std::cout << divisions << " divisions, threshold " << threshold << ", level " << level << ": "
+              << numberOfLabels << " segments" << std::endl;
+    }
+  return result;
+}
+
+} // end namespace
+
+int itkWatershedImageFilterStreamingTest( int, char* [] )
+{
+  using ImageType = itk::Image< float, Dimension >;
+  itk::WatershedImageFilter< ImageType >::Pointer watershed = itk::WatershedImageFilter< ImageType >::New();
+  ITK_TEST_EXPECT_EQUAL( watershed->GetNumberOfStreamDivisions(), 1u );
+  watershed->SetNumberOfStreamDivisions( 0 );
+  ITK_TEST_EXPECT_EQUAL( watershed->GetNumberOfStreamDivisions(), 1u );
+
+  int result = EXIT_SUCCESS;
+  for ( const auto & parameters : { std::make_pair( 0.0, 0.0 ), std::make_pair( 0.0, 0.05 ),
+                                    std::make_pair( 0.1, 0.05 ) } )
+    {
+    if ( TestStreaming< float >( parameters.first, parameters.second ) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    if ( TestStreaming< unsigned char >( parameters.first, parameters.second ) == EXIT_FAILURE )
+      {
+      result = EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}